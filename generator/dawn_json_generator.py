@@ -291,6 +291,24 @@ class Command(Record):
         self.members = members or []
         self.derived_object = None
         self.derived_method = None
+        self.is_fixed_size = False
+        self.has_nested_dawn_object = False
+
+    def update_metadata(self):
+        Record.update_metadata(self)
+
+        # Commands with objects in structures or in arrays need to be deserialized to find all
+        # the objects they use, the others have the IDs of their objects in their fixed part.
+        self.has_nested_dawn_object = any(
+            (isinstance(m.type, ObjectType) and m.annotation != 'value')
+            or (isinstance(m.type, StructureType) and m.type.may_have_dawn_object)
+            for m in self.members)
+
+        # Commands with only value members that aren't structures have the same size on the
+        # wire every time, which lets them be [de]serialized without computing their size.
+        self.is_fixed_size = all(
+            m.annotation == 'value' and m.type.category != 'structure'
+            for m in self.members)
 
 
 def linked_record_members(json_data, types):
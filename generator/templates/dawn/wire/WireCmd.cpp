@@ -109,33 +109,36 @@
 
     //* Structure for the wire format of each of the records. Members that are values
     //* are embedded directly in the structure. Other members are assumed to be in the
-    //* memory directly following the structure in the buffer.
-    struct {{Return}}{{name}}Transfer{{Inherits}} {
-        static_assert({{[is_cmd, record.extensible, record.chained].count(True)}} <= 1,
-                      "Record must be at most one of is_cmd, extensible, and chained.");
-        {% if is_cmd %}
-            //* Start the transfer structure with the command ID, so that casting to WireCmd gives the ID.
-            {{Return}}WireCmd commandId;
-        {% elif record.extensible %}
-            bool hasNextInChain;
-        {% elif record.chained %}
-            WGPUChainedStructTransfer chain;
-        {% endif %}
+    //* memory directly following the structure in the buffer. The structure of fixed-size
+    //* commands is in WireCmd_autogen.h instead.
+    {% if not (is_cmd and record.is_fixed_size) %}
+        struct {{Return}}{{name}}Transfer{{Inherits}} {
+            static_assert({{[is_cmd, record.extensible, record.chained].count(True)}} <= 1,
+                          "Record must be at most one of is_cmd, extensible, and chained.");
+            {% if is_cmd %}
+                //* Start the transfer structure with the command ID, so that casting to WireCmd gives the ID.
+                {{Return}}WireCmd commandId;
+            {% elif record.extensible %}
+                bool hasNextInChain;
+            {% elif record.chained %}
+                WGPUChainedStructTransfer chain;
+            {% endif %}
 
-        //* Value types are directly in the command, objects being replaced with their IDs.
-        {% for member in members if member.annotation == "value" %}
-            {{member_transfer_type(member)}} {{as_varName(member.name)}};
-        {% endfor %}
+            //* Value types are directly in the command, objects being replaced with their IDs.
+            {% for member in members if member.annotation == "value" %}
+                {{member_transfer_type(member)}} {{as_varName(member.name)}};
+            {% endfor %}
 
-        //* const char* have their length embedded directly in the command.
-        {% for member in members if member.length == "strlen" %}
-            uint64_t {{as_varName(member.name)}}Strlen;
-        {% endfor %}
+            //* const char* have their length embedded directly in the command.
+            {% for member in members if member.length == "strlen" %}
+                uint64_t {{as_varName(member.name)}}Strlen;
+            {% endfor %}
 
-        {% for member in members if member.optional and member.annotation != "value" and member.type.category != "object" %}
-            bool has_{{as_varName(member.name)}};
-        {% endfor %}
-    };
+            {% for member in members if member.optional and member.annotation != "value" and member.type.category != "object" %}
+                bool has_{{as_varName(member.name)}};
+            {% endfor %}
+        };
+    {% endif %}
 
     {% if is_cmd %}
         static_assert(offsetof({{Return}}{{name}}Transfer, commandSize) == 0);
@@ -270,20 +273,27 @@
             {
                 auto memberLength = {{member_length(member, "record.")}};
 
-                {{member_transfer_type(member)}}* memberBuffer;
-                WIRE_TRY(buffer->NextN(memberLength, &memberBuffer));
-
-                {% if member.type.is_wire_transparent %}
-                    memcpy(
-                        memberBuffer, record.{{memberName}},
-                        {{member_transfer_sizeof(member)}} * memberLength);
+                {% if member.json_data["wire_is_data_only"] %}
+                    //* The data may be gathered by the SerializeBuffer to be written directly in the
+                    //* command stream instead of being copied.
+                    WIRE_TRY(buffer->NextData(memberLength, record.{{memberName}}));
                 {% else %}
-                    //* This loop cannot overflow because it iterates up to |memberLength|. Even if
-                    //* memberLength were the maximum integer value, |i| would become equal to it
-                    //* just before exiting the loop, but not increment past or wrap around.
-                    for (decltype(memberLength) i = 0; i < memberLength; ++i) {
-                        {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
-                    }
+                    {{member_transfer_type(member)}}* memberBuffer;
+                    WIRE_TRY(buffer->NextN(memberLength, &memberBuffer));
+
+                    {% if member.type.is_wire_transparent %}
+                        memcpy(
+                            memberBuffer, record.{{memberName}},
+                            {{member_transfer_sizeof(member)}} * memberLength);
+                    {% else %}
+                        //* This loop cannot overflow because it iterates up to |memberLength|. Even
+                        //* if memberLength were the maximum integer value, |i| would become equal
+                        //* to it just before exiting the loop, but not increment past or wrap
+                        //* around.
+                        for (decltype(memberLength) i = 0; i < memberLength; ++i) {
+                            {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
+                        }
+                    {% endif %}
                 {% endif %}
             }
         {% endfor %}
@@ -438,6 +448,75 @@
         return size;
     }
 
+    size_t {{Cmd}}::GetDataOnlySize() const {
+        size_t result = 0;
+        {% for member in command.members if member.json_data["wire_is_data_only"] %}
+            {% if member.optional %}
+                if (this->{{as_varName(member.name)}} != nullptr)
+            {% endif %}
+            {
+                result += {{member_length(member, "this->")}} * {{member_transfer_sizeof(member)}};
+            }
+        {% endfor %}
+        return result;
+    }
+
+    {% if command.is_fixed_size %}
+        //* The fixed-size commands only have value members, so their helpers never use the
+        //* SerializeBuffer or the DeserializeAllocator.
+        {% if command.may_have_dawn_object %}
+            WireResult {{Cmd}}::SerializeFixedSize(
+                char* serializeBuffer,
+                const ObjectIdProvider& provider
+            ) const {
+                {{Name}}Transfer* transfer = reinterpret_cast<{{Name}}Transfer*>(serializeBuffer);
+                transfer->commandSize = kFixedSize;
+                return {{Name}}Serialize(*this, transfer, nullptr, provider);
+            }
+            WireResult {{Cmd}}::SerializeFixedSize(char* serializeBuffer) const {
+                ErrorObjectIdProvider provider;
+                return SerializeFixedSize(serializeBuffer, provider);
+            }
+
+            WireResult {{Cmd}}::DeserializeFixedSize(
+                DeserializeBuffer* deserializeBuffer,
+                const ObjectIdResolver& resolver
+            ) {
+                const volatile {{Name}}Transfer* transfer;
+                WIRE_TRY(deserializeBuffer->Read(&transfer));
+                return {{Name}}Deserialize(this, transfer, deserializeBuffer, nullptr, resolver);
+            }
+            WireResult {{Cmd}}::DeserializeFixedSize(DeserializeBuffer* deserializeBuffer) {
+                ErrorObjectIdResolver resolver;
+                return DeserializeFixedSize(deserializeBuffer, resolver);
+            }
+        {% else %}
+            WireResult {{Cmd}}::SerializeFixedSize(char* serializeBuffer) const {
+                {{Name}}Transfer* transfer = reinterpret_cast<{{Name}}Transfer*>(serializeBuffer);
+                transfer->commandSize = kFixedSize;
+                return {{Name}}Serialize(*this, transfer, nullptr);
+            }
+            WireResult {{Cmd}}::SerializeFixedSize(
+                char* serializeBuffer,
+                const ObjectIdProvider&
+            ) const {
+                return SerializeFixedSize(serializeBuffer);
+            }
+
+            WireResult {{Cmd}}::DeserializeFixedSize(DeserializeBuffer* deserializeBuffer) {
+                const volatile {{Name}}Transfer* transfer;
+                WIRE_TRY(deserializeBuffer->Read(&transfer));
+                return {{Name}}Deserialize(this, transfer, deserializeBuffer, nullptr);
+            }
+            WireResult {{Cmd}}::DeserializeFixedSize(
+                DeserializeBuffer* deserializeBuffer,
+                const ObjectIdResolver&
+            ) {
+                return DeserializeFixedSize(deserializeBuffer);
+            }
+        {% endif %}
+
+    {% endif %}
     {% if command.may_have_dawn_object %}
         WireResult {{Cmd}}::Serialize(
             size_t commandSize,
@@ -749,6 +828,32 @@ namespace dawn::wire {
                 {% endfor %}
         };
 
+        // Implementation of ObjectIdResolver that records the objects of a command, to find
+        // the objects in its structures and arrays for GetCommandRouting.
+        class RoutingObjectRecorder final : public ObjectIdResolver {
+            public:
+                explicit RoutingObjectRecorder(std::vector<RoutingObject>* objects)
+                    : mObjects(objects) {}
+
+                {% for type in by_category["object"] %}
+                    WireResult GetFromId(ObjectId id, {{as_cType(type.name)}}* out) const override {
+                        mObjects->push_back({ObjectType::{{type.name.CamelCase()}}, id});
+                        *out = nullptr;
+                        return WireResult::Success;
+                    }
+                    WireResult GetOptionalFromId(ObjectId id, {{as_cType(type.name)}}* out) const override {
+                        if (id == 0) {
+                            *out = nullptr;
+                            return WireResult::Success;
+                        }
+                        return GetFromId(id, out);
+                    }
+                {% endfor %}
+
+            private:
+                std::vector<RoutingObject>* mObjects;
+        };
+
     }  // anonymous namespace
 
     {% for command in cmd_records["command"] %}
@@ -759,4 +864,89 @@ namespace dawn::wire {
         {{ write_command_serialization_methods(command, True) }}
     {% endfor %}
 
+    const char* GetWireCommandName(uint32_t commandId) {
+        switch (static_cast<WireCmd>(commandId)) {
+            {% for command in cmd_records["command"] %}
+                case WireCmd::{{command.name.CamelCase()}}:
+                    return "{{command.name.CamelCase()}}";
+            {% endfor %}
+        }
+        return nullptr;
+    }
+
+    WireResult GetCommandRouting(const volatile char* commands,
+                                 size_t size,
+                                 DeserializeAllocator* allocator,
+                                 CommandRouting* routing) {
+        if (size < sizeof(CmdHeader) + sizeof(WireCmd)) {
+            return WireResult::FatalError;
+        }
+        routing->objects.clear();
+
+        DeserializeBuffer deserializeBuffer(commands, size);
+        WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
+            commands + sizeof(CmdHeader)));
+        switch (cmdId) {
+            {% for command in cmd_records["command"] %}
+                {% set Suffix = command.name.CamelCase() %}
+                {% set self = command.members[0] %}
+                case WireCmd::{{Suffix}}: {
+                    const volatile {{Suffix}}Transfer* transfer;
+                    WIRE_TRY(deserializeBuffer.Read(&transfer));
+
+                    {% if Suffix == "DestroyObject" %}
+                        //* The type of the destroyed object comes from the client.
+                        ObjectType selfType = transfer->objectType;
+                        if (static_cast<uint32_t>(selfType) >= {{len(by_category["object"])}}u) {
+                            return WireResult::FatalError;
+                        }
+                        routing->selfType = selfType;
+                        routing->selfId = transfer->objectId;
+                    {% else %}
+                        //* The first member is either the self object of a method, or the ID of
+                        //* the object named "<type> id" of a handwritten command.
+                        {% if self.type.category == "object" %}
+                            routing->selfType = ObjectType::{{self.type.name.CamelCase()}};
+                        {% else %}
+                            {{ assert(self.name.chunks[-1] == "id") }}
+                            routing->selfType = ObjectType::{{Name(" ".join(self.name.chunks[:-1])).CamelCase()}};
+                        {% endif %}
+                        routing->selfId = transfer->{{as_varName(self.name)}};
+                    {% endif %}
+
+                    {% set results = command.members|selectattr("handle_type")|list %}
+                    {{ assert(len(results) <= 1) }}
+                    {% if len(results) == 1 %}
+                        routing->hasResult = true;
+                        routing->resultType = ObjectType::{{results[0].handle_type.name.CamelCase()}};
+                        routing->result = transfer->{{as_varName(results[0].name)}};
+                    {% else %}
+                        routing->hasResult = false;
+                    {% endif %}
+
+                    {% if command.has_nested_dawn_object %}
+                        //* Deserialize the command to find the objects in its structures and
+                        //* arrays, which also finds the objects of its fixed part.
+                        {{Suffix}}Cmd cmd;
+                        DeserializeBuffer commandBuffer(commands, size);
+                        WIRE_TRY(cmd.Deserialize(&commandBuffer, allocator,
+                                                 RoutingObjectRecorder(&routing->objects)));
+                    {% elif Suffix != "DestroyObject" %}
+                        {% for member in command.members[1:] if member.annotation == "value" %}
+                            {% if member.type.category == "object" %}
+                                routing->objects.push_back({ObjectType::{{member.type.name.CamelCase()}}, transfer->{{as_varName(member.name)}}});
+                            {% elif member.type.name.get() == "ObjectId" %}
+                                //* The ID of the object named "<type> id" of a handwritten command.
+                                {{ assert(member.name.chunks[-1] == "id") }}
+                                routing->objects.push_back({ObjectType::{{Name(" ".join(member.name.chunks[:-1])).CamelCase()}}, transfer->{{as_varName(member.name)}}});
+                            {% endif %}
+                        {% endfor %}
+                    {% endif %}
+                    return WireResult::Success;
+                }
+            {% endfor %}
+        }
+        return WireResult::FatalError;
+    }
+
 }  // namespace dawn::wire
@@ -15,6 +15,8 @@
 #ifndef DAWNWIRE_WIRECMD_AUTOGEN_H_
 #define DAWNWIRE_WIRECMD_AUTOGEN_H_
 
+#include <vector>
+
 #include "dawn/webgpu.h"
 
 #include "dawn/wire/BufferConsumer.h"
@@ -68,12 +70,68 @@ namespace dawn::wire {
         uint64_t commandSize;
     };
 
+    struct RoutingObject {
+        ObjectType type;
+        ObjectId id;
+    };
+
+    //* The objects that a command uses and creates, read from its serialized form. Used by the
+    //* server to route the commands of each device to its thread.
+    struct CommandRouting {
+        // The object the command is called on, which is the first object of the command.
+        ObjectType selfType;
+        ObjectId selfId;
+        // The object created by the command, if any.
+        bool hasResult;
+        ObjectType resultType;
+        ObjectHandle result;
+        // The other objects used by the command. It may also contain the object the command is
+        // called on, and the same object more than once.
+        std::vector<RoutingObject> objects;
+    };
+
+    // Reads the CommandRouting of the serialized command at the start of |commands|. Returns a
+    // FatalError if there isn't enough data for the command or if its object type is invalid.
+    // Only the commands with objects in structures or arrays are deserialized to find them,
+    // using |allocator|.
+    WireResult GetCommandRouting(const volatile char* commands,
+                                 size_t size,
+                                 DeserializeAllocator* allocator,
+                                 CommandRouting* routing);
+
 {% macro write_command_struct(command, is_return_command) %}
     {% set Return = "Return" if is_return_command else "" %}
     {% set Cmd = command.name.CamelCase() + "Cmd" %}
+    {% if command.is_fixed_size %}
+        //* The wire format of fixed-size commands is in the header so that their size is known
+        //* at compile time. The wire format of other commands is private to WireCmd_autogen.cpp.
+        struct {{Return}}{{command.name.CamelCase()}}Transfer : CmdHeader {
+            {{Return}}WireCmd commandId;
+            {% for member in command.members %}
+                {% if member.type.category == "object" %}
+                    ObjectId {{as_varName(member.name)}};
+                {% elif member.type.category == "bitmask" %}
+                    {{as_cType(member.type.name)}}Flags {{as_varName(member.name)}};
+                {% else %}
+                    {{as_cType(member.type.name)}} {{as_varName(member.name)}};
+                {% endif %}
+            {% endfor %}
+        };
+    {% endif %}
+
     struct {{Return}}{{Cmd}} {
+        //* The size of the command on the wire if it is always the same, 0 otherwise.
+        {% if command.is_fixed_size %}
+            static constexpr size_t kFixedSize = sizeof({{Return}}{{command.name.CamelCase()}}Transfer);
+        {% else %}
+            static constexpr size_t kFixedSize = 0;
+        {% endif %}
+
         //* From a filled structure, compute how much size will be used in the serialization buffer.
         size_t GetRequiredSize() const;
+        //* The part of the required size used by members that are only data, which can be
+        //* gathered by the SerializeBuffer instead of being copied in it.
+        size_t GetDataOnlySize() const;
 
         //* Serialize the structure and everything it points to into serializeBuffer which must be
         //* big enough to contain all the data (as queried from GetRequiredSize).
@@ -92,6 +150,16 @@ namespace dawn::wire {
         // Override which produces a FatalError if any object is used.
         WireResult Deserialize(DeserializeBuffer* deserializeBuffer, DeserializeAllocator* allocator);
 
+        {% if command.is_fixed_size %}
+            //* Fast paths for fixed-size commands: Serialize writes exactly kFixedSize bytes in
+            //* serializeBuffer without a SerializeBuffer, and Deserialize doesn't need an allocator
+            //* because there is no pointed-to data.
+            WireResult SerializeFixedSize(char* serializeBuffer, const ObjectIdProvider& objectIdProvider) const;
+            WireResult SerializeFixedSize(char* serializeBuffer) const;
+            WireResult DeserializeFixedSize(DeserializeBuffer* deserializeBuffer, const ObjectIdResolver& resolver);
+            WireResult DeserializeFixedSize(DeserializeBuffer* deserializeBuffer);
+        {% endif %}
+
         {% if command.derived_method %}
             //* Command handlers want to know the object ID in addition to the backing object.
             //* Doesn't need to be filled before Serialize, or GetRequiredSize.
@@ -24,11 +24,33 @@
 
 namespace dawn::wire::server {
 
+    class ServerBase;
+
+    //* Finds the Server that has an object when there are several Servers, see ThreadedServer.
+    class ObjectServerLookup {
+      public:
+        //* Returns the Server that has the object, or nullptr if there is none.
+        virtual const ServerBase* FindObjectServer(ObjectType type, ObjectId id) const = 0;
+    };
+
     class ServerBase : public ChunkedCommandHandler, public ObjectIdResolver {
       public:
         ServerBase() = default;
         ~ServerBase() override = default;
 
+        //* Used by the servers of the device threads, which only see the IDs of their objects.
+        void AllowSparseObjectIds() {
+            {% for type in by_category["object"] %}
+                mKnown{{type.name.CamelCase()}}.AllowSparseIds();
+            {% endfor %}
+        }
+
+        //* Used by the ThreadedServer while all the Servers are idle, so that the commands that
+        //* use objects of several devices can resolve the IDs of the objects of other Servers.
+        void SetObjectServerLookup(const ObjectServerLookup* lookup) {
+            mObjectServerLookup = lookup;
+        }
+
       protected:
         void DestroyAllObjects(const DawnProcTable& procs) {
             //* Free all objects when the server is destroyed
@@ -67,12 +89,18 @@ namespace dawn::wire::server {
             }
         {% endfor %}
 
-      private:
         // Implementation of the ObjectIdResolver interface
         {% for type in by_category["object"] %}
             WireResult GetFromId(ObjectId id, {{as_cType(type.name)}}* out) const final {
                 auto data = mKnown{{type.name.CamelCase()}}.Get(id);
                 if (data == nullptr) {
+                    if (mObjectServerLookup != nullptr) {
+                        const ServerBase* server = mObjectServerLookup->FindObjectServer(
+                            ObjectType::{{type.name.CamelCase()}}, id);
+                        if (server != nullptr && server != this) {
+                            return server->GetFromId(id, out);
+                        }
+                    }
                     return WireResult::FatalError;
                 }
 
@@ -90,6 +118,7 @@ namespace dawn::wire::server {
             }
         {% endfor %}
 
+      private:
         //* The list of known IDs for each object type.
         {% for type in by_category["object"] %}
             KnownObjects<{{as_cType(type.name)}}> mKnown{{type.name.CamelCase()}};
@@ -98,6 +127,8 @@ namespace dawn::wire::server {
         {% for type in by_category["object"] if type.name.CamelCase() in server_reverse_lookup_objects %}
             ObjectIdLookupTable<{{as_cType(type.name)}}> m{{type.name.CamelCase()}}IdTable;
         {% endfor %}
+
+        const ObjectServerLookup* mObjectServerLookup = nullptr;
     };
 
 }  // namespace dawn::wire::server
@@ -25,7 +25,11 @@ namespace dawn::wire::server {
         //* The generic command handlers
         bool Server::Handle{{Suffix}}(DeserializeBuffer* deserializeBuffer) {
             {{Suffix}}Cmd cmd;
-            WireResult deserializeResult = cmd.Deserialize(deserializeBuffer, &mAllocator
+            {% if command.is_fixed_size %}
+                WireResult deserializeResult = cmd.DeserializeFixedSize(deserializeBuffer
+            {% else %}
+                WireResult deserializeResult = cmd.Deserialize(deserializeBuffer, &mAllocator
+            {% endif %}
                 {%- if command.may_have_dawn_object -%}
                     , *this
                 {%- endif -%}
@@ -106,10 +110,15 @@ namespace dawn::wire::server {
             WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
                 deserializeBuffer.Buffer() + sizeof(CmdHeader)));
             bool success = false;
+            //* Fixed-size commands don't use the allocator so it doesn't need to be reset.
+            bool usedAllocator = true;
             switch (cmdId) {
                 {% for command in cmd_records["command"] %}
                     case WireCmd::{{command.name.CamelCase()}}:
                         success = Handle{{command.name.CamelCase()}}(&deserializeBuffer);
+                        {% if command.is_fixed_size %}
+                            usedAllocator = false;
+                        {% endif %}
                         break;
                 {% endfor %}
                 default:
@@ -119,7 +128,9 @@ namespace dawn::wire::server {
             if (!success) {
                 return nullptr;
             }
-            mAllocator.Reset();
+            if (usedAllocator) {
+                mAllocator.Reset();
+            }
         }
 
         if (deserializeBuffer.AvailableSize() != 0) {
@@ -187,6 +187,49 @@ DAWN_NATIVE_EXPORT std::vector<const char*> GetTogglesUsed(WGPUDevice device);
 // Backdoor to get the number of lazy clears for testing
 DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(WGPUDevice device);
 
+// Cancels the asynchronous pipeline creations that haven't started yet and were requested with
+// |cancellationGroup| in their DawnAsyncPipelineCreationOptions. Their callbacks are called with
+// an error. Cancellation group 0 is the default and can't be cancelled. Returns the number of
+// cancelled creations.
+DAWN_NATIVE_EXPORT size_t CancelAsyncPipelineCreations(WGPUDevice device,
+                                                       uint64_t cancellationGroup);
+
+// Counters of the reuse of texture views and bind groups when the
+// pool_texture_views_and_bind_groups toggle is enabled.
+struct DAWN_NATIVE_EXPORT ObjectPoolStats {
+    uint64_t textureViewHits = 0;
+    uint64_t textureViewMisses = 0;
+    uint64_t bindGroupHits = 0;
+    uint64_t bindGroupMisses = 0;
+};
+
+DAWN_NATIVE_EXPORT ObjectPoolStats GetObjectPoolStats(WGPUDevice device);
+
+// Starts the asynchronous creation, on the worker task pool, of the pipelines recorded in the
+// blob cache by devices with the "record_pipeline_manifest" toggle enabled. The device keeps the
+// created pipelines alive so that creating the same pipelines later is immediate. Pipelines that
+// can't be created anymore, for example because the source of their shader modules was evicted
+// from the cache, are skipped. Pipelines created with a default layout aren't recorded. Returns
+// the number of creations started. Requires the blob cache to be enabled.
+DAWN_NATIVE_EXPORT size_t PrewarmPipelinesFromManifest(WGPUDevice device);
+
+// Returns the number of pipelines started by PrewarmPipelinesFromManifest that aren't created
+// yet. Like the callbacks of asynchronous pipeline creations, it decreases when the device is
+// ticked, or immediately for pipelines that are already created.
+DAWN_NATIVE_EXPORT size_t GetPendingPipelinePrewarmCount(WGPUDevice device);
+
+// Creates a buffer that is a view of the range [offset, offset + size) of |backingBuffer|, without
+// any backend allocation. The view can be used like a buffer in bind groups, copies, vertex,
+// index and indirect buffers, and Queue::WriteBuffer, but it isn't mappable and can't be
+// destroyed separately from |backingBuffer|. Commands reference |backingBuffer| instead of the
+// view, so usages are tracked and validated for the whole backing buffer: for example views of
+// the same backing buffer can't be used as a storage buffer and a uniform buffer in the same pass.
+// |offset| must be a multiple of minUniformBufferOffsetAlignment and
+// minStorageBufferOffsetAlignment. Returns an error buffer if validation fails.
+DAWN_NATIVE_EXPORT WGPUBuffer CreateSuballocatedBuffer(WGPUBuffer backingBuffer,
+                                                       uint64_t offset,
+                                                       uint64_t size);
+
 // Backdoor to get the number of deprecation warnings for testing
 DAWN_NATIVE_EXPORT size_t GetDeprecationWarningCountForTesting(WGPUDevice device);
 
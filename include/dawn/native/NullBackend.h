@@ -15,11 +15,39 @@
 #ifndef INCLUDE_DAWN_NATIVE_NULLBACKEND_H_
 #define INCLUDE_DAWN_NATIVE_NULLBACKEND_H_
 
+#include <cstdint>
+
 #include "dawn/dawn_wsi.h"
 #include "dawn/native/DawnNative.h"
 
 namespace dawn::native::null {
 DAWN_NATIVE_EXPORT DawnSwapChainImplementation CreateNativeSwapChainImpl();
+
+// Costs used by the null backend to simulate a GPU timeline. Durations are in nanoseconds of a
+// virtual clock that only moves when the device is ticked or when AdvanceSimulatedTime is
+// called, so simulations are deterministic. The default costs complete all work instantly.
+struct DAWN_NATIVE_EXPORT SimulatedExecutionCosts {
+    // Delay between a submission being scheduled on the simulated GPU and its completion.
+    uint64_t submitLatencyNs = 0;
+    // Cost of each command recorded in a submitted command buffer.
+    uint64_t perCommandNs = 0;
+    // Additional cost of each draw or dispatch command in a submitted command buffer.
+    uint64_t perDrawOrDispatchNs = 0;
+    // Cost of each kilobyte written to a resource by the queue or the dynamic uploader.
+    uint64_t perKilobyteWrittenNs = 0;
+    // Time that elapses on the virtual clock every time the device is ticked.
+    uint64_t tickDurationNs = 0;
+};
+
+DAWN_NATIVE_EXPORT void SetSimulatedExecutionCosts(WGPUDevice device,
+                                                   const SimulatedExecutionCosts& costs);
+
+// Moves the virtual clock of the device forward, completing the simulated GPU work that
+// finishes before the new time on the next device tick.
+DAWN_NATIVE_EXPORT void AdvanceSimulatedTime(WGPUDevice device, uint64_t durationNs);
+
+DAWN_NATIVE_EXPORT uint64_t GetSimulatedTime(WGPUDevice device);
+
 }  // namespace dawn::native::null
 
 #endif  // INCLUDE_DAWN_NATIVE_NULLBACKEND_H_
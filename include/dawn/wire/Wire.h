@@ -50,6 +50,11 @@ class DAWN_WIRE_EXPORT CommandHandler {
     virtual const volatile char* HandleCommands(const volatile char* commands, size_t size) = 0;
 };
 
+// Returns the name of the command with the given ID in a client->server command stream, or
+// nullptr if there is no such command. Used by tools that inspect serialized command streams,
+// like the replay of wire traces.
+DAWN_WIRE_EXPORT const char* GetWireCommandName(uint32_t commandId);
+
 }  // namespace dawn::wire
 
 // TODO(dawn:824): Remove once the deprecation period is passed.
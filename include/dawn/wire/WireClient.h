@@ -58,9 +58,45 @@ struct ReservedInstance {
     uint32_t generation;
 };
 
+// When the WireClient flushes its CommandSerializer by itself. By default it never does and the
+// embedder is responsible for calling Flush. With a policy, the commands can be batched in fewer,
+// larger messages while still being sent when the server needs them. The thresholds are checked
+// after each command, and 0 disables them.
+struct DAWN_WIRE_EXPORT WireClientFlushPolicy {
+    // Flush when at least this many bytes of commands are pending.
+    size_t maxPendingBytes = 0;
+    // Flush when at least this many commands are pending.
+    size_t maxPendingCommands = 0;
+    // Flush after each Queue::Submit so that the GPU work starts as soon as possible.
+    bool flushOnSubmit = false;
+    // Flush after each Buffer::MapAsync since its callback waits for the server.
+    bool flushOnMapAsync = false;
+    // Flush when the oldest pending command was serialized at least this many microseconds ago.
+    // The client doesn't have a thread of its own so this is only checked every few commands
+    // and in WireClient::FlushIfExpired, which the embedder can call periodically.
+    uint64_t maxPendingTimeUs = 0;
+};
+
+// The flushes of the CommandSerializer done through the WireClient since its creation. Flushes
+// without any pending command aren't counted.
+struct DAWN_WIRE_EXPORT WireClientFlushStats {
+    // The number of flushes, in total and for each reason.
+    uint64_t flushes = 0;
+    uint64_t explicitFlushes = 0;
+    uint64_t pendingBytesFlushes = 0;
+    uint64_t pendingCommandsFlushes = 0;
+    uint64_t submitFlushes = 0;
+    uint64_t mapAsyncFlushes = 0;
+    uint64_t pendingTimeFlushes = 0;
+    // The number of commands, and their size in bytes, that were flushed.
+    uint64_t flushedCommands = 0;
+    uint64_t flushedBytes = 0;
+};
+
 struct DAWN_WIRE_EXPORT WireClientDescriptor {
     CommandSerializer* serializer;
     client::MemoryTransferService* memoryTransferService = nullptr;
+    WireClientFlushPolicy flushPolicy = {};
 };
 
 class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
@@ -81,6 +117,16 @@ class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
     void ReclaimDeviceReservation(const ReservedDevice& reservation);
     void ReclaimInstanceReservation(const ReservedInstance& reservation);
 
+    // Flushes the CommandSerializer. Embedders using a WireClientFlushPolicy should flush
+    // through the client instead of the serializer directly so that it knows that no commands
+    // are pending anymore. Returns false if the serializer failed to flush or if the client is
+    // disconnected.
+    bool Flush();
+    // Flushes the CommandSerializer if the oldest pending command is older than the
+    // maxPendingTimeUs of the WireClientFlushPolicy. Returns false if the flush failed.
+    bool FlushIfExpired();
+    WireClientFlushStats GetFlushStats() const;
+
     // Disconnects the client.
     // Commands allocated after this point will not be sent.
     void Disconnect();
@@ -0,0 +1,116 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDE_DAWN_WIRE_WIRECOMPRESSION_H_
+#define INCLUDE_DAWN_WIRE_WIRECOMPRESSION_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+
+namespace dawn::wire {
+
+class LZCompressor;
+
+// Optional compression of a wire command stream, for transports where the bandwidth dominates,
+// like remote rendering over a socket or a VM boundary. The commands are very repetitive (object
+// IDs, identical descriptors, the same draws over and over) and compress well with a fast LZ
+// compression primed with a dictionary of command headers.
+//
+// A CompressingCommandSerializer goes between the wire (the WireClient, or the WireServer for the
+// return commands) and the serializer of the transport, and writes the commands to the transport
+// as compressed frames. On the other side, a DecompressingCommandHandler goes between the
+// transport and the wire. As for uncompressed commands, the transport must pass each allocation
+// of its serializer to the handler in a single HandleCommands call.
+//
+// The compression is negotiated when the wire is created: the first frame is preceded by a
+// stream header with the version of the format and a checksum of the dictionary. The
+// DecompressingCommandHandler finds out from the first commands it receives whether the stream
+// is compressed, so the side receiving the commands can always use one, and it fails if the
+// other side uses another format or dictionary, for example from another version of Dawn.
+
+// The statistics of a CompressingCommandSerializer since its creation.
+struct DAWN_WIRE_EXPORT WireCompressionStats {
+    // The number of frames written to the transport.
+    uint64_t frames = 0;
+    // The size of the commands before and after compression. The compressed size includes the
+    // stream and frame headers.
+    uint64_t uncompressedBytes = 0;
+    uint64_t compressedBytes = 0;
+};
+
+class DAWN_WIRE_EXPORT CompressingCommandSerializer : public CommandSerializer {
+  public:
+    // The maximum size of the commands in a frame. Larger commands are split by the wire.
+    static constexpr size_t kMaxFrameSize = 256 * 1024;
+
+    explicit CompressingCommandSerializer(CommandSerializer* serializer);
+    ~CompressingCommandSerializer() override;
+
+    size_t GetMaximumAllocationSize() const override;
+    void* GetCmdSpace(size_t size) override;
+    // Writes the pending commands as a frame and flushes the serializer of the transport.
+    bool Flush() override;
+    void OnSerializeError() override;
+
+    WireCompressionStats GetStats() const;
+
+  private:
+    // Compresses the pending commands and writes them to the transport.
+    bool WriteFrame();
+
+    CommandSerializer* mSerializer;
+    std::unique_ptr<LZCompressor> mCompressor;
+    size_t mFrameCapacity;
+    std::unique_ptr<char[]> mFrame;
+    size_t mFrameSize = 0;
+    std::unique_ptr<char[]> mCompressedFrame;
+    bool mWroteStreamHeader = false;
+    WireCompressionStats mStats;
+};
+
+class DAWN_WIRE_EXPORT DecompressingCommandHandler : public CommandHandler {
+  public:
+    explicit DecompressingCommandHandler(CommandHandler* handler);
+    ~DecompressingCommandHandler() override;
+
+    // Passes the commands to the handler, decompressing them if the stream is compressed.
+    // Returns nullptr if the compressed stream is invalid or if the handler fails.
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
+
+    // Whether the commands received so far are a compressed stream.
+    bool IsCompressed() const;
+
+  private:
+    enum class StreamState {
+        Unknown,
+        Compressed,
+        Uncompressed,
+    };
+
+    // Reads the stream header at the start of a compressed stream. Returns the number of bytes
+    // consumed, or 0 if the header is invalid.
+    size_t ReadStreamHeader(const volatile char* commands, size_t size);
+    const volatile char* HandleFrames(const volatile char* commands, size_t size);
+
+    CommandHandler* mHandler;
+    StreamState mState = StreamState::Unknown;
+    std::unique_ptr<char[]> mCompressedFrame;
+    std::unique_ptr<char[]> mFrame;
+};
+
+}  // namespace dawn::wire
+
+#endif  // INCLUDE_DAWN_WIRE_WIRECOMPRESSION_H_
@@ -25,6 +25,7 @@ namespace dawn::wire {
 
 namespace server {
 class Server;
+class ThreadedServer;
 class MemoryTransferService;
 }  // namespace server
 
@@ -32,6 +33,12 @@ struct DAWN_WIRE_EXPORT WireServerDescriptor {
     const DawnProcTable* procs;
     CommandSerializer* serializer;
     server::MemoryTransferService* memoryTransferService = nullptr;
+    // The maximum size of the memory that the server keeps across commands to deserialize the
+    // data they point to. Larger commands allocate and free their memory each time.
+    size_t maxDeserializeArenaSize = 1024 * 1024;
+    // The number of threads that handle the commands of the devices, or 0 to handle all the
+    // commands on the thread that calls HandleCommands. See WireServer::HandleCommands.
+    uint32_t deviceThreadCount = 0;
 };
 
 class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -39,6 +46,21 @@ class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
     explicit WireServer(const WireServerDescriptor& descriptor);
     ~WireServer() override;
 
+    // When WireServerDescriptor::deviceThreadCount isn't 0, each device is assigned to one of
+    // the device threads, which handle the commands of their devices in order. HandleCommands
+    // only routes the commands to the threads, except for the commands of the instance and the
+    // adapters that it handles itself once the device threads are idle. In that mode:
+    //  - The servers of the threads serialize the return commands and flush the serializer with
+    //    an internal lock held, so the embedder must not use the serializer.
+    //  - HandleCommands returns nullptr if a device thread failed to handle earlier commands.
+    //  - The commands of a device that use objects of a device on another thread are handled
+    //    on the thread of HandleCommands once the device threads are idle, so that the device
+    //    gets a validation error like when there are no device threads. They are much slower
+    //    than the other commands.
+    //  - The memory transfer service must be thread-safe.
+    //  - The devices must be ticked with TickDevices instead of directly.
+    //  - Devices cannot use surfaces, swapchains must be injected.
+    // All the methods of the WireServer must still be called on the same thread.
     const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
 
     bool InjectTexture(WGPUTexture texture,
@@ -70,8 +92,17 @@ class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
     // them periodically to ensure progress on asynchronous work is made.
     bool IsDeviceKnown(WGPUDevice device) const;
 
+    // Ticks all the devices of the wire. With device threads, the devices are ticked
+    // asynchronously by their thread.
+    void TickDevices();
+
+    // Waits until the device threads have handled all the commands given to HandleCommands so
+    // far. Does nothing if there are no device threads.
+    void WaitForIdle();
+
   private:
     std::unique_ptr<server::Server> mImpl;
+    std::unique_ptr<server::ThreadedServer> mThreadedImpl;
 };
 
 namespace server {
@@ -0,0 +1,133 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/common/HashUtils.h"
+
+#include <cstring>
+
+#include "dawn/common/Compiler.h"
+
+#if DAWN_COMPILER_IS(MSVC) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// HashBytes is an implementation of wyhash (https://github.com/wangyi-fudan/wyhash, released in
+// the public domain) which mixes the input 64 bits at a time with 64x64->128 bit multiplications.
+
+namespace {
+
+constexpr uint64_t kSecret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+                                 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+// Computes the 128 bit product of *a and *b and stores the low bits in *a and the high bits in
+// *b.
+inline void MultiplyFull(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = *a;
+    r *= *b;
+    *a = static_cast<uint64_t>(r);
+    *b = static_cast<uint64_t>(r >> 64);
+#elif DAWN_COMPILER_IS(MSVC) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ha = *a >> 32;
+    uint64_t hb = *b >> 32;
+    uint64_t la = static_cast<uint32_t>(*a);
+    uint64_t lb = static_cast<uint32_t>(*b);
+    uint64_t rh = ha * hb;
+    uint64_t rm0 = ha * lb;
+    uint64_t rm1 = hb * la;
+    uint64_t rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+inline uint64_t Mix(uint64_t a, uint64_t b) {
+    MultiplyFull(&a, &b);
+    return a ^ b;
+}
+
+// Unaligned reads of 8, 4 and 1 to 3 bytes.
+inline uint64_t Read8(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t Read4(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t Read1To3(const uint8_t* p, size_t size) {
+    return (uint64_t(p[0]) << 16) | (uint64_t(p[size >> 1]) << 8) | p[size - 1];
+}
+
+}  // anonymous namespace
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    seed ^= Mix(seed ^ kSecret[0], kSecret[1]);
+
+    uint64_t a;
+    uint64_t b;
+    if (DAWN_LIKELY(size <= 16)) {
+        if (DAWN_LIKELY(size >= 4)) {
+            // Two possibly overlapping reads of 4 bytes from each end of the data.
+            size_t offset = (size >> 3) << 2;
+            a = (Read4(p) << 32) | Read4(p + offset);
+            b = (Read4(p + size - 4) << 32) | Read4(p + size - 4 - offset);
+        } else if (DAWN_LIKELY(size > 0)) {
+            a = Read1To3(p, size);
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        size_t remaining = size;
+        if (DAWN_UNLIKELY(remaining > 48)) {
+            // Three independent lanes so that the multiplications can be pipelined.
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+                seed1 = Mix(Read8(p + 16) ^ kSecret[2], Read8(p + 24) ^ seed1);
+                seed2 = Mix(Read8(p + 32) ^ kSecret[3], Read8(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            } while (DAWN_LIKELY(remaining > 48));
+            seed ^= seed1 ^ seed2;
+        }
+        while (DAWN_UNLIKELY(remaining > 16)) {
+            seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // The last 16 bytes, possibly overlapping with the previous block.
+        a = Read8(p + remaining - 16);
+        b = Read8(p + remaining - 8);
+    }
+
+    a ^= kSecret[1];
+    b ^= seed;
+    MultiplyFull(&a, &b);
+    return Mix(a ^ kSecret[0] ^ size, b ^ kSecret[1]);
+}
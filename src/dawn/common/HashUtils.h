@@ -16,6 +16,8 @@
 #define SRC_DAWN_COMMON_HASHUTILS_H_
 
 #include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 
 #include "dawn/common/Platform.h"
@@ -29,6 +31,12 @@ size_t Hash(const T& value) {
     return std::hash<T>()(value);
 }
 
+// Hashes |size| contiguous bytes starting at |data|. This processes the data by 16 to 48 byte blocks
+// and is much faster than combining the hashes of each individual element so it should be used
+// for data that's laid out contiguously in memory like strings, code or serialized keys. The
+// result depends on the endianness of the platform and must only be used in memory.
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
 // Add hashing of TypedIntegers
 template <typename Tag, typename T>
 size_t Hash(const TypedInteger<Tag, T>& value) {
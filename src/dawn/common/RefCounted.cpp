@@ -20,14 +20,20 @@
 
 static constexpr size_t kPayloadBits = 1;
 static constexpr uint64_t kPayloadMask = (uint64_t(1) << kPayloadBits) - 1;
-static constexpr uint64_t kRefCountIncrement = (uint64_t(1) << kPayloadBits);
+
+// The bit after the payload marks refcounts that are only ever used from a single thread.
+static constexpr uint64_t kSingleThreadedBit = uint64_t(1) << kPayloadBits;
+
+static constexpr size_t kFlagBits = kPayloadBits + 1;
+static constexpr uint64_t kFlagMask = (uint64_t(1) << kFlagBits) - 1;
+static constexpr uint64_t kRefCountIncrement = (uint64_t(1) << kFlagBits);
 
 RefCount::RefCount(uint64_t payload) : mRefCount(kRefCountIncrement + payload) {
     ASSERT((payload & kPayloadMask) == payload);
 }
 
 uint64_t RefCount::GetValueForTesting() const {
-    return mRefCount >> kPayloadBits;
+    return mRefCount >> kFlagBits;
 }
 
 uint64_t RefCount::GetPayload() const {
@@ -39,7 +45,16 @@ uint64_t RefCount::GetPayload() const {
 }
 
 void RefCount::Increment() {
-    ASSERT((mRefCount & ~kPayloadMask) != 0);
+    ASSERT((mRefCount & ~kFlagMask) != 0);
+
+    // Single-threaded refcounts are updated with a plain load and store which don't require
+    // locked instructions. The relaxed load is as cheap as a non-atomic load on all
+    // architectures we support.
+    uint64_t refCount = mRefCount.load(std::memory_order_relaxed);
+    if (refCount & kSingleThreadedBit) {
+        mRefCount.store(refCount + kRefCountIncrement, std::memory_order_relaxed);
+        return;
+    }
 
     // The relaxed ordering guarantees only the atomicity of the update, which is enough here
     // because the reference we are copying from still exists and makes sure other threads
@@ -50,7 +65,13 @@ void RefCount::Increment() {
 }
 
 bool RefCount::Decrement() {
-    ASSERT((mRefCount & ~kPayloadMask) != 0);
+    ASSERT((mRefCount & ~kFlagMask) != 0);
+
+    uint64_t refCount = mRefCount.load(std::memory_order_relaxed);
+    if (refCount & kSingleThreadedBit) {
+        mRefCount.store(refCount - kRefCountIncrement, std::memory_order_relaxed);
+        return refCount < 2 * kRefCountIncrement;
+    }
 
     // The release fence here is to make sure all accesses to the object on a thread A
     // happen-before the object is deleted on a thread B. The release memory order ensures that
@@ -74,6 +95,10 @@ bool RefCount::Decrement() {
     return false;
 }
 
+void RefCount::SetSingleThreaded() {
+    mRefCount.fetch_or(kSingleThreadedBit, std::memory_order_relaxed);
+}
+
 RefCounted::RefCounted(uint64_t payload) : mRefCount(payload) {}
 RefCounted::~RefCounted() = default;
 
@@ -85,6 +110,10 @@ uint64_t RefCounted::GetRefCountPayload() const {
     return mRefCount.GetPayload();
 }
 
+void RefCounted::SetRefCountSingleThreaded() {
+    mRefCount.SetSingleThreaded();
+}
+
 void RefCounted::Reference() {
     mRefCount.Increment();
 }
@@ -34,6 +34,11 @@ class RefCount {
     // Remove a reference. Returns true if this was the last reference.
     bool Decrement();
 
+    // Make the updates of the refcount non-atomic. This must only be called while a single
+    // thread has access to the refcount, and afterwards the refcount must never be updated
+    // concurrently.
+    void SetSingleThreaded();
+
   private:
     std::atomic<uint64_t> mRefCount;
 };
@@ -54,6 +59,8 @@ class RefCounted {
   protected:
     virtual ~RefCounted();
 
+    void SetRefCountSingleThreaded();
+
     // A Derived class may override this if they require a custom deleter.
     virtual void DeleteThis();
 
@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_COMMON_SERIALQUEUE_H_
 #define SRC_DAWN_COMMON_SERIALQUEUE_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -23,12 +25,102 @@
 template <typename Serial, typename Value>
 class SerialQueue;
 
+// The storage of a SerialQueue: a vector of (Serial, values) buckets of which only the range
+// [mBegin, mEnd) is live. Buckets are not freed when they are cleared; they keep the capacity of
+// their vector of values and are reused for the next serials. This way a SerialQueue in steady
+// state (like the per-submit queues of the backends) doesn't allocate, and clearing the front of
+// the queue doesn't move all the remaining buckets. When the queue drains or rotates, the cleared
+// buckets in excess of twice the live ones are freed so that a burst of serials doesn't keep its
+// memory once it is cleared. The retained buckets still keep the capacity of their values.
+template <typename Serial, typename Value>
+class SerialQueueStorage {
+  public:
+    using SerialPair = std::pair<Serial, std::vector<Value>>;
+    using iterator = typename std::vector<SerialPair>::iterator;
+    using const_iterator = typename std::vector<SerialPair>::const_iterator;
+
+    iterator begin() { return mBuckets.begin() + mBegin; }
+    iterator end() { return mBuckets.begin() + mEnd; }
+    const_iterator begin() const { return mBuckets.begin() + mBegin; }
+    const_iterator end() const { return mBuckets.begin() + mEnd; }
+
+    bool empty() const { return mBegin == mEnd; }
+
+    SerialPair& back() {
+        DAWN_ASSERT(!empty());
+        return mBuckets[mEnd - 1];
+    }
+    const SerialPair& back() const {
+        DAWN_ASSERT(!empty());
+        return mBuckets[mEnd - 1];
+    }
+
+    // Appends a bucket for serial and returns its (empty) vector of values.
+    std::vector<Value>& AppendBucket(Serial serial) {
+        if (mEnd == mBuckets.size()) {
+            mBuckets.emplace_back(serial, std::vector<Value>{});
+        } else {
+            mBuckets[mEnd].first = serial;
+        }
+        return mBuckets[mEnd++].second;
+    }
+
+    void clear() { erase(begin(), end()); }
+
+    // The number of buckets in the storage, live or cleared.
+    size_t GetBucketCountForTesting() const { return mBuckets.size(); }
+
+    // Only erasing the front of the storage is supported.
+    void erase(iterator first, iterator last) {
+        DAWN_ASSERT(first == begin());
+        for (iterator it = first; it != last; ++it) {
+            it->second.clear();
+        }
+        mBegin += static_cast<size_t>(last - first);
+
+        if (mBegin == mEnd) {
+            mBegin = 0;
+            mEnd = 0;
+            TrimClearedBuckets();
+        } else if (mBegin >= mEnd - mBegin) {
+            // Move the live buckets back to the front once there are more cleared buckets before
+            // them than live buckets. This is amortized by the buckets cleared since the last
+            // rotation.
+            std::rotate(mBuckets.begin(), begin(), end());
+            mEnd -= mBegin;
+            mBegin = 0;
+            TrimClearedBuckets();
+        }
+    }
+
+  private:
+    // The number of cleared buckets kept for reuse even when the queue is empty.
+    static constexpr size_t kMinRetainedBuckets = 4;
+
+    // Frees the cleared buckets after the live ones, which must be at the front, when there are
+    // more than twice as many buckets as needed. The retained buckets are bounded to twice the
+    // live buckets (or kMinRetainedBuckets), and the margin amortizes the reallocation of
+    // mBuckets over the buckets that were added since the last trim.
+    void TrimClearedBuckets() {
+        DAWN_ASSERT(mBegin == 0);
+        size_t retainedBuckets = std::max(2 * mEnd, kMinRetainedBuckets);
+        if (mBuckets.size() <= 2 * retainedBuckets) {
+            return;
+        }
+        mBuckets.erase(mBuckets.begin() + retainedBuckets, mBuckets.end());
+        mBuckets.shrink_to_fit();
+    }
+
+    std::vector<SerialPair> mBuckets;
+    size_t mBegin = 0;
+    size_t mEnd = 0;
+};
+
 template <typename SerialT, typename ValueT>
 struct SerialStorageTraits<SerialQueue<SerialT, ValueT>> {
     using Serial = SerialT;
     using Value = ValueT;
-    using SerialPair = std::pair<Serial, std::vector<Value>>;
-    using Storage = std::vector<SerialPair>;
+    using Storage = SerialQueueStorage<SerialT, ValueT>;
     using StorageIterator = typename Storage::iterator;
     using ConstStorageIterator = typename Storage::const_iterator;
 };
@@ -54,9 +146,10 @@ void SerialQueue<Serial, Value>::Enqueue(const Value& value, Serial serial) {
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
 
     if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<Value>{});
+        this->mStorage.AppendBucket(serial).push_back(value);
+    } else {
+        this->mStorage.back().second.push_back(value);
     }
-    this->mStorage.back().second.push_back(value);
 }
 
 template <typename Serial, typename Value>
@@ -64,23 +157,24 @@ void SerialQueue<Serial, Value>::Enqueue(Value&& value, Serial serial) {
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
 
     if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<Value>{});
+        this->mStorage.AppendBucket(serial).push_back(std::move(value));
+    } else {
+        this->mStorage.back().second.push_back(std::move(value));
     }
-    this->mStorage.back().second.push_back(std::move(value));
 }
 
 template <typename Serial, typename Value>
 void SerialQueue<Serial, Value>::Enqueue(const std::vector<Value>& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+    this->mStorage.AppendBucket(serial).assign(values.begin(), values.end());
 }
 
 template <typename Serial, typename Value>
 void SerialQueue<Serial, Value>::Enqueue(std::vector<Value>&& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+    this->mStorage.AppendBucket(serial) = std::move(values);
 }
 
 #endif  // SRC_DAWN_COMMON_SERIALQUEUE_H_
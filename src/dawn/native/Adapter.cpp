@@ -22,6 +22,8 @@
 #include "dawn/native/Device.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/ValidationUtils_autogen.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 namespace dawn::native {
 
@@ -192,6 +194,7 @@ bool AdapterBase::GetLimits(SupportedLimits* limits) const {
 ResultOrError<Ref<DeviceBase>> AdapterBase::CreateDeviceInternal(
     const DeviceDescriptor* descriptor) {
     ASSERT(descriptor != nullptr);
+    TRACE_EVENT0(mInstance->GetPlatform(), General, "AdapterBase::CreateDevice");
 
     for (uint32_t i = 0; i < descriptor->requiredFeaturesCount; ++i) {
         wgpu::FeatureName f = descriptor->requiredFeatures[i];
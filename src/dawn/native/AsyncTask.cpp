@@ -14,71 +14,143 @@
 
 #include "dawn/native/AsyncTask.h"
 
+#include <algorithm>
+#include <thread>
 #include <utility>
 
+#include "dawn/common/Assert.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native {
 
-AsyncTaskManager::AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool)
-    : mWorkerTaskPool(workerTaskPool) {}
-
-void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
-    // If these allocations becomes expensive, we can slab-allocate tasks.
-    Ref<WaitableTask> waitableTask = AcquireRef(new WaitableTask());
-    waitableTask->taskManager = this;
-    waitableTask->asyncTask = std::move(asyncTask);
+AsyncTaskManager::AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool,
+                                   uint32_t maxConcurrentTasks)
+    : mWorkerTaskPool(workerTaskPool), mMaxConcurrentTasks(maxConcurrentTasks) {
+    ASSERT(mMaxConcurrentTasks > 0);
+}
 
-    {
-        // We insert new waitableTask objects into mPendingTasks in main thread (PostTask()),
-        // and we may remove waitableTask objects from mPendingTasks in either main thread
-        // (WaitAllPendingTasks()) or sub-thread (TaskCompleted), so mPendingTasks should be
-        // protected by a mutex.
-        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-        mPendingTasks.emplace(waitableTask.Get(), waitableTask);
-    }
+AsyncTaskManager::~AsyncTaskManager() {
+    // The workers reference the manager so they must be done before it is destroyed.
+    WaitAllPendingTasks();
+    ASSERT(mQueuedTasks.empty());
+    ASSERT(mWorkerCount == 0);
+}
 
-    // Ref the task since it is accessed inside the worker function.
-    // The worker function will acquire and release the task upon completion.
-    waitableTask->Reference();
-    waitableTask->waitableEvent =
-        mWorkerTaskPool->PostWorkerTask(DoWaitableTask, waitableTask.Get());
+// static
+uint32_t AsyncTaskManager::GetDefaultMaxConcurrentTasks() {
+    return std::max(std::thread::hardware_concurrency(), 1u);
 }
 
-void AsyncTaskManager::HandleTaskCompletion(WaitableTask* task) {
-    std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-    auto iter = mPendingTasks.find(task);
-    if (iter != mPendingTasks.end()) {
-        mPendingTasks.erase(iter);
+void AsyncTaskManager::PostTask(AsyncTask asyncTask,
+                                int32_t priority,
+                                uint64_t cancellationGroup,
+                                AsyncTask cancelTask) {
+    bool needsWorker = false;
+    {
+        // Tasks are queued from the main thread (PostTask()) and removed from either the main
+        // thread (CancelTasks()) or the workers, so the queue is protected by a mutex.
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQueuedTasks.emplace(TaskOrder{priority, mNextTaskSerial++},
+                             QueuedTask{std::move(asyncTask), std::move(cancelTask),
+                                        cancellationGroup});
+        if (mWorkerCount < mMaxConcurrentTasks) {
+            mWorkerCount++;
+            needsWorker = true;
+        }
+    }
+    if (!needsWorker) {
+        return;
     }
+
+    // Post the worker without holding the lock in case the pool runs it synchronously.
+    std::unique_ptr<dawn::platform::WaitableEvent> workerEvent =
+        mWorkerTaskPool->PostWorkerTask(DoWorkerTask, this);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mWorkerEvents.erase(
+        std::remove_if(mWorkerEvents.begin(), mWorkerEvents.end(),
+                       [](const std::unique_ptr<dawn::platform::WaitableEvent>& event) {
+                           return event->IsComplete();
+                       }),
+        mWorkerEvents.end());
+    mWorkerEvents.push_back(std::move(workerEvent));
 }
 
-void AsyncTaskManager::WaitAllPendingTasks() {
-    std::unordered_map<WaitableTask*, Ref<WaitableTask>> allPendingTasks;
+size_t AsyncTaskManager::CancelTasks(uint64_t cancellationGroup) {
+    ASSERT(cancellationGroup != kNoCancellationGroup);
 
+    std::vector<AsyncTask> cancelTasks;
     {
-        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-        allPendingTasks.swap(mPendingTasks);
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto it = mQueuedTasks.begin(); it != mQueuedTasks.end();) {
+            if (it->second.cancellationGroup == cancellationGroup) {
+                cancelTasks.push_back(std::move(it->second.cancelTask));
+                it = mQueuedTasks.erase(it);
+            } else {
+                ++it;
+            }
+        }
     }
 
-    for (auto& [_, task] : allPendingTasks) {
-        task->waitableEvent->Wait();
+    for (AsyncTask& cancelTask : cancelTasks) {
+        if (cancelTask) {
+            cancelTask();
+        }
+    }
+    return cancelTasks.size();
+}
+
+void AsyncTaskManager::WaitAllPendingTasks() {
+    // The workers run until the queue is empty so waiting for all of them also waits for the
+    // tasks that are still queued.
+    while (true) {
+        std::vector<std::unique_ptr<dawn::platform::WaitableEvent>> workerEvents;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            workerEvents.swap(mWorkerEvents);
+        }
+        if (workerEvents.empty()) {
+            return;
+        }
+        for (std::unique_ptr<dawn::platform::WaitableEvent>& event : workerEvents) {
+            event->Wait();
+        }
     }
 }
 
 bool AsyncTaskManager::HasPendingTasks() {
-    std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-    return !mPendingTasks.empty();
+    std::lock_guard<std::mutex> lock(mMutex);
+    return !mQueuedTasks.empty() || mRunningTaskCount > 0;
 }
 
-void AsyncTaskManager::DoWaitableTask(void* task) {
-    Ref<WaitableTask> waitableTask = AcquireRef(static_cast<WaitableTask*>(task));
-    waitableTask->asyncTask();
-    waitableTask->taskManager->HandleTaskCompletion(waitableTask.Get());
+// static
+void AsyncTaskManager::DoWorkerTask(void* taskManager) {
+    static_cast<AsyncTaskManager*>(taskManager)->RunQueuedTasks();
 }
 
-AsyncTaskManager::WaitableTask::WaitableTask() = default;
+void AsyncTaskManager::RunQueuedTasks() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mQueuedTasks.empty()) {
+        AsyncTask asyncTask = std::move(mQueuedTasks.begin()->second.asyncTask);
+        mQueuedTasks.erase(mQueuedTasks.begin());
+        mRunningTaskCount++;
 
-AsyncTaskManager::WaitableTask::~WaitableTask() = default;
+        lock.unlock();
+        asyncTask();
+        lock.lock();
+
+        mRunningTaskCount--;
+    }
+    // Decrement the worker count while holding the lock so that PostTask() posts a new worker
+    // if a task is queued after this worker saw an empty queue.
+    mWorkerCount--;
+}
+
+bool AsyncTaskManager::TaskOrder::operator<(const TaskOrder& other) const {
+    if (priority != other.priority) {
+        return priority > other.priority;
+    }
+    return serial < other.serial;
+}
 
 }  // namespace dawn::native
@@ -15,12 +15,12 @@
 #ifndef SRC_DAWN_NATIVE_ASYNCTASK_H_
 #define SRC_DAWN_NATIVE_ASYNCTASK_H_
 
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
-
-#include "dawn/common/RefCounted.h"
+#include <vector>
 
 namespace dawn::platform {
 class WaitableEvent;
@@ -29,38 +29,65 @@ class WorkerTaskPool;
 
 namespace dawn::native {
 
-// TODO(crbug.com/dawn/826): we'll add additional things to AsyncTask in the future, like
-// Cancel() and RunNow(). Cancelling helps avoid running the task's body when we are just
-// shutting down the device. RunNow() could be used for more advanced scenarios, for example
-// always doing ShaderModule initial compilation asynchronously, but being able to steal the
-// task if we need it for synchronous pipeline compilation.
 using AsyncTask = std::function<void()>;
 
+// Tasks posted with this cancellation group can't be cancelled.
+static constexpr uint64_t kNoCancellationGroup = 0;
+
+// Runs tasks on the worker task pool. At most |maxConcurrentTasks| tasks run at the same time and
+// the tasks that are waiting to run are started in order of decreasing priority, then in the
+// order they were posted. Each task is picked when a worker starts it instead of being bound to a
+// worker task when it is posted, so the ordering doesn't depend on the scheduling of the pool.
 class AsyncTaskManager {
   public:
-    explicit AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool);
+    explicit AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool,
+                              uint32_t maxConcurrentTasks = GetDefaultMaxConcurrentTasks());
+    ~AsyncTaskManager();
+
+    // |cancelTask| is called instead of |asyncTask| if the task is cancelled before it starts.
+    void PostTask(AsyncTask asyncTask,
+                  int32_t priority = 0,
+                  uint64_t cancellationGroup = kNoCancellationGroup,
+                  AsyncTask cancelTask = {});
+
+    // Removes the tasks of |cancellationGroup| that haven't started yet and calls their
+    // |cancelTask| on the calling thread. Returns the number of cancelled tasks.
+    size_t CancelTasks(uint64_t cancellationGroup);
 
-    void PostTask(AsyncTask asyncTask);
     void WaitAllPendingTasks();
     bool HasPendingTasks();
 
+    static uint32_t GetDefaultMaxConcurrentTasks();
+
   private:
-    class WaitableTask : public RefCounted {
-      public:
-        WaitableTask();
-        ~WaitableTask() override;
+    // Tasks are ordered by decreasing priority, then by increasing serial.
+    struct TaskOrder {
+        int32_t priority;
+        uint64_t serial;
 
+        bool operator<(const TaskOrder& other) const;
+    };
+    struct QueuedTask {
         AsyncTask asyncTask;
-        AsyncTaskManager* taskManager;
-        std::unique_ptr<dawn::platform::WaitableEvent> waitableEvent;
+        AsyncTask cancelTask;
+        uint64_t cancellationGroup;
     };
 
-    static void DoWaitableTask(void* task);
-    void HandleTaskCompletion(WaitableTask* task);
+    static void DoWorkerTask(void* taskManager);
+    void RunQueuedTasks();
+
+    // Protects all the members below.
+    std::mutex mMutex;
+    std::map<TaskOrder, QueuedTask> mQueuedTasks;
+    uint64_t mNextTaskSerial = 0;
+    uint32_t mRunningTaskCount = 0;
+    // The number of worker tasks posted to mWorkerTaskPool that haven't finished running queued
+    // tasks, and their events.
+    uint32_t mWorkerCount = 0;
+    std::vector<std::unique_ptr<dawn::platform::WaitableEvent>> mWorkerEvents;
 
-    std::mutex mPendingTasksMutex;
-    std::unordered_map<WaitableTask*, Ref<WaitableTask>> mPendingTasks;
     dawn::platform::WorkerTaskPool* mWorkerTaskPool;
+    const uint32_t mMaxConcurrentTasks;
 };
 
 }  // namespace dawn::native
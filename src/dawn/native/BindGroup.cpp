@@ -15,6 +15,7 @@
 #include "dawn/native/BindGroup.h"
 
 #include "dawn/common/Assert.h"
+#include "dawn/common/HashUtils.h"
 #include "dawn/common/Math.h"
 #include "dawn/common/ityp_bitset.h"
 #include "dawn/native/BindGroupLayout.h"
@@ -250,8 +251,44 @@ MaybeError ValidateExternalTextureBinding(
     return {};
 }
 
+// The resource, offset and size of a binding as stored in BindGroupBase, used to pool bind groups.
+struct PooledBinding {
+    BindingIndex bindingIndex;
+    ObjectBase* resource;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t rangeEnd;
+};
+
+PooledBinding GetPooledBinding(const BindGroupDescriptor* descriptor, const BindGroupEntry& entry) {
+    BindingIndex bindingIndex = descriptor->layout->GetBindingIndex(BindingNumber(entry.binding));
+    if (entry.buffer != nullptr) {
+        uint64_t size = (entry.size == wgpu::kWholeSize) ? entry.buffer->GetSize() - entry.offset
+                                                         : entry.size;
+        return {bindingIndex, entry.buffer->GetBackingBuffer(),
+                entry.offset + entry.buffer->GetBackingOffset(), size,
+                entry.buffer->GetBackingOffset() + entry.buffer->GetSize()};
+    }
+    if (entry.textureView != nullptr) {
+        return {bindingIndex, entry.textureView, 0, 0, 0};
+    }
+    return {bindingIndex, entry.sampler, 0, 0, 0};
+}
+
 }  // anonymous namespace
 
+size_t ComputeBindGroupPoolHash(const BindGroupDescriptor* descriptor) {
+    // Entries may be in any order so their hashes are summed.
+    size_t hash = 0;
+    for (uint32_t i = 0; i < descriptor->entryCount; ++i) {
+        PooledBinding binding = GetPooledBinding(descriptor, descriptor->entries[i]);
+        size_t entryHash = Hash(binding.bindingIndex);
+        HashCombine(&entryHash, binding.resource, binding.offset, binding.size, binding.rangeEnd);
+        hash += entryHash;
+    }
+    return hash;
+}
+
 MaybeError ValidateBindGroupDescriptor(DeviceBase* device,
                                        const BindGroupDescriptor* descriptor,
                                        UsageValidationMode mode) {
@@ -376,12 +413,17 @@ BindGroupBase::BindGroupBase(DeviceBase* device,
 
         if (entry.buffer != nullptr) {
             ASSERT(mBindingData.bindings[bindingIndex] == nullptr);
-            mBindingData.bindings[bindingIndex] = entry.buffer;
-            mBindingData.bufferData[bindingIndex].offset = entry.offset;
+            // Suballocated buffers are replaced with the range of their backing buffer, and
+            // dynamic offsets are limited to the end of the view.
+            mBindingData.bindings[bindingIndex] = entry.buffer->GetBackingBuffer();
+            mBindingData.bufferData[bindingIndex].offset =
+                entry.offset + entry.buffer->GetBackingOffset();
             uint64_t bufferSize = (entry.size == wgpu::kWholeSize)
                                       ? entry.buffer->GetSize() - entry.offset
                                       : entry.size;
             mBindingData.bufferData[bindingIndex].size = bufferSize;
+            mBindingData.bufferData[bindingIndex].rangeEnd =
+                entry.buffer->GetBackingOffset() + entry.buffer->GetSize();
             continue;
         }
 
@@ -435,6 +477,8 @@ BindGroupBase::BindGroupBase(DeviceBase* device,
             mBindingData.bufferData[paramsBindingIndex].offset = 0;
             mBindingData.bufferData[paramsBindingIndex].size =
                 sizeof(dawn_native::ExternalTextureParams);
+            mBindingData.bufferData[paramsBindingIndex].rangeEnd =
+                externalTextureBindingEntry->externalTexture->GetParamsBuffer()->GetSize();
 
             continue;
         }
@@ -460,6 +504,9 @@ BindGroupBase::BindGroupBase(DeviceBase* device) : ApiObjectBase(device, kLabelN
 BindGroupBase::~BindGroupBase() = default;
 
 void BindGroupBase::DestroyImpl() {
+    if (mIsPooled) {
+        mLayout->RemovePooledBindGroup(this);
+    }
     if (mLayout != nullptr) {
         ASSERT(!IsError());
         for (BindingIndex i{0}; i < mLayout->GetBindingCount(); ++i) {
@@ -509,7 +556,8 @@ BufferBinding BindGroupBase::GetBindingAsBufferBinding(BindingIndex bindingIndex
     ASSERT(mLayout->GetBindingInfo(bindingIndex).bindingType == BindingInfoType::Buffer);
     BufferBase* buffer = static_cast<BufferBase*>(mBindingData.bindings[bindingIndex].Get());
     return {buffer, mBindingData.bufferData[bindingIndex].offset,
-            mBindingData.bufferData[bindingIndex].size};
+            mBindingData.bufferData[bindingIndex].size,
+            mBindingData.bufferData[bindingIndex].rangeEnd};
 }
 
 SamplerBase* BindGroupBase::GetBindingAsSampler(BindingIndex bindingIndex) const {
@@ -531,4 +579,53 @@ const std::vector<Ref<ExternalTextureBase>>& BindGroupBase::GetBoundExternalText
     return mBoundExternalTextures;
 }
 
+bool BindGroupBase::HasSameEntries(const BindGroupDescriptor* descriptor) const {
+    ASSERT(!IsError());
+    ASSERT(descriptor->layout == mLayout.Get());
+    ASSERT(mLayout->GetExternalTextureBindingCount() == 0);
+
+    if (BindingIndex(descriptor->entryCount) != mLayout->GetBindingCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < descriptor->entryCount; ++i) {
+        PooledBinding binding = GetPooledBinding(descriptor, descriptor->entries[i]);
+        if (mBindingData.bindings[binding.bindingIndex].Get() != binding.resource) {
+            return false;
+        }
+        if (binding.bindingIndex < mLayout->GetBufferCount() &&
+            (mBindingData.bufferData[binding.bindingIndex].offset != binding.offset ||
+             mBindingData.bufferData[binding.bindingIndex].size != binding.size ||
+             mBindingData.bufferData[binding.bindingIndex].rangeEnd != binding.rangeEnd)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BindGroupBase::UsesDestroyedResource() const {
+    ASSERT(!IsError());
+    for (BindingIndex i{0}; i < mLayout->GetBindingCount(); ++i) {
+        switch (mLayout->GetBindingInfo(i).bindingType) {
+            case BindingInfoType::Buffer:
+                if (static_cast<const BufferBase*>(mBindingData.bindings[i].Get())
+                        ->IsDestroyed()) {
+                    return true;
+                }
+                break;
+            case BindingInfoType::Texture:
+            case BindingInfoType::StorageTexture:
+                if (static_cast<const TextureViewBase*>(mBindingData.bindings[i].Get())
+                        ->GetTexture()
+                        ->GetTextureState() == TextureBase::TextureState::Destroyed) {
+                    return true;
+                }
+                break;
+            case BindingInfoType::Sampler:
+            case BindingInfoType::ExternalTexture:
+                break;
+        }
+    }
+    return false;
+}
+
 }  // namespace dawn::native
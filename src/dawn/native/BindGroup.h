@@ -36,10 +36,16 @@ MaybeError ValidateBindGroupDescriptor(DeviceBase* device,
                                        const BindGroupDescriptor* descriptor,
                                        UsageValidationMode mode);
 
+// Returns the hash of the entries of |descriptor| used to pool bind groups, see
+// Toggle::PoolTextureViewsAndBindGroups. It doesn't depend on the order of the entries.
+size_t ComputeBindGroupPoolHash(const BindGroupDescriptor* descriptor);
+
 struct BufferBinding {
     BufferBase* buffer;
     uint64_t offset;
     uint64_t size;
+    // See BindGroupLayoutBase::BufferBindingData::rangeEnd.
+    uint64_t rangeEnd;
 };
 
 class BindGroupBase : public ApiObjectBase {
@@ -56,6 +62,12 @@ class BindGroupBase : public ApiObjectBase {
     const ityp::span<uint32_t, uint64_t>& GetUnverifiedBufferSizes() const;
     const std::vector<Ref<ExternalTextureBase>>& GetBoundExternalTextures() const;
 
+    // Returns whether the bind group was created with the same entries as |descriptor|, which
+    // must use the same layout and no external textures.
+    bool HasSameEntries(const BindGroupDescriptor* descriptor) const;
+    // Returns whether one of the buffers or textures of the bind group was destroyed.
+    bool UsesDestroyedResource() const;
+
   protected:
     // To save memory, the size of a bind group is dynamically determined and the bind group is
     // placement-allocated into memory big enough to hold the bind group with its
@@ -86,6 +98,10 @@ class BindGroupBase : public ApiObjectBase {
     BindGroupBase(DeviceBase* device, ObjectBase::ErrorTag tag);
     void DeleteThis() override;
 
+    friend class BindGroupLayoutBase;
+    size_t mPoolHash = 0;
+    bool mIsPooled = false;
+
     Ref<BindGroupLayoutBase> mLayout;
     BindGroupLayoutBase::BindingDataPointers mBindingData;
 
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "dawn/common/BitSetIterator.h"
+#include "dawn/native/BindGroup.h"
 #include "dawn/native/ChainUtils_autogen.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/ObjectBase.h"
@@ -653,6 +654,47 @@ bool BindGroupLayoutBase::IsStorageBufferBinding(BindingIndex bindingIndex) cons
     UNREACHABLE();
 }
 
+BindGroupBase* BindGroupLayoutBase::GetPooledBindGroup(const BindGroupDescriptor* descriptor,
+                                                       size_t hash) {
+    auto [begin, end] = mPooledBindGroups.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        BindGroupBase* bindGroup = it->second;
+        if (!bindGroup->HasSameEntries(descriptor)) {
+            continue;
+        }
+        // Stop pooling bind groups that use destroyed resources so that a new bind group is
+        // created and pooled instead.
+        if (bindGroup->UsesDestroyedResource()) {
+            bindGroup->mIsPooled = false;
+            mPooledBindGroups.erase(it);
+            return nullptr;
+        }
+        return bindGroup;
+    }
+    return nullptr;
+}
+
+void BindGroupLayoutBase::AddPooledBindGroup(BindGroupBase* bindGroup, size_t hash) {
+    ASSERT(bindGroup->GetLayout() == this);
+    ASSERT(!bindGroup->mIsPooled);
+    mPooledBindGroups.emplace(hash, bindGroup);
+    bindGroup->mPoolHash = hash;
+    bindGroup->mIsPooled = true;
+}
+
+void BindGroupLayoutBase::RemovePooledBindGroup(BindGroupBase* bindGroup) {
+    ASSERT(bindGroup->mIsPooled);
+    auto [begin, end] = mPooledBindGroups.equal_range(bindGroup->mPoolHash);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == bindGroup) {
+            mPooledBindGroups.erase(it);
+            bindGroup->mIsPooled = false;
+            return;
+        }
+    }
+    UNREACHABLE();
+}
+
 std::string BindGroupLayoutBase::EntriesToString() const {
     std::string entries = "[";
     std::string sep = "";
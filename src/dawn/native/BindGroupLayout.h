@@ -19,6 +19,7 @@
 #include <bitset>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #include "dawn/common/Constants.h"
 #include "dawn/common/Math.h"
@@ -111,6 +112,9 @@ class BindGroupLayoutBase : public ApiObjectBase, public CachedObject {
     struct BufferBindingData {
         uint64_t offset;
         uint64_t size;
+        // The end of the range of the buffer that dynamic offsets may move the binding in: the end
+        // of the view for suballocated buffers, and the end of the buffer otherwise.
+        uint64_t rangeEnd;
     };
 
     struct BindingDataPointers {
@@ -134,6 +138,14 @@ class BindGroupLayoutBase : public ApiObjectBase, public CachedObject {
     // Returns a detailed string representation of the layout entries for use in error messages.
     std::string EntriesToString() const;
 
+    // Pooling of the live bind groups created with this layout, see
+    // Toggle::PoolTextureViewsAndBindGroups. |hash| is the ComputeBindGroupPoolHash of the
+    // descriptor. The pool doesn't hold references to the bind groups, which remove themselves
+    // from it when they are destroyed.
+    BindGroupBase* GetPooledBindGroup(const BindGroupDescriptor* descriptor, size_t hash);
+    void AddPooledBindGroup(BindGroupBase* bindGroup, size_t hash);
+    void RemovePooledBindGroup(BindGroupBase* bindGroup);
+
   protected:
     // Constructor used only for mocking and testing.
     explicit BindGroupLayoutBase(DeviceBase* device);
@@ -163,6 +175,8 @@ class BindGroupLayoutBase : public ApiObjectBase, public CachedObject {
     const PipelineCompatibilityToken mPipelineCompatibilityToken = PipelineCompatibilityToken(0);
 
     uint32_t mUnexpandedBindingCount;
+
+    std::unordered_multimap<size_t, BindGroupBase*> mPooledBindGroups;
 };
 
 }  // namespace dawn::native
@@ -105,8 +105,7 @@ void stream::Stream<Blob>::Write(stream::Sink* s, const Blob& b) {
     size_t size = b.Size();
     StreamIn(s, size);
     if (size > 0) {
-        void* ptr = s->GetSpace(size);
-        memcpy(ptr, b.Data(), size);
+        s->Write(b.Data(), size);
     }
 }
 
@@ -114,15 +113,7 @@ template <>
 MaybeError stream::Stream<Blob>::Read(stream::Source* s, Blob* b) {
     size_t size;
     DAWN_TRY(StreamOut(s, &size));
-    if (size > 0) {
-        const void* ptr;
-        DAWN_TRY(s->Read(&ptr, size));
-        *b = CreateBlob(size);
-        memcpy(b->Data(), ptr, size);
-    } else {
-        *b = Blob();
-    }
-    return {};
+    return s->ReadBlob(b, size);
 }
 
 }  // namespace dawn::native
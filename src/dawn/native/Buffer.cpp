@@ -14,6 +14,7 @@
 
 #include "dawn/native/Buffer.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <limits>
@@ -88,6 +89,26 @@ class ErrorBuffer final : public BufferBase {
     std::unique_ptr<uint8_t[]> mFakeMappedData;
 };
 
+class SuballocatedBuffer final : public BufferBase {
+  public:
+    SuballocatedBuffer(BufferBase* backingBuffer, uint64_t offset, uint64_t size)
+        : BufferBase(backingBuffer, offset, size) {}
+
+  private:
+    // Suballocated buffers don't have mappable usages and can't be mapped at creation.
+    bool IsCPUWritableAtCreation() const override { UNREACHABLE(); }
+
+    MaybeError MapAtCreationImpl() override { UNREACHABLE(); }
+
+    MaybeError MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) override {
+        UNREACHABLE();
+    }
+
+    void* GetMappedPointerImpl() override { UNREACHABLE(); }
+
+    void UnmapImpl() override { UNREACHABLE(); }
+};
+
 }  // anonymous namespace
 
 MaybeError ValidateBufferDescriptor(DeviceBase*, const BufferDescriptor* descriptor) {
@@ -121,6 +142,34 @@ MaybeError ValidateBufferDescriptor(DeviceBase*, const BufferDescriptor* descrip
     return {};
 }
 
+MaybeError ValidateSuballocatedBufferRange(DeviceBase* device,
+                                           const BufferBase* backingBuffer,
+                                           uint64_t offset,
+                                           uint64_t size) {
+    DAWN_TRY(device->ValidateObject(backingBuffer));
+
+    // Bindings at the start of the suballocated buffer must be valid in the backing buffer.
+    const CombinedLimits& limits = device->GetLimits();
+    const uint64_t alignment = std::max(limits.v1.minUniformBufferOffsetAlignment,
+                                        limits.v1.minStorageBufferOffsetAlignment);
+    DAWN_INVALID_IF(offset % alignment != 0,
+                    "Suballocation offset (%u) is not a multiple of the buffer offset alignment "
+                    "(%u).",
+                    offset, alignment);
+
+    uint64_t backingSize = backingBuffer->GetSize();
+    DAWN_INVALID_IF(offset > backingSize || size > backingSize - offset,
+                    "Suballocation range (offset: %u, size: %u) doesn't fit in the size (%u) of "
+                    "%s.",
+                    offset, size, backingSize, backingBuffer);
+
+    DAWN_INVALID_IF(!(backingBuffer->GetUsageExternalOnly() & ~kMappableBufferUsages),
+                    "%s only has mappable usages (%s) that suballocated buffers can't have.",
+                    backingBuffer, backingBuffer->GetUsageExternalOnly());
+
+    return {};
+}
+
 // Buffer
 
 BufferBase::BufferBase(DeviceBase* device, const BufferDescriptor* descriptor)
@@ -174,6 +223,18 @@ BufferBase::BufferBase(DeviceBase* device, BufferState state)
     TrackInDevice();
 }
 
+BufferBase::BufferBase(BufferBase* backingBuffer, uint64_t offset, uint64_t size)
+    : ApiObjectBase(backingBuffer->GetDevice(), nullptr),
+      mSize(size),
+      mUsage(backingBuffer->GetUsage() & ~kMappableBufferUsages),
+      mState(BufferState::Unmapped),
+      mBackingBuffer(backingBuffer),
+      mBackingOffset(offset) {
+    // Suballocated buffers have no backend resources to destroy so they aren't tracked in the
+    // device, which saves the cost of a full buffer for each of them.
+    ASSERT(!backingBuffer->IsSuballocated());
+}
+
 BufferBase::~BufferBase() {
     ASSERT(mState == BufferState::Unmapped || mState == BufferState::Destroyed);
 }
@@ -196,6 +257,17 @@ BufferBase* BufferBase::MakeError(DeviceBase* device, const BufferDescriptor* de
     return new ErrorBuffer(device, descriptor);
 }
 
+// static
+Ref<BufferBase> BufferBase::MakeSuballocation(BufferBase* backingBuffer,
+                                              uint64_t offset,
+                                              uint64_t size) {
+    // Suballocations of suballocated buffers are flattened so that there is a single level of
+    // indirection to resolve when encoding commands.
+    offset += backingBuffer->GetBackingOffset();
+    backingBuffer = backingBuffer->GetBackingBuffer();
+    return AcquireRef(new SuballocatedBuffer(backingBuffer, offset, size));
+}
+
 ObjectType BufferBase::GetType() const {
     return ObjectType::Buffer;
 }
@@ -290,6 +362,11 @@ MaybeError BufferBase::MapAtCreationInternal() {
 MaybeError BufferBase::ValidateCanUseOnQueueNow() const {
     ASSERT(!IsError());
 
+    if (mBackingBuffer != nullptr) {
+        DAWN_TRY_CONTEXT(mBackingBuffer->ValidateCanUseOnQueueNow(),
+                         "validating the backing buffer of %s.", this);
+    }
+
     switch (mState) {
         case BufferState::Destroyed:
             return DAWN_FORMAT_VALIDATION_ERROR("%s used in submit while destroyed.", this);
@@ -383,6 +460,9 @@ void* BufferBase::GetMappedRange(size_t offset, size_t size, bool writable) {
 }
 
 void BufferBase::APIDestroy() {
+    if (GetDevice()->ConsumedError(ValidateDestroy(), "calling %s.Destroy().", this)) {
+        return;
+    }
     Destroy();
 }
 
@@ -547,6 +627,13 @@ MaybeError BufferBase::ValidateUnmap() const {
     UNREACHABLE();
 }
 
+MaybeError BufferBase::ValidateDestroy() const {
+    DAWN_INVALID_IF(mBackingBuffer != nullptr,
+                    "%s is suballocated from %s and can't be destroyed separately.", this,
+                    mBackingBuffer.Get());
+    return {};
+}
+
 void BufferBase::OnMapRequestCompleted(MapRequestID mapID, WGPUBufferMapAsyncStatus status) {
     CallMapCallback(mapID, status);
 }
@@ -559,10 +646,26 @@ bool BufferBase::IsDataInitialized() const {
     return mIsDataInitialized;
 }
 
+bool BufferBase::IsDestroyed() const {
+    return mState == BufferState::Destroyed;
+}
+
 void BufferBase::SetIsDataInitialized() {
     mIsDataInitialized = true;
 }
 
+bool BufferBase::IsSuballocated() const {
+    return mBackingBuffer != nullptr;
+}
+
+BufferBase* BufferBase::GetBackingBuffer() {
+    return mBackingBuffer != nullptr ? mBackingBuffer.Get() : this;
+}
+
+uint64_t BufferBase::GetBackingOffset() const {
+    return mBackingOffset;
+}
+
 bool BufferBase::IsFullBufferRange(uint64_t offset, uint64_t size) const {
     return offset == 0 && size == GetSize();
 }
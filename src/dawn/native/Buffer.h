@@ -31,6 +31,10 @@ struct CopyTextureToBufferCmd;
 enum class MapType : uint32_t;
 
 MaybeError ValidateBufferDescriptor(DeviceBase* device, const BufferDescriptor* descriptor);
+MaybeError ValidateSuballocatedBufferRange(DeviceBase* device,
+                                           const BufferBase* backingBuffer,
+                                           uint64_t offset,
+                                           uint64_t size);
 
 static constexpr wgpu::BufferUsage kReadOnlyBufferUsages =
     wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::Index |
@@ -49,6 +53,11 @@ class BufferBase : public ApiObjectBase {
         Destroyed,
     };
     static BufferBase* MakeError(DeviceBase* device, const BufferDescriptor* descriptor);
+    // Creates a view of [offset, offset + size) of |backingBuffer|, which must have been
+    // validated with ValidateSuballocatedBufferRange.
+    static Ref<BufferBase> MakeSuballocation(BufferBase* backingBuffer,
+                                             uint64_t offset,
+                                             uint64_t size);
 
     ObjectType GetType() const override;
 
@@ -70,6 +79,15 @@ class BufferBase : public ApiObjectBase {
     bool NeedsInitialization() const;
     bool IsDataInitialized() const;
     void SetIsDataInitialized();
+    bool IsDestroyed() const;
+
+    // Suballocated buffers are views of a range of a backing buffer that don't own any backend
+    // resource. Commands and bind groups reference the range of the backing buffer instead of the
+    // view, so usages are tracked at the granularity of the backing buffer. For other buffers
+    // these return the buffer itself and 0.
+    bool IsSuballocated() const;
+    BufferBase* GetBackingBuffer();
+    uint64_t GetBackingOffset() const;
 
     void* GetMappedRange(size_t offset, size_t size, bool writable = true);
     void Unmap();
@@ -92,6 +110,8 @@ class BufferBase : public ApiObjectBase {
     BufferBase(DeviceBase* device, const BufferDescriptor* descriptor, ObjectBase::ErrorTag tag);
     // Constructor used only for mocking and testing.
     BufferBase(DeviceBase* device, BufferState state);
+    // Constructor of suballocated buffers.
+    BufferBase(BufferBase* backingBuffer, uint64_t offset, uint64_t size);
 
     void DestroyImpl() override;
 
@@ -116,6 +136,7 @@ class BufferBase : public ApiObjectBase {
                                 size_t size,
                                 WGPUBufferMapAsyncStatus* status) const;
     MaybeError ValidateUnmap() const;
+    MaybeError ValidateDestroy() const;
     bool CanGetMappedRange(bool writable, size_t offset, size_t size) const;
     void UnmapInternal(WGPUBufferMapAsyncStatus callbackStatus);
 
@@ -126,6 +147,9 @@ class BufferBase : public ApiObjectBase {
 
     std::unique_ptr<StagingBufferBase> mStagingBuffer;
 
+    Ref<BufferBase> mBackingBuffer;
+    uint64_t mBackingOffset = 0;
+
     WGPUBufferMapCallback mMapCallback = nullptr;
     void* mMapUserdata = 0;
     MapRequestID mLastMapID = MapRequestID(0);
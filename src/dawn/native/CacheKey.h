@@ -26,7 +26,7 @@ class CacheKey : public stream::ByteVectorSink {
   public:
     using stream::ByteVectorSink::ByteVectorSink;
 
-    enum class Type { ComputePipeline, RenderPipeline, Shader };
+    enum class Type { ComputePipeline, RenderPipeline, Shader, PipelineManifest, ShaderSource };
 
     template <typename T>
     class UnsafeUnkeyedValue {
@@ -15,7 +15,9 @@
 #ifndef SRC_DAWN_NATIVE_CACHEREQUEST_H_
 #define SRC_DAWN_NATIVE_CACHEREQUEST_H_
 
+#include <cstddef>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "dawn/common/Assert.h"
@@ -26,6 +28,7 @@
 #include "dawn/native/CacheResult.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/Error.h"
+#include "dawn/native/TransformedShaderCache.h"
 #include "dawn/native/VisitableMembers.h"
 
 namespace dawn::native {
@@ -80,6 +83,10 @@ void LogCacheHitError(std::unique_ptr<ErrorData> error);
 // ResultOrError<CacheResult<T>>. CacheHitFn must return the same unwrapped type as CacheMissFn.
 // i.e. it doesn't need to be wrapped in ResultOrError.
 //
+// LoadOrRun can also be given a TransformedShaderCache as second argument. It is then looked up
+// before the device's BlobCache, and the result of CacheMissFn, or the blob loaded from the
+// BlobCache, is stored in it. In that case the result type must have a ToBlob method.
+//
 // CacheMissFn may not have any additional data bound to it. It may not be a lambda or std::function
 // which captures additional information, so it can only operate on the request data. This is
 // enforced with a compile-time static_assert, and ensures that the result created from the
@@ -109,6 +116,30 @@ class CacheRequestImpl {
                           Request&& r,
                           CacheHitFn cacheHitFn,
                           CacheMissFn cacheMissFn) {
+        return LoadOrRunImpl(device, nullptr, std::move(r), cacheHitFn, cacheMissFn);
+    }
+
+    template <typename CacheHitFn, typename CacheMissFn>
+    friend auto LoadOrRun(DeviceBase* device,
+                          TransformedShaderCache* transformedShaderCache,
+                          Request&& r,
+                          CacheHitFn cacheHitFn,
+                          CacheMissFn cacheMissFn) {
+        ASSERT(transformedShaderCache != nullptr);
+        return LoadOrRunImpl(device, transformedShaderCache, std::move(r), cacheHitFn,
+                             cacheMissFn);
+    }
+
+  private:
+    // MemoryCache is either TransformedShaderCache* or std::nullptr_t so that the result type
+    // only needs a ToBlob method when a TransformedShaderCache is used.
+    template <typename MemoryCache, typename CacheHitFn, typename CacheMissFn>
+    static auto LoadOrRunImpl(DeviceBase* device,
+                              MemoryCache memoryCache,
+                              Request&& r,
+                              CacheHitFn cacheHitFn,
+                              CacheMissFn cacheMissFn) {
+        constexpr bool kUsesMemoryCache = !std::is_same_v<MemoryCache, std::nullptr_t>;
         // Get return types and check that CacheMissReturnType can be cast to a raw function
         // pointer. This means it's not a std::function or lambda that captures additional data.
         using CacheHitReturnType = decltype(cacheHitFn(std::declval<Blob>()));
@@ -129,10 +160,20 @@ class CacheRequestImpl {
         using ReturnType = ResultOrError<CacheResultType>;
 
         CacheKey key = r.CreateCacheKey(device);
-        BlobCache* cache = device->GetBlobCache();
         Blob blob;
-        if (cache != nullptr) {
-            blob = cache->Load(key);
+        if constexpr (kUsesMemoryCache) {
+            blob = memoryCache->Load(key);
+        }
+        if (blob.Empty()) {
+            BlobCache* cache = device->GetBlobCache();
+            if (cache != nullptr) {
+                blob = cache->Load(key);
+            }
+            if constexpr (kUsesMemoryCache) {
+                if (!blob.Empty()) {
+                    memoryCache->Store(key, blob);
+                }
+            }
         }
 
         if (!blob.Empty()) {
@@ -155,7 +196,11 @@ class CacheRequestImpl {
         // Cache miss, or the CacheHitFn failed.
         auto result = cacheMissFn(std::move(r));
         if (DAWN_LIKELY(result.IsSuccess())) {
-            return ReturnType(CacheResultType::CacheMiss(std::move(key), result.AcquireSuccess()));
+            UnwrappedReturnType value = result.AcquireSuccess();
+            if constexpr (kUsesMemoryCache) {
+                memoryCache->Store(key, value.ToBlob());
+            }
+            return ReturnType(CacheResultType::CacheMiss(std::move(key), std::move(value)));
         }
         return ReturnType(result.AcquireError());
     }
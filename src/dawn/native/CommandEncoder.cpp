@@ -784,6 +784,7 @@ Ref<ComputePassEncoder> CommandEncoder::BeginComputePass(const ComputePassDescri
         [&](CommandAllocator* allocator) -> MaybeError {
             DAWN_TRY(ValidateComputePassDescriptor(device, descriptor));
 
+            DAWN_TRY(mEncodingContext.WillBeginComputePass());
             BeginComputePassCmd* cmd =
                 allocator->Allocate<BeginComputePassCmd>(Command::BeginComputePass);
 
@@ -855,7 +856,7 @@ Ref<RenderPassEncoder> CommandEncoder::BeginRenderPass(const RenderPassDescripto
 
             ASSERT(width > 0 && height > 0 && sampleCount > 0);
 
-            mEncodingContext.WillBeginRenderPass();
+            DAWN_TRY(mEncodingContext.WillBeginRenderPass());
             BeginRenderPassCmd* cmd =
                 allocator->Allocate<BeginRenderPassCmd>(Command::BeginRenderPass);
 
@@ -1027,6 +1028,10 @@ void CommandEncoder::APICopyBufferToBuffer(BufferBase* source,
 
                 DAWN_INVALID_IF(source == destination,
                                 "Source and destination are the same buffer (%s).", source);
+                DAWN_INVALID_IF(source->GetBackingBuffer() == destination->GetBackingBuffer(),
+                                "Source (%s) and destination (%s) are suballocated from the same "
+                                "buffer (%s).",
+                                source, destination, source->GetBackingBuffer());
 
                 DAWN_TRY_CONTEXT(ValidateCopySizeFitsInBuffer(source, sourceOffset, size),
                                  "validating source %s copy size.", source);
@@ -1045,10 +1050,10 @@ void CommandEncoder::APICopyBufferToBuffer(BufferBase* source,
 
             CopyBufferToBufferCmd* copy =
                 allocator->Allocate<CopyBufferToBufferCmd>(Command::CopyBufferToBuffer);
-            copy->source = source;
-            copy->sourceOffset = sourceOffset;
-            copy->destination = destination;
-            copy->destinationOffset = destinationOffset;
+            copy->source = source->GetBackingBuffer();
+            copy->sourceOffset = sourceOffset + source->GetBackingOffset();
+            copy->destination = destination->GetBackingBuffer();
+            copy->destinationOffset = destinationOffset + destination->GetBackingOffset();
             copy->size = size;
 
             return {};
@@ -1099,8 +1104,8 @@ void CommandEncoder::APICopyBufferToTexture(const ImageCopyBuffer* source,
 
             CopyBufferToTextureCmd* copy =
                 allocator->Allocate<CopyBufferToTextureCmd>(Command::CopyBufferToTexture);
-            copy->source.buffer = source->buffer;
-            copy->source.offset = srcLayout.offset;
+            copy->source.buffer = source->buffer->GetBackingBuffer();
+            copy->source.offset = srcLayout.offset + source->buffer->GetBackingOffset();
             copy->source.bytesPerRow = srcLayout.bytesPerRow;
             copy->source.rowsPerImage = srcLayout.rowsPerImage;
             copy->destination.texture = destination->texture;
@@ -1162,8 +1167,8 @@ void CommandEncoder::APICopyTextureToBuffer(const ImageCopyTexture* source,
             copy->source.origin = source->origin;
             copy->source.mipLevel = source->mipLevel;
             copy->source.aspect = ConvertAspect(source->texture->GetFormat(), source->aspect);
-            copy->destination.buffer = destination->buffer;
-            copy->destination.offset = dstLayout.offset;
+            copy->destination.buffer = destination->buffer->GetBackingBuffer();
+            copy->destination.offset = dstLayout.offset + destination->buffer->GetBackingOffset();
             copy->destination.bytesPerRow = dstLayout.bytesPerRow;
             copy->destination.rowsPerImage = dstLayout.rowsPerImage;
             copy->copySize = *copySize;
@@ -1289,8 +1294,8 @@ void CommandEncoder::APIClearBuffer(BufferBase* buffer, uint64_t offset, uint64_
             }
 
             ClearBufferCmd* cmd = allocator->Allocate<ClearBufferCmd>(Command::ClearBuffer);
-            cmd->buffer = buffer;
-            cmd->offset = offset;
+            cmd->buffer = buffer->GetBackingBuffer();
+            cmd->offset = offset + buffer->GetBackingOffset();
             cmd->size = size;
 
             return {};
@@ -1382,14 +1387,15 @@ void CommandEncoder::APIResolveQuerySet(QuerySetBase* querySet,
             cmd->querySet = querySet;
             cmd->firstQuery = firstQuery;
             cmd->queryCount = queryCount;
-            cmd->destination = destination;
-            cmd->destinationOffset = destinationOffset;
+            cmd->destination = destination->GetBackingBuffer();
+            cmd->destinationOffset = destinationOffset + destination->GetBackingOffset();
 
             // Encode internal compute pipeline for timestamp query
             if (querySet->GetQueryType() == wgpu::QueryType::Timestamp &&
                 !GetDevice()->IsToggleEnabled(Toggle::DisableTimestampQueryConversion)) {
                 DAWN_TRY(EncodeTimestampsToNanosecondsConversion(
-                    this, querySet, firstQuery, queryCount, destination, destinationOffset));
+                    this, querySet, firstQuery, queryCount, cmd->destination.Get(),
+                    cmd->destinationOffset));
             }
 
             return {};
@@ -1410,8 +1416,8 @@ void CommandEncoder::APIWriteBuffer(BufferBase* buffer,
             }
 
             WriteBufferCmd* cmd = allocator->Allocate<WriteBufferCmd>(Command::WriteBuffer);
-            cmd->buffer = buffer;
-            cmd->offset = bufferOffset;
+            cmd->buffer = buffer->GetBackingBuffer();
+            cmd->offset = bufferOffset + buffer->GetBackingOffset();
             cmd->size = size;
 
             uint8_t* inlinedData = allocator->AllocateData<uint8_t>(size);
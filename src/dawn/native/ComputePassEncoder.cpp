@@ -339,6 +339,10 @@ void ComputePassEncoder::APIDispatchWorkgroupsIndirect(BufferBase* indirectBuffe
                     indirectOffset, kDispatchIndirectSize, indirectBuffer->GetSize());
             }
 
+            // Suballocated buffers are replaced with the range of their backing buffer.
+            indirectOffset += indirectBuffer->GetBackingOffset();
+            indirectBuffer = indirectBuffer->GetBackingBuffer();
+
             SyncScopeUsageTracker scope;
             scope.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
             mUsageTracker.AddReferencedBuffer(indirectBuffer);
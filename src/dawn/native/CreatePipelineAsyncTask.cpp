@@ -138,24 +138,28 @@ void CreateComputePipelineAsyncTask::Run() {
                                                 mUserdata);
 }
 
+void CreateComputePipelineAsyncTask::Cancel() {
+    DeviceBase* device = mComputePipeline->GetDevice();
+    device->AddComputePipelineAsyncCallbackTask(nullptr, "Pipeline creation was cancelled.",
+                                                mCallback, mUserdata);
+}
+
 void CreateComputePipelineAsyncTask::RunAsync(
     std::unique_ptr<CreateComputePipelineAsyncTask> task) {
     DeviceBase* device = task->mComputePipeline->GetDevice();
+    int32_t priority = task->mComputePipeline->GetAsyncCreationPriority();
+    uint64_t cancellationGroup = task->mComputePipeline->GetAsyncCreationCancellationGroup();
 
     const char* eventLabel = utils::GetLabelForTrace(task->mComputePipeline->GetLabel().c_str());
-
-    // Using "taskPtr = std::move(task)" causes compilation error while it should be supported
-    // since C++14:
-    // https://docs.microsoft.com/en-us/cpp/cpp/lambda-expressions-in-cpp?view=msvc-160
-    auto asyncTask = [taskPtr = task.release()] {
-        std::unique_ptr<CreateComputePipelineAsyncTask> innnerTaskPtr(taskPtr);
-        innnerTaskPtr->Run();
-    };
-
     TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
                             "CreateComputePipelineAsyncTask::RunAsync", task.get(), "label",
                             eventLabel);
-    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+
+    // Either the task runs or it is cancelled, so both closures share its ownership.
+    std::shared_ptr<CreateComputePipelineAsyncTask> sharedTask = std::move(task);
+    device->GetAsyncTaskManager()->PostTask(
+        [sharedTask] { sharedTask->Run(); }, priority, cancellationGroup,
+        [sharedTask] { sharedTask->Cancel(); });
 }
 
 CreateRenderPipelineAsyncTask::CreateRenderPipelineAsyncTask(
@@ -189,22 +193,26 @@ void CreateRenderPipelineAsyncTask::Run() {
     device->AddRenderPipelineAsyncCallbackTask(mRenderPipeline, errorMessage, mCallback, mUserdata);
 }
 
+void CreateRenderPipelineAsyncTask::Cancel() {
+    DeviceBase* device = mRenderPipeline->GetDevice();
+    device->AddRenderPipelineAsyncCallbackTask(nullptr, "Pipeline creation was cancelled.",
+                                               mCallback, mUserdata);
+}
+
 void CreateRenderPipelineAsyncTask::RunAsync(std::unique_ptr<CreateRenderPipelineAsyncTask> task) {
     DeviceBase* device = task->mRenderPipeline->GetDevice();
+    int32_t priority = task->mRenderPipeline->GetAsyncCreationPriority();
+    uint64_t cancellationGroup = task->mRenderPipeline->GetAsyncCreationCancellationGroup();
 
     const char* eventLabel = utils::GetLabelForTrace(task->mRenderPipeline->GetLabel().c_str());
-
-    // Using "taskPtr = std::move(task)" causes compilation error while it should be supported
-    // since C++14:
-    // https://docs.microsoft.com/en-us/cpp/cpp/lambda-expressions-in-cpp?view=msvc-160
-    auto asyncTask = [taskPtr = task.release()] {
-        std::unique_ptr<CreateRenderPipelineAsyncTask> innerTaskPtr(taskPtr);
-        innerTaskPtr->Run();
-    };
-
     TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
                             "CreateRenderPipelineAsyncTask::RunAsync", task.get(), "label",
                             eventLabel);
-    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+
+    // Either the task runs or it is cancelled, so both closures share its ownership.
+    std::shared_ptr<CreateRenderPipelineAsyncTask> sharedTask = std::move(task);
+    device->GetAsyncTaskManager()->PostTask(
+        [sharedTask] { sharedTask->Run(); }, priority, cancellationGroup,
+        [sharedTask] { sharedTask->Cancel(); });
 }
 }  // namespace dawn::native
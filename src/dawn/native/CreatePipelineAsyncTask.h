@@ -83,7 +83,11 @@ class CreateComputePipelineAsyncTask {
     ~CreateComputePipelineAsyncTask();
 
     void Run();
+    // Calls the callback with an error instead of initializing the pipeline.
+    void Cancel();
 
+    // Initializes the pipeline on the worker task pool with the priority and cancellation group
+    // of the pipeline, see DawnAsyncPipelineCreationOptions.
     static void RunAsync(std::unique_ptr<CreateComputePipelineAsyncTask> task);
 
   private:
@@ -102,7 +106,11 @@ class CreateRenderPipelineAsyncTask {
     ~CreateRenderPipelineAsyncTask();
 
     void Run();
+    // Calls the callback with an error instead of initializing the pipeline.
+    void Cancel();
 
+    // Initializes the pipeline on the worker task pool with the priority and cancellation group
+    // of the pipeline, see DawnAsyncPipelineCreationOptions.
     static void RunAsync(std::unique_ptr<CreateRenderPipelineAsyncTask> task);
 
   private:
@@ -252,6 +252,27 @@ size_t GetLazyClearCountForTesting(WGPUDevice device) {
     return FromAPI(device)->GetLazyClearCountForTesting();
 }
 
+size_t CancelAsyncPipelineCreations(WGPUDevice device, uint64_t cancellationGroup) {
+    return FromAPI(device)->CancelAsyncPipelineCreations(cancellationGroup);
+}
+
+ObjectPoolStats GetObjectPoolStats(WGPUDevice device) {
+    return FromAPI(device)->GetObjectPoolStats();
+}
+
+size_t PrewarmPipelinesFromManifest(WGPUDevice device) {
+    return FromAPI(device)->PrewarmPipelinesFromManifest();
+}
+
+size_t GetPendingPipelinePrewarmCount(WGPUDevice device) {
+    return FromAPI(device)->GetPendingPipelinePrewarmCount();
+}
+
+WGPUBuffer CreateSuballocatedBuffer(WGPUBuffer backingBuffer, uint64_t offset, uint64_t size) {
+    BufferBase* backing = FromAPI(backingBuffer);
+    return ToAPI(backing->GetDevice()->APICreateSuballocatedBuffer(backing, offset, size));
+}
+
 size_t GetDeprecationWarningCountForTesting(WGPUDevice device) {
     return FromAPI(device)->GetDeprecationWarningCountForTesting();
 }
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <unordered_set>
 
@@ -42,6 +43,7 @@
 #include "dawn/native/InternalPipelineStore.h"
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/PipelineCache.h"
+#include "dawn/native/PipelineManifest.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/Queue.h"
 #include "dawn/native/RenderBundleEncoder.h"
@@ -154,6 +156,13 @@ ResultOrError<Ref<PipelineLayoutBase>> ValidateLayoutAndGetRenderPipelineDescrip
     Ref<PipelineLayoutBase> layoutRef;
     *outDescriptor = descriptor;
 
+    // Create the placeholder fragment shader used by GetRenderStagesAndSetPlaceholderShader
+    // the first time it is needed.
+    if (descriptor.fragment == nullptr &&
+        device->IsToggleEnabled(Toggle::UsePlaceholderFragmentInVertexOnlyPipeline)) {
+        DAWN_TRY(device->GetOrCreatePlaceholderFragmentShader());
+    }
+
     if (descriptor.layout == nullptr) {
         // Ref will keep the pipeline layout alive until the end of the function where
         // the pipeline will take another reference.
@@ -172,6 +181,7 @@ ResultOrError<Ref<PipelineLayoutBase>> ValidateLayoutAndGetRenderPipelineDescrip
 
 DeviceBase::DeviceBase(AdapterBase* adapter, const DeviceDescriptor* descriptor)
     : mAdapter(adapter), mNextPipelineCompatibilityToken(1) {
+    TRACE_EVENT0(GetPlatform(), General, "DeviceBase::DeviceBase");
     mAdapter->GetInstance()->IncrementDeviceCountForTesting();
     ASSERT(descriptor != nullptr);
 
@@ -187,6 +197,10 @@ DeviceBase::DeviceBase(AdapterBase* adapter, const DeviceDescriptor* descriptor)
     SetDefaultToggles();
     ApplyFeatures(descriptor);
 
+    if (IsToggleEnabled(Toggle::SingleThreadedDevice)) {
+        SetRefCountSingleThreaded();
+    }
+
     DawnCacheDeviceDescriptor defaultCacheDesc = {};
     const DawnCacheDeviceDescriptor* cacheDesc = nullptr;
     FindInChain(descriptor->nextInChain, &cacheDesc);
@@ -200,7 +214,7 @@ DeviceBase::DeviceBase(AdapterBase* adapter, const DeviceDescriptor* descriptor)
         GetDefaultLimits(&mLimits.v1);
     }
 
-    mFormatTable = BuildFormatTable(this);
+    mSupportedFormats = ComputeSupportedFormats(this);
 
     if (descriptor->label != nullptr && strlen(descriptor->label) != 0) {
         mLabel = descriptor->label;
@@ -228,6 +242,7 @@ DeviceBase::~DeviceBase() {
 }
 
 MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
+    TRACE_EVENT0(GetPlatform(), General, "DeviceBase::Initialize");
     SetWGSLExtensionAllowList();
 
     mQueue = std::move(defaultQueue);
@@ -256,35 +271,31 @@ MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
 
     mCaches = std::make_unique<DeviceBase::Caches>();
     mErrorScopeStack = std::make_unique<ErrorScopeStack>();
-    mDynamicUploader = std::make_unique<DynamicUploader>(this);
     mCallbackTaskManager = std::make_unique<CallbackTaskManager>();
     mDeprecationWarnings = std::make_unique<DeprecationWarnings>();
-    mInternalPipelineStore = std::make_unique<InternalPipelineStore>(this);
 
     ASSERT(GetPlatform() != nullptr);
     mWorkerTaskPool = GetPlatform()->CreateWorkerTaskPool();
     mAsyncTaskManager = std::make_unique<AsyncTaskManager>(mWorkerTaskPool.get());
 
+    if (IsToggleEnabled(Toggle::RecordPipelineManifest)) {
+        mPipelineManifest = std::make_unique<PipelineManifest>();
+        // Keep the pipelines recorded by previous runs. A corrupted manifest is replaced by the
+        // pipelines created from now on.
+        MaybeError maybeError = mPipelineManifest->Load(this);
+        if (maybeError.IsError()) {
+            maybeError.AcquireError();
+            mPipelineManifest = std::make_unique<PipelineManifest>();
+        }
+    }
+
     // Starting from now the backend can start doing reentrant calls so the device is marked as
     // alive.
     mState = State::Alive;
 
-    DAWN_TRY_ASSIGN(mEmptyBindGroupLayout, CreateEmptyBindGroupLayout());
-
-    // If placeholder fragment shader module is needed, initialize it
-    if (IsToggleEnabled(Toggle::UsePlaceholderFragmentInVertexOnlyPipeline)) {
-        // The empty fragment shader, used as a work around for vertex-only render pipeline
-        constexpr char kEmptyFragmentShader[] = R"(
-                @fragment fn fs_empty_main() {}
-            )";
-        ShaderModuleDescriptor descriptor;
-        ShaderModuleWGSLDescriptor wgslDesc;
-        wgslDesc.source = kEmptyFragmentShader;
-        descriptor.nextInChain = &wgslDesc;
-
-        DAWN_TRY_ASSIGN(mInternalPipelineStore->placeholderFragmentShader,
-                        CreateShaderModule(&descriptor));
-    }
+    // The DynamicUploader, the InternalPipelineStore, the empty bind group layout and the
+    // placeholder fragment shader are created lazily on first use since many devices never
+    // need them.
 
     return {};
 }
@@ -367,9 +378,10 @@ void DeviceBase::DestroyObjects() {
     // the actual destroy function.
     LinkedList<ApiObjectBase> objects;
     for (ObjectType type : kObjectTypeDependencyOrder) {
-        ApiObjectList& objList = mObjectLists[type];
-        const std::lock_guard<std::mutex> lock(objList.mutex);
-        objList.objects.MoveInto(&objects);
+        for (ApiObjectList::Segment& segment : mObjectLists[type].segments) {
+            const std::lock_guard<std::mutex> lock(segment.mutex);
+            segment.objects.MoveInto(&objects);
+        }
     }
     while (!objects.empty()) {
         // The destroy call should also remove the object from the list.
@@ -408,6 +420,10 @@ void DeviceBase::Destroy() {
         for (std::unique_ptr<CallbackTask>& callbackTask : callbackTasks) {
             callbackTask->HandleShutDown();
         }
+
+        if (mPipelineManifest != nullptr) {
+            mPipelineManifest->Flush(this);
+        }
     }
 
     // Disconnect the device, depending on which state we are currently in.
@@ -465,6 +481,7 @@ void DeviceBase::Destroy() {
     mEmptyBindGroupLayout = nullptr;
     mInternalPipelineStore = nullptr;
     mExternalTexturePlaceholderView = nullptr;
+    mPrewarmedPipelines.clear();
 
     AssumeCommandsComplete();
 
@@ -685,14 +702,25 @@ bool DeviceBase::IsLost() const {
     return mState != State::Alive;
 }
 
-void DeviceBase::TrackObject(ApiObjectBase* object) {
-    ApiObjectList& objectList = mObjectLists[object->GetType()];
-    std::lock_guard<std::mutex> lock(objectList.mutex);
-    object->InsertBefore(objectList.objects.head());
+uint32_t DeviceBase::TrackObject(ApiObjectBase* object) {
+    // Threads are assigned segments in a round robin so that up to kObjectListSegmentCount
+    // threads never share one.
+    static std::atomic<uint32_t> sNextThreadSegment{0};
+    thread_local uint32_t sThreadSegment =
+        sNextThreadSegment.fetch_add(1, std::memory_order_relaxed) % kObjectListSegmentCount;
+
+    ApiObjectList::Segment& segment = mObjectLists[object->GetType()].segments[sThreadSegment];
+    std::unique_lock<std::mutex> lock(segment.mutex, std::defer_lock);
+    if (!IsToggleEnabled(Toggle::SingleThreadedDevice)) {
+        lock.lock();
+    }
+    object->InsertBefore(segment.objects.head());
+    return sThreadSegment;
 }
 
-std::mutex* DeviceBase::GetObjectListMutex(ObjectType type) {
-    return &mObjectLists[type].mutex;
+std::mutex* DeviceBase::GetObjectListMutex(ObjectType type, uint32_t segment) {
+    ASSERT(segment < kObjectListSegmentCount);
+    return &mObjectLists[type].segments[segment].mutex;
 }
 
 AdapterBase* DeviceBase::GetAdapter() const {
@@ -716,6 +744,11 @@ ExecutionSerial DeviceBase::GetFutureSerial() const {
 }
 
 InternalPipelineStore* DeviceBase::GetInternalPipelineStore() {
+    // The store isn't recreated after the device is disconnected since the objects it caches
+    // hold references to the device and would keep it alive.
+    if (mInternalPipelineStore == nullptr && mState < State::Disconnected) {
+        mInternalPipelineStore = std::make_unique<InternalPipelineStore>(this);
+    }
     return mInternalPipelineStore.get();
 }
 
@@ -770,25 +803,20 @@ MaybeError DeviceBase::CheckPassedSerials() {
 
 ResultOrError<const Format*> DeviceBase::GetInternalFormat(wgpu::TextureFormat format) const {
     FormatIndex index = ComputeFormatIndex(format);
-    DAWN_INVALID_IF(index >= mFormatTable.size(), "Unknown texture format %s.", format);
-
-    const Format* internalFormat = &mFormatTable[index];
-    DAWN_INVALID_IF(!internalFormat->isSupported, "Unsupported texture format %s.", format);
+    DAWN_INVALID_IF(index >= FormatIndex(kKnownFormatCount), "Unknown texture format %s.", format);
+    DAWN_INVALID_IF(!mSupportedFormats[index], "Unsupported texture format %s.", format);
 
-    return internalFormat;
+    return &GetKnownFormat(index);
 }
 
 const Format& DeviceBase::GetValidInternalFormat(wgpu::TextureFormat format) const {
-    FormatIndex index = ComputeFormatIndex(format);
-    ASSERT(index < mFormatTable.size());
-    ASSERT(mFormatTable[index].isSupported);
-    return mFormatTable[index];
+    return GetValidInternalFormat(ComputeFormatIndex(format));
 }
 
 const Format& DeviceBase::GetValidInternalFormat(FormatIndex index) const {
-    ASSERT(index < mFormatTable.size());
-    ASSERT(mFormatTable[index].isSupported);
-    return mFormatTable[index];
+    ASSERT(index < FormatIndex(kKnownFormatCount));
+    ASSERT(mSupportedFormats[index]);
+    return GetKnownFormat(index);
 }
 
 ResultOrError<Ref<BindGroupLayoutBase>> DeviceBase::GetOrCreateBindGroupLayout(
@@ -829,9 +857,30 @@ ResultOrError<Ref<BindGroupLayoutBase>> DeviceBase::CreateEmptyBindGroupLayout()
     return GetOrCreateBindGroupLayout(&desc);
 }
 
-BindGroupLayoutBase* DeviceBase::GetEmptyBindGroupLayout() {
-    ASSERT(mEmptyBindGroupLayout != nullptr);
-    return mEmptyBindGroupLayout.Get();
+ResultOrError<Ref<BindGroupLayoutBase>> DeviceBase::GetOrCreateEmptyBindGroupLayout() {
+    if (mEmptyBindGroupLayout == nullptr) {
+        DAWN_TRY_ASSIGN(mEmptyBindGroupLayout, CreateEmptyBindGroupLayout());
+    }
+    return mEmptyBindGroupLayout;
+}
+
+ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreatePlaceholderFragmentShader() {
+    InternalPipelineStore* store = GetInternalPipelineStore();
+    if (store->placeholderFragmentShader == nullptr) {
+        TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreatePlaceholderFragmentShader");
+
+        // The empty fragment shader, used as a work around for vertex-only render pipeline
+        constexpr char kEmptyFragmentShader[] = R"(
+                @fragment fn fs_empty_main() {}
+            )";
+        ShaderModuleDescriptor descriptor;
+        ShaderModuleWGSLDescriptor wgslDesc;
+        wgslDesc.source = kEmptyFragmentShader;
+        descriptor.nextInChain = &wgslDesc;
+
+        DAWN_TRY_ASSIGN(store->placeholderFragmentShader, CreateShaderModule(&descriptor));
+    }
+    return store->placeholderFragmentShader;
 }
 
 Ref<ComputePipelineBase> DeviceBase::GetCachedComputePipeline(
@@ -860,6 +909,9 @@ Ref<ComputePipelineBase> DeviceBase::AddOrGetCachedComputePipeline(
     auto [cachedPipeline, inserted] = mCaches->computePipelines.insert(computePipeline.Get());
     if (inserted) {
         computePipeline->SetIsCachedReference();
+        if (mPipelineManifest != nullptr) {
+            mPipelineManifest->RecordComputePipeline(this, computePipeline.Get());
+        }
         return computePipeline;
     } else {
         return *cachedPipeline;
@@ -871,6 +923,9 @@ Ref<RenderPipelineBase> DeviceBase::AddOrGetCachedRenderPipeline(
     auto [cachedPipeline, inserted] = mCaches->renderPipelines.insert(renderPipeline.Get());
     if (inserted) {
         renderPipeline->SetIsCachedReference();
+        if (mPipelineManifest != nullptr) {
+            mPipelineManifest->RecordRenderPipeline(this, renderPipeline.Get());
+        }
         return renderPipeline;
     } else {
         return *cachedPipeline;
@@ -1081,6 +1136,21 @@ BufferBase* DeviceBase::APICreateBuffer(const BufferDescriptor* descriptor) {
     }
     return result.Detach();
 }
+BufferBase* DeviceBase::APICreateSuballocatedBuffer(BufferBase* backingBuffer,
+                                                    uint64_t offset,
+                                                    uint64_t size) {
+    Ref<BufferBase> result = nullptr;
+    if (ConsumedError(CreateSuballocatedBuffer(backingBuffer, offset, size), &result,
+                      "calling CreateSuballocatedBuffer(%s, %u, %u).", backingBuffer, offset,
+                      size)) {
+        ASSERT(result == nullptr);
+        BufferDescriptor descriptor = {};
+        descriptor.size = size;
+        descriptor.usage = wgpu::BufferUsage::None;
+        return BufferBase::MakeError(this, &descriptor);
+    }
+    return result.Detach();
+}
 CommandEncoder* DeviceBase::APICreateCommandEncoder(const CommandEncoderDescriptor* descriptor) {
     Ref<CommandEncoder> result;
     if (ConsumedError(CreateCommandEncoder(descriptor), &result,
@@ -1273,7 +1343,9 @@ MaybeError DeviceBase::Tick() {
         // TODO(crbug.com/dawn/833): decouple TickImpl from updating the serial so that we can
         // tick the dynamic uploader before the backend resource allocators. This would allow
         // reclaiming resources one tick earlier.
-        mDynamicUploader->Deallocate(mCompletedSerial);
+        if (mDynamicUploader != nullptr) {
+            mDynamicUploader->Deallocate(mCompletedSerial);
+        }
         mQueue->Tick(mCompletedSerial);
     }
 
@@ -1281,6 +1353,12 @@ MaybeError DeviceBase::Tick() {
     // serials.
     FlushCallbackTaskQueue();
 
+    // Store the pipelines recorded since the last tick at once instead of rewriting the manifest
+    // for each of them.
+    if (mPipelineManifest != nullptr) {
+        mPipelineManifest->Flush(this);
+    }
+
     return {};
 }
 
@@ -1352,10 +1430,49 @@ void DeviceBase::IncrementLazyClearCountForTesting() {
     ++mLazyClearCountForTesting;
 }
 
+size_t DeviceBase::CancelAsyncPipelineCreations(uint64_t cancellationGroup) {
+    if (cancellationGroup == kNoCancellationGroup) {
+        return 0;
+    }
+    return mAsyncTaskManager->CancelTasks(cancellationGroup);
+}
+
 size_t DeviceBase::GetDeprecationWarningCountForTesting() {
     return mDeprecationWarnings->count;
 }
 
+const ObjectPoolStats& DeviceBase::GetObjectPoolStats() const {
+    return mObjectPoolStats;
+}
+
+size_t DeviceBase::PrewarmPipelinesFromManifest() {
+    PipelineManifest manifest;
+    MaybeError maybeError = manifest.Load(this);
+    if (maybeError.IsError()) {
+        maybeError.AcquireError();
+        return 0;
+    }
+
+    return manifest.Prewarm(this);
+}
+
+size_t DeviceBase::GetPendingPipelinePrewarmCount() const {
+    return mPendingPipelinePrewarmCount;
+}
+
+void DeviceBase::AddPendingPipelinePrewarm() {
+    mPendingPipelinePrewarmCount++;
+}
+
+void DeviceBase::AddPrewarmedPipeline(Ref<PipelineBase> pipeline) {
+    ASSERT(mPendingPipelinePrewarmCount > 0);
+    mPendingPipelinePrewarmCount--;
+    // The pipeline is null if its creation failed or if the device was destroyed.
+    if (pipeline != nullptr && mState == State::Alive) {
+        mPrewarmedPipelines.push_back(std::move(pipeline));
+    }
+}
+
 void DeviceBase::EmitDeprecationWarning(const char* warning) {
     mDeprecationWarnings->count++;
     if (mDeprecationWarnings->emitted.insert(warning).second) {
@@ -1423,7 +1540,25 @@ ResultOrError<Ref<BindGroupBase>> DeviceBase::CreateBindGroup(const BindGroupDes
         DAWN_TRY_CONTEXT(ValidateBindGroupDescriptor(this, descriptor, mode),
                          "validating %s against %s", descriptor, descriptor->layout);
     }
-    return CreateBindGroupImpl(descriptor);
+
+    // External textures are expanded in multiple bindings so bind groups using them aren't pooled.
+    if (!IsToggleEnabled(Toggle::PoolTextureViewsAndBindGroups) ||
+        descriptor->layout->GetExternalTextureBindingCount() > 0) {
+        return CreateBindGroupImpl(descriptor);
+    }
+
+    size_t hash = ComputeBindGroupPoolHash(descriptor);
+    BindGroupBase* pooledBindGroup = descriptor->layout->GetPooledBindGroup(descriptor, hash);
+    if (pooledBindGroup != nullptr) {
+        mObjectPoolStats.bindGroupHits++;
+        return Ref<BindGroupBase>(pooledBindGroup);
+    }
+    mObjectPoolStats.bindGroupMisses++;
+
+    Ref<BindGroupBase> result;
+    DAWN_TRY_ASSIGN(result, CreateBindGroupImpl(descriptor));
+    descriptor->layout->AddPooledBindGroup(result.Get(), hash);
+    return std::move(result);
 }
 
 ResultOrError<Ref<BindGroupLayoutBase>> DeviceBase::CreateBindGroupLayout(
@@ -1453,6 +1588,16 @@ ResultOrError<Ref<BufferBase>> DeviceBase::CreateBuffer(const BufferDescriptor*
     return std::move(buffer);
 }
 
+ResultOrError<Ref<BufferBase>> DeviceBase::CreateSuballocatedBuffer(BufferBase* backingBuffer,
+                                                                    uint64_t offset,
+                                                                    uint64_t size) {
+    DAWN_TRY(ValidateIsAlive());
+    if (IsValidationEnabled()) {
+        DAWN_TRY(ValidateSuballocatedBufferRange(this, backingBuffer, offset, size));
+    }
+    return BufferBase::MakeSuballocation(backingBuffer, offset, size);
+}
+
 ResultOrError<Ref<ComputePipelineBase>> DeviceBase::CreateComputePipeline(
     const ComputePipelineDescriptor* descriptor) {
     DAWN_TRY(ValidateIsAlive());
@@ -1514,6 +1659,13 @@ MaybeError DeviceBase::CreateComputePipelineAsync(const ComputePipelineDescripto
     Ref<ComputePipelineBase> uninitializedComputePipeline =
         CreateUninitializedComputePipelineImpl(&appliedDescriptor);
 
+    const DawnAsyncPipelineCreationOptions* asyncOptions = nullptr;
+    FindInChain(descriptor->nextInChain, &asyncOptions);
+    if (asyncOptions != nullptr) {
+        uninitializedComputePipeline->SetAsyncCreationOptions(asyncOptions->priority,
+                                                              asyncOptions->cancellationGroup);
+    }
+
     // Call the callback directly when we can get a cached compute pipeline object.
     Ref<ComputePipelineBase> cachedComputePipeline =
         GetCachedComputePipeline(uninitializedComputePipeline.Get());
@@ -1521,6 +1673,11 @@ MaybeError DeviceBase::CreateComputePipelineAsync(const ComputePipelineDescripto
         // TODO(crbug.com/dawn/1122): Call callbacks only on wgpuInstanceProcessEvents
         callback(WGPUCreatePipelineAsyncStatus_Success, ToAPI(cachedComputePipeline.Detach()), "",
                  userdata);
+    } else if (IsToggleEnabled(Toggle::SingleThreadedDevice)) {
+        // Skip the asynchronous implementation of the backend so that the objects are never
+        // referenced from the worker threads.
+        DeviceBase::InitializeComputePipelineAsyncImpl(std::move(uninitializedComputePipeline),
+                                                    callback, userdata);
     } else {
         // Otherwise we will create the pipeline object in InitializeComputePipelineAsyncImpl(),
         // where the pipeline object may be initialized asynchronously and the result will be
@@ -1658,6 +1815,13 @@ MaybeError DeviceBase::CreateRenderPipelineAsync(const RenderPipelineDescriptor*
     Ref<RenderPipelineBase> uninitializedRenderPipeline =
         CreateUninitializedRenderPipelineImpl(&appliedDescriptor);
 
+    const DawnAsyncPipelineCreationOptions* asyncOptions = nullptr;
+    FindInChain(descriptor->nextInChain, &asyncOptions);
+    if (asyncOptions != nullptr) {
+        uninitializedRenderPipeline->SetAsyncCreationOptions(asyncOptions->priority,
+                                                             asyncOptions->cancellationGroup);
+    }
+
     // Call the callback directly when we can get a cached render pipeline object.
     Ref<RenderPipelineBase> cachedRenderPipeline =
         GetCachedRenderPipeline(uninitializedRenderPipeline.Get());
@@ -1665,6 +1829,11 @@ MaybeError DeviceBase::CreateRenderPipelineAsync(const RenderPipelineDescriptor*
         // TODO(crbug.com/dawn/1122): Call callbacks only on wgpuInstanceProcessEvents
         callback(WGPUCreatePipelineAsyncStatus_Success, ToAPI(cachedRenderPipeline.Detach()), "",
                  userdata);
+    } else if (IsToggleEnabled(Toggle::SingleThreadedDevice)) {
+        // Skip the asynchronous implementation of the backend so that the objects are never
+        // referenced from the worker threads.
+        DeviceBase::InitializeRenderPipelineAsyncImpl(std::move(uninitializedRenderPipeline),
+                                                    callback, userdata);
     } else {
         // Otherwise we will create the pipeline object in InitializeRenderPipelineAsyncImpl(),
         // where the pipeline object may be initialized asynchronously and the result will be
@@ -1758,12 +1927,31 @@ ResultOrError<Ref<TextureViewBase>> DeviceBase::CreateTextureView(
         DAWN_TRY_CONTEXT(ValidateTextureViewDescriptor(this, texture, &desc),
                          "validating %s against %s.", &desc, texture);
     }
-    return CreateTextureViewImpl(texture, &desc);
+
+    if (!IsToggleEnabled(Toggle::PoolTextureViewsAndBindGroups) ||
+        texture->GetTextureState() == TextureBase::TextureState::Destroyed) {
+        return CreateTextureViewImpl(texture, &desc);
+    }
+
+    TextureViewBase* pooledView = texture->GetPooledView(&desc);
+    if (pooledView != nullptr) {
+        mObjectPoolStats.textureViewHits++;
+        return Ref<TextureViewBase>(pooledView);
+    }
+    mObjectPoolStats.textureViewMisses++;
+
+    Ref<TextureViewBase> result;
+    DAWN_TRY_ASSIGN(result, CreateTextureViewImpl(texture, &desc));
+    texture->AddPooledView(result.Get());
+    return std::move(result);
 }
 
 // Other implementation details
 
-DynamicUploader* DeviceBase::GetDynamicUploader() const {
+DynamicUploader* DeviceBase::GetDynamicUploader() {
+    if (mDynamicUploader == nullptr) {
+        mDynamicUploader = std::make_unique<DynamicUploader>(this);
+    }
     return mDynamicUploader.get();
 }
 
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_DEVICE_H_
 #define SRC_DAWN_NATIVE_DEVICE_H_
 
+#include <array>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -54,6 +55,7 @@ class CallbackTaskManager;
 class DynamicUploader;
 class ErrorScopeStack;
 class OwnedCompilationMessages;
+class PipelineManifest;
 struct CallbackTask;
 struct InternalPipelineStore;
 struct ShaderModuleParseResult;
@@ -173,12 +175,16 @@ class DeviceBase : public RefCountedWithExternalCount {
         PipelineCompatibilityToken pipelineCompatibilityToken = PipelineCompatibilityToken(0));
     void UncacheBindGroupLayout(BindGroupLayoutBase* obj);
 
-    BindGroupLayoutBase* GetEmptyBindGroupLayout();
+    ResultOrError<Ref<BindGroupLayoutBase>> GetOrCreateEmptyBindGroupLayout();
 
     void UncacheComputePipeline(ComputePipelineBase* obj);
 
     ResultOrError<Ref<TextureViewBase>> GetOrCreatePlaceholderTextureViewForExternalTexture();
 
+    // Returns the fragment shader used for vertex-only render pipelines when the
+    // UsePlaceholderFragmentInVertexOnlyPipeline toggle is enabled.
+    ResultOrError<Ref<ShaderModuleBase>> GetOrCreatePlaceholderFragmentShader();
+
     ResultOrError<Ref<PipelineLayoutBase>> GetOrCreatePipelineLayout(
         const PipelineLayoutDescriptor* descriptor);
     void UncachePipelineLayout(PipelineLayoutBase* obj);
@@ -211,6 +217,9 @@ class DeviceBase : public RefCountedWithExternalCount {
         const BindGroupLayoutDescriptor* descriptor,
         bool allowInternalBinding = false);
     ResultOrError<Ref<BufferBase>> CreateBuffer(const BufferDescriptor* descriptor);
+    ResultOrError<Ref<BufferBase>> CreateSuballocatedBuffer(BufferBase* backingBuffer,
+                                                            uint64_t offset,
+                                                            uint64_t size);
     ResultOrError<Ref<CommandEncoder>> CreateCommandEncoder(
         const CommandEncoderDescriptor* descriptor = nullptr);
     ResultOrError<Ref<ComputePipelineBase>> CreateComputePipeline(
@@ -243,6 +252,10 @@ class DeviceBase : public RefCountedWithExternalCount {
     BindGroupBase* APICreateBindGroup(const BindGroupDescriptor* descriptor);
     BindGroupLayoutBase* APICreateBindGroupLayout(const BindGroupLayoutDescriptor* descriptor);
     BufferBase* APICreateBuffer(const BufferDescriptor* descriptor);
+    // Native-only, exposed as dawn::native::CreateSuballocatedBuffer.
+    BufferBase* APICreateSuballocatedBuffer(BufferBase* backingBuffer,
+                                            uint64_t offset,
+                                            uint64_t size);
     CommandEncoder* APICreateCommandEncoder(const CommandEncoderDescriptor* descriptor);
     ComputePipelineBase* APICreateComputePipeline(const ComputePipelineDescriptor* descriptor);
     PipelineLayoutBase* APICreatePipelineLayout(const PipelineLayoutDescriptor* descriptor);
@@ -305,7 +318,7 @@ class DeviceBase : public RefCountedWithExternalCount {
                                                 TextureCopy* dst,
                                                 const Extent3D& copySizePixels) = 0;
 
-    DynamicUploader* GetDynamicUploader() const;
+    DynamicUploader* GetDynamicUploader();
 
     // The device state which is a combination of creation state and loss state.
     //
@@ -329,8 +342,10 @@ class DeviceBase : public RefCountedWithExternalCount {
     };
     State GetState() const;
     bool IsLost() const;
-    void TrackObject(ApiObjectBase* object);
-    std::mutex* GetObjectListMutex(ObjectType type);
+    // Adds |object| to the list of live objects of its type and returns the index of the
+    // segment of the list that contains it.
+    uint32_t TrackObject(ApiObjectBase* object);
+    std::mutex* GetObjectListMutex(ObjectType type, uint32_t segment);
 
     std::vector<const char*> GetTogglesUsed() const;
     WGSLExtensionSet GetWGSLExtensionAllowList() const;
@@ -340,6 +355,16 @@ class DeviceBase : public RefCountedWithExternalCount {
     size_t GetLazyClearCountForTesting();
     void IncrementLazyClearCountForTesting();
     size_t GetDeprecationWarningCountForTesting();
+    size_t CancelAsyncPipelineCreations(uint64_t cancellationGroup);
+    const ObjectPoolStats& GetObjectPoolStats() const;
+    // Starts the asynchronous creation of the pipelines of the manifest stored in the BlobCache
+    // and returns how many were started. The pipelines are kept alive by the device once created.
+    size_t PrewarmPipelinesFromManifest();
+    size_t GetPendingPipelinePrewarmCount() const;
+    // Called before the creation of each prewarmed pipeline is posted, since its callback may be
+    // called immediately, and when it is created (or failed to be) respectively.
+    void AddPendingPipelinePrewarm();
+    void AddPrewarmedPipeline(Ref<PipelineBase> pipeline);
     void EmitDeprecationWarning(const char* warning);
     void EmitLog(const char* message);
     void EmitLog(WGPULoggingType loggingType, const char* message);
@@ -547,19 +572,26 @@ class DeviceBase : public RefCountedWithExternalCount {
 
     State mState = State::BeingCreated;
 
-    // Encompasses the mutex and the actual list that contains all live objects "owned" by the
-    // device.
+    // Encompasses the mutexes and the actual lists that contain all live objects "owned" by the
+    // device. The list of each type is split in segments that have their own mutex, and each
+    // thread adds objects to a segment of its own so that creating and destroying objects on
+    // multiple threads doesn't contend on a single mutex.
+    static constexpr uint32_t kObjectListSegmentCount = 8;
     struct ApiObjectList {
-        std::mutex mutex;
-        LinkedList<ApiObjectBase> objects;
+        struct Segment {
+            std::mutex mutex;
+            LinkedList<ApiObjectBase> objects;
+        };
+        std::array<Segment, kObjectListSegmentCount> segments;
     };
     PerObjectType<ApiObjectList> mObjectLists;
 
-    FormatTable mFormatTable;
+    FormatSet mSupportedFormats;
 
     TogglesSet mEnabledToggles;
     TogglesSet mOverridenToggles;
     size_t mLazyClearCountForTesting = 0;
+    ObjectPoolStats mObjectPoolStats;
     std::atomic_uint64_t mNextPipelineCompatibilityToken;
 
     CombinedLimits mLimits;
@@ -568,6 +600,11 @@ class DeviceBase : public RefCountedWithExternalCount {
 
     std::unique_ptr<InternalPipelineStore> mInternalPipelineStore;
 
+    // Only created when the RecordPipelineManifest toggle is enabled.
+    std::unique_ptr<PipelineManifest> mPipelineManifest;
+    std::vector<Ref<PipelineBase>> mPrewarmedPipelines;
+    size_t mPendingPipelinePrewarmCount = 0;
+
     std::unique_ptr<CallbackTaskManager> mCallbackTaskManager;
     std::unique_ptr<dawn::platform::WorkerTaskPool> mWorkerTaskPool;
     std::string mLabel;
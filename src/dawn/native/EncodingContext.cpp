@@ -28,6 +28,7 @@ EncodingContext::EncodingContext(DeviceBase* device, const ApiObjectBase* initia
     : mDevice(device),
       mTopLevelEncoder(initialEncoder),
       mCurrentEncoder(initialEncoder),
+      mDeferredIndirectDrawMetadata(device->GetLimits()),
       mDestroyed(device->IsLost()) {}
 
 EncodingContext::~EncodingContext() {
@@ -64,7 +65,10 @@ CommandIterator* EncodingContext::GetIterator() {
 }
 
 void EncodingContext::MoveToIterator() {
-    CommitCommands(std::move(mPendingCommands));
+    // Deferred render passes are only left when encoding stopped before Finish().
+    CommandAllocator pendingCommands = std::move(mPendingCommands);
+    CommitDeferredRenderPasses();
+    CommitCommands(std::move(pendingCommands));
     if (!mWasMovedToIterator) {
         mIterator.AcquireCommandBlocks(std::move(mAllocators));
         mWasMovedToIterator = true;
@@ -91,7 +95,7 @@ void EncodingContext::HandleError(std::unique_ptr<ErrorData> error) {
     }
 }
 
-void EncodingContext::WillBeginRenderPass() {
+MaybeError EncodingContext::WillBeginRenderPass() {
     ASSERT(mCurrentEncoder == mTopLevelEncoder);
     if (mDevice->IsValidationEnabled() || mDevice->MayRequireDuplicationOfIndirectParameters()) {
         // When validation is enabled or indirect parameters require duplication, we are going
@@ -100,8 +104,34 @@ void EncodingContext::WillBeginRenderPass() {
         // any necessary validation or duplication commands. To support this we commit any
         // current commands now, so that the impending BeginRenderPassCmd starts in a fresh
         // CommandAllocator.
-        CommitCommands(std::move(mPendingCommands));
+        CommandAllocator commands = std::move(mPendingCommands);
+
+        // Commands encoded since the previous render pass may write to the indirect buffers
+        // used by the next render passes, so the validation of the deferred render passes can't
+        // be delayed any further.
+        MaybeError result = {};
+        if (!commands.IsEmpty()) {
+            result = EncodeDeferredRenderPasses();
+        }
+        CommitCommands(std::move(commands));
+        return result;
+    }
+    return {};
+}
+
+MaybeError EncodingContext::WillBeginComputePass() {
+    ASSERT(mCurrentEncoder == mTopLevelEncoder);
+    if (mDeferredRenderPassCommands.empty() || mIsEncodingDeferredRenderPasses) {
+        return {};
     }
+
+    // The validation of the deferred render passes is a compute pass whose usage is recorded
+    // when it is encoded, so it must be encoded before the compute pass that begins. The
+    // commands encoded since the previous render pass follow the deferred render passes.
+    CommandAllocator commands = std::move(mPendingCommands);
+    MaybeError result = EncodeDeferredRenderPasses();
+    CommitCommands(std::move(commands));
+    return result;
 }
 
 void EncodingContext::EnterPass(const ApiObjectBase* passEncoder) {
@@ -128,16 +158,87 @@ MaybeError EncodingContext::ExitRenderPass(const ApiObjectBase* passEncoder,
         // EndRenderPassCmd, inclusive. Now we swap out this allocator with a fresh one to give
         // the validation encoder a chance to insert its commands first.
         CommandAllocator renderCommands = std::move(mPendingCommands);
-        DAWN_TRY(EncodeIndirectDrawValidationCommands(mDevice, commandEncoder, &usageTracker,
-                                                      &indirectDrawMetadata));
-        CommitCommands(std::move(mPendingCommands));
-        CommitCommands(std::move(renderCommands));
+
+        // The validation of the render pass is deferred to be encoded along with the next ones.
+        MaybeError result = {};
+        if (!CanDeferIndirectDrawValidation(indirectDrawMetadata)) {
+            result = EncodeDeferredRenderPasses();
+        }
+
+        if (mDeferredRenderPassCommands.empty()) {
+            mDeferredIndirectDrawMetadata = std::move(indirectDrawMetadata);
+        } else {
+            mDeferredIndirectDrawMetadata.AddRenderPass(indirectDrawMetadata);
+        }
+        mDeferredRenderPassCommands.push_back(std::move(renderCommands));
+        mDeferredRenderPassUsageTrackers.push_back(std::move(usageTracker));
+        mDeferredRenderPassCommandEncoder = commandEncoder;
+        return result;
     }
 
     mRenderPassUsages.push_back(usageTracker.AcquireResourceUsage());
     return {};
 }
 
+bool EncodingContext::CanDeferIndirectDrawValidation(
+    const IndirectDrawMetadata& indirectDrawMetadata) const {
+    if (mDeferredRenderPassCommands.empty()) {
+        return true;
+    }
+
+    if (mDeferredIndirectDrawMetadata.GetDrawCount() + indirectDrawMetadata.GetDrawCount() >
+        ComputeMaxDrawCallsPerIndirectValidationGroup(mDevice->GetLimits())) {
+        return false;
+    }
+
+    // The indirect parameters are read when the validation is encoded, before the deferred
+    // render passes, so they must not be written by these render passes.
+    for (const auto& [config, _] : *indirectDrawMetadata.GetIndexedIndirectBufferValidationInfo()) {
+        for (const RenderPassResourceUsageTracker& usageTracker :
+             mDeferredRenderPassUsageTrackers) {
+            if (usageTracker.GetBufferUsage(config.inputIndirectBuffer) &
+                wgpu::BufferUsage::Storage) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+MaybeError EncodingContext::EncodeDeferredRenderPasses() {
+    if (mDeferredRenderPassCommands.empty()) {
+        return {};
+    }
+
+    // The validation commands are encoded in mPendingCommands, ahead of the render passes.
+    ASSERT(mCurrentEncoder == mTopLevelEncoder);
+    ASSERT(mPendingCommands.IsEmpty());
+    ASSERT(!mIsEncodingDeferredRenderPasses);
+    mIsEncodingDeferredRenderPasses = true;
+    MaybeError result = EncodeIndirectDrawValidationCommands(
+        mDevice, mDeferredRenderPassCommandEncoder, &mDeferredRenderPassUsageTrackers,
+        &mDeferredIndirectDrawMetadata);
+    mIsEncodingDeferredRenderPasses = false;
+    CommitCommands(std::move(mPendingCommands));
+
+    CommitDeferredRenderPasses();
+    return result;
+}
+
+void EncodingContext::CommitDeferredRenderPasses() {
+    for (CommandAllocator& renderCommands : mDeferredRenderPassCommands) {
+        CommitCommands(std::move(renderCommands));
+    }
+    for (RenderPassResourceUsageTracker& usageTracker : mDeferredRenderPassUsageTrackers) {
+        mRenderPassUsages.push_back(usageTracker.AcquireResourceUsage());
+    }
+
+    mDeferredRenderPassCommands.clear();
+    mDeferredRenderPassUsageTrackers.clear();
+    mDeferredIndirectDrawMetadata = IndirectDrawMetadata(mDevice->GetLimits());
+    mDeferredRenderPassCommandEncoder = nullptr;
+}
+
 void EncodingContext::ExitComputePass(const ApiObjectBase* passEncoder,
                                       ComputePassResourceUsage usages) {
     ASSERT(mCurrentEncoder != mTopLevelEncoder);
@@ -192,16 +293,27 @@ MaybeError EncodingContext::Finish() {
     const ApiObjectBase* currentEncoder = mCurrentEncoder;
     const ApiObjectBase* topLevelEncoder = mTopLevelEncoder;
 
+    // The deferred render passes are followed by the commands in mPendingCommands. Their
+    // validation is only encoded if the command buffer can be valid.
+    CommandAllocator pendingCommands = std::move(mPendingCommands);
+    MaybeError deferredRenderPassesResult = {};
+    if (mError == nullptr && currentEncoder == topLevelEncoder) {
+        deferredRenderPassesResult = EncodeDeferredRenderPasses();
+    } else {
+        CommitDeferredRenderPasses();
+    }
+
     // Even if finish validation fails, it is now invalid to call any encoding commands,
     // so we clear the encoders. Note: mTopLevelEncoder == nullptr is used as a flag for
     // if Finish() has been called.
     mCurrentEncoder = nullptr;
     mTopLevelEncoder = nullptr;
-    CommitCommands(std::move(mPendingCommands));
+    CommitCommands(std::move(pendingCommands));
 
     if (mError != nullptr) {
         return std::move(mError);
     }
+    DAWN_TRY(std::move(deferredRenderPassesResult));
     DAWN_INVALID_IF(currentEncoder != topLevelEncoder,
                     "Command buffer recording ended before %s was ended.", currentEncoder);
     return {};
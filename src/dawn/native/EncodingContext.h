@@ -122,7 +122,12 @@ class EncodingContext {
     // Must be called prior to encoding a BeginRenderPassCmd. Note that it's OK to call this
     // and then not actually call EnterPass+ExitRenderPass, for example if some other pass setup
     // failed validation before the BeginRenderPassCmd could be encoded.
-    void WillBeginRenderPass();
+    MaybeError WillBeginRenderPass();
+
+    // Must be called prior to encoding a BeginComputePassCmd. The compute passes must be
+    // encoded after the deferred render passes and their validation, so that the order of the
+    // compute pass usages matches the order of the compute passes in the commands.
+    MaybeError WillBeginComputePass();
 
     // Functions to set current encoder state
     void EnterPass(const ApiObjectBase* passEncoder);
@@ -148,6 +153,13 @@ class EncodingContext {
   private:
     void CommitCommands(CommandAllocator allocator);
 
+    bool CanDeferIndirectDrawValidation(const IndirectDrawMetadata& indirectDrawMetadata) const;
+    // Encodes the validation of the indirect draws of the deferred render passes, followed by
+    // the render passes themselves.
+    MaybeError EncodeDeferredRenderPasses();
+    // Commits the deferred render passes without validation, when encoding stops with an error.
+    void CommitDeferredRenderPasses();
+
     bool IsFinished() const;
     void MoveToIterator();
 
@@ -170,6 +182,18 @@ class EncodingContext {
 
     CommandAllocator mPendingCommands;
 
+    // Consecutive render passes whose indirect draws are validated together, before the first
+    // of them, so that draws using the same indirect parameters in different render passes are
+    // validated once. They are encoded when a command is encoded between two render passes, when
+    // a compute pass begins, or when a render pass could be reading indirect parameters written
+    // by a previous one.
+    std::vector<CommandAllocator> mDeferredRenderPassCommands;
+    std::vector<RenderPassResourceUsageTracker> mDeferredRenderPassUsageTrackers;
+    IndirectDrawMetadata mDeferredIndirectDrawMetadata;
+    CommandEncoder* mDeferredRenderPassCommandEncoder = nullptr;
+    // Set while the validation compute passes of the deferred render passes are encoded.
+    bool mIsEncodingDeferredRenderPasses = false;
+
     std::vector<CommandAllocator> mAllocators;
     CommandIterator mIterator;
     bool mWasMovedToIterator = false;
@@ -137,38 +137,42 @@ typename std::bitset<kKnownFormatCount>::reference FormatSet::operator[](const F
 
 // Implementation details of the format table of the DeviceBase
 
-// For the enum for formats are packed but this might change when we have a broader feature
-// mechanism for webgpu.h. Formats start at 1 because 0 is the undefined format.
-FormatIndex ComputeFormatIndex(wgpu::TextureFormat format) {
-    // This takes advantage of overflows to make the index of TextureFormat::Undefined outside
-    // of the range of the FormatTable.
-    static_assert(static_cast<uint32_t>(wgpu::TextureFormat::Undefined) - 1 > kKnownFormatCount);
-    return static_cast<FormatIndex>(static_cast<uint32_t>(format) - 1);
+namespace {
+
+static constexpr SampleTypeBit kAnyFloat = SampleTypeBit::Float | SampleTypeBit::UnfilterableFloat;
+
+// Not constexpr on purpose: calling it during the constant evaluation of the format table makes
+// the compilation fail, which turns the consistency checks of the table into compile-time checks.
+void FormatTableCheckFailed() {}
+
+constexpr void CheckFormatTable(bool condition) {
+    if (!condition) {
+        FormatTableCheckFailed();
+    }
 }
 
-FormatTable BuildFormatTable(const DeviceBase* device) {
-    FormatTable table;
-    FormatSet formatsSet;
+}  // anonymous namespace
 
-    static constexpr SampleTypeBit kAnyFloat =
-        SampleTypeBit::Float | SampleTypeBit::UnfilterableFloat;
+constexpr FormatTable BuildFormatTable() {
+    FormatTable table;
+    std::array<bool, kKnownFormatCount> formatsSet{};
 
-    auto AddFormat = [&table, &formatsSet](Format format) {
-        FormatIndex index = ComputeFormatIndex(format.format);
-        ASSERT(index < table.size());
+    auto AddFormat = [&table, &formatsSet](const Format& format) {
+        const uint32_t index = static_cast<uint32_t>(ComputeFormatIndex(format.format));
+        CheckFormatTable(index < table.size());
 
         // This checks that each format is set at most once, the first part of checking that all
         // formats are set exactly once.
-        ASSERT(!formatsSet[index]);
+        CheckFormatTable(!formatsSet[index]);
 
         // Vulkan describes bytesPerRow in units of texels. If there's any format for which this
-        // ASSERT isn't true, then additional validation on bytesPerRow must be added.
+        // check isn't true, then additional validation on bytesPerRow must be added.
         const bool hasMultipleAspects = !HasOneBit(format.aspects);
-        ASSERT(hasMultipleAspects ||
-               (kTextureBytesPerRowAlignment % format.aspectInfo[0].block.byteSize) == 0);
+        CheckFormatTable(hasMultipleAspects ||
+                         (kTextureBytesPerRowAlignment % format.aspectInfo[0].block.byteSize) == 0);
 
         table[index] = format;
-        formatsSet.set(index);
+        formatsSet[index] = true;
     };
 
     auto AddColorFormat =
@@ -180,12 +184,9 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
             internalFormat.format = format;
             internalFormat.isRenderable = renderable;
             internalFormat.isCompressed = false;
-            internalFormat.isSupported = true;
             internalFormat.supportsStorageUsage = supportsStorageUsage;
 
-            if (supportsMultisample) {
-                ASSERT(renderable);
-            }
+            CheckFormatTable(!supportsMultisample || renderable);
             internalFormat.supportsMultisample = supportsMultisample;
             internalFormat.supportsResolveTarget = supportsResolveTarget;
             internalFormat.aspects = Aspect::Color;
@@ -215,10 +216,10 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
                         firstAspect->baseType = wgpu::TextureComponentType::Uint;
                         break;
                     default:
-                        UNREACHABLE();
+                        CheckFormatTable(false);
                 }
             } else {
-                ASSERT((sampleTypes & SampleTypeBit::Float).value != 0);
+                CheckFormatTable((sampleTypes & SampleTypeBit::Float).value != 0);
                 firstAspect->baseType = wgpu::TextureComponentType::Float;
             }
             firstAspect->supportedSampleTypes = sampleTypes;
@@ -226,14 +227,12 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
             AddFormat(internalFormat);
         };
 
-    auto AddDepthFormat = [&AddFormat](wgpu::TextureFormat format, uint32_t byteSize,
-                                       bool isSupported) {
+    auto AddDepthFormat = [&AddFormat](wgpu::TextureFormat format, uint32_t byteSize) {
         Format internalFormat;
         internalFormat.format = format;
         internalFormat.baseFormat = format;
         internalFormat.isRenderable = true;
         internalFormat.isCompressed = false;
-        internalFormat.isSupported = isSupported;
         internalFormat.supportsStorageUsage = false;
         internalFormat.supportsMultisample = true;
         internalFormat.supportsResolveTarget = false;
@@ -250,13 +249,12 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
         AddFormat(internalFormat);
     };
 
-    auto AddStencilFormat = [&AddFormat](wgpu::TextureFormat format, bool isSupported) {
+    auto AddStencilFormat = [&AddFormat](wgpu::TextureFormat format) {
         Format internalFormat;
         internalFormat.format = format;
         internalFormat.baseFormat = format;
         internalFormat.isRenderable = true;
         internalFormat.isCompressed = false;
-        internalFormat.isSupported = isSupported;
         internalFormat.supportsStorageUsage = false;
         internalFormat.supportsMultisample = true;
         internalFormat.supportsResolveTarget = false;
@@ -267,8 +265,7 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
         //  - aspectInfo[0] is used by AddMultiAspectFormat to copy the info for the whole
         //    stencil8 aspect of depth-stencil8 formats.
         //  - aspectInfo[1] is the actual info used in the rest of Dawn since
-        //    GetAspectIndex(Aspect::Stencil) is 1.
-        ASSERT(GetAspectIndex(Aspect::Stencil) == 1);
+        //    GetAspectIndex(Aspect::Stencil) is 1 (it is ASSERTed in ComputeSupportedFormats).
 
         internalFormat.aspectInfo[0].block.byteSize = 1;
         internalFormat.aspectInfo[0].block.width = 1;
@@ -284,13 +281,13 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
 
     auto AddCompressedFormat =
         [&AddFormat](wgpu::TextureFormat format, uint32_t byteSize, uint32_t width, uint32_t height,
-                     bool isSupported, uint8_t componentCount,
+                     Feature requiredFeature, uint8_t componentCount,
                      wgpu::TextureFormat baseFormat = wgpu::TextureFormat::Undefined) {
             Format internalFormat;
             internalFormat.format = format;
             internalFormat.isRenderable = false;
             internalFormat.isCompressed = true;
-            internalFormat.isSupported = isSupported;
+            internalFormat.requiredFeature = requiredFeature;
             internalFormat.supportsStorageUsage = false;
             internalFormat.supportsMultisample = false;
             internalFormat.supportsResolveTarget = false;
@@ -317,14 +314,14 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
     auto AddMultiAspectFormat =
         [&AddFormat, &table](wgpu::TextureFormat format, Aspect aspects,
                              wgpu::TextureFormat firstFormat, wgpu::TextureFormat secondFormat,
-                             bool isRenderable, bool isSupported, bool supportsMultisample,
-                             uint8_t componentCount) {
+                             bool isRenderable, Feature requiredFeature,
+                             bool supportsMultisample, uint8_t componentCount) {
             Format internalFormat;
             internalFormat.format = format;
             internalFormat.baseFormat = format;
             internalFormat.isRenderable = isRenderable;
             internalFormat.isCompressed = false;
-            internalFormat.isSupported = isSupported;
+            internalFormat.requiredFeature = requiredFeature;
             internalFormat.supportsStorageUsage = false;
             internalFormat.supportsMultisample = supportsMultisample;
             internalFormat.supportsResolveTarget = false;
@@ -333,12 +330,16 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
 
             // Multi aspect formats just copy information about single-aspect formats. This
             // means that the single-plane formats must have been added before multi-aspect
-            // ones. (it is ASSERTed below).
-            const FormatIndex firstFormatIndex = ComputeFormatIndex(firstFormat);
-            const FormatIndex secondFormatIndex = ComputeFormatIndex(secondFormat);
+            // ones. (it is checked below).
+            const uint32_t firstFormatIndex =
+                static_cast<uint32_t>(ComputeFormatIndex(firstFormat));
+            const uint32_t secondFormatIndex =
+                static_cast<uint32_t>(ComputeFormatIndex(secondFormat));
 
-            ASSERT(table[firstFormatIndex].aspectInfo[0].format != wgpu::TextureFormat::Undefined);
-            ASSERT(table[secondFormatIndex].aspectInfo[0].format != wgpu::TextureFormat::Undefined);
+            CheckFormatTable(table[firstFormatIndex].aspectInfo[0].format !=
+                             wgpu::TextureFormat::Undefined);
+            CheckFormatTable(table[secondFormatIndex].aspectInfo[0].format !=
+                             wgpu::TextureFormat::Undefined);
 
             internalFormat.aspectInfo[0] = table[firstFormatIndex].aspectInfo[0];
             internalFormat.aspectInfo[1] = table[secondFormatIndex].aspectInfo[0];
@@ -395,93 +396,114 @@ FormatTable BuildFormatTable(const DeviceBase* device) {
         AddColorFormat(wgpu::TextureFormat::RGBA32Float, true, true, false, false, 16, SampleTypeBit::UnfilterableFloat, 4);
 
         // Depth-stencil formats
-        AddStencilFormat(wgpu::TextureFormat::Stencil8, true);
-        AddDepthFormat(wgpu::TextureFormat::Depth16Unorm, 2, true);
+        AddStencilFormat(wgpu::TextureFormat::Stencil8);
+        AddDepthFormat(wgpu::TextureFormat::Depth16Unorm, 2);
         // TODO(crbug.com/dawn/843): This is 4 because we read this to perform zero initialization,
         // and textures are always use depth32float. We should improve this to be more robust. Perhaps,
         // using 0 here to mean "unsized" and adding a backend-specific query for the block size.
-        AddDepthFormat(wgpu::TextureFormat::Depth24Plus, 4, true);
+        AddDepthFormat(wgpu::TextureFormat::Depth24Plus, 4);
         AddMultiAspectFormat(wgpu::TextureFormat::Depth24PlusStencil8,
-                              Aspect::Depth | Aspect::Stencil, wgpu::TextureFormat::Depth24Plus, wgpu::TextureFormat::Stencil8, true, true, true, 2);
-        AddDepthFormat(wgpu::TextureFormat::Depth32Float, 4, true);
-        bool isD32S8Supported = device->IsFeatureEnabled(Feature::Depth32FloatStencil8);
+                              Aspect::Depth | Aspect::Stencil, wgpu::TextureFormat::Depth24Plus, wgpu::TextureFormat::Stencil8, true, Feature::InvalidEnum, true, 2);
+        AddDepthFormat(wgpu::TextureFormat::Depth32Float, 4);
         AddMultiAspectFormat(wgpu::TextureFormat::Depth32FloatStencil8,
-                              Aspect::Depth | Aspect::Stencil, wgpu::TextureFormat::Depth32Float, wgpu::TextureFormat::Stencil8, true, isD32S8Supported, true, 2);
+                              Aspect::Depth | Aspect::Stencil, wgpu::TextureFormat::Depth32Float, wgpu::TextureFormat::Stencil8, true, Feature::Depth32FloatStencil8, true, 2);
 
         // BC compressed formats
-        bool isBCFormatSupported = device->IsFeatureEnabled(Feature::TextureCompressionBC);
-        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnorm, 8, 4, 4, isBCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnormSrgb, 8, 4, 4, isBCFormatSupported, 4, wgpu::TextureFormat::BC1RGBAUnorm);
-        AddCompressedFormat(wgpu::TextureFormat::BC4RSnorm, 8, 4, 4, isBCFormatSupported, 1);
-        AddCompressedFormat(wgpu::TextureFormat::BC4RUnorm, 8, 4, 4, isBCFormatSupported, 1);
-        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnorm, 16, 4, 4, isBCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported, 4, wgpu::TextureFormat::BC2RGBAUnorm);
-        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnorm, 16, 4, 4, isBCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported, 4, wgpu::TextureFormat::BC3RGBAUnorm);
-        AddCompressedFormat(wgpu::TextureFormat::BC5RGSnorm, 16, 4, 4, isBCFormatSupported, 2);
-        AddCompressedFormat(wgpu::TextureFormat::BC5RGUnorm, 16, 4, 4, isBCFormatSupported, 2);
-        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBFloat, 16, 4, 4, isBCFormatSupported, 3);
-        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBUfloat, 16, 4, 4, isBCFormatSupported, 3);
-        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnorm, 16, 4, 4, isBCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported, 4, wgpu::TextureFormat::BC7RGBAUnorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnorm, 8, 4, 4, Feature::TextureCompressionBC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnormSrgb, 8, 4, 4, Feature::TextureCompressionBC, 4, wgpu::TextureFormat::BC1RGBAUnorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC4RSnorm, 8, 4, 4, Feature::TextureCompressionBC, 1);
+        AddCompressedFormat(wgpu::TextureFormat::BC4RUnorm, 8, 4, 4, Feature::TextureCompressionBC, 1);
+        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnorm, 16, 4, 4, Feature::TextureCompressionBC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnormSrgb, 16, 4, 4, Feature::TextureCompressionBC, 4, wgpu::TextureFormat::BC2RGBAUnorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnorm, 16, 4, 4, Feature::TextureCompressionBC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnormSrgb, 16, 4, 4, Feature::TextureCompressionBC, 4, wgpu::TextureFormat::BC3RGBAUnorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC5RGSnorm, 16, 4, 4, Feature::TextureCompressionBC, 2);
+        AddCompressedFormat(wgpu::TextureFormat::BC5RGUnorm, 16, 4, 4, Feature::TextureCompressionBC, 2);
+        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBFloat, 16, 4, 4, Feature::TextureCompressionBC, 3);
+        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBUfloat, 16, 4, 4, Feature::TextureCompressionBC, 3);
+        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnorm, 16, 4, 4, Feature::TextureCompressionBC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnormSrgb, 16, 4, 4, Feature::TextureCompressionBC, 4, wgpu::TextureFormat::BC7RGBAUnorm);
 
         // ETC2/EAC compressed formats
-        bool isETC2FormatSupported = device->IsFeatureEnabled(Feature::TextureCompressionETC2);
-        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8Unorm, 8, 4, 4, isETC2FormatSupported, 3);
-        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8UnormSrgb, 8, 4, 4, isETC2FormatSupported, 3, wgpu::TextureFormat::ETC2RGB8Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8A1Unorm, 8, 4, 4, isETC2FormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8A1UnormSrgb, 8, 4, 4, isETC2FormatSupported, 4, wgpu::TextureFormat::ETC2RGB8A1Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ETC2RGBA8Unorm, 16, 4, 4, isETC2FormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ETC2RGBA8UnormSrgb, 16, 4, 4, isETC2FormatSupported, 4, wgpu::TextureFormat::ETC2RGBA8Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::EACR11Unorm, 8, 4, 4, isETC2FormatSupported, 1);
-        AddCompressedFormat(wgpu::TextureFormat::EACR11Snorm, 8, 4, 4, isETC2FormatSupported, 1);
-        AddCompressedFormat(wgpu::TextureFormat::EACRG11Unorm, 16, 4, 4, isETC2FormatSupported, 2);
-        AddCompressedFormat(wgpu::TextureFormat::EACRG11Snorm, 16, 4, 4, isETC2FormatSupported, 2);
+        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8Unorm, 8, 4, 4, Feature::TextureCompressionETC2, 3);
+        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8UnormSrgb, 8, 4, 4, Feature::TextureCompressionETC2, 3, wgpu::TextureFormat::ETC2RGB8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8A1Unorm, 8, 4, 4, Feature::TextureCompressionETC2, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ETC2RGB8A1UnormSrgb, 8, 4, 4, Feature::TextureCompressionETC2, 4, wgpu::TextureFormat::ETC2RGB8A1Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ETC2RGBA8Unorm, 16, 4, 4, Feature::TextureCompressionETC2, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ETC2RGBA8UnormSrgb, 16, 4, 4, Feature::TextureCompressionETC2, 4, wgpu::TextureFormat::ETC2RGBA8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::EACR11Unorm, 8, 4, 4, Feature::TextureCompressionETC2, 1);
+        AddCompressedFormat(wgpu::TextureFormat::EACR11Snorm, 8, 4, 4, Feature::TextureCompressionETC2, 1);
+        AddCompressedFormat(wgpu::TextureFormat::EACRG11Unorm, 16, 4, 4, Feature::TextureCompressionETC2, 2);
+        AddCompressedFormat(wgpu::TextureFormat::EACRG11Snorm, 16, 4, 4, Feature::TextureCompressionETC2, 2);
 
         // ASTC compressed formats
-        bool isASTCFormatSupported = device->IsFeatureEnabled(Feature::TextureCompressionASTC);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC4x4Unorm, 16, 4, 4, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC4x4UnormSrgb, 16, 4, 4, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC4x4Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC5x4Unorm, 16, 5, 4, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC5x4UnormSrgb, 16, 5, 4, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC5x4Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC5x5Unorm, 16, 5, 5, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC5x5UnormSrgb, 16, 5, 5, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC5x5Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC6x5Unorm, 16, 6, 5, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC6x5UnormSrgb, 16, 6, 5, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC6x5Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC6x6Unorm, 16, 6, 6, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC6x6UnormSrgb, 16, 6, 6, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC6x6Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC8x5Unorm, 16, 8, 5, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC8x5UnormSrgb, 16, 8, 5, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC8x5Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC8x6Unorm, 16, 8, 6, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC8x6UnormSrgb, 16, 8, 6, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC8x6Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC8x8Unorm, 16, 8, 8, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC8x8UnormSrgb, 16, 8, 8, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC8x8Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x5Unorm, 16, 10, 5, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x5UnormSrgb, 16, 10, 5, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC10x5Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x6Unorm, 16, 10, 6, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x6UnormSrgb, 16, 10, 6, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC10x6Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x8Unorm, 16, 10, 8, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x8UnormSrgb, 16, 10, 8, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC10x8Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x10Unorm, 16, 10, 10, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC10x10UnormSrgb, 16, 10, 10, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC10x10Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC12x10Unorm, 16, 12, 10, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC12x10UnormSrgb, 16, 12, 10, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC12x10Unorm);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC12x12Unorm, 16, 12, 12, isASTCFormatSupported, 4);
-        AddCompressedFormat(wgpu::TextureFormat::ASTC12x12UnormSrgb, 16, 12, 12, isASTCFormatSupported, 4, wgpu::TextureFormat::ASTC12x12Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC4x4Unorm, 16, 4, 4, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC4x4UnormSrgb, 16, 4, 4, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC4x4Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC5x4Unorm, 16, 5, 4, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC5x4UnormSrgb, 16, 5, 4, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC5x4Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC5x5Unorm, 16, 5, 5, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC5x5UnormSrgb, 16, 5, 5, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC5x5Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC6x5Unorm, 16, 6, 5, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC6x5UnormSrgb, 16, 6, 5, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC6x5Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC6x6Unorm, 16, 6, 6, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC6x6UnormSrgb, 16, 6, 6, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC6x6Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC8x5Unorm, 16, 8, 5, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC8x5UnormSrgb, 16, 8, 5, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC8x5Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC8x6Unorm, 16, 8, 6, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC8x6UnormSrgb, 16, 8, 6, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC8x6Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC8x8Unorm, 16, 8, 8, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC8x8UnormSrgb, 16, 8, 8, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC8x8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x5Unorm, 16, 10, 5, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x5UnormSrgb, 16, 10, 5, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC10x5Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x6Unorm, 16, 10, 6, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x6UnormSrgb, 16, 10, 6, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC10x6Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x8Unorm, 16, 10, 8, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x8UnormSrgb, 16, 10, 8, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC10x8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x10Unorm, 16, 10, 10, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC10x10UnormSrgb, 16, 10, 10, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC10x10Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC12x10Unorm, 16, 12, 10, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC12x10UnormSrgb, 16, 12, 10, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC12x10Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC12x12Unorm, 16, 12, 12, Feature::TextureCompressionASTC, 4);
+        AddCompressedFormat(wgpu::TextureFormat::ASTC12x12UnormSrgb, 16, 12, 12, Feature::TextureCompressionASTC, 4, wgpu::TextureFormat::ASTC12x12Unorm);
 
         // multi-planar formats
-        const bool isMultiPlanarFormatSupported = device->IsFeatureEnabled(Feature::MultiPlanarFormats);
         AddMultiAspectFormat(wgpu::TextureFormat::R8BG8Biplanar420Unorm, Aspect::Plane0 | Aspect::Plane1,
-            wgpu::TextureFormat::R8Unorm, wgpu::TextureFormat::RG8Unorm, false, isMultiPlanarFormatSupported, false, 3);
+            wgpu::TextureFormat::R8Unorm, wgpu::TextureFormat::RG8Unorm, false, Feature::MultiPlanarFormats, false, 3);
 
     // clang-format on
 
     // This checks that each format is set at least once, the second part of checking that all
-    // formats are checked exactly once. If this assertion is failing and texture formats have been
+    // formats are checked exactly once. If this check is failing and texture formats have been
     // added or removed recently, check that kKnownFormatCount has been updated.
-    ASSERT(formatsSet.all());
+    for (bool isSet : formatsSet) {
+        CheckFormatTable(isSet);
+    }
 
     return table;
 }
 
+namespace {
+
+static constexpr FormatTable kFormatTable = BuildFormatTable();
+
+}  // anonymous namespace
+
+const Format& GetKnownFormat(FormatIndex index) {
+    ASSERT(index < FormatIndex(kKnownFormatCount));
+    return kFormatTable[static_cast<uint32_t>(index)];
+}
+
+FormatSet ComputeSupportedFormats(const DeviceBase* device) {
+    ASSERT(GetAspectIndex(Aspect::Stencil) == 1);
+
+    FormatSet supportedFormats;
+    for (const Format& format : kFormatTable) {
+        if (format.requiredFeature == Feature::InvalidEnum ||
+            device->IsFeatureEnabled(format.requiredFeature)) {
+            supportedFormats[format] = true;
+        }
+    }
+    return supportedFormats;
+}
+
 }  // namespace dawn::native
@@ -24,6 +24,7 @@
 #include "dawn/common/ityp_bitset.h"
 #include "dawn/native/EnumClassBitmasks.h"
 #include "dawn/native/Error.h"
+#include "dawn/native/Features.h"
 #include "dawn/native/Subresource.h"
 
 // About multi-planar formats.
@@ -77,14 +78,14 @@ struct AspectInfo {
     wgpu::TextureFormat format = wgpu::TextureFormat::Undefined;
 };
 
-// The number of formats Dawn knows about. Asserts in BuildFormatTable ensure that this is the
-// exact number of known format.
+// The number of formats Dawn knows about. Checks in BuildFormatTable ensure at compile time that
+// this is the exact number of known format.
 static constexpr uint32_t kKnownFormatCount = 95;
 
 using FormatIndex = TypedInteger<struct FormatIndexT, uint32_t>;
 
 struct Format;
-using FormatTable = ityp::array<FormatIndex, Format, kKnownFormatCount>;
+using FormatTable = std::array<Format, kKnownFormatCount>;
 
 // A wgpu::TextureFormat along with all the information about it necessary for validation.
 struct Format {
@@ -93,8 +94,10 @@ struct Format {
     // TODO(crbug.com/dawn/1332): These members could be stored in a Format capability matrix.
     bool isRenderable = false;
     bool isCompressed = false;
-    // A format can be known but not supported because it is part of a disabled extension.
-    bool isSupported = false;
+    // A format can be known but not supported because it is part of a disabled extension. This
+    // is the feature that must be enabled for the format to be supported, or
+    // Feature::InvalidEnum if the format is always supported. See ComputeSupportedFormats.
+    Feature requiredFeature = Feature::InvalidEnum;
     bool supportsStorageUsage = false;
     bool supportsMultisample = false;
     bool supportsResolveTarget = false;
@@ -138,7 +141,7 @@ struct Format {
     // aspectInfo[i] is the ith plane.
     std::array<AspectInfo, kMaxPlanesPerFormat> aspectInfo{};
 
-    friend FormatTable BuildFormatTable(const DeviceBase* device);
+    friend constexpr FormatTable BuildFormatTable();
 };
 
 class FormatSet : public ityp::bitset<FormatIndex, kKnownFormatCount> {
@@ -154,10 +157,20 @@ class FormatSet : public ityp::bitset<FormatIndex, kKnownFormatCount> {
 
 // Implementation details of the format table in the device.
 
-// Returns the index of a format in the FormatTable.
-FormatIndex ComputeFormatIndex(wgpu::TextureFormat format);
-// Builds the format table with the extensions enabled on the device.
-FormatTable BuildFormatTable(const DeviceBase* device);
+// For the enum for formats are packed but this might change when we have a broader feature
+// mechanism for webgpu.h. Formats start at 1 because 0 is the undefined format.
+constexpr FormatIndex ComputeFormatIndex(wgpu::TextureFormat format) {
+    // This takes advantage of overflows to make the index of TextureFormat::Undefined outside
+    // of the range of the FormatTable.
+    static_assert(static_cast<uint32_t>(wgpu::TextureFormat::Undefined) - 1 > kKnownFormatCount);
+    return static_cast<FormatIndex>(static_cast<uint32_t>(format) - 1);
+}
+
+// Returns the entry at |index| of the table of all known formats. The table is built at compile
+// time and shared by all devices, which only keep the set of formats they support.
+const Format& GetKnownFormat(FormatIndex index);
+// Computes the set of known formats supported with the features enabled on the device.
+FormatSet ComputeSupportedFormats(const DeviceBase* device);
 
 }  // namespace dawn::native
 
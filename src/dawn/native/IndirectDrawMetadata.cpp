@@ -136,14 +136,31 @@ IndirectDrawMetadata::GetIndexedIndirectBufferValidationInfo() {
     return &mIndexedIndirectBufferValidationInfo;
 }
 
+const IndirectDrawMetadata::IndexedIndirectBufferValidationInfoMap*
+IndirectDrawMetadata::GetIndexedIndirectBufferValidationInfo() const {
+    return &mIndexedIndirectBufferValidationInfo;
+}
+
 void IndirectDrawMetadata::AddBundle(RenderBundleBase* bundle) {
     auto [_, inserted] = mAddedBundles.insert(bundle);
     if (!inserted) {
         return;
     }
 
-    for (const auto& [config, validationInfo] :
-         bundle->GetIndirectDrawMetadata().mIndexedIndirectBufferValidationInfo) {
+    const IndirectDrawMetadata& bundleMetadata = bundle->GetIndirectDrawMetadata();
+    AddValidationInfo(bundleMetadata.mIndexedIndirectBufferValidationInfo);
+    mDrawCount += bundleMetadata.mDrawCount;
+}
+
+void IndirectDrawMetadata::AddRenderPass(const IndirectDrawMetadata& other) {
+    AddValidationInfo(other.mIndexedIndirectBufferValidationInfo);
+    mAddedBundles.insert(other.mAddedBundles.begin(), other.mAddedBundles.end());
+    mDrawCount += other.mDrawCount;
+}
+
+void IndirectDrawMetadata::AddValidationInfo(
+    const IndexedIndirectBufferValidationInfoMap& validationInfoMap) {
+    for (const auto& [config, validationInfo] : validationInfoMap) {
         auto it = mIndexedIndirectBufferValidationInfo.lower_bound(config);
         if (it != mIndexedIndirectBufferValidationInfo.end() && it->first == config) {
             // We already have batches for the same config. Merge the new ones in.
@@ -187,6 +204,7 @@ void IndirectDrawMetadata::AddIndexedIndirectDraw(wgpu::IndexFormat indexFormat,
     draw.inputBufferOffset = indirectOffset;
     draw.cmd = cmd;
     it->second.AddIndirectDraw(mMaxDrawCallsPerBatch, mMaxBatchOffsetRange, draw);
+    mDrawCount++;
 }
 
 void IndirectDrawMetadata::AddIndirectDraw(BufferBase* indirectBuffer,
@@ -206,6 +224,11 @@ void IndirectDrawMetadata::AddIndirectDraw(BufferBase* indirectBuffer,
     draw.inputBufferOffset = indirectOffset;
     draw.cmd = cmd;
     it->second.AddIndirectDraw(mMaxDrawCallsPerBatch, mMaxBatchOffsetRange, draw);
+    mDrawCount++;
+}
+
+uint64_t IndirectDrawMetadata::GetDrawCount() const {
+    return mDrawCount;
 }
 
 bool IndirectDrawMetadata::IndexedIndirectConfig::operator<(
@@ -36,8 +36,9 @@ struct CombinedLimits;
 // this length of the buffer, we split the validation work into multiple batches.
 uint64_t ComputeMaxIndirectValidationBatchOffsetRange(const CombinedLimits& limits);
 
-// Metadata corresponding to the validation requirements of a single render pass. This metadata
-// is accumulated while its corresponding render pass is encoded, and is later used to encode
+// Metadata corresponding to the validation requirements of a single render pass, or of
+// consecutive render passes of a command buffer that are validated together. This metadata is
+// accumulated while its corresponding render pass is encoded, and is later used to encode
 // validation commands to be inserted into the command buffer just before the render pass's own
 // commands.
 class IndirectDrawMetadata : public NonCopyable {
@@ -116,8 +117,15 @@ class IndirectDrawMetadata : public NonCopyable {
     IndirectDrawMetadata& operator=(IndirectDrawMetadata&&);
 
     IndexedIndirectBufferValidationInfoMap* GetIndexedIndirectBufferValidationInfo();
+    const IndexedIndirectBufferValidationInfoMap* GetIndexedIndirectBufferValidationInfo() const;
 
     void AddBundle(RenderBundleBase* bundle);
+
+    // Adds the draw calls of a render pass encoded after the ones already in this metadata, so
+    // that all of them are validated before the first render pass. Draw calls using the same
+    // indirect buffer with the same configuration are merged into the same batches.
+    void AddRenderPass(const IndirectDrawMetadata& other);
+
     void AddIndexedIndirectDraw(wgpu::IndexFormat indexFormat,
                                 uint64_t indexBufferSize,
                                 BufferBase* indirectBuffer,
@@ -130,9 +138,16 @@ class IndirectDrawMetadata : public NonCopyable {
                          bool duplicateBaseVertexInstance,
                          DrawIndirectCmd* cmd);
 
+    // Returns the number of draw calls to validate, counting separately the ones that use the
+    // same indirect offset.
+    uint64_t GetDrawCount() const;
+
   private:
+    void AddValidationInfo(const IndexedIndirectBufferValidationInfoMap& validationInfoMap);
+
     IndexedIndirectBufferValidationInfoMap mIndexedIndirectBufferValidationInfo;
     std::set<RenderBundleBase*> mAddedBundles;
+    uint64_t mDrawCount = 0;
 
     uint64_t mMaxBatchOffsetRange;
     uint32_t mMaxDrawCallsPerBatch;
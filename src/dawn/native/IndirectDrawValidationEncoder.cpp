@@ -235,13 +235,28 @@ uint32_t ComputeMaxDrawCallsPerIndirectValidationBatch(const CombinedLimits& lim
                   uint64_t(std::numeric_limits<uint32_t>::max())}));
 }
 
-MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
-                                                CommandEncoder* commandEncoder,
-                                                RenderPassResourceUsageTracker* usageTracker,
-                                                IndirectDrawMetadata* indirectDrawMetadata) {
+uint64_t ComputeMaxDrawCallsPerIndirectValidationGroup(const CombinedLimits& limits) {
+    // In the worst case every draw call is in its own batch, with indirect parameters that are
+    // duplicated and aligned to the storage buffer offset alignment.
+    const uint64_t maxOutputSizePerDrawCall = kDrawIndexedIndirectSize + 2 * sizeof(uint32_t) +
+                                              limits.v1.minStorageBufferOffsetAlignment;
+    return limits.v1.maxStorageBufferBindingSize / maxOutputSizePerDrawCall;
+}
+
+MaybeError EncodeIndirectDrawValidationCommands(
+    DeviceBase* device,
+    CommandEncoder* commandEncoder,
+    std::vector<RenderPassResourceUsageTracker>* usageTrackers,
+    IndirectDrawMetadata* indirectDrawMetadata) {
     struct Batch {
         const IndirectDrawMetadata::IndirectValidationBatch* metadata;
+        BufferBase* inputIndirectBuffer;
         uint64_t numIndexBufferElements;
+        uint32_t flags;
+        // The sorted offsets of the draws in the batch without duplicates. Draws using the same
+        // indirect offset are validated once and share the validated parameters.
+        std::vector<uint64_t> uniqueOffsets;
+        uint64_t outputIndirectSize;
         uint64_t dataBufferOffset;
         uint64_t dataSize;
         uint64_t inputIndirectOffset;
@@ -252,18 +267,15 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
     };
 
     struct Pass {
-        uint32_t flags;
-        BufferBase* inputIndirectBuffer;
-        uint64_t outputParamsSize = 0;
         uint64_t batchDataSize = 0;
         std::unique_ptr<void, void (*)(void*)> batchData{nullptr, std::free};
         std::vector<Batch> batches;
     };
 
     // First stage is grouping all batches into passes. We try to pack as many batches into a
-    // single pass as possible. Batches can be grouped together as long as they're validating
-    // data from the same indirect buffer, but they may still be split into multiple passes if
-    // the number of draw calls in a pass would exceed some (very high) upper bound.
+    // single pass as possible, even when they validate data from different indirect buffers,
+    // since each batch has its own bind group. Batches are only split into multiple passes if
+    // their data would exceed the maximum storage buffer binding size.
     uint64_t outputParamsSize = 0;
     std::vector<Pass> passes;
     IndirectDrawMetadata::IndexedIndirectBufferValidationInfoMap& bufferInfoMap =
@@ -276,14 +288,27 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
     const uint32_t minStorageBufferOffsetAlignment =
         device->GetLimits().v1.minStorageBufferOffsetAlignment;
 
+    uint32_t deviceFlags = 0;
+    if (device->IsValidationEnabled()) {
+        deviceFlags |= kValidationEnabled;
+    }
+    if (device->IsFeatureEnabled(Feature::IndirectFirstInstance)) {
+        deviceFlags |= kIndirectFirstInstanceEnabled;
+    }
+
     for (auto& [config, validationInfo] : bufferInfoMap) {
         const uint64_t indirectDrawCommandSize =
             config.drawType == IndirectDrawMetadata::DrawType::Indexed ? kDrawIndexedIndirectSize
                                                                        : kDrawIndirectSize;
 
         uint64_t outputIndirectSize = indirectDrawCommandSize;
+        uint32_t flags = deviceFlags;
         if (config.duplicateBaseVertexInstance) {
             outputIndirectSize += 2 * sizeof(uint32_t);
+            flags |= kDuplicateBaseVertexInstance;
+        }
+        if (config.drawType == IndirectDrawMetadata::DrawType::Indexed) {
+            flags |= kIndexedDraw;
         }
 
         for (const IndirectDrawMetadata::IndirectValidationBatch& batch :
@@ -294,13 +319,26 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
 
             Batch newBatch;
             newBatch.metadata = &batch;
+            newBatch.inputIndirectBuffer = config.inputIndirectBuffer;
             newBatch.numIndexBufferElements = config.numIndexBufferElements;
-            newBatch.dataSize = GetBatchDataSize(batch.draws.size());
+            newBatch.flags = flags;
+
+            newBatch.uniqueOffsets.reserve(batch.draws.size());
+            for (const IndirectDrawMetadata::IndirectDraw& draw : batch.draws) {
+                newBatch.uniqueOffsets.push_back(draw.inputBufferOffset);
+            }
+            std::sort(newBatch.uniqueOffsets.begin(), newBatch.uniqueOffsets.end());
+            newBatch.uniqueOffsets.erase(
+                std::unique(newBatch.uniqueOffsets.begin(), newBatch.uniqueOffsets.end()),
+                newBatch.uniqueOffsets.end());
+
+            newBatch.outputIndirectSize = outputIndirectSize;
+            newBatch.dataSize = GetBatchDataSize(newBatch.uniqueOffsets.size());
             newBatch.inputIndirectOffset = minOffsetAlignedDown;
             newBatch.inputIndirectSize =
                 batch.maxOffset + indirectDrawCommandSize - minOffsetAlignedDown;
 
-            newBatch.outputParamsSize = batch.draws.size() * outputIndirectSize;
+            newBatch.outputParamsSize = newBatch.uniqueOffsets.size() * outputIndirectSize;
             newBatch.outputParamsOffset = Align(outputParamsSize, minStorageBufferOffsetAlignment);
             outputParamsSize = newBatch.outputParamsOffset + newBatch.outputParamsSize;
             if (outputParamsSize > maxStorageBufferBindingSize) {
@@ -308,7 +346,7 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
             }
 
             Pass* currentPass = passes.empty() ? nullptr : &passes.back();
-            if (currentPass && currentPass->inputIndirectBuffer == config.inputIndirectBuffer) {
+            if (currentPass) {
                 uint64_t nextBatchDataOffset =
                     Align(currentPass->batchDataSize, minStorageBufferOffsetAlignment);
                 uint64_t newPassBatchDataSize = nextBatchDataOffset + newBatch.dataSize;
@@ -316,7 +354,7 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
                     // We can fit this batch in the current pass.
                     newBatch.dataBufferOffset = nextBatchDataOffset;
                     currentPass->batchDataSize = newPassBatchDataSize;
-                    currentPass->batches.push_back(newBatch);
+                    currentPass->batches.push_back(std::move(newBatch));
                     continue;
                 }
             }
@@ -325,22 +363,8 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
             newBatch.dataBufferOffset = 0;
 
             Pass newPass{};
-            newPass.inputIndirectBuffer = config.inputIndirectBuffer;
             newPass.batchDataSize = newBatch.dataSize;
-            newPass.batches.push_back(newBatch);
-            newPass.flags = 0;
-            if (config.duplicateBaseVertexInstance) {
-                newPass.flags |= kDuplicateBaseVertexInstance;
-            }
-            if (config.drawType == IndirectDrawMetadata::DrawType::Indexed) {
-                newPass.flags |= kIndexedDraw;
-            }
-            if (device->IsValidationEnabled()) {
-                newPass.flags |= kValidationEnabled;
-            }
-            if (device->IsFeatureEnabled(Feature::IndirectFirstInstance)) {
-                newPass.flags |= kIndirectFirstInstanceEnabled;
-            }
+            newPass.batches.push_back(std::move(newBatch));
             passes.push_back(std::move(newPass));
         }
     }
@@ -354,10 +378,11 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
         requiredBatchDataBufferSize = std::max(requiredBatchDataBufferSize, pass.batchDataSize);
     }
     DAWN_TRY(batchDataBuffer.EnsureCapacity(requiredBatchDataBufferSize));
-    usageTracker->BufferUsedAs(batchDataBuffer.GetBuffer(), wgpu::BufferUsage::Storage);
-
     DAWN_TRY(outputParamsBuffer.EnsureCapacity(outputParamsSize));
-    usageTracker->BufferUsedAs(outputParamsBuffer.GetBuffer(), wgpu::BufferUsage::Indirect);
+    for (RenderPassResourceUsageTracker& usageTracker : *usageTrackers) {
+        usageTracker.BufferUsedAs(batchDataBuffer.GetBuffer(), wgpu::BufferUsage::Storage);
+        usageTracker.BufferUsedAs(outputParamsBuffer.GetBuffer(), wgpu::BufferUsage::Indirect);
+    }
 
     // Now we allocate and populate host-side batch data to be copied to the GPU.
     for (Pass& pass : passes) {
@@ -368,23 +393,24 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
         for (Batch& batch : pass.batches) {
             batch.batchInfo = new (&batchData[batch.dataBufferOffset]) BatchInfo();
             batch.batchInfo->numIndexBufferElements = batch.numIndexBufferElements;
-            batch.batchInfo->numDraws = static_cast<uint32_t>(batch.metadata->draws.size());
-            batch.batchInfo->flags = pass.flags;
+            batch.batchInfo->numDraws = static_cast<uint32_t>(batch.uniqueOffsets.size());
+            batch.batchInfo->flags = batch.flags;
 
             uint32_t* indirectOffsets = reinterpret_cast<uint32_t*>(batch.batchInfo + 1);
-            uint64_t outputParamsOffset = batch.outputParamsOffset;
-            for (auto& draw : batch.metadata->draws) {
+            for (uint64_t offset : batch.uniqueOffsets) {
                 // The shader uses this to index an array of u32, hence the division by 4 bytes.
                 *indirectOffsets++ =
-                    static_cast<uint32_t>((draw.inputBufferOffset - batch.inputIndirectOffset) / 4);
+                    static_cast<uint32_t>((offset - batch.inputIndirectOffset) / 4);
+            }
 
+            for (const IndirectDrawMetadata::IndirectDraw& draw : batch.metadata->draws) {
+                size_t drawIndex = std::lower_bound(batch.uniqueOffsets.begin(),
+                                                    batch.uniqueOffsets.end(),
+                                                    draw.inputBufferOffset) -
+                                   batch.uniqueOffsets.begin();
                 draw.cmd->indirectBuffer = outputParamsBuffer.GetBuffer();
-                draw.cmd->indirectOffset = outputParamsOffset;
-                if (pass.flags & kIndexedDraw) {
-                    outputParamsOffset += kDrawIndexedIndirectSize;
-                } else {
-                    outputParamsOffset += kDrawIndirectSize;
-                }
+                draw.cmd->indirectOffset =
+                    batch.outputParamsOffset + drawIndex * batch.outputIndirectSize;
             }
         }
     }
@@ -413,9 +439,8 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
     bindGroupDescriptor.entries = bindings;
 
     // Finally, we can now encode our validation and duplication passes. Each pass first does a
-    // two WriteBuffer to get batch and pass data over to the GPU, followed by a single compute
-    // pass. The compute pass encodes a separate SetBindGroup and Dispatch command for each
-    // batch.
+    // WriteBuffer to get the batch data over to the GPU, followed by a single compute pass. The
+    // compute pass encodes a separate SetBindGroup and Dispatch command for each batch.
     for (const Pass& pass : passes) {
         commandEncoder->APIWriteBuffer(batchDataBuffer.GetBuffer(), 0,
                                        static_cast<const uint8_t*>(pass.batchData.get()),
@@ -424,11 +449,10 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
         Ref<ComputePassEncoder> passEncoder = commandEncoder->BeginComputePass();
         passEncoder->APISetPipeline(pipeline);
 
-        inputIndirectBinding.buffer = pass.inputIndirectBuffer;
-
         for (const Batch& batch : pass.batches) {
             bufferDataBinding.offset = batch.dataBufferOffset;
             bufferDataBinding.size = batch.dataSize;
+            inputIndirectBinding.buffer = batch.inputIndirectBuffer;
             inputIndirectBinding.offset = batch.inputIndirectOffset;
             inputIndirectBinding.size = batch.inputIndirectSize;
             outputParamsBinding.offset = batch.outputParamsOffset;
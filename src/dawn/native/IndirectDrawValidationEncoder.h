@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_NATIVE_INDIRECTDRAWVALIDATIONENCODER_H_
 #define SRC_DAWN_NATIVE_INDIRECTDRAWVALIDATIONENCODER_H_
 
+#include <vector>
+
 #include "dawn/native/Error.h"
 #include "dawn/native/IndirectDrawMetadata.h"
 
@@ -30,10 +32,18 @@ class RenderPassResourceUsageTracker;
 // allowed storage binding size (with the base limits, it is about 6.7M).
 uint32_t ComputeMaxDrawCallsPerIndirectValidationBatch(const CombinedLimits& limits);
 
-MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
-                                                CommandEncoder* commandEncoder,
-                                                RenderPassResourceUsageTracker* usageTracker,
-                                                IndirectDrawMetadata* indirectDrawMetadata);
+// The maximum number of draw calls of consecutive render passes that are validated together.
+// It bounds the size of the scratch buffer holding the validated indirect parameters.
+uint64_t ComputeMaxDrawCallsPerIndirectValidationGroup(const CombinedLimits& limits);
+
+// Encodes the validation of the draw calls in |indirectDrawMetadata| and updates their commands
+// to use the validated parameters. |usageTrackers| are the trackers of the render passes that
+// contain the draw calls, which are all encoded after the validation commands.
+MaybeError EncodeIndirectDrawValidationCommands(
+    DeviceBase* device,
+    CommandEncoder* commandEncoder,
+    std::vector<RenderPassResourceUsageTracker>* usageTrackers,
+    IndirectDrawMetadata* indirectDrawMetadata);
 
 }  // namespace dawn::native
 
@@ -29,9 +29,17 @@ bool ErrorMonad::IsError() const {
     return GetRefCountPayload() == kErrorPayload;
 }
 
-ObjectBase::ObjectBase(DeviceBase* device) : ErrorMonad(), mDevice(device) {}
+ObjectBase::ObjectBase(DeviceBase* device) : ErrorMonad(), mDevice(device) {
+    if (device != nullptr && device->IsToggleEnabled(Toggle::SingleThreadedDevice)) {
+        SetRefCountSingleThreaded();
+    }
+}
 
-ObjectBase::ObjectBase(DeviceBase* device, ErrorTag) : ErrorMonad(kError), mDevice(device) {}
+ObjectBase::ObjectBase(DeviceBase* device, ErrorTag) : ErrorMonad(kError), mDevice(device) {
+    if (device != nullptr && device->IsToggleEnabled(Toggle::SingleThreadedDevice)) {
+        SetRefCountSingleThreaded();
+    }
+}
 
 DeviceBase* ObjectBase::GetDevice() const {
     return mDevice.Get();
@@ -73,11 +81,20 @@ void ApiObjectBase::DeleteThis() {
 
 void ApiObjectBase::TrackInDevice() {
     ASSERT(GetDevice() != nullptr);
-    GetDevice()->TrackObject(this);
+    mObjectListSegment = GetDevice()->TrackObject(this);
 }
 
 void ApiObjectBase::Destroy() {
-    const std::lock_guard<std::mutex> lock(*GetDevice()->GetObjectListMutex(GetType()));
+    // Objects that were never tracked are not in any list and have nothing to destroy.
+    if (mObjectListSegment == kUntrackedSegment) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(
+        *GetDevice()->GetObjectListMutex(GetType(), mObjectListSegment), std::defer_lock);
+    if (!GetDevice()->IsToggleEnabled(Toggle::SingleThreadedDevice)) {
+        lock.lock();
+    }
     if (RemoveFromList()) {
         DestroyImpl();
     }
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_OBJECTBASE_H_
 #define SRC_DAWN_NATIVE_OBJECTBASE_H_
 
+#include <cstdint>
 #include <string>
 
 #include "dawn/common/LinkedList.h"
@@ -97,6 +98,11 @@ class ApiObjectBase : public ObjectBase, public LinkNode<ApiObjectBase> {
     virtual void SetLabelImpl();
 
     std::string mLabel;
+
+    // The segment of the device's object list that tracks this object, see
+    // DeviceBase::TrackObject.
+    static constexpr uint32_t kUntrackedSegment = ~uint32_t(0);
+    uint32_t mObjectListSegment = kUntrackedSegment;
 };
 
 }  // namespace dawn::native
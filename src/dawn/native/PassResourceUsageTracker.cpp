@@ -35,11 +35,21 @@ SyncScopeUsageTracker::~SyncScopeUsageTracker() = default;
 SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&&) = default;
 
 void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
+    // Usages of suballocated buffers are tracked on their backing buffer.
+    ASSERT(!buffer->IsSuballocated());
     // std::map's operator[] will create the key and return 0 if the key didn't exist
     // before.
     mBufferUsages[buffer] |= usage;
 }
 
+wgpu::BufferUsage SyncScopeUsageTracker::GetBufferUsage(BufferBase* buffer) const {
+    auto it = mBufferUsages.find(buffer);
+    if (it == mBufferUsages.end()) {
+        return wgpu::BufferUsage::None;
+    }
+    return it->second;
+}
+
 void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::TextureUsage usage) {
     TextureBase* texture = view->GetTexture();
     const SubresourceRange& range = view->GetSubresourceRange();
@@ -182,6 +192,7 @@ void ComputePassResourceUsageTracker::AddDispatch(SyncScopeResourceUsage scope)
 }
 
 void ComputePassResourceUsageTracker::AddReferencedBuffer(BufferBase* buffer) {
+    ASSERT(!buffer->IsSuballocated());
     mUsage.referencedBuffers.insert(buffer);
 }
 
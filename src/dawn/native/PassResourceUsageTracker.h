@@ -43,6 +43,8 @@ class SyncScopeUsageTracker {
     SyncScopeUsageTracker& operator=(SyncScopeUsageTracker&&);
 
     void BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage);
+    // Returns the combined usages of |buffer| tracked so far, or None if it is not used.
+    wgpu::BufferUsage GetBufferUsage(BufferBase* buffer) const;
     void TextureViewUsedAs(TextureViewBase* texture, wgpu::TextureUsage usage);
     void AddRenderBundleTextureUsage(TextureBase* texture,
                                      const TextureSubresourceUsage& textureUsage);
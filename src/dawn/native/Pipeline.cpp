@@ -194,6 +194,19 @@ wgpu::ShaderStage PipelineBase::GetStageMask() const {
     return mStageMask;
 }
 
+void PipelineBase::SetAsyncCreationOptions(int32_t priority, uint64_t cancellationGroup) {
+    mAsyncCreationPriority = priority;
+    mAsyncCreationCancellationGroup = cancellationGroup;
+}
+
+int32_t PipelineBase::GetAsyncCreationPriority() const {
+    return mAsyncCreationPriority;
+}
+
+uint64_t PipelineBase::GetAsyncCreationCancellationGroup() const {
+    return mAsyncCreationCancellationGroup;
+}
+
 MaybeError PipelineBase::ValidateGetBindGroupLayout(uint32_t groupIndex) {
     DAWN_TRY(GetDevice()->ValidateIsAlive());
     DAWN_TRY(GetDevice()->ValidateObject(this));
@@ -209,7 +222,7 @@ ResultOrError<Ref<BindGroupLayoutBase>> PipelineBase::GetBindGroupLayout(uint32_
 
     BindGroupIndex groupIndex(groupIndexIn);
     if (!mLayout->GetBindGroupLayoutsMask()[groupIndex]) {
-        return Ref<BindGroupLayoutBase>(GetDevice()->GetEmptyBindGroupLayout());
+        return GetDevice()->GetOrCreateEmptyBindGroupLayout();
     } else {
         return Ref<BindGroupLayoutBase>(mLayout->GetBindGroupLayout(groupIndex));
     }
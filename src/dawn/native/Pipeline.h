@@ -76,6 +76,12 @@ class PipelineBase : public ApiObjectBase, public CachedObject {
     // Initialize() should only be called once by the frontend.
     virtual MaybeError Initialize() = 0;
 
+    // The priority and cancellation group of the asynchronous creation of the pipeline, from the
+    // DawnAsyncPipelineCreationOptions chained in its descriptor.
+    void SetAsyncCreationOptions(int32_t priority, uint64_t cancellationGroup);
+    int32_t GetAsyncCreationPriority() const;
+    uint64_t GetAsyncCreationCancellationGroup() const;
+
   protected:
     PipelineBase(DeviceBase* device,
                  PipelineLayoutBase* layout,
@@ -94,6 +100,9 @@ class PipelineBase : public ApiObjectBase, public CachedObject {
 
     Ref<PipelineLayoutBase> mLayout;
     RequiredBufferSizes mMinBufferSizes;
+
+    int32_t mAsyncCreationPriority = 0;
+    uint64_t mAsyncCreationCancellationGroup = 0;
 };
 
 }  // namespace dawn::native
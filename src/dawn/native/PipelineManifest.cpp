@@ -0,0 +1,743 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/PipelineManifest.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "dawn/common/BitSetIterator.h"
+#include "dawn/common/HashUtils.h"
+#include "dawn/native/BindGroupLayout.h"
+#include "dawn/native/CacheKey.h"
+#include "dawn/native/ComputePipeline.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/ObjectType_autogen.h"
+#include "dawn/native/PipelineLayout.h"
+#include "dawn/native/RenderPipeline.h"
+#include "dawn/native/Serializable.h"
+#include "dawn/native/ShaderModule.h"
+
+namespace dawn::native {
+
+#define RECORDED_SHADER_MODULE_MEMBERS(X) \
+    X(std::string, wgsl)                  \
+    X(std::vector<uint32_t>, spirv)
+DAWN_SERIALIZABLE(struct, RecordedShaderModule, RECORDED_SHADER_MODULE_MEMBERS){};
+#undef RECORDED_SHADER_MODULE_MEMBERS
+
+using RecordedConstants = std::vector<std::pair<std::string, double>>;
+
+#define RECORDED_STAGE_MEMBERS(X) \
+    X(SingleShaderStage, stage)   \
+    X(uint64_t, moduleHash)       \
+    X(std::string, entryPoint)    \
+    X(RecordedConstants, constants)
+DAWN_SERIALIZABLE(struct, RecordedStage, RECORDED_STAGE_MEMBERS){};
+#undef RECORDED_STAGE_MEMBERS
+
+// Only the members for the layout of |bindingType| are used, the others are left to their default
+// values.
+#define RECORDED_BINDING_MEMBERS(X)                     \
+    X(uint32_t, binding)                                \
+    X(wgpu::ShaderStage, visibility)                    \
+    X(BindingInfoType, bindingType)                     \
+    X(wgpu::BufferBindingType, bufferType)              \
+    X(bool, hasDynamicOffset)                           \
+    X(uint64_t, minBindingSize)                         \
+    X(wgpu::SamplerBindingType, samplerType)            \
+    X(wgpu::TextureSampleType, textureSampleType)       \
+    X(wgpu::TextureViewDimension, viewDimension)        \
+    X(bool, multisampled)                               \
+    X(wgpu::StorageTextureAccess, storageTextureAccess) \
+    X(wgpu::TextureFormat, storageTextureFormat)
+DAWN_SERIALIZABLE(struct, RecordedBinding, RECORDED_BINDING_MEMBERS){};
+#undef RECORDED_BINDING_MEMBERS
+
+#define RECORDED_VERTEX_ATTRIBUTE_MEMBERS(X) \
+    X(wgpu::VertexFormat, format)            \
+    X(uint64_t, offset)                      \
+    X(uint32_t, shaderLocation)
+DAWN_SERIALIZABLE(struct, RecordedVertexAttribute, RECORDED_VERTEX_ATTRIBUTE_MEMBERS){};
+#undef RECORDED_VERTEX_ATTRIBUTE_MEMBERS
+
+#define RECORDED_VERTEX_BUFFER_MEMBERS(X) \
+    X(uint64_t, arrayStride)              \
+    X(wgpu::VertexStepMode, stepMode)     \
+    X(std::vector<RecordedVertexAttribute>, attributes)
+DAWN_SERIALIZABLE(struct, RecordedVertexBuffer, RECORDED_VERTEX_BUFFER_MEMBERS){};
+#undef RECORDED_VERTEX_BUFFER_MEMBERS
+
+#define RECORDED_STENCIL_FACE_MEMBERS(X)   \
+    X(wgpu::CompareFunction, compare)      \
+    X(wgpu::StencilOperation, failOp)      \
+    X(wgpu::StencilOperation, depthFailOp) \
+    X(wgpu::StencilOperation, passOp)
+DAWN_SERIALIZABLE(struct, RecordedStencilFace, RECORDED_STENCIL_FACE_MEMBERS){};
+#undef RECORDED_STENCIL_FACE_MEMBERS
+
+#define RECORDED_BLEND_COMPONENT_MEMBERS(X) \
+    X(wgpu::BlendOperation, operation)      \
+    X(wgpu::BlendFactor, srcFactor)         \
+    X(wgpu::BlendFactor, dstFactor)
+DAWN_SERIALIZABLE(struct, RecordedBlendComponent, RECORDED_BLEND_COMPONENT_MEMBERS){};
+#undef RECORDED_BLEND_COMPONENT_MEMBERS
+
+// Targets with an undefined format are the holes in the sparse color attachments.
+#define RECORDED_COLOR_TARGET_MEMBERS(X) \
+    X(wgpu::TextureFormat, format)       \
+    X(bool, hasBlend)                    \
+    X(RecordedBlendComponent, color)     \
+    X(RecordedBlendComponent, alpha)     \
+    X(wgpu::ColorWriteMask, writeMask)
+DAWN_SERIALIZABLE(struct, RecordedColorTarget, RECORDED_COLOR_TARGET_MEMBERS){};
+#undef RECORDED_COLOR_TARGET_MEMBERS
+
+// The members after |stages| are only used for render pipelines. The depth-stencil members are
+// only used if |depthStencilFormat| isn't undefined.
+#define RECORDED_PIPELINE_MEMBERS(X)                               \
+    X(ObjectType, type)                                            \
+    X(std::vector<std::vector<RecordedBinding>>, bindGroupLayouts) \
+    X(std::vector<RecordedStage>, stages)                          \
+    X(std::vector<RecordedVertexBuffer>, vertexBuffers)            \
+    X(wgpu::PrimitiveTopology, topology)                           \
+    X(wgpu::IndexFormat, stripIndexFormat)                         \
+    X(wgpu::FrontFace, frontFace)                                  \
+    X(wgpu::CullMode, cullMode)                                    \
+    X(bool, unclippedDepth)                                        \
+    X(wgpu::TextureFormat, depthStencilFormat)                     \
+    X(bool, depthWriteEnabled)                                     \
+    X(wgpu::CompareFunction, depthCompare)                         \
+    X(RecordedStencilFace, stencilFront)                           \
+    X(RecordedStencilFace, stencilBack)                            \
+    X(uint32_t, stencilReadMask)                                   \
+    X(uint32_t, stencilWriteMask)                                  \
+    X(int32_t, depthBias)                                          \
+    X(float, depthBiasSlopeScale)                                  \
+    X(float, depthBiasClamp)                                       \
+    X(uint32_t, sampleCount)                                       \
+    X(uint32_t, sampleMask)                                        \
+    X(bool, alphaToCoverageEnabled)                                \
+    X(std::vector<RecordedColorTarget>, colorTargets)
+DAWN_SERIALIZABLE(struct, RecordedPipeline, RECORDED_PIPELINE_MEMBERS){};
+#undef RECORDED_PIPELINE_MEMBERS
+
+namespace {
+
+using ShaderModuleMap = std::unordered_map<uint64_t, Ref<ShaderModuleBase>>;
+
+CacheKey GetManifestCacheKey(DeviceBase* device) {
+    CacheKey key;
+    StreamIn(&key, CacheKey::Type::PipelineManifest, device->GetCacheKey());
+    return key;
+}
+
+CacheKey GetShaderSourceCacheKey(DeviceBase* device, uint64_t moduleHash) {
+    CacheKey key;
+    StreamIn(&key, CacheKey::Type::ShaderSource, device->GetCacheKey(), moduleHash);
+    return key;
+}
+
+uint64_t HashSerialized(const stream::ByteVectorSink& sink) {
+    return HashBytes(sink.data(), sink.size());
+}
+
+RecordedBinding RecordBinding(const BindingInfo& info) {
+    RecordedBinding binding;
+    binding.binding = static_cast<uint32_t>(info.binding);
+    binding.visibility = info.visibility;
+    binding.bindingType = info.bindingType;
+    switch (info.bindingType) {
+        case BindingInfoType::Buffer:
+            binding.bufferType = info.buffer.type;
+            binding.hasDynamicOffset = info.buffer.hasDynamicOffset;
+            binding.minBindingSize = info.buffer.minBindingSize;
+            break;
+        case BindingInfoType::Sampler:
+            binding.samplerType = info.sampler.type;
+            break;
+        case BindingInfoType::Texture:
+            binding.textureSampleType = info.texture.sampleType;
+            binding.viewDimension = info.texture.viewDimension;
+            binding.multisampled = info.texture.multisampled;
+            break;
+        case BindingInfoType::StorageTexture:
+            binding.storageTextureAccess = info.storageTexture.access;
+            binding.storageTextureFormat = info.storageTexture.format;
+            binding.viewDimension = info.storageTexture.viewDimension;
+            break;
+        case BindingInfoType::ExternalTexture:
+            UNREACHABLE();
+    }
+    return binding;
+}
+
+BindGroupLayoutEntry ToBindGroupLayoutEntry(const RecordedBinding& binding) {
+    BindGroupLayoutEntry entry;
+    entry.binding = binding.binding;
+    entry.visibility = binding.visibility;
+    switch (binding.bindingType) {
+        case BindingInfoType::Buffer:
+            entry.buffer.type = binding.bufferType;
+            entry.buffer.hasDynamicOffset = binding.hasDynamicOffset;
+            entry.buffer.minBindingSize = binding.minBindingSize;
+            break;
+        case BindingInfoType::Sampler:
+            entry.sampler.type = binding.samplerType;
+            break;
+        case BindingInfoType::Texture:
+            entry.texture.sampleType = binding.textureSampleType;
+            entry.texture.viewDimension = binding.viewDimension;
+            entry.texture.multisampled = binding.multisampled;
+            break;
+        case BindingInfoType::StorageTexture:
+            entry.storageTexture.access = binding.storageTextureAccess;
+            entry.storageTexture.format = binding.storageTextureFormat;
+            entry.storageTexture.viewDimension = binding.viewDimension;
+            break;
+        case BindingInfoType::ExternalTexture:
+            // Left as an entry without any binding type, which fails validation.
+            break;
+    }
+    return entry;
+}
+
+// Returns false if the layout can't be recorded.
+bool RecordLayout(const PipelineLayoutBase* layout, RecordedPipeline* pipeline) {
+    const BindGroupLayoutMask& mask = layout->GetBindGroupLayoutsMask();
+    for (BindGroupIndex group : IterateBitSet(mask)) {
+        const BindGroupLayoutBase* bgl = layout->GetBindGroupLayout(group);
+        if (bgl->GetExternalTextureBindingCount() > 0) {
+            return false;
+        }
+        // The bind group layouts of default pipeline layouts are the only ones with a pipeline
+        // compatibility token. A prewarmed pipeline with a default layout would get a new token,
+        // so it would never match the application's pipeline in the frontend cache.
+        if (bgl->GetPipelineCompatibilityToken() != PipelineCompatibilityToken(0)) {
+            return false;
+        }
+    }
+
+    pipeline->bindGroupLayouts.resize(static_cast<uint32_t>(GetHighestBitIndexPlusOne(mask)));
+    for (BindGroupIndex group : IterateBitSet(mask)) {
+        const BindGroupLayoutBase* bgl = layout->GetBindGroupLayout(group);
+        std::vector<RecordedBinding>& bindings =
+            pipeline->bindGroupLayouts[static_cast<uint32_t>(group)];
+        for (BindingIndex i{0}; i < bgl->GetBindingCount(); ++i) {
+            bindings.push_back(RecordBinding(bgl->GetBindingInfo(i)));
+        }
+    }
+    return true;
+}
+
+// Returns false if the module can't be recorded because it wasn't created from WGSL or SPIR-V.
+bool RecordShaderModule(const ShaderModuleBase* module,
+                        stream::ByteVectorSink* serializedModule,
+                        uint64_t* moduleHash) {
+    RecordedShaderModule recordedModule;
+    recordedModule.wgsl = module->GetOriginalWGSL();
+    recordedModule.spirv = module->GetOriginalSpirv();
+    if (recordedModule.wgsl.empty() && recordedModule.spirv.empty()) {
+        return false;
+    }
+    StreamIn(serializedModule, recordedModule);
+    *moduleHash = HashSerialized(*serializedModule);
+    return true;
+}
+
+ResultOrError<Ref<ShaderModuleBase>> GetOrLoadShaderModule(DeviceBase* device,
+                                                           uint64_t moduleHash,
+                                                           ShaderModuleMap* modules) {
+    auto it = modules->find(moduleHash);
+    if (it != modules->end()) {
+        return Ref<ShaderModuleBase>(it->second);
+    }
+
+    Blob blob = device->LoadCachedBlob(GetShaderSourceCacheKey(device, moduleHash));
+    DAWN_INVALID_IF(blob.Empty(), "The source of shader module %u is not in the BlobCache.",
+                    moduleHash);
+    DAWN_INVALID_IF(HashBytes(blob.Data(), blob.Size()) != moduleHash,
+                    "The source of shader module %u in the BlobCache has a different hash.",
+                    moduleHash);
+
+    RecordedShaderModule recordedModule;
+    DAWN_TRY_ASSIGN(recordedModule, RecordedShaderModule::FromBlob(std::move(blob)));
+
+    ShaderModuleWGSLDescriptor wgslDesc;
+    wgslDesc.source = recordedModule.wgsl.c_str();
+    ShaderModuleSPIRVDescriptor spirvDesc;
+    spirvDesc.codeSize = static_cast<uint32_t>(recordedModule.spirv.size());
+    spirvDesc.code = recordedModule.spirv.data();
+
+    ShaderModuleDescriptor desc;
+    if (recordedModule.spirv.empty()) {
+        desc.nextInChain = &wgslDesc;
+    } else {
+        desc.nextInChain = &spirvDesc;
+    }
+
+    Ref<ShaderModuleBase> module;
+    DAWN_TRY_ASSIGN(module, device->CreateShaderModule(&desc));
+    modules->emplace(moduleHash, module);
+    return module;
+}
+
+ResultOrError<Ref<PipelineLayoutBase>> CreateLayout(DeviceBase* device,
+                                                    const RecordedPipeline& pipeline) {
+    std::vector<Ref<BindGroupLayoutBase>> bgls;
+    std::vector<BindGroupLayoutBase*> bglPtrs;
+    for (const std::vector<RecordedBinding>& bindings : pipeline.bindGroupLayouts) {
+        std::vector<BindGroupLayoutEntry> entries;
+        for (const RecordedBinding& binding : bindings) {
+            entries.push_back(ToBindGroupLayoutEntry(binding));
+        }
+
+        BindGroupLayoutDescriptor bglDesc;
+        bglDesc.entryCount = static_cast<uint32_t>(entries.size());
+        bglDesc.entries = entries.data();
+
+        Ref<BindGroupLayoutBase> bgl;
+        DAWN_TRY_ASSIGN(bgl, device->CreateBindGroupLayout(&bglDesc));
+        bglPtrs.push_back(bgl.Get());
+        bgls.push_back(std::move(bgl));
+    }
+
+    PipelineLayoutDescriptor desc;
+    desc.bindGroupLayoutCount = static_cast<uint32_t>(bglPtrs.size());
+    desc.bindGroupLayouts = bglPtrs.data();
+    return device->CreatePipelineLayout(&desc);
+}
+
+// The storage for the members of a ProgrammableStageDescriptor, VertexState or FragmentState
+// that are pointers.
+struct StageStorage {
+    Ref<ShaderModuleBase> module;
+    std::vector<ConstantEntry> constants;
+};
+
+MaybeError LoadStage(DeviceBase* device,
+                     const RecordedStage& stage,
+                     ShaderModuleMap* modules,
+                     StageStorage* storage) {
+    DAWN_TRY_ASSIGN(storage->module, GetOrLoadShaderModule(device, stage.moduleHash, modules));
+    for (const auto& [key, value] : stage.constants) {
+        ConstantEntry entry;
+        entry.key = key.c_str();
+        entry.value = value;
+        storage->constants.push_back(entry);
+    }
+    return {};
+}
+
+void OnComputePipelinePrewarmed(WGPUCreatePipelineAsyncStatus status,
+                                WGPUComputePipeline pipeline,
+                                const char* message,
+                                void* userdata) {
+    static_cast<DeviceBase*>(userdata)->AddPrewarmedPipeline(AcquireRef(FromAPI(pipeline)));
+}
+
+void OnRenderPipelinePrewarmed(WGPUCreatePipelineAsyncStatus status,
+                               WGPURenderPipeline pipeline,
+                               const char* message,
+                               void* userdata) {
+    static_cast<DeviceBase*>(userdata)->AddPrewarmedPipeline(AcquireRef(FromAPI(pipeline)));
+}
+
+MaybeError PrewarmComputePipeline(DeviceBase* device,
+                                  const RecordedPipeline& pipeline,
+                                  ShaderModuleMap* modules) {
+    DAWN_INVALID_IF(pipeline.stages.size() != 1 ||
+                        pipeline.stages[0].stage != SingleShaderStage::Compute,
+                    "The recorded compute pipeline doesn't have a single compute stage.");
+
+    Ref<PipelineLayoutBase> layout;
+    DAWN_TRY_ASSIGN(layout, CreateLayout(device, pipeline));
+    StageStorage compute;
+    DAWN_TRY(LoadStage(device, pipeline.stages[0], modules, &compute));
+
+    ComputePipelineDescriptor desc;
+    desc.layout = layout.Get();
+    desc.compute.module = compute.module.Get();
+    desc.compute.entryPoint = pipeline.stages[0].entryPoint.c_str();
+    desc.compute.constantCount = compute.constants.size();
+    desc.compute.constants = compute.constants.data();
+
+    // The callback is called immediately if the pipeline is already in the frontend cache.
+    device->AddPendingPipelinePrewarm();
+    MaybeError maybeError =
+        device->CreateComputePipelineAsync(&desc, OnComputePipelinePrewarmed, device);
+    if (maybeError.IsError()) {
+        device->AddPrewarmedPipeline(nullptr);
+    }
+    return maybeError;
+}
+
+MaybeError PrewarmRenderPipeline(DeviceBase* device,
+                                 const RecordedPipeline& pipeline,
+                                 ShaderModuleMap* modules) {
+    Ref<PipelineLayoutBase> layout;
+    DAWN_TRY_ASSIGN(layout, CreateLayout(device, pipeline));
+
+    RenderPipelineDescriptor desc;
+    desc.layout = layout.Get();
+
+    StageStorage vertex;
+    StageStorage fragment;
+    FragmentState fragmentState;
+    for (const RecordedStage& stage : pipeline.stages) {
+        switch (stage.stage) {
+            case SingleShaderStage::Vertex:
+                DAWN_TRY(LoadStage(device, stage, modules, &vertex));
+                desc.vertex.module = vertex.module.Get();
+                desc.vertex.entryPoint = stage.entryPoint.c_str();
+                desc.vertex.constantCount = vertex.constants.size();
+                desc.vertex.constants = vertex.constants.data();
+                break;
+            case SingleShaderStage::Fragment:
+                DAWN_TRY(LoadStage(device, stage, modules, &fragment));
+                fragmentState.module = fragment.module.Get();
+                fragmentState.entryPoint = stage.entryPoint.c_str();
+                fragmentState.constantCount = fragment.constants.size();
+                fragmentState.constants = fragment.constants.data();
+                desc.fragment = &fragmentState;
+                break;
+            default:
+                return DAWN_VALIDATION_ERROR("The recorded render pipeline has a compute stage.");
+        }
+    }
+
+    std::vector<std::vector<VertexAttribute>> attributes;
+    std::vector<VertexBufferLayout> buffers;
+    for (const RecordedVertexBuffer& recordedBuffer : pipeline.vertexBuffers) {
+        std::vector<VertexAttribute>& bufferAttributes = attributes.emplace_back();
+        for (const RecordedVertexAttribute& recordedAttribute : recordedBuffer.attributes) {
+            VertexAttribute attribute;
+            attribute.format = recordedAttribute.format;
+            attribute.offset = recordedAttribute.offset;
+            attribute.shaderLocation = recordedAttribute.shaderLocation;
+            bufferAttributes.push_back(attribute);
+        }
+
+        VertexBufferLayout buffer;
+        buffer.arrayStride = recordedBuffer.arrayStride;
+        buffer.stepMode = recordedBuffer.stepMode;
+        buffer.attributeCount = bufferAttributes.size();
+        buffer.attributes = bufferAttributes.data();
+        buffers.push_back(buffer);
+    }
+    desc.vertex.bufferCount = buffers.size();
+    desc.vertex.buffers = buffers.data();
+
+    PrimitiveDepthClipControl depthClipControl;
+    desc.primitive.topology = pipeline.topology;
+    desc.primitive.stripIndexFormat = pipeline.stripIndexFormat;
+    desc.primitive.frontFace = pipeline.frontFace;
+    desc.primitive.cullMode = pipeline.cullMode;
+    if (pipeline.unclippedDepth) {
+        depthClipControl.unclippedDepth = true;
+        desc.primitive.nextInChain = &depthClipControl;
+    }
+
+    DepthStencilState depthStencil;
+    if (pipeline.depthStencilFormat != wgpu::TextureFormat::Undefined) {
+        depthStencil.format = pipeline.depthStencilFormat;
+        depthStencil.depthWriteEnabled = pipeline.depthWriteEnabled;
+        depthStencil.depthCompare = pipeline.depthCompare;
+        for (auto [face, recordedFace] :
+             {std::make_pair(&depthStencil.stencilFront, &pipeline.stencilFront),
+              std::make_pair(&depthStencil.stencilBack, &pipeline.stencilBack)}) {
+            face->compare = recordedFace->compare;
+            face->failOp = recordedFace->failOp;
+            face->depthFailOp = recordedFace->depthFailOp;
+            face->passOp = recordedFace->passOp;
+        }
+        depthStencil.stencilReadMask = pipeline.stencilReadMask;
+        depthStencil.stencilWriteMask = pipeline.stencilWriteMask;
+        depthStencil.depthBias = pipeline.depthBias;
+        depthStencil.depthBiasSlopeScale = pipeline.depthBiasSlopeScale;
+        depthStencil.depthBiasClamp = pipeline.depthBiasClamp;
+        desc.depthStencil = &depthStencil;
+    }
+
+    desc.multisample.count = pipeline.sampleCount;
+    desc.multisample.mask = pipeline.sampleMask;
+    desc.multisample.alphaToCoverageEnabled = pipeline.alphaToCoverageEnabled;
+
+    std::vector<BlendState> blends(pipeline.colorTargets.size());
+    std::vector<ColorTargetState> targets(pipeline.colorTargets.size());
+    for (size_t i = 0; i < pipeline.colorTargets.size(); ++i) {
+        const RecordedColorTarget& recordedTarget = pipeline.colorTargets[i];
+        targets[i].format = recordedTarget.format;
+        targets[i].writeMask = recordedTarget.writeMask;
+        if (recordedTarget.hasBlend) {
+            for (auto [component, recordedComponent] :
+                 {std::make_pair(&blends[i].color, &recordedTarget.color),
+                  std::make_pair(&blends[i].alpha, &recordedTarget.alpha)}) {
+                component->operation = recordedComponent->operation;
+                component->srcFactor = recordedComponent->srcFactor;
+                component->dstFactor = recordedComponent->dstFactor;
+            }
+            targets[i].blend = &blends[i];
+        }
+    }
+    DAWN_INVALID_IF(desc.fragment == nullptr && !targets.empty(),
+                    "The recorded render pipeline has color targets but no fragment stage.");
+    fragmentState.targetCount = targets.size();
+    fragmentState.targets = targets.data();
+
+    // The callback is called immediately if the pipeline is already in the frontend cache.
+    device->AddPendingPipelinePrewarm();
+    MaybeError maybeError =
+        device->CreateRenderPipelineAsync(&desc, OnRenderPipelinePrewarmed, device);
+    if (maybeError.IsError()) {
+        device->AddPrewarmedPipeline(nullptr);
+    }
+    return maybeError;
+}
+
+}  // anonymous namespace
+
+PipelineManifest::PipelineManifest() = default;
+
+PipelineManifest::~PipelineManifest() = default;
+
+MaybeError PipelineManifest::Load(DeviceBase* device) {
+    Blob blob = device->LoadCachedBlob(GetManifestCacheKey(device));
+    if (blob.Empty()) {
+        return {};
+    }
+
+    std::vector<RecordedPipeline> pipelines;
+    stream::BlobSource source(std::move(blob));
+    DAWN_TRY(StreamOut(&source, &pipelines));
+
+    for (RecordedPipeline& pipeline : pipelines) {
+        AddPipeline(std::move(pipeline));
+    }
+
+    // The loaded pipelines were already stored.
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDirty = false;
+    return {};
+}
+
+void PipelineManifest::RecordComputePipeline(DeviceBase* device,
+                                             const ComputePipelineBase* pipeline) {
+    RecordedPipeline recorded;
+    recorded.type = ObjectType::ComputePipeline;
+    if (!RecordLayout(pipeline->GetLayout(), &recorded)) {
+        return;
+    }
+
+    const ProgrammableStage& stage = pipeline->GetStage(SingleShaderStage::Compute);
+    stream::ByteVectorSink serializedModule;
+    RecordedStage& recordedStage = recorded.stages.emplace_back();
+    if (!RecordShaderModule(stage.module.Get(), &serializedModule, &recordedStage.moduleHash)) {
+        return;
+    }
+    recordedStage.stage = SingleShaderStage::Compute;
+    recordedStage.entryPoint = stage.entryPoint;
+    recordedStage.constants.assign(stage.constants.begin(), stage.constants.end());
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mStoredModuleHashes.insert(recordedStage.moduleHash).second) {
+            device->StoreCachedBlob(GetShaderSourceCacheKey(device, recordedStage.moduleHash),
+                                    CreateBlob(std::move(serializedModule)));
+        }
+    }
+    AddPipeline(std::move(recorded));
+}
+
+void PipelineManifest::RecordRenderPipeline(DeviceBase* device,
+                                            const RenderPipelineBase* pipeline) {
+    RecordedPipeline recorded;
+    recorded.type = ObjectType::RenderPipeline;
+    if (!RecordLayout(pipeline->GetLayout(), &recorded)) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, stream::ByteVectorSink>> modules;
+    for (SingleShaderStage stage : IterateStages(pipeline->GetStageMask())) {
+        const ProgrammableStage& programmableStage = pipeline->GetStage(stage);
+        auto& [moduleHash, serializedModule] = modules.emplace_back();
+        if (!RecordShaderModule(programmableStage.module.Get(), &serializedModule, &moduleHash)) {
+            return;
+        }
+
+        RecordedStage& recordedStage = recorded.stages.emplace_back();
+        recordedStage.stage = stage;
+        recordedStage.moduleHash = moduleHash;
+        recordedStage.entryPoint = programmableStage.entryPoint;
+        recordedStage.constants.assign(programmableStage.constants.begin(),
+                                       programmableStage.constants.end());
+    }
+
+    // Unused vertex buffer slots have no attributes so they are recorded with
+    // VertexBufferNotUsed.
+    recorded.vertexBuffers.resize(pipeline->GetVertexBufferCount());
+    for (uint32_t slot = 0; slot < pipeline->GetVertexBufferCount(); ++slot) {
+        RecordedVertexBuffer& buffer = recorded.vertexBuffers[slot];
+        VertexBufferSlot typedSlot(static_cast<uint8_t>(slot));
+        if (!pipeline->GetVertexBufferSlotsUsed()[typedSlot]) {
+            buffer.stepMode = wgpu::VertexStepMode::VertexBufferNotUsed;
+            continue;
+        }
+        buffer.arrayStride = pipeline->GetVertexBuffer(typedSlot).arrayStride;
+        buffer.stepMode = pipeline->GetVertexBuffer(typedSlot).stepMode;
+    }
+    for (VertexAttributeLocation location : IterateBitSet(pipeline->GetAttributeLocationsUsed())) {
+        const VertexAttributeInfo& info = pipeline->GetAttribute(location);
+        RecordedVertexAttribute attribute;
+        attribute.format = info.format;
+        attribute.offset = info.offset;
+        attribute.shaderLocation = static_cast<uint8_t>(info.shaderLocation);
+        recorded.vertexBuffers[static_cast<uint8_t>(info.vertexBufferSlot)].attributes.push_back(
+            attribute);
+    }
+
+    recorded.topology = pipeline->GetPrimitiveTopology();
+    recorded.stripIndexFormat = pipeline->GetStripIndexFormat();
+    recorded.frontFace = pipeline->GetFrontFace();
+    recorded.cullMode = pipeline->GetCullMode();
+    recorded.unclippedDepth = pipeline->HasUnclippedDepth();
+
+    if (pipeline->HasDepthStencilAttachment()) {
+        const DepthStencilState* depthStencil = pipeline->GetDepthStencilState();
+        recorded.depthStencilFormat = depthStencil->format;
+        recorded.depthWriteEnabled = depthStencil->depthWriteEnabled;
+        recorded.depthCompare = depthStencil->depthCompare;
+        for (auto [recordedFace, face] :
+             {std::make_pair(&recorded.stencilFront, &depthStencil->stencilFront),
+              std::make_pair(&recorded.stencilBack, &depthStencil->stencilBack)}) {
+            recordedFace->compare = face->compare;
+            recordedFace->failOp = face->failOp;
+            recordedFace->depthFailOp = face->depthFailOp;
+            recordedFace->passOp = face->passOp;
+        }
+        recorded.stencilReadMask = depthStencil->stencilReadMask;
+        recorded.stencilWriteMask = depthStencil->stencilWriteMask;
+        recorded.depthBias = depthStencil->depthBias;
+        recorded.depthBiasSlopeScale = depthStencil->depthBiasSlopeScale;
+        recorded.depthBiasClamp = depthStencil->depthBiasClamp;
+    }
+
+    recorded.sampleCount = pipeline->GetSampleCount();
+    recorded.sampleMask = pipeline->GetSampleMask();
+    recorded.alphaToCoverageEnabled = pipeline->IsAlphaToCoverageEnabled();
+
+    const auto& colorAttachmentsMask = pipeline->GetColorAttachmentsMask();
+    recorded.colorTargets.resize(
+        static_cast<uint8_t>(GetHighestBitIndexPlusOne(colorAttachmentsMask)));
+    for (ColorAttachmentIndex i : IterateBitSet(colorAttachmentsMask)) {
+        const ColorTargetState* target = pipeline->GetColorTargetState(i);
+        RecordedColorTarget& recordedTarget = recorded.colorTargets[static_cast<uint8_t>(i)];
+        recordedTarget.format = pipeline->GetColorAttachmentFormat(i);
+        recordedTarget.writeMask = target->writeMask;
+        if (target->blend != nullptr) {
+            recordedTarget.hasBlend = true;
+            for (auto [recordedComponent, component] :
+                 {std::make_pair(&recordedTarget.color, &target->blend->color),
+                  std::make_pair(&recordedTarget.alpha, &target->blend->alpha)}) {
+                recordedComponent->operation = component->operation;
+                recordedComponent->srcFactor = component->srcFactor;
+                recordedComponent->dstFactor = component->dstFactor;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& [moduleHash, serializedModule] : modules) {
+            if (mStoredModuleHashes.insert(moduleHash).second) {
+                device->StoreCachedBlob(GetShaderSourceCacheKey(device, moduleHash),
+                                        CreateBlob(std::move(serializedModule)));
+            }
+        }
+    }
+    AddPipeline(std::move(recorded));
+}
+
+void PipelineManifest::AddPipeline(RecordedPipeline pipeline) {
+    stream::ByteVectorSink serialized;
+    StreamIn(&serialized, pipeline);
+    uint64_t hash = HashSerialized(serialized);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mPipelineHashes.insert(hash).second) {
+        mPipelines.push_back(std::move(pipeline));
+        mDirty = true;
+    }
+}
+
+void PipelineManifest::Flush(DeviceBase* device) {
+    stream::ByteVectorSink serialized;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mDirty) {
+            return;
+        }
+        StreamIn(&serialized, mPipelines);
+        mDirty = false;
+    }
+    device->StoreCachedBlob(GetManifestCacheKey(device), CreateBlob(std::move(serialized)));
+}
+
+size_t PipelineManifest::Prewarm(DeviceBase* device) const {
+    std::vector<RecordedPipeline> pipelines;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        pipelines = mPipelines;
+    }
+
+    ShaderModuleMap modules;
+    size_t startedCount = 0;
+    for (const RecordedPipeline& pipeline : pipelines) {
+        MaybeError maybeError;
+        switch (pipeline.type) {
+            case ObjectType::ComputePipeline:
+                maybeError = PrewarmComputePipeline(device, pipeline, &modules);
+                break;
+            case ObjectType::RenderPipeline:
+                maybeError = PrewarmRenderPipeline(device, pipeline, &modules);
+                break;
+            default:
+                maybeError = DAWN_VALIDATION_ERROR("The recorded pipeline has an invalid type.");
+                break;
+        }
+
+        if (!maybeError.IsError()) {
+            startedCount++;
+            continue;
+        }
+
+        // Validation errors are expected when the manifest was recorded with different features
+        // or limits, or when shader sources were evicted from the BlobCache. The pipeline is
+        // skipped without reporting the error to the application.
+        std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+        if (error->GetType() != InternalErrorType::Validation) {
+            [[maybe_unused]] bool consumed = device->ConsumedError(MaybeError(std::move(error)));
+            break;
+        }
+    }
+    return startedCount;
+}
+
+size_t PipelineManifest::GetPipelineCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPipelines.size();
+}
+
+}  // namespace dawn::native
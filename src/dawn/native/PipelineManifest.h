@@ -0,0 +1,81 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_PIPELINEMANIFEST_H_
+#define SRC_DAWN_NATIVE_PIPELINEMANIFEST_H_
+
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "dawn/native/Error.h"
+#include "dawn/native/Forward.h"
+
+namespace dawn::native {
+
+struct RecordedPipeline;
+
+// A list of descriptions of the pipelines created by a device that is persisted in the BlobCache,
+// so that the pipelines can be created again in parallel when the application starts, before it
+// needs them. The descriptions are flat copies of the pipeline descriptors in which the shader
+// modules are referred to by the hash of their source. The sources are stored in the BlobCache
+// as separate entries so that modules shared by many pipelines are only stored once.
+//
+// Pipelines whose layout contains external textures aren't recorded since their bind group
+// layouts are expanded at creation and can't be converted back to a descriptor. Pipelines with a
+// default layout aren't recorded either: the layout created for a prewarmed pipeline would have a
+// new pipeline compatibility token, so the application's pipeline would never match it in the
+// frontend cache.
+//
+// This class is thread-safe because pipelines may be created asynchronously.
+class PipelineManifest {
+  public:
+    PipelineManifest();
+    ~PipelineManifest();
+
+    // Adds the pipelines of the manifest stored in the device's BlobCache, if any.
+    MaybeError Load(DeviceBase* device);
+
+    // Adds the description of the pipeline if it isn't already in the manifest, and stores the
+    // source of its shader modules in the device's BlobCache if they weren't stored already.
+    void RecordComputePipeline(DeviceBase* device, const ComputePipelineBase* pipeline);
+    void RecordRenderPipeline(DeviceBase* device, const RenderPipelineBase* pipeline);
+
+    // Stores the manifest in the device's BlobCache if pipelines were added since the last call.
+    void Flush(DeviceBase* device);
+
+    // Starts the asynchronous creation of all the pipelines of the manifest. The pipelines are
+    // given to DeviceBase::AddPrewarmedPipeline once created. Pipelines whose shader modules
+    // aren't in the BlobCache anymore, or that fail validation, are skipped. Returns the number
+    // of creations started.
+    size_t Prewarm(DeviceBase* device) const;
+
+    size_t GetPipelineCount() const;
+
+  private:
+    void AddPipeline(RecordedPipeline pipeline);
+
+    // Protects thread safety of access to the members below.
+    mutable std::mutex mMutex;
+    std::vector<RecordedPipeline> mPipelines;
+    // The hashes of the serialized elements of mPipelines, used to skip duplicates.
+    std::unordered_set<uint64_t> mPipelineHashes;
+    // The hashes of the shader modules whose source is already in the BlobCache.
+    std::unordered_set<uint64_t> mStoredModuleHashes;
+    bool mDirty = false;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_PIPELINEMANIFEST_H_
@@ -155,26 +155,28 @@ MaybeError ProgrammableEncoder::ValidateSetBindGroup(BindGroupIndex index,
         BufferBinding bufferBinding = group->GetBindingAsBufferBinding(i);
 
         // During BindGroup creation, validation ensures binding offset + binding size
-        // <= buffer size.
-        ASSERT(bufferBinding.buffer->GetSize() >= bufferBinding.size);
-        ASSERT(bufferBinding.buffer->GetSize() - bufferBinding.size >= bufferBinding.offset);
+        // <= buffer size. The range end is the buffer size, or the end of the view in the backing
+        // buffer for suballocated buffers.
+        ASSERT(bufferBinding.rangeEnd <= bufferBinding.buffer->GetSize());
+        ASSERT(bufferBinding.rangeEnd >= bufferBinding.size);
+        ASSERT(bufferBinding.rangeEnd - bufferBinding.size >= bufferBinding.offset);
 
         if ((dynamicOffsets[i] >
-             bufferBinding.buffer->GetSize() - bufferBinding.offset - bufferBinding.size)) {
+             bufferBinding.rangeEnd - bufferBinding.offset - bufferBinding.size)) {
             DAWN_INVALID_IF(
-                (bufferBinding.buffer->GetSize() - bufferBinding.offset) == bufferBinding.size,
+                (bufferBinding.rangeEnd - bufferBinding.offset) == bufferBinding.size,
                 "Dynamic Offset[%u] (%u) is out of bounds of %s with a size of %u and a bound "
                 "range of (offset: %u, size: %u). The binding goes to the end of the buffer "
                 "even with a dynamic offset of 0. Did you forget to specify "
                 "the binding's size?",
                 static_cast<uint32_t>(i), dynamicOffsets[i], bufferBinding.buffer,
-                bufferBinding.buffer->GetSize(), bufferBinding.offset, bufferBinding.size);
+                bufferBinding.rangeEnd, bufferBinding.offset, bufferBinding.size);
 
             return DAWN_FORMAT_VALIDATION_ERROR(
                 "Dynamic Offset[%u] (%u) is out of bounds of "
                 "%s with a size of %u and a bound range of (offset: %u, size: %u).",
                 static_cast<uint32_t>(i), dynamicOffsets[i], bufferBinding.buffer,
-                bufferBinding.buffer->GetSize(), bufferBinding.offset, bufferBinding.size);
+                bufferBinding.rangeEnd, bufferBinding.offset, bufferBinding.size);
         }
     }
 
@@ -265,7 +265,8 @@ MaybeError QueueBase::WriteBuffer(BufferBase* buffer,
     DAWN_TRY(GetDevice()->ValidateObject(this));
     DAWN_TRY(ValidateWriteBuffer(GetDevice(), buffer, bufferOffset, size));
     DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
-    return WriteBufferImpl(buffer, bufferOffset, data, size);
+    return WriteBufferImpl(buffer->GetBackingBuffer(), bufferOffset + buffer->GetBackingOffset(),
+                           data, size);
 }
 
 MaybeError QueueBase::WriteBufferImpl(BufferBase* buffer,
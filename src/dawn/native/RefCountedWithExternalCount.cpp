@@ -28,4 +28,9 @@ void RefCountedWithExternalCount::APIRelease() {
     RefCounted::APIRelease();
 }
 
+void RefCountedWithExternalCount::SetRefCountSingleThreaded() {
+    mExternalRefCount.SetSingleThreaded();
+    RefCounted::SetRefCountSingleThreaded();
+}
+
 }  // namespace dawn::native
@@ -34,6 +34,10 @@ class RefCountedWithExternalCount : private RefCounted {
     void APIReference();
     void APIRelease();
 
+  protected:
+    // Makes both the internal and the external refcounts non-atomic.
+    void SetRefCountSingleThreaded();
+
   private:
     virtual void WillDropLastExternalRef() = 0;
 
@@ -175,6 +175,10 @@ void RenderEncoderBase::APIDrawIndirect(BufferBase* indirectBuffer, uint64_t ind
                     indirectOffset, indirectBuffer, indirectBuffer->GetSize());
             }
 
+            // Suballocated buffers are replaced with the range of their backing buffer.
+            BufferBase* backingBuffer = indirectBuffer->GetBackingBuffer();
+            uint64_t backingOffset = indirectOffset + indirectBuffer->GetBackingOffset();
+
             DrawIndirectCmd* cmd = allocator->Allocate<DrawIndirectCmd>(Command::DrawIndirect);
 
             bool duplicateBaseVertexInstance =
@@ -188,17 +192,17 @@ void RenderEncoderBase::APIDrawIndirect(BufferBase* indirectBuffer, uint64_t ind
                 // render pass, while the |cmd| pointer is still valid.
                 cmd->indirectBuffer = nullptr;
 
-                mIndirectDrawMetadata.AddIndirectDraw(indirectBuffer, indirectOffset,
+                mIndirectDrawMetadata.AddIndirectDraw(backingBuffer, backingOffset,
                                                       duplicateBaseVertexInstance, cmd);
             } else {
-                cmd->indirectBuffer = indirectBuffer;
-                cmd->indirectOffset = indirectOffset;
+                cmd->indirectBuffer = backingBuffer;
+                cmd->indirectOffset = backingOffset;
             }
 
             // TODO(crbug.com/dawn/1166): Adding the indirectBuffer is needed for correct usage
             // validation, but it will unnecessarily transition to indirectBuffer usage in the
             // backend.
-            mUsageTracker.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
+            mUsageTracker.BufferUsedAs(backingBuffer, wgpu::BufferUsage::Indirect);
 
             mDrawCount++;
 
@@ -227,6 +231,10 @@ void RenderEncoderBase::APIDrawIndexedIndirect(BufferBase* indirectBuffer,
                     indirectOffset, indirectBuffer, indirectBuffer->GetSize());
             }
 
+            // Suballocated buffers are replaced with the range of their backing buffer.
+            BufferBase* backingBuffer = indirectBuffer->GetBackingBuffer();
+            uint64_t backingOffset = indirectOffset + indirectBuffer->GetBackingOffset();
+
             DrawIndexedIndirectCmd* cmd =
                 allocator->Allocate<DrawIndexedIndirectCmd>(Command::DrawIndexedIndirect);
 
@@ -243,16 +251,16 @@ void RenderEncoderBase::APIDrawIndexedIndirect(BufferBase* indirectBuffer,
 
                 mIndirectDrawMetadata.AddIndexedIndirectDraw(
                     mCommandBufferState.GetIndexFormat(), mCommandBufferState.GetIndexBufferSize(),
-                    indirectBuffer, indirectOffset, duplicateBaseVertexInstance, cmd);
+                    backingBuffer, backingOffset, duplicateBaseVertexInstance, cmd);
             } else {
-                cmd->indirectBuffer = indirectBuffer;
-                cmd->indirectOffset = indirectOffset;
+                cmd->indirectBuffer = backingBuffer;
+                cmd->indirectOffset = backingOffset;
             }
 
             // TODO(crbug.com/dawn/1166): Adding the indirectBuffer is needed for correct usage
             // validation, but it will unecessarily transition to indirectBuffer usage in the
             // backend.
-            mUsageTracker.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
+            mUsageTracker.BufferUsedAs(backingBuffer, wgpu::BufferUsage::Indirect);
 
             mDrawCount++;
 
@@ -342,12 +350,12 @@ void RenderEncoderBase::APISetIndexBuffer(BufferBase* buffer,
 
             SetIndexBufferCmd* cmd =
                 allocator->Allocate<SetIndexBufferCmd>(Command::SetIndexBuffer);
-            cmd->buffer = buffer;
+            cmd->buffer = buffer->GetBackingBuffer();
             cmd->format = format;
-            cmd->offset = offset;
+            cmd->offset = offset + buffer->GetBackingOffset();
             cmd->size = size;
 
-            mUsageTracker.BufferUsedAs(buffer, wgpu::BufferUsage::Index);
+            mUsageTracker.BufferUsedAs(cmd->buffer.Get(), wgpu::BufferUsage::Index);
 
             return {};
         },
@@ -400,11 +408,11 @@ void RenderEncoderBase::APISetVertexBuffer(uint32_t slot,
             SetVertexBufferCmd* cmd =
                 allocator->Allocate<SetVertexBufferCmd>(Command::SetVertexBuffer);
             cmd->slot = VertexBufferSlot(static_cast<uint8_t>(slot));
-            cmd->buffer = buffer;
-            cmd->offset = offset;
+            cmd->buffer = buffer->GetBackingBuffer();
+            cmd->offset = offset + buffer->GetBackingOffset();
             cmd->size = size;
 
-            mUsageTracker.BufferUsedAs(buffer, wgpu::BufferUsage::Vertex);
+            mUsageTracker.BufferUsedAs(cmd->buffer.Get(), wgpu::BufferUsage::Vertex);
 
             return {};
         },
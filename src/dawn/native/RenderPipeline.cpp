@@ -430,7 +430,8 @@ bool IsStripPrimitiveTopology(wgpu::PrimitiveTopology primitiveTopology) {
 
 MaybeError ValidateRenderPipelineDescriptor(DeviceBase* device,
                                             const RenderPipelineDescriptor* descriptor) {
-    DAWN_INVALID_IF(descriptor->nextInChain != nullptr, "nextInChain must be nullptr.");
+    DAWN_TRY(ValidateSingleSType(descriptor->nextInChain,
+                                 wgpu::SType::DawnAsyncPipelineCreationOptions));
 
     if (descriptor->layout != nullptr) {
         DAWN_TRY(device->ValidateObject(descriptor->layout));
@@ -477,7 +478,8 @@ std::vector<StageAndDescriptor> GetRenderStagesAndSetPlaceholderShader(
                           descriptor->fragment->constants});
     } else if (device->IsToggleEnabled(Toggle::UsePlaceholderFragmentInVertexOnlyPipeline)) {
         InternalPipelineStore* store = device->GetInternalPipelineStore();
-        // The placeholder fragment shader module should already be initialized
+        // The placeholder fragment shader module is created before the render pipeline is
+        // created, see ValidateLayoutAndGetRenderPipelineDescriptorWithDefaults.
         DAWN_ASSERT(store->placeholderFragmentShader != nullptr);
         ShaderModuleBase* placeholderFragmentShader = store->placeholderFragmentShader.Get();
         stages.push_back(
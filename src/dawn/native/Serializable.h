@@ -18,8 +18,10 @@
 #include <utility>
 
 #include "dawn/native/VisitableMembers.h"
+#include "dawn/native/stream/BlobSink.h"
 #include "dawn/native/stream/BlobSource.h"
 #include "dawn/native/stream/ByteVectorSink.h"
+#include "dawn/native/stream/SizeCountingSink.h"
 #include "dawn/native/stream/Stream.h"
 
 namespace dawn::native {
@@ -44,10 +46,15 @@ class Serializable {
         return out;
     }
 
+    // Measures the serialized size first so that the data is written directly in a blob of the
+    // right size instead of being copied out of a growing vector.
     Blob ToBlob() const {
-        stream::ByteVectorSink sink;
-        StreamIn(&sink, static_cast<const Derived&>(*this));
-        return CreateBlob(std::move(sink));
+        const Derived& self = static_cast<const Derived&>(*this);
+        stream::SizeCountingSink counter;
+        StreamIn(&counter, self);
+        stream::BlobSink sink(CreateBlob(counter.GetSize()));
+        StreamIn(&sink, self);
+        return sink.AcquireBlob();
     }
 };
 }  // namespace dawn::native
@@ -37,6 +37,10 @@ namespace dawn::native {
 
 namespace {
 
+// The number of (layout, entry point, transform configuration) variants of a shader module for
+// which the transformed and compiled results are kept in memory.
+constexpr size_t kMaxTransformedShaderCacheEntries = 32;
+
 ResultOrError<SingleShaderStage> TintPipelineStageToShaderStage(
     tint::inspector::PipelineStage stage) {
     switch (stage) {
@@ -1070,7 +1074,9 @@ MaybeError ValidateCompatibilityWithPipelineLayout(DeviceBase* device,
 ShaderModuleBase::ShaderModuleBase(DeviceBase* device,
                                    const ShaderModuleDescriptor* descriptor,
                                    ApiObjectBase::UntrackedByDeviceTag tag)
-    : ApiObjectBase(device, descriptor->label), mType(Type::Undefined) {
+    : ApiObjectBase(device, descriptor->label),
+      mType(Type::Undefined),
+      mTransformedShaderCache(kMaxTransformedShaderCacheEntries) {
     ASSERT(descriptor->nextInChain != nullptr);
     const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
     FindInChain(descriptor->nextInChain, &spirvDesc);
@@ -1093,12 +1099,15 @@ ShaderModuleBase::ShaderModuleBase(DeviceBase* device, const ShaderModuleDescrip
 }
 
 ShaderModuleBase::ShaderModuleBase(DeviceBase* device)
-    : ApiObjectBase(device, kLabelNotImplemented) {
+    : ApiObjectBase(device, kLabelNotImplemented),
+      mTransformedShaderCache(kMaxTransformedShaderCacheEntries) {
     TrackInDevice();
 }
 
 ShaderModuleBase::ShaderModuleBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-    : ApiObjectBase(device, tag), mType(Type::Undefined) {}
+    : ApiObjectBase(device, tag),
+      mType(Type::Undefined),
+      mTransformedShaderCache(kMaxTransformedShaderCacheEntries) {}
 
 ShaderModuleBase::~ShaderModuleBase() = default;
 
@@ -1107,6 +1116,7 @@ void ShaderModuleBase::DestroyImpl() {
         // Do not uncache the actual cached object if we are a blueprint.
         GetDevice()->UncacheShaderModule(this);
     }
+    mTransformedShaderCache.Clear();
 }
 
 // static
@@ -1191,6 +1201,18 @@ OwnedCompilationMessages* ShaderModuleBase::GetCompilationMessages() const {
     return mCompilationMessages.get();
 }
 
+TransformedShaderCache* ShaderModuleBase::GetTransformedShaderCache() {
+    return &mTransformedShaderCache;
+}
+
+const std::string& ShaderModuleBase::GetOriginalWGSL() const {
+    return mWgsl;
+}
+
+const std::vector<uint32_t>& ShaderModuleBase::GetOriginalSpirv() const {
+    return mOriginalSpirv;
+}
+
 MaybeError ShaderModuleBase::InitializeBase(ShaderModuleParseResult* parseResult,
                                             OwnedCompilationMessages* compilationMessages) {
     mTintProgram = std::move(parseResult->tintProgram);
@@ -35,6 +35,7 @@
 #include "dawn/native/IntegerTypes.h"
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/PerStage.h"
+#include "dawn/native/TransformedShaderCache.h"
 #include "dawn/native/VertexFormat.h"
 #include "dawn/native/dawn_platform.h"
 
@@ -281,6 +282,15 @@ class ShaderModuleBase : public ApiObjectBase, public CachedObject {
 
     OwnedCompilationMessages* GetCompilationMessages() const;
 
+    // The cache of the results of the backend's transforms and compilation for this module. It
+    // should be passed to LoadOrRun for the compilation requests made for this module.
+    TransformedShaderCache* GetTransformedShaderCache();
+
+    // The WGSL source or the SPIR-V code the module was created from. At most one of them is
+    // non-empty.
+    const std::string& GetOriginalWGSL() const;
+    const std::vector<uint32_t>& GetOriginalSpirv() const;
+
   protected:
     // Constructor used only for mocking and testing.
     explicit ShaderModuleBase(DeviceBase* device);
@@ -304,6 +314,8 @@ class ShaderModuleBase : public ApiObjectBase, public CachedObject {
     std::unique_ptr<TintSource> mTintSource;  // Keep the tint::Source::File alive
 
     std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
+
+    TransformedShaderCache mTransformedShaderCache;
 };
 
 }  // namespace dawn::native
@@ -18,6 +18,7 @@
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Constants.h"
+#include "dawn/common/HashUtils.h"
 #include "dawn/common/Math.h"
 #include "dawn/native/Adapter.h"
 #include "dawn/native/ChainUtils_autogen.h"
@@ -578,6 +579,12 @@ TextureBase::TextureBase(DeviceBase* device,
 
 void TextureBase::DestroyImpl() {
     mState = TextureState::Destroyed;
+
+    // Views created from now on must not be the ones of the destroyed texture.
+    for (auto& [key, view] : mPooledViews) {
+        view->mIsPooled = false;
+    }
+    mPooledViews.clear();
 }
 
 // static
@@ -766,6 +773,55 @@ ResultOrError<Ref<TextureViewBase>> TextureBase::CreateView(
     return GetDevice()->CreateTextureView(this, descriptor);
 }
 
+TextureViewBase* TextureBase::GetPooledView(const TextureViewDescriptor* descriptor) {
+    ViewPoolKey key = {descriptor->format,
+                       descriptor->dimension,
+                       {ConvertViewAspect(GetDevice()->GetValidInternalFormat(descriptor->format),
+                                          descriptor->aspect),
+                        {descriptor->baseArrayLayer, descriptor->arrayLayerCount},
+                        {descriptor->baseMipLevel, descriptor->mipLevelCount}}};
+    auto it = mPooledViews.find(key);
+    if (it == mPooledViews.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void TextureBase::AddPooledView(TextureViewBase* view) {
+    ASSERT(view->GetTexture() == this);
+    ASSERT(!view->mIsPooled);
+    ViewPoolKey key = {view->GetFormat().format, view->GetDimension(),
+                       view->GetSubresourceRange()};
+    bool inserted = mPooledViews.emplace(key, view).second;
+    ASSERT(inserted);
+    view->mIsPooled = true;
+}
+
+void TextureBase::RemovePooledView(TextureViewBase* view) {
+    ASSERT(view->mIsPooled);
+    ViewPoolKey key = {view->GetFormat().format, view->GetDimension(),
+                       view->GetSubresourceRange()};
+    size_t removedCount = mPooledViews.erase(key);
+    ASSERT(removedCount == 1);
+    view->mIsPooled = false;
+}
+
+bool TextureBase::ViewPoolKey::operator==(const ViewPoolKey& other) const {
+    return format == other.format && dimension == other.dimension &&
+           range.aspects == other.range.aspects &&
+           range.baseArrayLayer == other.range.baseArrayLayer &&
+           range.layerCount == other.range.layerCount &&
+           range.baseMipLevel == other.range.baseMipLevel &&
+           range.levelCount == other.range.levelCount;
+}
+
+size_t TextureBase::ViewPoolKey::HashFunc::operator()(const ViewPoolKey& key) const {
+    size_t hash = 0;
+    HashCombine(&hash, key.format, key.dimension, key.range.aspects, key.range.baseArrayLayer,
+                key.range.layerCount, key.range.baseMipLevel, key.range.levelCount);
+    return hash;
+}
+
 TextureViewBase* TextureBase::APICreateView(const TextureViewDescriptor* descriptor) {
     DeviceBase* device = GetDevice();
 
@@ -846,7 +902,11 @@ TextureViewBase::TextureViewBase(DeviceBase* device, ObjectBase::ErrorTag tag)
 
 TextureViewBase::~TextureViewBase() = default;
 
-void TextureViewBase::DestroyImpl() {}
+void TextureViewBase::DestroyImpl() {
+    if (mIsPooled) {
+        mTexture->RemovePooledView(this);
+    }
+}
 
 // static
 TextureViewBase* TextureViewBase::MakeError(DeviceBase* device) {
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_TEXTURE_H_
 #define SRC_DAWN_NATIVE_TEXTURE_H_
 
+#include <unordered_map>
 #include <vector>
 
 #include "dawn/common/ityp_array.h"
@@ -93,6 +94,13 @@ class TextureBase : public ApiObjectBase {
     ResultOrError<Ref<TextureViewBase>> CreateView(
         const TextureViewDescriptor* descriptor = nullptr);
 
+    // Pooling of the live views of the texture, see Toggle::PoolTextureViewsAndBindGroups.
+    // |descriptor| must have its defaults applied. The pool doesn't hold references to the views,
+    // which remove themselves from it when they are destroyed.
+    TextureViewBase* GetPooledView(const TextureViewDescriptor* descriptor);
+    void AddPooledView(TextureViewBase* view);
+    void RemovePooledView(TextureViewBase* view);
+
     // Dawn API
     TextureViewBase* APICreateView(const TextureViewDescriptor* descriptor = nullptr);
     void APIDestroy();
@@ -118,6 +126,18 @@ class TextureBase : public ApiObjectBase {
     TextureBase(DeviceBase* device, const TextureDescriptor* descriptor, ObjectBase::ErrorTag tag);
 
     MaybeError ValidateDestroy() const;
+
+    struct ViewPoolKey {
+        wgpu::TextureFormat format;
+        wgpu::TextureViewDimension dimension;
+        SubresourceRange range;
+
+        bool operator==(const ViewPoolKey& other) const;
+        struct HashFunc {
+            size_t operator()(const ViewPoolKey& key) const;
+        };
+    };
+
     wgpu::TextureDimension mDimension;
     const Format& mFormat;
     FormatSet mViewFormats;
@@ -131,6 +151,8 @@ class TextureBase : public ApiObjectBase {
 
     // TODO(crbug.com/dawn/845): Use a more optimized data structure to save space
     std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+
+    std::unordered_map<ViewPoolKey, TextureViewBase*, ViewPoolKey::HashFunc> mPooledViews;
 };
 
 class TextureViewBase : public ApiObjectBase {
@@ -162,6 +184,9 @@ class TextureViewBase : public ApiObjectBase {
   private:
     TextureViewBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+    friend class TextureBase;
+    bool mIsPooled = false;
+
     Ref<TextureBase> mTexture;
 
     const Format& mFormat;
@@ -305,6 +305,27 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
       "integer that is greater than 2^24 or smaller than -2^24). This toggle is also enabled on "
       "Intel GPUs on Metal backend due to a driver issue on Intel Metal driver.",
       "https://crbug.com/dawn/537"}},
+    {Toggle::SingleThreadedDevice,
+     {"single_threaded_device",
+      "Assumes that the device and all the objects created from it are only ever used from a "
+      "single thread. Reference counting of these objects becomes non-atomic, the tracking of "
+      "objects in the device skips its locks, and asynchronous pipeline creation is done on the "
+      "device's thread instead of the worker task pool.",
+      ""}},
+    {Toggle::PoolTextureViewsAndBindGroups,
+     {"pool_texture_views_and_bind_groups",
+      "Returns an existing live texture view when creating a view of a texture with the same "
+      "descriptor, and an existing live bind group when creating a bind group with the same layout "
+      "and entries. Pooled objects are shared so they keep the label of the first one created. "
+      "Views of destroyed textures and bind groups using destroyed resources aren't reused.",
+      ""}},
+    {Toggle::RecordPipelineManifest,
+     {"record_pipeline_manifest",
+      "Records the descriptors of the pipelines created by the device, and the source of their "
+      "shader modules, in the blob cache so that they can be prewarmed with "
+      "dawn::native::PrewarmPipelinesFromManifest when the application starts again. Requires the "
+      "blob cache to be enabled.",
+      ""}},
     // Comment to separate the }} so it is clearer what to copy-paste to add a toggle.
 }};
 }  // anonymous namespace
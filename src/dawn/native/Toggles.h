@@ -77,6 +77,9 @@ enum class Toggle {
     D3D12AllocateExtraMemoryFor2DArrayTexture,
     D3D12UseTempBufferInDepthStencilTextureAndBufferCopyWithNonZeroBufferOffset,
     ApplyClearBigIntegerColorValueWithDraw,
+    SingleThreadedDevice,
+    PoolTextureViewsAndBindGroups,
+    RecordPipelineManifest,
 
     EnumCount,
     InvalidEnum = EnumCount,
@@ -0,0 +1,97 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/TransformedShaderCache.h"
+
+#include <cstring>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/HashUtils.h"
+
+namespace dawn::native {
+
+TransformedShaderCache::TransformedShaderCache(size_t maxEntries) : mMaxEntries(maxEntries) {
+    ASSERT(mMaxEntries > 0);
+}
+
+TransformedShaderCache::~TransformedShaderCache() = default;
+
+Blob TransformedShaderCache::Load(const CacheKey& key) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mEntriesByKey.find(&key);
+    if (it == mEntriesByKey.end()) {
+        return Blob();
+    }
+
+    EntryList::iterator entry = it->second;
+    mEntries.splice(mEntries.begin(), mEntries, entry);
+
+    // Return a copy since the caller takes ownership of the blob and may keep it after the entry
+    // is evicted.
+    Blob result = CreateBlob(entry->value.Size());
+    memcpy(result.Data(), entry->value.Data(), entry->value.Size());
+    return result;
+}
+
+void TransformedShaderCache::Store(const CacheKey& key, size_t valueSize, const void* value) {
+    ASSERT(value != nullptr);
+    ASSERT(valueSize > 0);
+
+    Blob storedValue = CreateBlob(valueSize);
+    memcpy(storedValue.Data(), value, valueSize);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mEntriesByKey.find(&key);
+    if (it != mEntriesByKey.end()) {
+        // Replace the value in case the stored one couldn't be used, for example if it was loaded
+        // from a corrupted BlobCache entry.
+        it->second->value = std::move(storedValue);
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return;
+    }
+
+    mEntries.push_front({key, std::move(storedValue)});
+    mEntriesByKey.emplace(&mEntries.front().key, mEntries.begin());
+
+    if (mEntries.size() > mMaxEntries) {
+        mEntriesByKey.erase(&mEntries.back().key);
+        mEntries.pop_back();
+    }
+}
+
+void TransformedShaderCache::Store(const CacheKey& key, const Blob& value) {
+    Store(key, value.Size(), value.Data());
+}
+
+void TransformedShaderCache::Clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntriesByKey.clear();
+    mEntries.clear();
+}
+
+size_t TransformedShaderCache::GetEntryCountForTesting() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+size_t TransformedShaderCache::KeyHashFunc::operator()(const CacheKey* key) const {
+    return static_cast<size_t>(HashBytes(key->data(), key->size()));
+}
+
+bool TransformedShaderCache::KeyEqualityFunc::operator()(const CacheKey* a,
+                                                         const CacheKey* b) const {
+    return *a == *b;
+}
+
+}  // namespace dawn::native
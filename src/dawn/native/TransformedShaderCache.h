@@ -0,0 +1,80 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_TRANSFORMEDSHADERCACHE_H_
+#define SRC_DAWN_NATIVE_TRANSFORMEDSHADERCACHE_H_
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "dawn/native/Blob.h"
+#include "dawn/native/CacheKey.h"
+
+namespace dawn::native {
+
+// An in-memory LRU cache of the blobs produced by the backends when transforming and compiling a
+// shader module for a pipeline. It is keyed by the CacheKey of the compilation request, which
+// contains everything the result depends on: the program, the entry point, the bindings remapped
+// from the pipeline layout and the transform configuration. Each ShaderModuleBase owns one so
+// that pipelines created from the same module with equivalent layouts don't run the transforms
+// again, even when the device doesn't have a BlobCache.
+//
+// This class is thread-safe because pipelines may be created asynchronously.
+class TransformedShaderCache {
+  public:
+    explicit TransformedShaderCache(size_t maxEntries);
+    ~TransformedShaderCache();
+
+    // Returns empty blob if the key is not found in the cache. Otherwise returns a copy of the
+    // stored blob and marks the entry as the most recently used.
+    Blob Load(const CacheKey& key);
+
+    // Value to store must be non-empty/non-null. Replaces the value if the key is already in the
+    // cache, otherwise evicts the least recently used entry if the cache is full.
+    void Store(const CacheKey& key, size_t valueSize, const void* value);
+    void Store(const CacheKey& key, const Blob& value);
+
+    void Clear();
+
+    size_t GetEntryCountForTesting() const;
+
+  private:
+    struct Entry {
+        CacheKey key;
+        Blob value;
+    };
+    using EntryList = std::list<Entry>;
+
+    struct KeyHashFunc {
+        size_t operator()(const CacheKey* key) const;
+    };
+    struct KeyEqualityFunc {
+        bool operator()(const CacheKey* a, const CacheKey* b) const;
+    };
+
+    const size_t mMaxEntries;
+
+    // Protects thread safety of access to mEntries and mEntriesByKey.
+    mutable std::mutex mMutex;
+    // Ordered from the most recently used to the least recently used.
+    EntryList mEntries;
+    // Points to the keys of mEntries, which are stable since they are nodes of a list.
+    std::unordered_map<const CacheKey*, EntryList::iterator, KeyHashFunc, KeyEqualityFunc>
+        mEntriesByKey;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_TRANSFORMEDSHADERCACHE_H_
@@ -660,8 +660,8 @@ ResultOrError<CompiledShader> ShaderModule::Compile(const ProgrammableStage& pro
     req.hlsl.arrayLengthFromUniform = std::move(arrayLengthFromUniform);
 
     CacheResult<CompiledShader> compiledShader;
-    DAWN_TRY_LOAD_OR_RUN(compiledShader, device, std::move(req), CompiledShader::FromBlob,
-                         CompileShader);
+    DAWN_TRY_LOAD_OR_RUN(compiledShader, device, GetTransformedShaderCache(), std::move(req),
+                         CompiledShader::FromBlob, CompileShader);
 
     if (device->IsToggleEnabled(Toggle::DumpShaders)) {
         std::ostringstream dumpedMsg;
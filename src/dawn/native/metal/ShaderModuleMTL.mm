@@ -93,6 +93,7 @@ MaybeError ShaderModule::Initialize(ShaderModuleParseResult* parseResult,
 namespace {
 
 ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(DeviceBase* device,
+                                                          TransformedShaderCache* cache,
                                                           const tint::Program* inputProgram,
                                                           const char* entryPointName,
                                                           SingleShaderStage stage,
@@ -168,7 +169,7 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(DeviceBase* device,
 
     CacheResult<MslCompilation> mslCompilation;
     DAWN_TRY_LOAD_OR_RUN(
-        mslCompilation, device, std::move(req), MslCompilation::FromBlob,
+        mslCompilation, device, cache, std::move(req), MslCompilation::FromBlob,
         [](MslCompilationRequest r) -> ResultOrError<MslCompilation> {
             tint::transform::Manager transformManager;
             tint::transform::DataMap transformInputs;
@@ -290,8 +291,9 @@ MaybeError ShaderModule::CreateFunction(const char* entryPointName,
     }
 
     CacheResult<MslCompilation> mslCompilation;
-    DAWN_TRY_ASSIGN(mslCompilation, TranslateToMSL(GetDevice(), GetTintProgram(), entryPointName,
-                                                   stage, layout, sampleMask, renderPipeline));
+    DAWN_TRY_ASSIGN(mslCompilation,
+                    TranslateToMSL(GetDevice(), GetTransformedShaderCache(), GetTintProgram(),
+                                   entryPointName, stage, layout, sampleMask, renderPipeline));
     out->needsStorageBufferLength = mslCompilation->needsStorageBufferLength;
     out->workgroupAllocations = std::move(mslCompilation->workgroupAllocations);
 
@@ -14,6 +14,7 @@
 
 #include "dawn/native/null/DeviceNull.h"
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 
@@ -197,6 +198,12 @@ void Device::DestroyImpl() {
 
 MaybeError Device::WaitForIdleForDestruction() {
     mPendingOperations.clear();
+
+    // Fast-forward the virtual clock to the completion of all the simulated GPU work.
+    if (!mSimulatedSerialsInFlight.Empty()) {
+        mSimulatedTime = std::max(mSimulatedTime, mSimulatedSerialsInFlight.LastSerial());
+        mSimulatedSerialsInFlight.Clear();
+    }
     return {};
 }
 
@@ -209,6 +216,8 @@ MaybeError Device::CopyFromStagingToBuffer(StagingBufferBase* source,
         destination->SetIsDataInitialized();
     }
 
+    AddSimulatedWriteCost(size);
+
     auto operation = std::make_unique<CopyFromStagingToBufferOperation>();
     operation->staging = source;
     operation->destination = ToBackend(destination);
@@ -243,11 +252,50 @@ void Device::DecrementMemoryUsage(uint64_t bytes) {
 }
 
 MaybeError Device::TickImpl() {
+    mSimulatedTime += mSimulatedCosts.tickDurationNs;
     return SubmitPendingOperations();
 }
 
 ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
-    return GetLastSubmittedCommandSerial();
+    // Only submissions with a simulated completion time in the future are tracked, so with the
+    // default costs all the work is complete as soon as it is submitted.
+    mSimulatedSerialsInFlight.ClearUpTo(mSimulatedTime);
+    if (mSimulatedSerialsInFlight.Empty()) {
+        return GetLastSubmittedCommandSerial();
+    }
+    return *mSimulatedSerialsInFlight.IterateAll().begin() - ExecutionSerial(1);
+}
+
+void Device::SetSimulatedExecutionCosts(const SimulatedExecutionCosts& costs) {
+    mSimulatedCosts = costs;
+}
+
+void Device::AdvanceSimulatedTime(uint64_t durationNs) {
+    mSimulatedTime += durationNs;
+}
+
+uint64_t Device::GetSimulatedTime() const {
+    return mSimulatedTime;
+}
+
+void Device::AddSimulatedCommandBufferCost(CommandBuffer* commandBuffer) {
+    mHasPendingSimulatedWork = true;
+
+    // Walking the commands isn't free, skip it when it can't contribute to the cost.
+    if (mSimulatedCosts.perCommandNs == 0 && mSimulatedCosts.perDrawOrDispatchNs == 0) {
+        return;
+    }
+
+    uint64_t commandCount = 0;
+    uint64_t drawAndDispatchCount = 0;
+    commandBuffer->CountCommands(&commandCount, &drawAndDispatchCount);
+    mPendingSubmissionCost += commandCount * mSimulatedCosts.perCommandNs +
+                              drawAndDispatchCount * mSimulatedCosts.perDrawOrDispatchNs;
+}
+
+void Device::AddSimulatedWriteCost(uint64_t size) {
+    mHasPendingSimulatedWork = true;
+    mPendingSubmissionCost += size * mSimulatedCosts.perKilobyteWrittenNs / 1024;
 }
 
 void Device::AddPendingOperation(std::unique_ptr<PendingOperation> operation) {
@@ -257,12 +305,34 @@ void Device::AddPendingOperation(std::unique_ptr<PendingOperation> operation) {
 MaybeError Device::SubmitPendingOperations() {
     for (auto& operation : mPendingOperations) {
         operation->Execute();
+        mHasPendingSimulatedWork = true;
     }
     mPendingOperations.clear();
 
     DAWN_TRY(CheckPassedSerials());
     IncrementLastSubmittedCommandSerial();
 
+    // The simulated GPU executes submissions in order, starting each one when both the CPU has
+    // submitted it and the previous one has finished executing. The submit latency delays the
+    // completion but doesn't keep the simulated GPU busy. Submissions made by ticks without any
+    // work complete along with the previous submission.
+    uint64_t startTime = std::max(mSimulatedTime, mSimulatedGPUIdleTime);
+    mSimulatedGPUIdleTime = startTime + mPendingSubmissionCost;
+
+    uint64_t completionTime = mSimulatedGPUIdleTime;
+    if (mHasPendingSimulatedWork) {
+        completionTime += mSimulatedCosts.submitLatencyNs;
+    }
+    if (!mSimulatedSerialsInFlight.Empty()) {
+        completionTime = std::max(completionTime, mSimulatedSerialsInFlight.LastSerial());
+    }
+    mPendingSubmissionCost = 0;
+    mHasPendingSimulatedWork = false;
+
+    if (completionTime > mSimulatedTime) {
+        mSimulatedSerialsInFlight.Enqueue(GetLastSubmittedCommandSerial(), completionTime);
+    }
+
     return {};
 }
 
@@ -342,6 +412,26 @@ void Buffer::DestroyImpl() {
 CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
     : CommandBufferBase(encoder, descriptor) {}
 
+void CommandBuffer::CountCommands(uint64_t* commandCount, uint64_t* drawAndDispatchCount) {
+    Command type;
+    while (mCommands.NextCommandId(&type)) {
+        (*commandCount)++;
+        switch (type) {
+            case Command::Dispatch:
+            case Command::DispatchIndirect:
+            case Command::Draw:
+            case Command::DrawIndexed:
+            case Command::DrawIndirect:
+            case Command::DrawIndexedIndirect:
+                (*drawAndDispatchCount)++;
+                break;
+            default:
+                break;
+        }
+        SkipCommand(&mCommands, type);
+    }
+}
+
 // QuerySet
 
 QuerySet::QuerySet(Device* device, const QuerySetDescriptor* descriptor)
@@ -353,9 +443,13 @@ Queue::Queue(Device* device, const QueueDescriptor* descriptor) : QueueBase(devi
 
 Queue::~Queue() {}
 
-MaybeError Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
+MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
     Device* device = ToBackend(GetDevice());
 
+    for (uint32_t i = 0; i < commandCount; ++i) {
+        device->AddSimulatedCommandBufferCost(ToBackend(commands[i]));
+    }
+
     // The Vulkan, D3D12 and Metal implementation all tick the device here,
     // for testing purposes we should also tick in the null implementation.
     DAWN_TRY(device->Tick());
@@ -367,6 +461,7 @@ MaybeError Queue::WriteBufferImpl(BufferBase* buffer,
                                   uint64_t bufferOffset,
                                   const void* data,
                                   size_t size) {
+    ToBackend(GetDevice())->AddSimulatedWriteCost(size);
     ToBackend(buffer)->DoWriteBuffer(bufferOffset, data, size);
     return {};
 }
@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 
+#include "dawn/common/SerialQueue.h"
 #include "dawn/native/Adapter.h"
 #include "dawn/native/BindGroup.h"
 #include "dawn/native/BindGroupLayout.h"
@@ -26,6 +27,7 @@
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/ComputePipeline.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/NullBackend.h"
 #include "dawn/native/PipelineLayout.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/Queue.h"
@@ -122,6 +124,14 @@ class Device final : public DeviceBase {
 
     float GetTimestampPeriodInNS() const override;
 
+    void SetSimulatedExecutionCosts(const SimulatedExecutionCosts& costs);
+    void AdvanceSimulatedTime(uint64_t durationNs);
+    uint64_t GetSimulatedTime() const;
+
+    // Adds the simulated cost of the work to the submission that is currently being recorded.
+    void AddSimulatedCommandBufferCost(CommandBuffer* commandBuffer);
+    void AddSimulatedWriteCost(uint64_t size);
+
   private:
     using DeviceBase::DeviceBase;
 
@@ -164,6 +174,15 @@ class Device final : public DeviceBase {
 
     static constexpr uint64_t kMaxMemoryUsage = 512 * 1024 * 1024;
     size_t mMemoryUsage = 0;
+
+    // State of the simulated GPU timeline. Submissions are executed in order, so their
+    // completion times are non-decreasing and can be used as the key of a SerialQueue.
+    SimulatedExecutionCosts mSimulatedCosts;
+    uint64_t mSimulatedTime = 0;
+    uint64_t mSimulatedGPUIdleTime = 0;
+    uint64_t mPendingSubmissionCost = 0;
+    bool mHasPendingSimulatedWork = false;
+    SerialQueue<uint64_t, ExecutionSerial> mSimulatedSerialsInFlight;
 };
 
 class Adapter : public AdapterBase {
@@ -240,6 +259,8 @@ class Buffer final : public BufferBase {
 class CommandBuffer final : public CommandBufferBase {
   public:
     CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
+
+    void CountCommands(uint64_t* commandCount, uint64_t* drawAndDispatchCount);
 };
 
 class QuerySet final : public QuerySetBase {
@@ -29,4 +29,16 @@ DawnSwapChainImplementation CreateNativeSwapChainImpl() {
     return impl;
 }
 
+void SetSimulatedExecutionCosts(WGPUDevice device, const SimulatedExecutionCosts& costs) {
+    ToBackend(FromAPI(device))->SetSimulatedExecutionCosts(costs);
+}
+
+void AdvanceSimulatedTime(WGPUDevice device, uint64_t durationNs) {
+    ToBackend(FromAPI(device))->AdvanceSimulatedTime(durationNs);
+}
+
+uint64_t GetSimulatedTime(WGPUDevice device) {
+    return ToBackend(FromAPI(device))->GetSimulatedTime();
+}
+
 }  // namespace dawn::native::null
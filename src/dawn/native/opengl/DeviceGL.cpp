@@ -230,7 +230,6 @@ void Device::InitTogglesFromDriver() {
 }
 
 const GLFormat& Device::GetGLFormat(const Format& format) {
-    ASSERT(format.isSupported);
     ASSERT(format.GetIndex() < mFormatTable.size());
 
     const GLFormat& result = mFormatTable[format.GetIndex()];
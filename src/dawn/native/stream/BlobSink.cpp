@@ -0,0 +1,37 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/stream/BlobSink.h"
+
+#include <utility>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::native::stream {
+
+BlobSink::BlobSink(Blob&& blob) : mBlob(std::move(blob)) {}
+
+void* BlobSink::GetSpace(size_t bytes) {
+    ASSERT(bytes <= mBlob.Size() - mOffset);
+    void* ptr = mBlob.Data() + mOffset;
+    mOffset += bytes;
+    return ptr;
+}
+
+Blob BlobSink::AcquireBlob() {
+    ASSERT(mOffset == mBlob.Size());
+    return std::move(mBlob);
+}
+
+}  // namespace dawn::native::stream
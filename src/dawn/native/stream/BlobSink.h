@@ -0,0 +1,43 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_STREAM_BLOBSINK_H_
+#define SRC_DAWN_NATIVE_STREAM_BLOBSINK_H_
+
+#include "dawn/native/Blob.h"
+#include "dawn/native/stream/Sink.h"
+
+namespace dawn::native::stream {
+
+// A sink that writes in place into a Blob allocated by the caller. The size of the serialized data
+// must be known in advance, for example by streaming it in a SizeCountingSink first, but then it
+// doesn't need to be copied out of a growing vector at the end.
+class BlobSink : public Sink {
+  public:
+    explicit BlobSink(Blob&& blob);
+
+    // stream::Sink implementation.
+    void* GetSpace(size_t bytes) override;
+
+    // Returns the blob, which must have been filled entirely.
+    Blob AcquireBlob();
+
+  private:
+    Blob mBlob;
+    size_t mOffset = 0;
+};
+
+}  // namespace dawn::native::stream
+
+#endif  // SRC_DAWN_NATIVE_STREAM_BLOBSINK_H_
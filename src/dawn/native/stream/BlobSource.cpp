@@ -18,11 +18,23 @@
 
 namespace dawn::native::stream {
 
-BlobSource::BlobSource(Blob&& blob) : mBlob(std::move(blob)) {}
+BlobSource::BlobSource(Blob&& blob) : mBlob(std::make_shared<Blob>(std::move(blob))) {}
 
 MaybeError BlobSource::Read(const void** ptr, size_t bytes) {
-    DAWN_INVALID_IF(bytes > mBlob.Size() - mOffset, "Out of bounds.");
-    *ptr = mBlob.Data() + mOffset;
+    DAWN_INVALID_IF(bytes > mBlob->Size() - mOffset, "Out of bounds.");
+    *ptr = mBlob->Data() + mOffset;
+    mOffset += bytes;
+    return {};
+}
+
+MaybeError BlobSource::ReadBlob(Blob* blob, size_t bytes) {
+    DAWN_INVALID_IF(bytes > mBlob->Size() - mOffset, "Out of bounds.");
+    if (bytes == 0) {
+        *blob = Blob();
+        return {};
+    }
+    *blob = Blob::UnsafeCreateWithDeleter(mBlob->Data() + mOffset, bytes,
+                                          [owner = mBlob]() mutable { owner = nullptr; });
     mOffset += bytes;
     return {};
 }
@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_NATIVE_STREAM_BLOBSOURCE_H_
 #define SRC_DAWN_NATIVE_STREAM_BLOBSOURCE_H_
 
+#include <memory>
+
 #include "dawn/native/Blob.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/stream/Source.h"
@@ -27,9 +29,13 @@ class BlobSource : public Source {
 
     // stream::Source implementation.
     MaybeError Read(const void** ptr, size_t bytes) override;
+    // Returns a Blob pointing into the source's blob, which is kept alive until all of the
+    // returned Blobs are destroyed.
+    MaybeError ReadBlob(Blob* blob, size_t bytes) override;
 
   private:
-    const Blob mBlob;
+    // Shared with the Blobs returned by ReadBlob.
+    const std::shared_ptr<Blob> mBlob;
     size_t mOffset = 0;
 };
 
@@ -24,14 +24,19 @@ void* ByteVectorSink::GetSpace(size_t bytes) {
     return &this->operator[](currentSize);
 }
 
+void ByteVectorSink::Write(const void* data, size_t bytes) {
+    // Insert the data directly instead of zero-initializing the space before copying over it.
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    this->insert(this->end(), begin, begin + bytes);
+}
+
 template <>
 void stream::Stream<ByteVectorSink>::Write(stream::Sink* sink, const ByteVectorSink& vec) {
     // For nested sinks, we do not record the length, and just copy the data so that it
     // appears flattened.
     size_t size = vec.size();
     if (size > 0) {
-        void* ptr = sink->GetSpace(size);
-        memcpy(ptr, vec.data(), size);
+        sink->Write(vec.data(), size);
     }
 }
 
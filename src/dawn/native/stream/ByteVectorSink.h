@@ -29,6 +29,7 @@ class ByteVectorSink : public std::vector<uint8_t>, public Sink {
 
     // Implementation of stream::Sink
     void* GetSpace(size_t bytes) override;
+    void Write(const void* data, size_t bytes) override;
 };
 
 // Stream operator for ByteVectorSink for debugging.
@@ -16,6 +16,7 @@
 #define SRC_DAWN_NATIVE_STREAM_SINK_H_
 
 #include <cstddef>
+#include <cstring>
 
 namespace dawn::native::stream {
 
@@ -23,8 +24,14 @@ namespace dawn::native::stream {
 class Sink {
   public:
     // Allocate `bytes` space in the sink. Returns the pointer to the start
-    // of the allocation.
+    // of the allocation. The space is only valid until the next call on the sink and must not be
+    // read back: sinks that only measure the serialized size, like SizeCountingSink, return the
+    // same scratch memory for every call.
     virtual void* GetSpace(size_t bytes) = 0;
+
+    // Append `bytes` bytes of `data` to the sink. Sinks that only measure the serialized size
+    // override this to skip the copy.
+    virtual void Write(const void* data, size_t bytes) { memcpy(GetSpace(bytes), data, bytes); }
 };
 
 }  // namespace dawn::native::stream
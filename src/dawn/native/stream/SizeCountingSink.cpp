@@ -0,0 +1,35 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/stream/SizeCountingSink.h"
+
+namespace dawn::native::stream {
+
+void* SizeCountingSink::GetSpace(size_t bytes) {
+    mSize += bytes;
+    if (mScratch.size() < bytes) {
+        mScratch.resize(bytes);
+    }
+    return mScratch.data();
+}
+
+void SizeCountingSink::Write(const void* data, size_t bytes) {
+    mSize += bytes;
+}
+
+size_t SizeCountingSink::GetSize() const {
+    return mSize;
+}
+
+}  // namespace dawn::native::stream
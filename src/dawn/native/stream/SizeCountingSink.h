@@ -0,0 +1,42 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_STREAM_SIZECOUNTINGSINK_H_
+#define SRC_DAWN_NATIVE_STREAM_SIZECOUNTINGSINK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "dawn/native/stream/Sink.h"
+
+namespace dawn::native::stream {
+
+// A sink that only counts the bytes streamed in it, to size the allocation of a BlobSink.
+class SizeCountingSink : public Sink {
+  public:
+    // stream::Sink implementation. GetSpace returns scratch memory shared by all the calls, for
+    // the few writers that don't go through Write.
+    void* GetSpace(size_t bytes) override;
+    void Write(const void* data, size_t bytes) override;
+
+    size_t GetSize() const;
+
+  private:
+    size_t mSize = 0;
+    std::vector<uint8_t> mScratch;
+};
+
+}  // namespace dawn::native::stream
+
+#endif  // SRC_DAWN_NATIVE_STREAM_SIZECOUNTINGSINK_H_
@@ -16,6 +16,10 @@
 #define SRC_DAWN_NATIVE_STREAM_SOURCE_H_
 
 #include <cstddef>
+#include <cstring>
+
+#include "dawn/native/Blob.h"
+#include "dawn/native/Error.h"
 
 namespace dawn::native::stream {
 
@@ -27,6 +31,18 @@ class Source {
     // a tagged pointer that must be 4-byte aligned. This function writes out |ptr|
     // which may not be aligned.
     virtual MaybeError Read(const void** ptr, size_t bytes) = 0;
+
+    // Read `bytes` bytes from the source as a Blob. The data is copied by default, but sources
+    // that own their data may return a Blob pointing into it instead.
+    virtual MaybeError ReadBlob(Blob* blob, size_t bytes) {
+        const void* ptr;
+        DAWN_TRY(Read(&ptr, bytes));
+        *blob = CreateBlob(bytes);
+        if (bytes > 0) {
+            memcpy(blob->Data(), ptr, bytes);
+        }
+        return {};
+    }
 };
 
 }  // namespace dawn::native::stream
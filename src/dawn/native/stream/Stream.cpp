@@ -23,8 +23,7 @@ void Stream<std::string>::Write(Sink* s, const std::string& t) {
     StreamIn(s, t.length());
     size_t size = t.length() * sizeof(char);
     if (size > 0) {
-        void* ptr = s->GetSpace(size);
-        memcpy(ptr, t.data(), size);
+        s->Write(t.data(), size);
     }
 }
 
@@ -43,8 +42,7 @@ void Stream<std::string_view>::Write(Sink* s, const std::string_view& t) {
     StreamIn(s, t.length());
     size_t size = t.length() * sizeof(char);
     if (size > 0) {
-        void* ptr = s->GetSpace(size);
-        memcpy(ptr, t.data(), size);
+        s->Write(t.data(), size);
     }
 }
 
@@ -53,8 +51,7 @@ void Stream<std::wstring_view>::Write(Sink* s, const std::wstring_view& t) {
     StreamIn(s, t.length());
     size_t size = t.length() * sizeof(wchar_t);
     if (size > 0) {
-        void* ptr = s->GetSpace(size);
-        memcpy(ptr, t.data(), size);
+        s->Write(t.data(), size);
     }
 }
 
@@ -85,7 +85,7 @@ MaybeError StreamOut(Source* s, T* v, Ts*... vs) {
 template <typename T>
 class Stream<T, std::enable_if_t<std::is_fundamental_v<T>>> {
   public:
-    static void Write(Sink* s, const T& v) { memcpy(s->GetSpace(sizeof(T)), &v, sizeof(T)); }
+    static void Write(Sink* s, const T& v) { s->Write(&v, sizeof(T)); }
     static MaybeError Read(Source* s, T* v) {
         const void* ptr;
         DAWN_TRY(s->Read(&ptr, sizeof(T)));
@@ -216,7 +216,7 @@ class Stream<T[N], std::enable_if_t<std::is_fundamental_v<T>>> {
   public:
     static void Write(Sink* s, const T (&t)[N]) {
         static_assert(N > 0);
-        memcpy(s->GetSpace(sizeof(t)), &t, sizeof(t));
+        s->Write(&t, sizeof(t));
     }
 
     static MaybeError Read(Source* s, T (*t)[N]) {
@@ -249,8 +249,42 @@ class Stream<T[N], std::enable_if_t<!std::is_fundamental_v<T>>> {
 };
 
 // Stream specialization for std::vector.
+namespace detail {
+// Vectors of these types are streamed with a single copy of their storage. It gives the same
+// bytes as streaming the elements one by one. std::vector<bool> is excluded since it is packed.
+template <typename T>
+constexpr bool IsBulkStreamable = std::is_fundamental_v<T> && !std::is_same_v<T, bool>;
+}  // namespace detail
+
+template <typename T>
+class Stream<std::vector<T>, std::enable_if_t<detail::IsBulkStreamable<T>>> {
+  public:
+    static void Write(Sink* s, const std::vector<T>& v) {
+        StreamIn(s, v.size());
+        if (!v.empty()) {
+            s->Write(v.data(), v.size() * sizeof(T));
+        }
+    }
+
+    static MaybeError Read(Source* s, std::vector<T>* v) {
+        using SizeT = decltype(std::declval<std::vector<T>>().size());
+        SizeT size;
+        DAWN_TRY(StreamOut(s, &size));
+        // Check the size before resizing so that corrupted data can't make us allocate a huge
+        // vector.
+        DAWN_INVALID_IF(size > std::numeric_limits<SizeT>::max() / sizeof(T), "Out of bounds.");
+        const void* ptr;
+        DAWN_TRY(s->Read(&ptr, size * sizeof(T)));
+        v->resize(size);
+        if (size > 0) {
+            memcpy(v->data(), ptr, size * sizeof(T));
+        }
+        return {};
+    }
+};
+
 template <typename T>
-class Stream<std::vector<T>> {
+class Stream<std::vector<T>, std::enable_if_t<!detail::IsBulkStreamable<T>>> {
   public:
     static void Write(Sink* s, const std::vector<T>& v) {
         StreamIn(s, v.size());
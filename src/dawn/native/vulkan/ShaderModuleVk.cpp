@@ -251,7 +251,7 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
 
     CacheResult<Spirv> spirv;
     DAWN_TRY_LOAD_OR_RUN(
-        spirv, GetDevice(), std::move(req), Spirv::FromBlob,
+        spirv, GetDevice(), GetTransformedShaderCache(), std::move(req), Spirv::FromBlob,
         [](SpirvCompilationRequest r) -> ResultOrError<Spirv> {
             tint::transform::Manager transformManager;
             // Many Vulkan drivers can't handle multi-entrypoint shader modules.
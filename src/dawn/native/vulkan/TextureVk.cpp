@@ -1420,6 +1420,7 @@ MaybeError TextureView::Initialize(const TextureViewDescriptor* descriptor) {
 TextureView::~TextureView() {}
 
 void TextureView::DestroyImpl() {
+    TextureViewBase::DestroyImpl();
     Device* device = ToBackend(GetTexture()->GetDevice());
 
     if (mHandle != VK_NULL_HANDLE) {
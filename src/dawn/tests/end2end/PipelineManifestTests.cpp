@@ -0,0 +1,234 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string_view>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/DawnTest.h"
+#include "dawn/tests/mocks/platform/CachingInterfaceMock.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/SystemUtils.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+using ::testing::NiceMock;
+
+static constexpr std::string_view kComputeShader = R"(
+        @compute @workgroup_size(1) fn main() {}
+    )";
+
+static constexpr std::string_view kVertexShader = R"(
+        @vertex fn main(@location(0) pos : vec4<f32>) -> @builtin(position) vec4<f32> {
+            return pos;
+        }
+    )";
+
+static constexpr std::string_view kFragmentShader = R"(
+        struct S {
+            value : f32
+        };
+
+        @group(0) @binding(0) var<uniform> uBuffer : S;
+
+        @fragment fn main() -> @location(0) vec4<f32> {
+            return vec4<f32>(uBuffer.value, 0.2, 0.3, 0.4);
+        }
+    )";
+
+class PipelineManifestTests : public DawnTest {
+  protected:
+    std::unique_ptr<dawn::platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnCachingMockPlatform>(&mMockCache);
+    }
+
+    void SetUp() override {
+        DawnTest::SetUp();
+        // The manifest is only accessible through the native API.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+
+    // A render pipeline with an explicit layout and some non-default state.
+    wgpu::RenderPipeline CreateRenderPipeline(const wgpu::Device& device) {
+        utils::ComboRenderPipelineDescriptor desc;
+        desc.vertex.module = utils::CreateShaderModule(device, kVertexShader.data());
+        desc.vertex.entryPoint = "main";
+        desc.vertex.bufferCount = 1;
+        desc.cBuffers[0].arrayStride = 16;
+        desc.cBuffers[0].attributeCount = 1;
+        desc.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+        desc.cFragment.module = utils::CreateShaderModule(device, kFragmentShader.data());
+        desc.cFragment.entryPoint = "main";
+        desc.cTargets[0].blend = &desc.cBlends[0];
+        desc.primitive.cullMode = wgpu::CullMode::Back;
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+        desc.layout = utils::MakePipelineLayout(device, {bgl});
+        return device.CreateRenderPipeline(&desc);
+    }
+
+    // A compute pipeline with an explicit empty layout.
+    wgpu::ComputePipeline CreateComputePipeline(const wgpu::Device& device) {
+        wgpu::ComputePipelineDescriptor desc;
+        desc.layout = utils::MakePipelineLayout(device, {});
+        desc.compute.module = utils::CreateShaderModule(device, kComputeShader.data());
+        desc.compute.entryPoint = "main";
+        return device.CreateComputePipeline(&desc);
+    }
+
+    // A render pipeline with a default layout that has a bind group layout.
+    wgpu::RenderPipeline CreateDefaultLayoutRenderPipeline(const wgpu::Device& device) {
+        utils::ComboRenderPipelineDescriptor desc;
+        desc.vertex.module = utils::CreateShaderModule(device, kVertexShader.data());
+        desc.vertex.entryPoint = "main";
+        desc.vertex.bufferCount = 1;
+        desc.cBuffers[0].arrayStride = 16;
+        desc.cBuffers[0].attributeCount = 1;
+        desc.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+        desc.cFragment.module = utils::CreateShaderModule(device, kFragmentShader.data());
+        desc.cFragment.entryPoint = "main";
+        return device.CreateRenderPipeline(&desc);
+    }
+
+    // Ticks the device until the callbacks of all the prewarmed pipelines are called.
+    void WaitForPrewarm(const wgpu::Device& device) {
+        while (dawn::native::GetPendingPipelinePrewarmCount(device.Get()) > 0) {
+            device.Tick();
+            utils::USleep(100);
+        }
+    }
+
+    NiceMock<CachingInterfaceMock> mMockCache;
+};
+
+// Test that prewarming without a recorded manifest doesn't create anything.
+TEST_P(PipelineManifestTests, NoManifest) {
+    wgpu::Device device = CreateDevice();
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 0u);
+    EXPECT_EQ(dawn::native::GetPendingPipelinePrewarmCount(device.Get()), 0u);
+}
+
+// Test that the pipelines created by a device are prewarmed by the next ones, and that the
+// prewarmed pipelines are reused without going to the cache.
+TEST_P(PipelineManifestTests, RecordAndPrewarm) {
+    {
+        wgpu::Device device = CreateDevice();
+        CreateRenderPipeline(device);
+        CreateComputePipeline(device);
+    }
+
+    {
+        wgpu::Device device = CreateDevice();
+        EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 2u);
+        WaitForPrewarm(device);
+
+        // The shader modules, the layout and the pipeline are all kept alive by the device.
+        EXPECT_CACHE_STATS(mMockCache, Hit(0), Add(0), CreateRenderPipeline(device));
+    }
+
+    // The prewarmed pipelines aren't recorded again.
+    {
+        wgpu::Device device = CreateDevice();
+        EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 2u);
+        WaitForPrewarm(device);
+    }
+}
+
+// Test that prewarming again once the pipelines are created, which gets them from the frontend
+// cache immediately, is accounted for.
+TEST_P(PipelineManifestTests, PrewarmTwice) {
+    {
+        wgpu::Device device = CreateDevice();
+        CreateRenderPipeline(device);
+        CreateComputePipeline(device);
+    }
+
+    wgpu::Device device = CreateDevice();
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 2u);
+    WaitForPrewarm(device);
+
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 2u);
+    EXPECT_EQ(dawn::native::GetPendingPipelinePrewarmCount(device.Get()), 0u);
+
+    // Prewarming twice without waiting works as well.
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 2u);
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 2u);
+    WaitForPrewarm(device);
+}
+
+// Test that pipelines with a default layout aren't recorded, since the prewarmed pipelines would
+// have a different layout than the application's.
+TEST_P(PipelineManifestTests, DefaultLayoutNotRecorded) {
+    {
+        wgpu::Device device = CreateDevice();
+        CreateDefaultLayoutRenderPipeline(device);
+    }
+    {
+        wgpu::Device device = CreateDevice();
+        EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 0u);
+        CreateDefaultLayoutRenderPipeline(device);
+        CreateComputePipeline(device);
+    }
+
+    // Only the pipeline with an explicit layout is prewarmed.
+    wgpu::Device device = CreateDevice();
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 1u);
+    WaitForPrewarm(device);
+}
+
+// Test that pipelines created multiple times, by the same device or different ones, are only
+// recorded once.
+TEST_P(PipelineManifestTests, PipelinesRecordedOnce) {
+    {
+        wgpu::Device device = CreateDevice();
+        CreateRenderPipeline(device);
+        CreateRenderPipeline(device);
+    }
+    {
+        wgpu::Device device = CreateDevice();
+        CreateRenderPipeline(device);
+    }
+
+    wgpu::Device device = CreateDevice();
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 1u);
+    WaitForPrewarm(device);
+}
+
+// Test that pipelines whose shader sources aren't in the cache anymore are skipped.
+TEST_P(PipelineManifestTests, MissingShaderSource) {
+    {
+        wgpu::Device device = CreateDevice();
+        CreateComputePipeline(device);
+    }
+
+    // Only the two calls loading the size and the data of the manifest hit the cache.
+    wgpu::Device device = CreateDevice();
+    EXPECT_CALL(mMockCache, LoadData)
+        .WillOnce(testing::DoDefault())
+        .WillOnce(testing::DoDefault())
+        .WillRepeatedly(testing::Return(0));
+    EXPECT_EQ(dawn::native::PrewarmPipelinesFromManifest(device.Get()), 0u);
+    EXPECT_EQ(dawn::native::GetPendingPipelinePrewarmCount(device.Get()), 0u);
+}
+
+DAWN_INSTANTIATE_TEST(PipelineManifestTests,
+                      D3D12Backend({"enable_blob_cache", "record_pipeline_manifest"}),
+                      MetalBackend({"enable_blob_cache", "record_pipeline_manifest"}),
+                      OpenGLBackend({"enable_blob_cache", "record_pipeline_manifest"}),
+                      OpenGLESBackend({"enable_blob_cache", "record_pipeline_manifest"}),
+                      VulkanBackend({"enable_blob_cache", "record_pipeline_manifest"}),
+                      NullBackend({"enable_blob_cache", "record_pipeline_manifest"}));
+
+}  // namespace
@@ -0,0 +1,118 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+constexpr unsigned int kNumIterations = 10;
+constexpr uint32_t kNumBuffers = 1024;
+constexpr uint64_t kBufferSize = 256;
+
+enum class Allocation {
+    Separate,
+    Suballocated,
+};
+
+std::ostream& operator<<(std::ostream& ostream, const Allocation& allocation) {
+    switch (allocation) {
+        case Allocation::Separate:
+            ostream << "Separate";
+            break;
+        case Allocation::Suballocated:
+            ostream << "Suballocated";
+            break;
+    }
+    return ostream;
+}
+
+struct BufferSuballocationParams : AdapterTestParam {
+    BufferSuballocationParams(const AdapterTestParam& param, Allocation allocationIn)
+        : AdapterTestParam(param), allocation(allocationIn) {}
+    Allocation allocation;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const BufferSuballocationParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.allocation;
+    return ostream;
+}
+
+}  // anonymous namespace
+
+// Test the performance of creating many small uniform buffers with a bind group for each of them,
+// either as separate buffers or suballocated from a single backing buffer with
+// dawn::native::CreateSuballocatedBuffer. On the Null backend this measures only the CPU cost of
+// the objects.
+class BufferSuballocationPerf : public DawnPerfTestWithParams<BufferSuballocationParams> {
+  public:
+    BufferSuballocationPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~BufferSuballocationPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend is the one that best isolates the cost of the frontend.
+        DawnTestWithParams<BufferSuballocationParams>::SetUp();
+        // Suballocated buffers are only available through the native API.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        mLayout = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform}});
+
+        wgpu::BufferDescriptor desc;
+        desc.size = kNumBuffers * kBufferSize;
+        desc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        mBackingBuffer = device.CreateBuffer(&desc);
+    }
+
+  private:
+    void Step() override {
+        for (unsigned int i = 0; i < kNumIterations; ++i) {
+            std::vector<wgpu::BindGroup> bindGroups;
+            bindGroups.reserve(kNumBuffers);
+            for (uint32_t j = 0; j < kNumBuffers; ++j) {
+                wgpu::Buffer buffer = CreateBuffer(j);
+                bindGroups.push_back(utils::MakeBindGroup(device, mLayout, {{0, buffer}}));
+            }
+        }
+    }
+
+    wgpu::Buffer CreateBuffer(uint32_t index) {
+        if (GetParam().allocation == Allocation::Suballocated) {
+            return wgpu::Buffer::Acquire(dawn::native::CreateSuballocatedBuffer(
+                mBackingBuffer.Get(), index * kBufferSize, kBufferSize));
+        }
+        wgpu::BufferDescriptor desc;
+        desc.size = kBufferSize;
+        desc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        return device.CreateBuffer(&desc);
+    }
+
+    wgpu::BindGroupLayout mLayout;
+    wgpu::Buffer mBackingBuffer;
+};
+
+TEST_P(BufferSuballocationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BufferSuballocationPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {Allocation::Separate, Allocation::Suballocated});
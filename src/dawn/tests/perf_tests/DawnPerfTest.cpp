@@ -106,14 +106,27 @@ DawnPerfTestEnvironment::DawnPerfTestEnvironment(int argc, char** argv)
             continue;
         }
 
+        constexpr const char kWireReplayTraceArg[] = "--wire-replay-trace=";
+        argLen = sizeof(kWireReplayTraceArg) - 1;
+        if (strncmp(argv[i], kWireReplayTraceArg, argLen) == 0) {
+            const char* wireReplayTrace = argv[i] + argLen;
+            if (wireReplayTrace[0] != '\0') {
+                mWireReplayTraceFile = wireReplayTrace;
+            }
+            continue;
+        }
+
         if (strcmp("-h", argv[i]) == 0 || strcmp("--help", argv[i]) == 0) {
             dawn::InfoLog()
                 << "Additional flags:"
-                << " [--calibration] [--override-steps=x] [--trace-file=file]\n"
+                << " [--calibration] [--override-steps=x] [--trace-file=file]"
+                   " [--wire-replay-trace=file]\n"
                 << "  --calibration: Only run calibration. Calibration allows the perf test"
                    " runner script to save some time.\n"
                 << " --override-steps: Set a fixed number of steps to run for each test\n"
-                << " --trace-file: The file to dump trace results.\n";
+                << " --trace-file: The file to dump trace results.\n"
+                << " --wire-replay-trace: The wire trace to replay in WireReplayPerf, as recorded"
+                   " with --wire-trace-dir.\n";
             continue;
         }
     }
@@ -169,6 +182,10 @@ const char* DawnPerfTestEnvironment::GetTraceFile() const {
     return mTraceFile;
 }
 
+const char* DawnPerfTestEnvironment::GetWireReplayTraceFile() const {
+    return mWireReplayTraceFile;
+}
+
 DawnPerfTestPlatform* DawnPerfTestEnvironment::GetPlatform() const {
     return mPlatform.get();
 }
@@ -187,6 +204,10 @@ void DawnPerfTestBase::AbortTest() {
     mRunning = false;
 }
 
+const char* DawnPerfTestBase::GetWireReplayTraceFile() const {
+    return gTestEnv->GetWireReplayTraceFile();
+}
+
 void DawnPerfTestBase::RunTest() {
     if (gTestEnv->OverrideStepsToRun() == 0) {
         // Run to compute the approximate number of steps to perform.
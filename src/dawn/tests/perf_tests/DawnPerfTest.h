@@ -43,6 +43,9 @@ class DawnPerfTestEnvironment : public DawnTestEnvironment {
     // not be written to a json file.
     const char* GetTraceFile() const;
 
+    // Returns the path to the wire trace replayed by WireReplayPerf, or nullptr if there is none.
+    const char* GetWireReplayTraceFile() const;
+
     DawnPerfTestPlatform* GetPlatform() const;
 
   private:
@@ -54,6 +57,8 @@ class DawnPerfTestEnvironment : public DawnTestEnvironment {
 
     const char* mTraceFile = nullptr;
 
+    const char* mWireReplayTraceFile = nullptr;
+
     std::unique_ptr<DawnPerfTestPlatform> mPlatform;
 };
 
@@ -77,6 +82,8 @@ class DawnPerfTestBase {
     // Call if the test step was aborted and the test should stop running.
     void AbortTest();
 
+    const char* GetWireReplayTraceFile() const;
+
     void RunTest();
     void PrintPerIterationResultFromSeconds(const std::string& trace,
                                             double valueInSeconds,
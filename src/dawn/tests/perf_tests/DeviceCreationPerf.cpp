@@ -0,0 +1,53 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+// Test the performance of creating and destroying devices. On the Null backend this measures only
+// the frontend work done for each device (format table, caches, internal objects, ...).
+class DeviceCreationPerf : public DawnPerfTest {
+  public:
+    static constexpr unsigned int kNumIterations = 10;
+
+    DeviceCreationPerf() : DawnPerfTest(kNumIterations, 1) {}
+    ~DeviceCreationPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend is the one that best isolates the cost of the frontend.
+        DawnTestWithParams<>::SetUp();
+
+        // The devices are created directly on the native adapter.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+
+  private:
+    void Step() override {
+        for (unsigned int i = 0; i < kNumIterations; ++i) {
+            wgpu::Device newDevice = wgpu::Device::Acquire(GetAdapter().CreateDevice());
+            newDevice.Destroy();
+        }
+    }
+};
+
+TEST_P(DeviceCreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(DeviceCreationPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      NullBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
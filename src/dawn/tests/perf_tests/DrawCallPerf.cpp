@@ -607,7 +607,7 @@ TEST_P(DrawCallPerf, Run) {
 DAWN_INSTANTIATE_TEST_P(
     DrawCallPerf,
     {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend(),
-     VulkanBackend({"skip_validation"})},
+     VulkanBackend({"skip_validation"}), VulkanBackend({"single_threaded_device"})},
     {
         // Baseline
         MakeParam(),
@@ -0,0 +1,110 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+constexpr unsigned int kNumIterations = 10;
+constexpr uint32_t kNumRenderPasses = 16;
+constexpr uint32_t kNumDrawsPerRenderPass = 512;
+// The draws of each render pass use the same indirect parameters, like the shadow passes of a
+// GPU-driven renderer.
+constexpr uint32_t kNumIndirectDraws = 256;
+constexpr uint64_t kIndirectParamsSize = 5 * sizeof(uint32_t);
+constexpr uint32_t kTextureSize = 64;
+
+}  // anonymous namespace
+
+// Test the performance of encoding many indexed indirect draws in consecutive render passes, which
+// is dominated by the validation of the indirect parameters. On the Null backend this measures
+// only the CPU side of the validation.
+class IndirectDrawValidationPerf : public DawnPerfTest {
+  public:
+    IndirectDrawValidationPerf() : DawnPerfTest(kNumIterations, 1) {}
+    ~IndirectDrawValidationPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend is the one that best isolates the cost of the frontend.
+        DawnTestWithParams<>::SetUp();
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4<f32> {
+                return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4<f32> {
+                return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+            }
+        )");
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        std::vector<uint32_t> indirectData;
+        for (uint32_t i = 0; i < kNumIndirectDraws; ++i) {
+            // indexCount, instanceCount, firstIndex, baseVertex, firstInstance
+            indirectData.insert(indirectData.end(), {3, 1, 0, 0, 0});
+        }
+        mIndirectBuffer = utils::CreateBufferFromData(
+            device, indirectData.data(), indirectData.size() * sizeof(uint32_t),
+            wgpu::BufferUsage::Indirect);
+        mIndexBuffer =
+            utils::CreateBufferFromData<uint32_t>(device, wgpu::BufferUsage::Index, {0, 1, 2});
+
+        mRenderPass = utils::CreateBasicRenderPass(device, kTextureSize, kTextureSize);
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (unsigned int i = 0; i < kNumIterations; ++i) {
+            for (uint32_t pass = 0; pass < kNumRenderPasses; ++pass) {
+                wgpu::RenderPassEncoder renderPass =
+                    encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+                renderPass.SetPipeline(mPipeline);
+                renderPass.SetIndexBuffer(mIndexBuffer, wgpu::IndexFormat::Uint32);
+                for (uint32_t draw = 0; draw < kNumDrawsPerRenderPass; ++draw) {
+                    renderPass.DrawIndexedIndirect(
+                        mIndirectBuffer, (draw % kNumIndirectDraws) * kIndirectParamsSize);
+                }
+                renderPass.End();
+            }
+        }
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Buffer mIndirectBuffer;
+    wgpu::Buffer mIndexBuffer;
+    utils::BasicRenderPass mRenderPass;
+};
+
+TEST_P(IndirectDrawValidationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(IndirectDrawValidationPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      NullBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
@@ -0,0 +1,178 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sstream>
+#include <string>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+constexpr unsigned int kObjectsPerStep = 256;
+// The number of helper functions in the shader, which makes its source about 20KB.
+constexpr uint32_t kHelperFunctionCount = 200;
+constexpr uint32_t kVertexAttributeCount = 8;
+constexpr uint32_t kColorTargetCount = 4;
+
+enum class Workload {
+    ShaderModule,    // Creation of a shader module identical to an existing one.
+    RenderPipeline,  // Creation of a complex render pipeline identical to an existing one.
+};
+
+std::ostream& operator<<(std::ostream& ostream, const Workload& workload) {
+    switch (workload) {
+        case Workload::ShaderModule:
+            ostream << "ShaderModule";
+            break;
+        case Workload::RenderPipeline:
+            ostream << "RenderPipeline";
+            break;
+    }
+    return ostream;
+}
+
+struct PipelineCreationParams : AdapterTestParam {
+    PipelineCreationParams(const AdapterTestParam& param, Workload workloadIn)
+        : AdapterTestParam(param), workload(workloadIn) {}
+    Workload workload;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const PipelineCreationParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.workload;
+    return ostream;
+}
+
+// A shader with many vertex inputs and color outputs, and many unused helper functions so that
+// its source is large like the ones of real applications.
+std::string MakeShaderSource() {
+    std::ostringstream source;
+    for (uint32_t i = 0; i < kHelperFunctionCount; ++i) {
+        source << "fn helper" << i << "(v : vec4<f32>) -> vec4<f32> {\n"
+               << "    return v * " << i << ".0 + vec4<f32>(0.25, 0.5, 0.75, 1.0);\n"
+               << "}\n";
+    }
+
+    source << "struct VertexIn {\n";
+    for (uint32_t i = 0; i < kVertexAttributeCount; ++i) {
+        source << "    @location(" << i << ") a" << i << " : vec4<f32>,\n";
+    }
+    source << "}\n";
+    source << "@vertex fn vs_main(input : VertexIn) -> @builtin(position) vec4<f32> {\n"
+           << "    return input.a0";
+    for (uint32_t i = 1; i < kVertexAttributeCount; ++i) {
+        source << " + input.a" << i;
+    }
+    source << ";\n}\n";
+
+    source << "struct FragmentOut {\n";
+    for (uint32_t i = 0; i < kColorTargetCount; ++i) {
+        source << "    @location(" << i << ") c" << i << " : vec4<f32>,\n";
+    }
+    source << "}\n";
+    source << "@fragment fn fs_main() -> FragmentOut {\n"
+           << "    var output : FragmentOut;\n";
+    for (uint32_t i = 0; i < kColorTargetCount; ++i) {
+        source << "    output.c" << i << " = vec4<f32>(0.5);\n";
+    }
+    source << "    return output;\n}\n";
+    return source.str();
+}
+
+}  // anonymous namespace
+
+// Test the performance of creating shader modules and render pipelines that are already in the
+// frontend caches, which is dominated by the hashing and comparison of their content. Validation
+// is skipped since it parses the shader modules before looking them up in the cache. On the Null
+// backend this measures only the CPU cost of the frontend.
+class PipelineCreationPerf : public DawnPerfTestWithParams<PipelineCreationParams> {
+  public:
+    PipelineCreationPerf() : DawnPerfTestWithParams(kObjectsPerStep, 1) {}
+    ~PipelineCreationPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend is the one that best isolates the cost of the frontend.
+        DawnTestWithParams<PipelineCreationParams>::SetUp();
+
+        mSource = MakeShaderSource();
+        // The module and the pipeline are kept alive so that the creations in Step find them in
+        // the caches.
+        mModule = utils::CreateShaderModule(device, mSource.c_str());
+        InitializeRenderPipelineDescriptor();
+        mPipeline = device.CreateRenderPipeline(&mPipelineDesc);
+    }
+
+  private:
+    void InitializeRenderPipelineDescriptor() {
+        mPipelineDesc.vertex.module = mModule;
+        mPipelineDesc.vertex.entryPoint = "vs_main";
+        mPipelineDesc.vertex.bufferCount = kVertexAttributeCount;
+        for (uint32_t i = 0; i < kVertexAttributeCount; ++i) {
+            mPipelineDesc.cBuffers[i].arrayStride = 16;
+            mPipelineDesc.cBuffers[i].attributeCount = 1;
+            mPipelineDesc.cBuffers[i].attributes = &mPipelineDesc.cAttributes[i];
+            mPipelineDesc.cAttributes[i].shaderLocation = i;
+            mPipelineDesc.cAttributes[i].format = wgpu::VertexFormat::Float32x4;
+        }
+
+        mPipelineDesc.cFragment.module = mModule;
+        mPipelineDesc.cFragment.entryPoint = "fs_main";
+        mPipelineDesc.cFragment.targetCount = kColorTargetCount;
+        for (uint32_t i = 0; i < kColorTargetCount; ++i) {
+            mPipelineDesc.cTargets[i].format = wgpu::TextureFormat::RGBA8Unorm;
+            mPipelineDesc.cBlends[i].color.srcFactor = wgpu::BlendFactor::SrcAlpha;
+            mPipelineDesc.cBlends[i].color.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+            mPipelineDesc.cTargets[i].blend = &mPipelineDesc.cBlends[i];
+        }
+
+        wgpu::DepthStencilState* depthStencil = mPipelineDesc.EnableDepthStencil();
+        depthStencil->depthWriteEnabled = true;
+        depthStencil->depthCompare = wgpu::CompareFunction::Less;
+        mPipelineDesc.primitive.cullMode = wgpu::CullMode::Back;
+        mPipelineDesc.layout = utils::MakePipelineLayout(device, {});
+    }
+
+    void Step() override {
+        switch (GetParam().workload) {
+            case Workload::ShaderModule:
+                for (unsigned int i = 0; i < kObjectsPerStep; ++i) {
+                    utils::CreateShaderModule(device, mSource.c_str());
+                }
+                break;
+            case Workload::RenderPipeline:
+                for (unsigned int i = 0; i < kObjectsPerStep; ++i) {
+                    device.CreateRenderPipeline(&mPipelineDesc);
+                }
+                break;
+        }
+    }
+
+    std::string mSource;
+    wgpu::ShaderModule mModule;
+    utils::ComboRenderPipelineDescriptor mPipelineDesc;
+    wgpu::RenderPipeline mPipeline;
+};
+
+TEST_P(PipelineCreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(PipelineCreationPerf,
+                        {D3D12Backend({"skip_validation"}), MetalBackend({"skip_validation"}),
+                         NullBackend({"skip_validation"}), OpenGLBackend({"skip_validation"}),
+                         VulkanBackend({"skip_validation"})},
+                        {Workload::ShaderModule, Workload::RenderPipeline});
@@ -0,0 +1,226 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/SharedMemoryTransferService.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace {
+
+enum class MemoryTransfer {
+    Inline,        // The default transfer service, which copies the data in the commands.
+    SharedMemory,  // utils::SharedMemory*TransferService.
+};
+
+std::ostream& operator<<(std::ostream& ostream, const MemoryTransfer& memoryTransfer) {
+    switch (memoryTransfer) {
+        case MemoryTransfer::Inline:
+            ostream << "Inline";
+            break;
+        case MemoryTransfer::SharedMemory:
+            ostream << "SharedMemory";
+            break;
+    }
+    return ostream;
+}
+
+enum class ReadbackSize {
+    Size1MB,
+    Size64MB,
+};
+
+std::ostream& operator<<(std::ostream& ostream, const ReadbackSize& size) {
+    switch (size) {
+        case ReadbackSize::Size1MB:
+            ostream << "1MB";
+            break;
+        case ReadbackSize::Size64MB:
+            ostream << "64MB";
+            break;
+    }
+    return ostream;
+}
+
+uint64_t GetBufferSize(ReadbackSize size) {
+    return size == ReadbackSize::Size1MB ? 1 << 20 : 64 << 20;
+}
+
+struct WireBufferReadbackParams : AdapterTestParam {
+    WireBufferReadbackParams(const AdapterTestParam& param,
+                             MemoryTransfer memoryTransferIn,
+                             ReadbackSize readbackSizeIn)
+        : AdapterTestParam(param), memoryTransfer(memoryTransferIn), readbackSize(readbackSizeIn) {}
+    MemoryTransfer memoryTransfer;
+    ReadbackSize readbackSize;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const WireBufferReadbackParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.memoryTransfer << "_" << param.readbackSize;
+    return ostream;
+}
+
+}  // anonymous namespace
+
+// Test the performance of reading back a large buffer through the wire, with the inline transfer
+// service that copies the data in the commands or with the shared memory transfer services. The
+// test uses its own WireClient and WireServer on top of the test's device so that it can choose
+// the transfer services, and calls the client procs directly.
+class WireBufferReadbackPerf : public DawnPerfTestWithParams<WireBufferReadbackParams> {
+  public:
+    WireBufferReadbackPerf() : DawnPerfTestWithParams(1, 1) {}
+    ~WireBufferReadbackPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend measures only the cost of the wire.
+        DawnTestWithParams<WireBufferReadbackParams>::SetUp();
+        // The test creates its own wire on top of the native device.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        mBufferSize = GetBufferSize(GetParam().readbackSize);
+        mNativeProcs = dawn::native::GetProcs();
+        mClientProcs = dawn::wire::client::GetProcs();
+
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &mNativeProcs;
+        serverDesc.serializer = &mS2cBuf;
+        dawn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = &mC2sBuf;
+        if (GetParam().memoryTransfer == MemoryTransfer::SharedMemory) {
+            mServerTransferService = std::make_unique<utils::SharedMemoryServerTransferService>();
+            mClientTransferService = std::make_unique<utils::SharedMemoryClientTransferService>(
+                [this](uint64_t id, int fd, size_t size) {
+                    return mServerTransferService->ImportRegion(id, dup(fd), size);
+                });
+            serverDesc.memoryTransferService = mServerTransferService.get();
+            clientDesc.memoryTransferService = mClientTransferService.get();
+        }
+        mWireServer = std::make_unique<dawn::wire::WireServer>(serverDesc);
+        mWireClient = std::make_unique<dawn::wire::WireClient>(clientDesc);
+        mC2sBuf.SetHandler(mWireServer.get());
+        mS2cBuf.SetHandler(mWireClient.get());
+
+        dawn::wire::ReservedDevice reservation = mWireClient->ReserveDevice();
+        ASSERT_TRUE(
+            mWireServer->InjectDevice(device.Get(), reservation.id, reservation.generation));
+        mClientDevice = reservation.device;
+        mClientQueue = mClientProcs.deviceGetQueue(mClientDevice);
+
+        // Fill the source buffer through the wire.
+        WGPUBufferDescriptor desc = {};
+        desc.size = mBufferSize;
+        desc.usage = WGPUBufferUsage_CopySrc;
+        desc.mappedAtCreation = true;
+        mSourceBuffer = mClientProcs.deviceCreateBuffer(mClientDevice, &desc);
+        uint32_t* sourceData = static_cast<uint32_t*>(
+            mClientProcs.bufferGetMappedRange(mSourceBuffer, 0, mBufferSize));
+        ASSERT_NE(sourceData, nullptr);
+        for (uint64_t i = 0; i < mBufferSize / sizeof(uint32_t); ++i) {
+            sourceData[i] = static_cast<uint32_t>(i);
+        }
+        mClientProcs.bufferUnmap(mSourceBuffer);
+
+        desc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_MapRead;
+        desc.mappedAtCreation = false;
+        mReadbackBuffer = mClientProcs.deviceCreateBuffer(mClientDevice, &desc);
+        mReadbackData.resize(mBufferSize);
+        ASSERT_TRUE(mC2sBuf.Flush());
+    }
+
+    void TearDown() override {
+        if (mWireClient != nullptr) {
+            if (mReadbackBuffer != nullptr) {
+                mClientProcs.bufferRelease(mReadbackBuffer);
+                mClientProcs.bufferRelease(mSourceBuffer);
+                mClientProcs.queueRelease(mClientQueue);
+                mClientProcs.deviceRelease(mClientDevice);
+            }
+            mC2sBuf.Flush();
+            mWireClient = nullptr;
+            mWireServer = nullptr;
+        }
+        DawnTestWithParams<WireBufferReadbackParams>::TearDown();
+    }
+
+  private:
+    void Step() override {
+        WGPUCommandEncoder encoder =
+            mClientProcs.deviceCreateCommandEncoder(mClientDevice, nullptr);
+        mClientProcs.commandEncoderCopyBufferToBuffer(encoder, mSourceBuffer, 0, mReadbackBuffer,
+                                                      0, mBufferSize);
+        WGPUCommandBuffer commands = mClientProcs.commandEncoderFinish(encoder, nullptr);
+        mClientProcs.queueSubmit(mClientQueue, 1, &commands);
+        mClientProcs.commandBufferRelease(commands);
+        mClientProcs.commandEncoderRelease(encoder);
+
+        bool mapped = false;
+        mClientProcs.bufferMapAsync(
+            mReadbackBuffer, WGPUMapMode_Read, 0, mBufferSize,
+            [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                ASSERT_EQ(status, WGPUBufferMapAsyncStatus_Success);
+                *static_cast<bool*>(userdata) = true;
+            },
+            &mapped);
+        while (!mapped) {
+            if (!mC2sBuf.Flush() || !mS2cBuf.Flush()) {
+                AbortTest();
+                return;
+            }
+            device.Tick();
+        }
+
+        // Copy the data out like an application would, so that the cost of accessing the
+        // mapping is included.
+        const void* data =
+            mClientProcs.bufferGetConstMappedRange(mReadbackBuffer, 0, mBufferSize);
+        memcpy(mReadbackData.data(), data, mBufferSize);
+        mClientProcs.bufferUnmap(mReadbackBuffer);
+    }
+
+    uint64_t mBufferSize;
+    DawnProcTable mNativeProcs;
+    DawnProcTable mClientProcs;
+
+    utils::TerribleCommandBuffer mC2sBuf;
+    utils::TerribleCommandBuffer mS2cBuf;
+    std::unique_ptr<utils::SharedMemoryServerTransferService> mServerTransferService;
+    std::unique_ptr<utils::SharedMemoryClientTransferService> mClientTransferService;
+    std::unique_ptr<dawn::wire::WireServer> mWireServer;
+    std::unique_ptr<dawn::wire::WireClient> mWireClient;
+
+    WGPUDevice mClientDevice = nullptr;
+    WGPUQueue mClientQueue = nullptr;
+    WGPUBuffer mSourceBuffer = nullptr;
+    WGPUBuffer mReadbackBuffer = nullptr;
+    std::vector<char> mReadbackData;
+};
+
+TEST_P(WireBufferReadbackPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(WireBufferReadbackPerf,
+                        {NullBackend(), OpenGLBackend(), VulkanBackend()},
+                        {MemoryTransfer::Inline, MemoryTransfer::SharedMemory},
+                        {ReadbackSize::Size1MB, ReadbackSize::Size64MB});
@@ -0,0 +1,377 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/Timer.h"
+#include "dawn/utils/WireTrace.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireCompression.h"
+
+namespace {
+
+constexpr unsigned int kRenderPassesPerFrame = 4;
+constexpr unsigned int kDrawsPerRenderPass = 256;
+constexpr unsigned int kWriteBuffersPerFrame = 16;
+constexpr uint64_t kUniformBufferSize = 512;
+constexpr uint64_t kWriteBufferSize = 256;
+
+enum class CommandStream {
+    Frame,  // A frame of WriteBuffers and draws recorded from a WireClient.
+    Trace,  // The wire trace passed with --wire-replay-trace.
+};
+
+std::ostream& operator<<(std::ostream& ostream, const CommandStream& stream) {
+    switch (stream) {
+        case CommandStream::Frame:
+            ostream << "Frame";
+            break;
+        case CommandStream::Trace:
+            ostream << "Trace";
+            break;
+    }
+    return ostream;
+}
+
+struct WireCompressionParams : AdapterTestParam {
+    WireCompressionParams(const AdapterTestParam& param, CommandStream streamIn)
+        : AdapterTestParam(param), stream(streamIn) {}
+    CommandStream stream;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const WireCompressionParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.stream;
+    return ostream;
+}
+
+// A command stream as it was given to the transport: the allocations of the CommandSerializer
+// and the flushes after some of them.
+class CapturedStream : public dawn::wire::CommandSerializer {
+  public:
+    struct Allocation {
+        size_t offset;
+        size_t size;
+        bool flushAfter;
+    };
+
+    size_t GetMaximumAllocationSize() const override {
+        return dawn::wire::CompressingCommandSerializer::kMaxFrameSize;
+    }
+    void* GetCmdSpace(size_t size) override {
+        size_t offset = mData.size();
+        mData.resize(offset + size);
+        mAllocations.push_back({offset, size, false});
+        return &mData[offset];
+    }
+    bool Flush() override {
+        if (!mAllocations.empty()) {
+            mAllocations.back().flushAfter = true;
+        }
+        return true;
+    }
+
+    void Clear() {
+        mData.clear();
+        mAllocations.clear();
+    }
+
+    const std::vector<Allocation>& GetAllocations() const { return mAllocations; }
+    const char* GetData(const Allocation& allocation) const { return &mData[allocation.offset]; }
+    size_t GetSize() const { return mData.size(); }
+
+  private:
+    std::vector<char> mData;
+    std::vector<Allocation> mAllocations;
+};
+
+// Stores the compressed messages of a step, reusing their storage.
+class MessageRecorder : public dawn::wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        if (mMessageCount == mMessages.size()) {
+            mMessages.emplace_back();
+        }
+        std::vector<char>& message = mMessages[mMessageCount];
+        size_t offset = message.size();
+        message.resize(offset + size);
+        return &message[offset];
+    }
+    bool Flush() override {
+        // Flushes without commands don't send a message.
+        if (mMessageCount < mMessages.size() && !mMessages[mMessageCount].empty()) {
+            mMessageCount++;
+        }
+        return true;
+    }
+
+    // Passes the messages to |handler| and clears them.
+    bool HandleMessages(dawn::wire::CommandHandler* handler) {
+        bool success = true;
+        for (size_t i = 0; i < mMessageCount; ++i) {
+            success = success &&
+                      handler->HandleCommands(mMessages[i].data(), mMessages[i].size()) != nullptr;
+            mMessages[i].clear();
+        }
+        mMessageCount = 0;
+        return success;
+    }
+
+  private:
+    std::vector<std::vector<char>> mMessages;
+    size_t mMessageCount = 0;
+};
+
+// Stands for the wire on the receiving side.
+class DiscardingCommandHandler : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        return commands + size;
+    }
+};
+
+// Records a frame of commands from a WireClient without a server, flushed at each submit.
+void CaptureFrame(CapturedStream* stream) {
+    const DawnProcTable& procs = dawn::wire::client::GetProcs();
+    dawn::wire::WireClientDescriptor clientDesc = {};
+    clientDesc.serializer = stream;
+    clientDesc.flushPolicy.flushOnSubmit = true;
+    auto wireClient = std::make_unique<dawn::wire::WireClient>(clientDesc);
+
+    WGPUDevice device = wireClient->ReserveDevice().device;
+    WGPUQueue queue = procs.deviceGetQueue(device);
+
+    WGPUBufferDescriptor bufferDesc = {};
+    bufferDesc.size = kUniformBufferSize;
+    bufferDesc.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
+    WGPUBuffer buffer = procs.deviceCreateBuffer(device, &bufferDesc);
+
+    WGPUBindGroupLayoutEntry layoutEntry = {};
+    layoutEntry.binding = 0;
+    layoutEntry.visibility = WGPUShaderStage_Vertex;
+    layoutEntry.buffer.type = WGPUBufferBindingType_Uniform;
+    layoutEntry.buffer.hasDynamicOffset = true;
+    WGPUBindGroupLayoutDescriptor layoutDesc = {};
+    layoutDesc.entryCount = 1;
+    layoutDesc.entries = &layoutEntry;
+    WGPUBindGroupLayout layout = procs.deviceCreateBindGroupLayout(device, &layoutDesc);
+
+    WGPUBindGroupEntry entry = {};
+    entry.binding = 0;
+    entry.buffer = buffer;
+    entry.size = 16;
+    WGPUBindGroupDescriptor bindGroupDesc = {};
+    bindGroupDesc.layout = layout;
+    bindGroupDesc.entryCount = 1;
+    bindGroupDesc.entries = &entry;
+    WGPUBindGroup bindGroup = procs.deviceCreateBindGroup(device, &bindGroupDesc);
+
+    WGPUTextureDescriptor textureDesc = {};
+    textureDesc.usage = WGPUTextureUsage_RenderAttachment;
+    textureDesc.dimension = WGPUTextureDimension_2D;
+    textureDesc.size = {1, 1, 1};
+    textureDesc.format = WGPUTextureFormat_RGBA8Unorm;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.sampleCount = 1;
+    WGPUTexture texture = procs.deviceCreateTexture(device, &textureDesc);
+    WGPUTextureView view = procs.textureCreateView(texture, nullptr);
+
+    // Only the commands of the frame itself are measured.
+    wireClient->Flush();
+    stream->Clear();
+
+    // Uniform data like transforms that change a bit for each object.
+    std::vector<float> uniforms(kWriteBufferSize / sizeof(float));
+    for (unsigned int i = 0; i < kWriteBuffersPerFrame; ++i) {
+        for (size_t j = 0; j < uniforms.size(); ++j) {
+            uniforms[j] = j % 5 == 0 ? 1.0f : 0.125f * static_cast<float>(i + j % 7);
+        }
+        procs.queueWriteBuffer(queue, buffer, 0, uniforms.data(), kWriteBufferSize);
+    }
+
+    for (unsigned int i = 0; i < kRenderPassesPerFrame; ++i) {
+        WGPUCommandEncoder encoder = procs.deviceCreateCommandEncoder(device, nullptr);
+        WGPURenderPassColorAttachment attachment = {};
+        attachment.view = view;
+        attachment.loadOp = WGPULoadOp_Load;
+        attachment.storeOp = WGPUStoreOp_Store;
+        attachment.clearColor = {NAN, NAN, NAN, NAN};
+        WGPURenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+        WGPURenderPassEncoder pass = procs.commandEncoderBeginRenderPass(encoder, &passDesc);
+        for (unsigned int j = 0; j < kDrawsPerRenderPass; ++j) {
+            uint32_t offset = static_cast<uint32_t>(j % 16 * 256 % kUniformBufferSize);
+            procs.renderPassEncoderSetBindGroup(pass, 0, bindGroup, 1, &offset);
+            procs.renderPassEncoderDraw(pass, 3 * (1 + j % 4), 1, 3 * j, 0);
+        }
+        procs.renderPassEncoderEnd(pass);
+
+        WGPUCommandBuffer commands = procs.commandEncoderFinish(encoder, nullptr);
+        procs.queueSubmit(queue, 1, &commands);
+        procs.commandBufferRelease(commands);
+        procs.renderPassEncoderRelease(pass);
+        procs.commandEncoderRelease(encoder);
+    }
+    wireClient->Flush();
+
+    procs.textureViewRelease(view);
+    procs.textureRelease(texture);
+    procs.bindGroupRelease(bindGroup);
+    procs.bindGroupLayoutRelease(layout);
+    procs.bufferRelease(buffer);
+    procs.queueRelease(queue);
+    procs.deviceRelease(device);
+}
+
+// Splits a wire trace in messages flushed at each Queue::Submit.
+bool CaptureTrace(const char* traceFile, CapturedStream* stream) {
+    std::unique_ptr<utils::WireTrace> trace = utils::WireTrace::LoadFromFile(traceFile);
+    if (trace == nullptr) {
+        return false;
+    }
+    for (const utils::WireTrace::Command& command : trace->GetCommands()) {
+        if (command.size > stream->GetMaximumAllocationSize()) {
+            return false;
+        }
+        memcpy(stream->GetCmdSpace(command.size), trace->GetCommandData(command), command.size);
+        const char* name = dawn::wire::GetWireCommandName(command.id);
+        if (name != nullptr && strcmp(name, "QueueSubmit") == 0) {
+            stream->Flush();
+        }
+    }
+    stream->Flush();
+    return true;
+}
+
+}  // anonymous namespace
+
+// Test the optional compression of the wire command stream: its compression ratio and its CPU
+// cost on both sides. Each step compresses a captured command stream with a
+// CompressingCommandSerializer, with the same allocations and flushes as when it was captured,
+// and decompresses the resulting messages with a DecompressingCommandHandler. The commands
+// aren't handled by a WireServer so that only the cost of the compression is measured.
+//
+// The streams are either a frame recorded from a WireClient, flushed at each submit, or a wire
+// trace passed with --wire-replay-trace, flushed at each Queue::Submit of the trace. Traces are
+// recorded by running any of the tests with --use-wire --wire-trace-dir=<dir>.
+class WireCompressionPerf : public DawnPerfTestWithParams<WireCompressionParams> {
+  public:
+    WireCompressionPerf() : DawnPerfTestWithParams(1, 1), mTimer(utils::CreateTimer()) {}
+    ~WireCompressionPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the test
+        // doesn't use the GPU.
+        DawnTestWithParams<WireCompressionParams>::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        switch (GetParam().stream) {
+            case CommandStream::Frame:
+                CaptureFrame(&mStream);
+                break;
+            case CommandStream::Trace: {
+                const char* traceFile = GetWireReplayTraceFile();
+                DAWN_TEST_UNSUPPORTED_IF(traceFile == nullptr);
+                ASSERT_TRUE(CaptureTrace(traceFile, &mStream));
+                break;
+            }
+        }
+        ASSERT_GT(mStream.GetSize(), 0u);
+
+        mSerializer = std::make_unique<dawn::wire::CompressingCommandSerializer>(&mTransport);
+        mHandler = std::make_unique<dawn::wire::DecompressingCommandHandler>(&mWire);
+    }
+
+  protected:
+    void PrintCompressionResults() const {
+        if (mStepCount == 0) {
+            return;
+        }
+        dawn::wire::WireCompressionStats stats = mSerializer->GetStats();
+        double megabytes = static_cast<double>(stats.uncompressedBytes) / (1024.0 * 1024.0);
+        PrintResult("uncompressed_size",
+                    static_cast<double>(stats.uncompressedBytes) / static_cast<double>(mStepCount),
+                    "bytes", false);
+        PrintResult("compressed_size",
+                    static_cast<double>(stats.compressedBytes) / static_cast<double>(mStepCount),
+                    "bytes", false);
+        PrintResult("compression_ratio",
+                    static_cast<double>(stats.uncompressedBytes) /
+                        static_cast<double>(stats.compressedBytes),
+                    "ratio", true);
+        PrintResult("compress_throughput", megabytes / mCompressSeconds, "MB/s", true);
+        PrintResult("decompress_throughput", megabytes / mDecompressSeconds, "MB/s", true);
+    }
+
+  private:
+    void Step() override {
+        mTimer->Start();
+        bool success = true;
+        for (const CapturedStream::Allocation& allocation : mStream.GetAllocations()) {
+            void* space = mSerializer->GetCmdSpace(allocation.size);
+            if (space == nullptr) {
+                success = false;
+                break;
+            }
+            memcpy(space, mStream.GetData(allocation), allocation.size);
+            if (allocation.flushAfter && !mSerializer->Flush()) {
+                success = false;
+                break;
+            }
+        }
+        success = success && mSerializer->Flush();
+        mTimer->Stop();
+        mCompressSeconds += mTimer->GetElapsedTime();
+
+        mTimer->Start();
+        success = mTransport.HandleMessages(mHandler.get()) && success;
+        mTimer->Stop();
+        mDecompressSeconds += mTimer->GetElapsedTime();
+
+        if (!success || !mHandler->IsCompressed()) {
+            AbortTest();
+            return;
+        }
+        mStepCount++;
+    }
+
+    std::unique_ptr<utils::Timer> mTimer;
+
+    CapturedStream mStream;
+    MessageRecorder mTransport;
+    DiscardingCommandHandler mWire;
+    std::unique_ptr<dawn::wire::CompressingCommandSerializer> mSerializer;
+    std::unique_ptr<dawn::wire::DecompressingCommandHandler> mHandler;
+
+    // The statistics of the steps, including those of the warmup.
+    uint64_t mStepCount = 0;
+    double mCompressSeconds = 0.0;
+    double mDecompressSeconds = 0.0;
+};
+
+TEST_P(WireCompressionPerf, Run) {
+    RunTest();
+    PrintCompressionResults();
+}
+
+DAWN_INSTANTIATE_TEST_P(WireCompressionPerf,
+                        {NullBackend()},
+                        {CommandStream::Frame, CommandStream::Trace});
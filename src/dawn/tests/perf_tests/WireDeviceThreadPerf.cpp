@@ -0,0 +1,292 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace {
+
+constexpr unsigned int kDeviceCount = 4;
+constexpr unsigned int kRenderPassesPerDevice = 4;
+constexpr unsigned int kDrawsPerRenderPass = 256;
+
+struct WireDeviceThreadParams : AdapterTestParam {
+    WireDeviceThreadParams(const AdapterTestParam& param, uint32_t deviceThreadCountIn)
+        : AdapterTestParam(param), deviceThreadCount(deviceThreadCountIn) {}
+    uint32_t deviceThreadCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const WireDeviceThreadParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_DeviceThreads" << param.deviceThreadCount;
+    return ostream;
+}
+
+// Sends the commands of the client to the server at each flush, or captures them to replay them
+// later.
+class CapturingCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    void SetHandler(dawn::wire::CommandHandler* handler) { mHandler = handler; }
+    void StartCapture() { mCapturing = true; }
+    std::vector<char> StopCapture() {
+        mCapturing = false;
+        std::vector<char> commands(mCommands.begin(), mCommands.begin() + mSize);
+        mSize = 0;
+        return commands;
+    }
+
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        if (mCommands.size() - mSize < size) {
+            mCommands.resize(std::max(mCommands.size() * 2, mSize + size));
+        }
+        char* result = &mCommands[mSize];
+        mSize += size;
+        return result;
+    }
+    bool Flush() override {
+        if (mCapturing || mSize == 0) {
+            return true;
+        }
+        bool success = mHandler->HandleCommands(mCommands.data(), mSize) != nullptr;
+        mSize = 0;
+        return success;
+    }
+
+  private:
+    dawn::wire::CommandHandler* mHandler = nullptr;
+    std::vector<char> mCommands;
+    size_t mSize = 0;
+    bool mCapturing = false;
+};
+
+// The return commands are serialized by the device threads, which is the only thing this
+// serializer may be used by.
+class DiscardingCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        if (mCommands.size() < size) {
+            mCommands.resize(size);
+        }
+        return mCommands.data();
+    }
+    bool Flush() override { return true; }
+
+  private:
+    std::vector<char> mCommands;
+};
+
+constexpr char kShader[] = R"(
+    @vertex fn vs_main(@builtin(vertex_index) i : u32) -> @builtin(position) vec4<f32> {
+        return vec4<f32>(f32(i), 0.0, 0.0, 1.0);
+    }
+
+    @fragment fn fs_main() -> @location(0) vec4<f32> {
+        return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+    }
+)";
+
+}  // anonymous namespace
+
+// Measures how the WireServer scales with the number of device threads when it handles the
+// commands of several independent devices, like the GPU process of a browser with many tabs.
+// The commands of a frame of all the devices, each with render passes of many draws, are
+// captured once from a WireClient and each step replays them on the WireServer and waits for the
+// device threads to handle them. The server is on top of the Null backend so the time is spent
+// in the wire and the frontend.
+class WireDeviceThreadPerf : public DawnPerfTestWithParams<WireDeviceThreadParams> {
+  public:
+    WireDeviceThreadPerf() : DawnPerfTestWithParams(1, 1) {}
+    ~WireDeviceThreadPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend measures only the cost of the wire and the frontend.
+        DawnTestWithParams<WireDeviceThreadParams>::SetUp();
+        // The test creates its own wire on top of native devices.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        mNativeProcs = dawn::native::GetProcs();
+        mClientProcs = dawn::wire::client::GetProcs();
+
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &mNativeProcs;
+        serverDesc.serializer = &mS2cBuf;
+        serverDesc.deviceThreadCount = GetParam().deviceThreadCount;
+        dawn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = &mC2sBuf;
+        mWireServer = std::make_unique<dawn::wire::WireServer>(serverDesc);
+        mWireClient = std::make_unique<dawn::wire::WireClient>(clientDesc);
+        mC2sBuf.SetHandler(mWireServer.get());
+
+        for (DeviceObjects& objects : mDevices) {
+            objects.nativeDevice = GetAdapter().CreateDevice();
+            ASSERT_NE(objects.nativeDevice, nullptr);
+            dawn::wire::ReservedDevice reservation = mWireClient->ReserveDevice();
+            ASSERT_TRUE(mWireServer->InjectDevice(objects.nativeDevice, reservation.id,
+                                                  reservation.generation));
+            objects.device = reservation.device;
+            objects.queue = mClientProcs.deviceGetQueue(objects.device);
+            CreateObjects(&objects);
+        }
+        ASSERT_TRUE(mWireClient->Flush());
+
+        mC2sBuf.StartCapture();
+        for (DeviceObjects& objects : mDevices) {
+            for (unsigned int i = 0; i < kRenderPassesPerDevice; ++i) {
+                EncodeRenderPass(objects);
+            }
+        }
+        ASSERT_TRUE(mWireClient->Flush());
+        mFrameCommands = mC2sBuf.StopCapture();
+    }
+
+    void TearDown() override {
+        if (mWireClient != nullptr) {
+            for (DeviceObjects& objects : mDevices) {
+                if (objects.device == nullptr) {
+                    continue;
+                }
+                mClientProcs.renderPipelineRelease(objects.pipeline);
+                mClientProcs.textureViewRelease(objects.renderTargetView);
+                mClientProcs.textureRelease(objects.renderTarget);
+                mClientProcs.queueRelease(objects.queue);
+                mClientProcs.deviceRelease(objects.device);
+            }
+            mWireClient->Flush();
+            mWireClient = nullptr;
+            mWireServer = nullptr;
+        }
+        for (DeviceObjects& objects : mDevices) {
+            if (objects.nativeDevice != nullptr) {
+                mNativeProcs.deviceRelease(objects.nativeDevice);
+            }
+        }
+        DawnTestWithParams<WireDeviceThreadParams>::TearDown();
+    }
+
+  private:
+    struct DeviceObjects {
+        WGPUDevice nativeDevice = nullptr;
+        WGPUDevice device = nullptr;
+        WGPUQueue queue = nullptr;
+        WGPURenderPipeline pipeline = nullptr;
+        WGPUTexture renderTarget = nullptr;
+        WGPUTextureView renderTargetView = nullptr;
+    };
+
+    void CreateObjects(DeviceObjects* objects) {
+        WGPUShaderModuleWGSLDescriptor wgslDesc = {};
+        wgslDesc.chain.sType = WGPUSType_ShaderModuleWGSLDescriptor;
+        wgslDesc.source = kShader;
+        WGPUShaderModuleDescriptor moduleDesc = {};
+        moduleDesc.nextInChain = &wgslDesc.chain;
+        WGPUShaderModule module =
+            mClientProcs.deviceCreateShaderModule(objects->device, &moduleDesc);
+
+        WGPUColorTargetState target = {};
+        target.format = WGPUTextureFormat_RGBA8Unorm;
+        target.writeMask = WGPUColorWriteMask_All;
+        WGPUFragmentState fragment = {};
+        fragment.module = module;
+        fragment.entryPoint = "fs_main";
+        fragment.targetCount = 1;
+        fragment.targets = &target;
+
+        WGPURenderPipelineDescriptor pipelineDesc = {};
+        pipelineDesc.vertex.module = module;
+        pipelineDesc.vertex.entryPoint = "vs_main";
+        pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+        pipelineDesc.multisample.count = 1;
+        pipelineDesc.multisample.mask = 0xFFFFFFFF;
+        pipelineDesc.fragment = &fragment;
+        objects->pipeline = mClientProcs.deviceCreateRenderPipeline(objects->device, &pipelineDesc);
+        mClientProcs.shaderModuleRelease(module);
+
+        WGPUTextureDescriptor textureDesc = {};
+        textureDesc.usage = WGPUTextureUsage_RenderAttachment;
+        textureDesc.dimension = WGPUTextureDimension_2D;
+        textureDesc.size = {1, 1, 1};
+        textureDesc.format = WGPUTextureFormat_RGBA8Unorm;
+        textureDesc.mipLevelCount = 1;
+        textureDesc.sampleCount = 1;
+        objects->renderTarget = mClientProcs.deviceCreateTexture(objects->device, &textureDesc);
+        objects->renderTargetView = mClientProcs.textureCreateView(objects->renderTarget, nullptr);
+    }
+
+    // Encodes and submits a render pass, releasing all the objects it creates so that the
+    // captured commands can be replayed.
+    void EncodeRenderPass(const DeviceObjects& objects) {
+        WGPUCommandEncoder encoder =
+            mClientProcs.deviceCreateCommandEncoder(objects.device, nullptr);
+
+        WGPURenderPassColorAttachment attachment = {};
+        attachment.view = objects.renderTargetView;
+        attachment.loadOp = WGPULoadOp_Load;
+        attachment.storeOp = WGPUStoreOp_Store;
+        attachment.clearColor = {NAN, NAN, NAN, NAN};
+        WGPURenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+        WGPURenderPassEncoder pass = mClientProcs.commandEncoderBeginRenderPass(encoder, &passDesc);
+        mClientProcs.renderPassEncoderSetPipeline(pass, objects.pipeline);
+        for (unsigned int i = 0; i < kDrawsPerRenderPass; ++i) {
+            mClientProcs.renderPassEncoderDraw(pass, 3, 1, 0, 0);
+        }
+        mClientProcs.renderPassEncoderEnd(pass);
+
+        WGPUCommandBuffer commands = mClientProcs.commandEncoderFinish(encoder, nullptr);
+        mClientProcs.queueSubmit(objects.queue, 1, &commands);
+        mClientProcs.commandBufferRelease(commands);
+        mClientProcs.renderPassEncoderRelease(pass);
+        mClientProcs.commandEncoderRelease(encoder);
+    }
+
+    void Step() override {
+        if (mWireServer->HandleCommands(mFrameCommands.data(), mFrameCommands.size()) ==
+            nullptr) {
+            AbortTest();
+            return;
+        }
+        // Complete the submits so that they don't accumulate.
+        mWireServer->TickDevices();
+        mWireServer->WaitForIdle();
+    }
+
+    DawnProcTable mNativeProcs;
+    DawnProcTable mClientProcs;
+
+    CapturingCommandSerializer mC2sBuf;
+    DiscardingCommandSerializer mS2cBuf;
+    std::unique_ptr<dawn::wire::WireServer> mWireServer;
+    std::unique_ptr<dawn::wire::WireClient> mWireClient;
+
+    std::array<DeviceObjects, kDeviceCount> mDevices;
+    std::vector<char> mFrameCommands;
+};
+
+TEST_P(WireDeviceThreadPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(WireDeviceThreadPerf, {NullBackend()}, {0u, 1u, 2u, 4u});
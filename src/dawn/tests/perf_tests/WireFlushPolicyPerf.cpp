@@ -0,0 +1,375 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace {
+
+constexpr unsigned int kRenderPassesPerStep = 4;
+constexpr unsigned int kDrawsPerRenderPass = 256;
+constexpr unsigned int kWriteBuffersPerStep = 16;
+constexpr uint64_t kWriteBufferSize = 256;
+
+enum class FlushPolicy {
+    EveryCommand,     // Flush after each command, like an embedder flushing at each API call.
+    Submit,           // Flush at each Queue::Submit and Buffer::MapAsync.
+    PendingBytes,     // Flush every 64KB of commands.
+    PendingCommands,  // Flush every 256 commands.
+    PendingTime,      // Flush when the oldest command is 100us old.
+};
+
+std::ostream& operator<<(std::ostream& ostream, const FlushPolicy& policy) {
+    switch (policy) {
+        case FlushPolicy::EveryCommand:
+            ostream << "EveryCommand";
+            break;
+        case FlushPolicy::Submit:
+            ostream << "Submit";
+            break;
+        case FlushPolicy::PendingBytes:
+            ostream << "PendingBytes";
+            break;
+        case FlushPolicy::PendingCommands:
+            ostream << "PendingCommands";
+            break;
+        case FlushPolicy::PendingTime:
+            ostream << "PendingTime";
+            break;
+    }
+    return ostream;
+}
+
+dawn::wire::WireClientFlushPolicy GetClientFlushPolicy(FlushPolicy policy) {
+    dawn::wire::WireClientFlushPolicy clientPolicy = {};
+    switch (policy) {
+        case FlushPolicy::EveryCommand:
+            clientPolicy.maxPendingCommands = 1;
+            break;
+        case FlushPolicy::Submit:
+            clientPolicy.flushOnSubmit = true;
+            clientPolicy.flushOnMapAsync = true;
+            break;
+        case FlushPolicy::PendingBytes:
+            clientPolicy.maxPendingBytes = 64 * 1024;
+            break;
+        case FlushPolicy::PendingCommands:
+            clientPolicy.maxPendingCommands = 256;
+            break;
+        case FlushPolicy::PendingTime:
+            clientPolicy.maxPendingTimeUs = 100;
+            break;
+    }
+    return clientPolicy;
+}
+
+struct WireFlushPolicyParams : AdapterTestParam {
+    WireFlushPolicyParams(const AdapterTestParam& param, FlushPolicy flushPolicyIn)
+        : AdapterTestParam(param), flushPolicy(flushPolicyIn) {}
+    FlushPolicy flushPolicy;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const WireFlushPolicyParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.flushPolicy;
+    return ostream;
+}
+
+// Sends each flush of the client to the server as one message, like a transport between
+// processes would, and records how many messages there were and how long their oldest command
+// waited to be sent.
+class MessageCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    void SetHandler(dawn::wire::CommandHandler* handler) { mHandler = handler; }
+
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        if (mSize == 0) {
+            mFirstCommandTime = std::chrono::steady_clock::now();
+        }
+        if (mCommands.size() - mSize < size) {
+            mCommands.resize(std::max(mCommands.size() * 2, mSize + size));
+        }
+        char* result = &mCommands[mSize];
+        mSize += size;
+        return result;
+    }
+    bool Flush() override {
+        if (mSize == 0) {
+            return true;
+        }
+        mMessageCount++;
+        mByteCount += mSize;
+        mDelaySeconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - mFirstCommandTime)
+                .count();
+
+        bool success = mHandler->HandleCommands(mCommands.data(), mSize) != nullptr;
+        mSize = 0;
+        return success;
+    }
+
+    uint64_t GetMessageCount() const { return mMessageCount; }
+    uint64_t GetByteCount() const { return mByteCount; }
+    double GetDelaySeconds() const { return mDelaySeconds; }
+
+  private:
+    dawn::wire::CommandHandler* mHandler = nullptr;
+    std::vector<char> mCommands;
+    size_t mSize = 0;
+    std::chrono::steady_clock::time_point mFirstCommandTime;
+
+    uint64_t mMessageCount = 0;
+    uint64_t mByteCount = 0;
+    double mDelaySeconds = 0.0;
+};
+
+constexpr char kShader[] = R"(
+    @vertex fn vs_main(@builtin(vertex_index) i : u32) -> @builtin(position) vec4<f32> {
+        return vec4<f32>(f32(i), 0.0, 0.0, 1.0);
+    }
+
+    @fragment fn fs_main() -> @location(0) vec4<f32> {
+        return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+    }
+)";
+
+}  // anonymous namespace
+
+// Test the tradeoff of the WireClientFlushPolicy between the number of messages sent by the
+// client and how long the commands wait before being sent. Each step is a frame with some
+// Queue::WriteBuffer calls and render passes of many draws, each in its own submit, followed by
+// an explicit flush at the end of the frame. The wire is on top of the Null backend and each
+// flush is handled by the server immediately.
+//
+// For each policy, the test reports the number of messages per frame, their average size, and
+// the average time that the oldest command of each message waited before being flushed. The
+// wall time of the frames includes the handling of the commands by the server.
+class WireFlushPolicyPerf : public DawnPerfTestWithParams<WireFlushPolicyParams> {
+  public:
+    WireFlushPolicyPerf() : DawnPerfTestWithParams(1, 1) {}
+    ~WireFlushPolicyPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend measures only the cost of the wire and the frontend.
+        DawnTestWithParams<WireFlushPolicyParams>::SetUp();
+        // The test creates its own wire on top of the native device.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        mNativeProcs = dawn::native::GetProcs();
+        mClientProcs = dawn::wire::client::GetProcs();
+
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &mNativeProcs;
+        serverDesc.serializer = &mS2cBuf;
+        dawn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = &mC2sBuf;
+        clientDesc.flushPolicy = GetClientFlushPolicy(GetParam().flushPolicy);
+        mWireServer = std::make_unique<dawn::wire::WireServer>(serverDesc);
+        mWireClient = std::make_unique<dawn::wire::WireClient>(clientDesc);
+        mC2sBuf.SetHandler(mWireServer.get());
+        mS2cBuf.SetHandler(mWireClient.get());
+
+        dawn::wire::ReservedDevice reservation = mWireClient->ReserveDevice();
+        ASSERT_TRUE(
+            mWireServer->InjectDevice(device.Get(), reservation.id, reservation.generation));
+        mClientDevice = reservation.device;
+        mClientQueue = mClientProcs.deviceGetQueue(mClientDevice);
+
+        CreatePipeline();
+        CreateRenderTarget();
+        CreateWriteBufferTarget();
+        ASSERT_TRUE(mWireClient->Flush());
+
+        mInitialMessageCount = mC2sBuf.GetMessageCount();
+        mInitialByteCount = mC2sBuf.GetByteCount();
+        mInitialDelaySeconds = mC2sBuf.GetDelaySeconds();
+    }
+
+    void TearDown() override {
+        if (mWireClient != nullptr) {
+            if (mClientDevice != nullptr) {
+                ReleaseIfNotNull(mPipeline, mClientProcs.renderPipelineRelease);
+                ReleaseIfNotNull(mRenderTargetView, mClientProcs.textureViewRelease);
+                ReleaseIfNotNull(mRenderTarget, mClientProcs.textureRelease);
+                ReleaseIfNotNull(mBuffer, mClientProcs.bufferRelease);
+                mClientProcs.queueRelease(mClientQueue);
+                mClientProcs.deviceRelease(mClientDevice);
+            }
+            mWireClient->Flush();
+            mWireClient = nullptr;
+            mWireServer = nullptr;
+        }
+        DawnTestWithParams<WireFlushPolicyParams>::TearDown();
+    }
+
+  protected:
+    void PrintFlushResults() const {
+        uint64_t messageCount = mC2sBuf.GetMessageCount() - mInitialMessageCount;
+        if (messageCount == 0 || mStepCount == 0) {
+            return;
+        }
+        double messages = static_cast<double>(messageCount);
+        PrintResult("messages_per_frame", messages / static_cast<double>(mStepCount), "count",
+                    true);
+        PrintResult("bytes_per_message",
+                    static_cast<double>(mC2sBuf.GetByteCount() - mInitialByteCount) / messages,
+                    "bytes", false);
+        PrintResult("flush_delay",
+                    (mC2sBuf.GetDelaySeconds() - mInitialDelaySeconds) * 1e6 / messages, "us",
+                    true);
+    }
+
+  private:
+    template <typename T>
+    static void ReleaseIfNotNull(T object, void (*release)(T)) {
+        if (object != nullptr) {
+            release(object);
+        }
+    }
+
+    void CreatePipeline() {
+        WGPUShaderModuleWGSLDescriptor wgslDesc = {};
+        wgslDesc.chain.sType = WGPUSType_ShaderModuleWGSLDescriptor;
+        wgslDesc.source = kShader;
+        WGPUShaderModuleDescriptor moduleDesc = {};
+        moduleDesc.nextInChain = &wgslDesc.chain;
+        WGPUShaderModule module = mClientProcs.deviceCreateShaderModule(mClientDevice, &moduleDesc);
+
+        WGPUColorTargetState target = {};
+        target.format = WGPUTextureFormat_RGBA8Unorm;
+        target.writeMask = WGPUColorWriteMask_All;
+        WGPUFragmentState fragment = {};
+        fragment.module = module;
+        fragment.entryPoint = "fs_main";
+        fragment.targetCount = 1;
+        fragment.targets = &target;
+
+        WGPURenderPipelineDescriptor desc = {};
+        desc.vertex.module = module;
+        desc.vertex.entryPoint = "vs_main";
+        desc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+        desc.multisample.count = 1;
+        desc.multisample.mask = 0xFFFFFFFF;
+        desc.fragment = &fragment;
+        mPipeline = mClientProcs.deviceCreateRenderPipeline(mClientDevice, &desc);
+        mClientProcs.shaderModuleRelease(module);
+    }
+
+    void CreateRenderTarget() {
+        WGPUTextureDescriptor desc = {};
+        desc.usage = WGPUTextureUsage_RenderAttachment;
+        desc.dimension = WGPUTextureDimension_2D;
+        desc.size = {1, 1, 1};
+        desc.format = WGPUTextureFormat_RGBA8Unorm;
+        desc.mipLevelCount = 1;
+        desc.sampleCount = 1;
+        mRenderTarget = mClientProcs.deviceCreateTexture(mClientDevice, &desc);
+        mRenderTargetView = mClientProcs.textureCreateView(mRenderTarget, nullptr);
+    }
+
+    void CreateWriteBufferTarget() {
+        WGPUBufferDescriptor desc = {};
+        desc.size = kWriteBufferSize;
+        desc.usage = WGPUBufferUsage_CopyDst;
+        mBuffer = mClientProcs.deviceCreateBuffer(mClientDevice, &desc);
+        mWriteBufferData.resize(kWriteBufferSize);
+    }
+
+    void EncodeRenderPass() {
+        WGPUCommandEncoder encoder =
+            mClientProcs.deviceCreateCommandEncoder(mClientDevice, nullptr);
+
+        WGPURenderPassColorAttachment attachment = {};
+        attachment.view = mRenderTargetView;
+        attachment.loadOp = WGPULoadOp_Load;
+        attachment.storeOp = WGPUStoreOp_Store;
+        attachment.clearColor = {NAN, NAN, NAN, NAN};
+        WGPURenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+        WGPURenderPassEncoder pass = mClientProcs.commandEncoderBeginRenderPass(encoder, &passDesc);
+        mClientProcs.renderPassEncoderSetPipeline(pass, mPipeline);
+        for (unsigned int i = 0; i < kDrawsPerRenderPass; ++i) {
+            mClientProcs.renderPassEncoderDraw(pass, 3, 1, 0, 0);
+        }
+        mClientProcs.renderPassEncoderEnd(pass);
+
+        WGPUCommandBuffer commands = mClientProcs.commandEncoderFinish(encoder, nullptr);
+        mClientProcs.queueSubmit(mClientQueue, 1, &commands);
+        mClientProcs.commandBufferRelease(commands);
+        mClientProcs.renderPassEncoderRelease(pass);
+        mClientProcs.commandEncoderRelease(encoder);
+    }
+
+    void Step() override {
+        for (unsigned int i = 0; i < kWriteBuffersPerStep; ++i) {
+            mClientProcs.queueWriteBuffer(mClientQueue, mBuffer, 0, mWriteBufferData.data(),
+                                          kWriteBufferSize);
+        }
+        for (unsigned int i = 0; i < kRenderPassesPerStep; ++i) {
+            EncodeRenderPass();
+        }
+        // The end of the frame, where the embedder flushes whatever is left.
+        if (!mWireClient->Flush() || !mS2cBuf.Flush()) {
+            AbortTest();
+            return;
+        }
+        mStepCount++;
+        // Complete the submits so that they don't accumulate.
+        device.Tick();
+    }
+
+    DawnProcTable mNativeProcs;
+    DawnProcTable mClientProcs;
+
+    MessageCommandSerializer mC2sBuf;
+    utils::TerribleCommandBuffer mS2cBuf;
+    std::unique_ptr<dawn::wire::WireServer> mWireServer;
+    std::unique_ptr<dawn::wire::WireClient> mWireClient;
+
+    WGPUDevice mClientDevice = nullptr;
+    WGPUQueue mClientQueue = nullptr;
+    WGPURenderPipeline mPipeline = nullptr;
+    WGPUTexture mRenderTarget = nullptr;
+    WGPUTextureView mRenderTargetView = nullptr;
+    WGPUBuffer mBuffer = nullptr;
+    std::vector<char> mWriteBufferData;
+
+    // The statistics of the steps, including those of the warmup.
+    uint64_t mStepCount = 0;
+    uint64_t mInitialMessageCount = 0;
+    uint64_t mInitialByteCount = 0;
+    double mInitialDelaySeconds = 0.0;
+};
+
+TEST_P(WireFlushPolicyPerf, Run) {
+    RunTest();
+    PrintFlushResults();
+}
+
+DAWN_INSTANTIATE_TEST_P(WireFlushPolicyPerf,
+                        {NullBackend()},
+                        {FlushPolicy::EveryCommand, FlushPolicy::Submit, FlushPolicy::PendingBytes,
+                         FlushPolicy::PendingCommands, FlushPolicy::PendingTime});
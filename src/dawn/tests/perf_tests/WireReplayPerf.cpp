@@ -0,0 +1,118 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WireTrace.h"
+#include "dawn/wire/Wire.h"
+
+namespace {
+
+WGPUAdapter sReplayAdapter = nullptr;
+WGPUProcDeviceCreateSwapChain sOriginalDeviceCreateSwapChain = nullptr;
+
+// Make all the swapchains of the trace error swapchains since their implementation pointers are
+// meaningless outside of the process that recorded the trace.
+WGPUSwapChain ErrorDeviceCreateSwapChain(WGPUDevice device,
+                                         WGPUSurface surface,
+                                         const WGPUSwapChainDescriptor*) {
+    WGPUSwapChainDescriptor desc = {};
+    // A 0 implementation will trigger a swapchain creation error.
+    desc.implementation = 0;
+    return sOriginalDeviceCreateSwapChain(device, surface, &desc);
+}
+
+// Always return the adapter of the test so that the trace runs on the backend being tested.
+void ReplayInstanceRequestAdapter(WGPUInstance,
+                                  const WGPURequestAdapterOptions*,
+                                  WGPURequestAdapterCallback callback,
+                                  void* userdata) {
+    dawn::native::GetProcs().adapterReference(sReplayAdapter);
+    callback(WGPURequestAdapterStatus_Success, sReplayAdapter, nullptr, userdata);
+}
+
+}  // anonymous namespace
+
+// Replays the wire trace passed with --wire-replay-trace= directly on a WireServer, measuring the
+// time it takes on the server side and reporting the average time spent in each command. Traces
+// are recorded by running any of the tests with --use-wire --wire-trace-dir=<dir>.
+class WireReplayPerf : public DawnPerfTest {
+  public:
+    WireReplayPerf() : DawnPerfTest(1, 1) {}
+    ~WireReplayPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend is useful to measure only the cost of the wire and the frontend.
+        DawnTestWithParams<>::SetUp();
+
+        // The trace is replayed directly on a WireServer.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        const char* traceFile = GetWireReplayTraceFile();
+        DAWN_TEST_UNSUPPORTED_IF(traceFile == nullptr);
+        mTrace = utils::WireTrace::LoadFromFile(traceFile);
+        DAWN_TEST_UNSUPPORTED_IF(mTrace == nullptr);
+
+        mProcs = dawn::native::GetProcs();
+        sOriginalDeviceCreateSwapChain = mProcs.deviceCreateSwapChain;
+        mProcs.deviceCreateSwapChain = ErrorDeviceCreateSwapChain;
+        mProcs.instanceRequestAdapter = ReplayInstanceRequestAdapter;
+        sReplayAdapter = GetAdapter().Get();
+    }
+
+  protected:
+    void PrintCommandResults() const {
+        for (uint32_t id = 0; id < mStats.size(); ++id) {
+            const utils::WireReplayCommandStats& stats = mStats[id];
+            if (stats.count == 0) {
+                continue;
+            }
+
+            const char* name = dawn::wire::GetWireCommandName(id);
+            std::string trace = name != nullptr ? name : "Unknown" + std::to_string(id);
+            PrintResult(trace + "_count", static_cast<unsigned int>(stats.count), "count", false);
+            PrintResult(trace + "_average_time",
+                        stats.seconds * 1e6 / static_cast<double>(stats.count), "us", false);
+        }
+    }
+
+  private:
+    void Step() override {
+        if (!utils::ReplayWireTrace(*mTrace, mProcs, GetInstance().Get(), &mStats)) {
+            AbortTest();
+        }
+    }
+
+    std::unique_ptr<utils::WireTrace> mTrace;
+    DawnProcTable mProcs;
+    // The statistics accumulated over all the replays, including those of the warmup.
+    std::vector<utils::WireReplayCommandStats> mStats;
+};
+
+TEST_P(WireReplayPerf, Run) {
+    RunTest();
+    PrintCommandResults();
+}
+
+DAWN_INSTANTIATE_TEST(WireReplayPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      NullBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
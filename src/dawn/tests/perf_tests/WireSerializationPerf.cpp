@@ -0,0 +1,614 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/utils/Timer.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace {
+
+// The number of calls to the global operator new made on the thread of WireSerializationPerf
+// while it measures the wire, used to report the allocations per command. Aligned allocations
+// aren't counted. Only standalone builds replace operator new since Chromium builds already
+// replace it with their allocator shim.
+thread_local bool tCountAllocations = false;
+uint64_t sAllocationCount = 0;
+
+// Counts the allocations of the current thread for the duration of the scope.
+class ScopedAllocationCounter {
+  public:
+    ScopedAllocationCounter() {
+        ASSERT(!tCountAllocations);
+        tCountAllocations = true;
+    }
+    ~ScopedAllocationCounter() { tCountAllocations = false; }
+};
+
+}  // anonymous namespace
+
+#if defined(DAWN_PERF_TESTS_COUNT_ALLOCATIONS)
+// Outside of the ScopedAllocationCounters the replacement only forwards to malloc, so the other
+// perf tests aren't affected. Tests may be built without exceptions so running out of memory
+// aborts instead of throwing std::bad_alloc.
+void* operator new(size_t size) {
+    if (tCountAllocations) {
+        sAllocationCount++;
+    }
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        std::abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+#endif  // defined(DAWN_PERF_TESTS_COUNT_ALLOCATIONS)
+
+namespace {
+
+// The size of the CmdHeader followed by the WireCmd at the start of each command.
+constexpr size_t kCommandHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+constexpr unsigned int kEncoderCommandsPerStep = 4096;
+constexpr unsigned int kWriteBuffersPerStep = 16;
+constexpr uint64_t kWriteBufferSize = 1 << 20;
+constexpr uint64_t kUniformBufferSize = 512;
+constexpr unsigned int kBindGroupsPerStep = 256;
+constexpr unsigned int kChurnObjectsPerStep = 256;
+// The number of samplers in the large bind groups, for each of the three shader stages.
+constexpr uint32_t kSamplersPerStage = 16;
+
+enum class CommandMix {
+    Draw,             // A render pass with a pipeline and many draws.
+    SetBindGroup,     // A render pass changing bind groups with a dynamic offset.
+    WriteBuffer,      // Large Queue::WriteBuffer calls, with the data inline in the commands.
+    CreateBindGroup,  // Creation of bind groups with many entries.
+    ObjectChurn,      // Creation and release of buffers and of bind groups using them, which
+                      // recycles their IDs and the server's storage of the objects.
+};
+
+std::ostream& operator<<(std::ostream& ostream, const CommandMix& mix) {
+    switch (mix) {
+        case CommandMix::Draw:
+            ostream << "Draw";
+            break;
+        case CommandMix::SetBindGroup:
+            ostream << "SetBindGroup";
+            break;
+        case CommandMix::WriteBuffer:
+            ostream << "WriteBuffer";
+            break;
+        case CommandMix::CreateBindGroup:
+            ostream << "CreateBindGroup";
+            break;
+        case CommandMix::ObjectChurn:
+            ostream << "ObjectChurn";
+            break;
+    }
+    return ostream;
+}
+
+unsigned int GetCommandsPerStep(CommandMix mix) {
+    switch (mix) {
+        case CommandMix::Draw:
+        case CommandMix::SetBindGroup:
+            return kEncoderCommandsPerStep;
+        case CommandMix::WriteBuffer:
+            return kWriteBuffersPerStep;
+        case CommandMix::CreateBindGroup:
+            return kBindGroupsPerStep;
+        case CommandMix::ObjectChurn:
+            return kChurnObjectsPerStep;
+    }
+    UNREACHABLE();
+}
+
+struct WireSerializationParams : AdapterTestParam {
+    WireSerializationParams(const AdapterTestParam& param, CommandMix commandMixIn)
+        : AdapterTestParam(param), commandMix(commandMixIn) {}
+    CommandMix commandMix;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const WireSerializationParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.commandMix;
+    return ostream;
+}
+
+// Stores the client->server commands in memory so that they are handled separately from their
+// serialization.
+class RecordingCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        // Keep the storage of the previous steps so that it doesn't need to be initialized again.
+        if (mCommands.size() - mSize < size) {
+            mCommands.resize(std::max(mCommands.size() * 2, mSize + size));
+        }
+        char* result = &mCommands[mSize];
+        mSize += size;
+        return result;
+    }
+    bool Flush() override { return true; }
+
+    const char* GetCommands() const { return mCommands.data(); }
+    size_t GetSize() const { return mSize; }
+    void Clear() { mSize = 0; }
+
+  private:
+    std::vector<char> mCommands;
+    size_t mSize = 0;
+};
+
+constexpr char kShader[] = R"(
+    @vertex fn vs_main(@builtin(vertex_index) i : u32) -> @builtin(position) vec4<f32> {
+        return vec4<f32>(f32(i), 0.0, 0.0, 1.0);
+    }
+
+    @fragment fn fs_main() -> @location(0) vec4<f32> {
+        return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+    }
+)";
+
+}  // anonymous namespace
+
+// Test the throughput of dawn_wire: the generated serialization on the client side, and the
+// deserialization and dispatch of the commands on the server side, on top of the Null backend so
+// that the cost of the GPU is excluded. The commands are recorded in memory and the two sides are
+// timed separately. The test uses its own WireClient and WireServer on top of the test's device,
+// and calls the client procs directly.
+//
+// For each mix of commands, the test reports the average size of the commands, the time to
+// serialize and to handle them, and in standalone builds the number of heap allocations on each
+// side.
+class WireSerializationPerf : public DawnPerfTestWithParams<WireSerializationParams> {
+  public:
+    WireSerializationPerf()
+        : DawnPerfTestWithParams(GetCommandsPerStep(GetParam().commandMix), 1),
+          mTimer(utils::CreateTimer()) {}
+    ~WireSerializationPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters since the Null
+        // backend measures only the cost of the wire and the frontend.
+        DawnTestWithParams<WireSerializationParams>::SetUp();
+        // The test creates its own wire on top of the native device.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        mNativeProcs = dawn::native::GetProcs();
+        mClientProcs = dawn::wire::client::GetProcs();
+
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &mNativeProcs;
+        serverDesc.serializer = &mS2cBuf;
+        dawn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = &mC2sBuf;
+        mWireServer = std::make_unique<dawn::wire::WireServer>(serverDesc);
+        mWireClient = std::make_unique<dawn::wire::WireClient>(clientDesc);
+        mS2cBuf.SetHandler(mWireClient.get());
+
+        dawn::wire::ReservedDevice reservation = mWireClient->ReserveDevice();
+        ASSERT_TRUE(
+            mWireServer->InjectDevice(device.Get(), reservation.id, reservation.generation));
+        mClientDevice = reservation.device;
+        mClientQueue = mClientProcs.deviceGetQueue(mClientDevice);
+
+        switch (GetParam().commandMix) {
+            case CommandMix::Draw:
+                CreatePipeline();
+                CreateRenderTarget();
+                break;
+            case CommandMix::SetBindGroup:
+                CreateBindGroups();
+                CreateRenderTarget();
+                break;
+            case CommandMix::WriteBuffer:
+                CreateWriteBufferTarget();
+                break;
+            case CommandMix::CreateBindGroup:
+                CreateLargeBindGroupLayout();
+                break;
+            case CommandMix::ObjectChurn:
+                CreateUniformBindGroupLayout();
+                break;
+        }
+        ASSERT_TRUE(HandleRecordedCommands());
+    }
+
+    void TearDown() override {
+        if (mWireClient != nullptr) {
+            if (mClientDevice != nullptr) {
+                for (WGPUBindGroup bindGroup : mBindGroups) {
+                    mClientProcs.bindGroupRelease(bindGroup);
+                }
+                ReleaseIfNotNull(mPipeline, mClientProcs.renderPipelineRelease);
+                ReleaseIfNotNull(mRenderTargetView, mClientProcs.textureViewRelease);
+                ReleaseIfNotNull(mRenderTarget, mClientProcs.textureRelease);
+                ReleaseIfNotNull(mBuffer, mClientProcs.bufferRelease);
+                ReleaseIfNotNull(mLargeBindGroupLayout, mClientProcs.bindGroupLayoutRelease);
+                ReleaseIfNotNull(mUniformBindGroupLayout, mClientProcs.bindGroupLayoutRelease);
+                ReleaseIfNotNull(mSampler, mClientProcs.samplerRelease);
+                mClientProcs.queueRelease(mClientQueue);
+                mClientProcs.deviceRelease(mClientDevice);
+            }
+            HandleRecordedCommands();
+            mWireClient = nullptr;
+            mWireServer = nullptr;
+        }
+        DawnTestWithParams<WireSerializationParams>::TearDown();
+    }
+
+  protected:
+    void PrintSerializationResults() const {
+        if (mCommandCount == 0) {
+            return;
+        }
+        double commandCount = static_cast<double>(mCommandCount);
+        PrintResult("bytes_per_command", static_cast<double>(mByteCount) / commandCount,
+                    "bytes", false);
+        PrintResult("serialize_time", mSerializeSeconds * 1e9 / commandCount, "ns", true);
+        PrintResult("deserialize_time", mDeserializeSeconds * 1e9 / commandCount, "ns", true);
+#if defined(DAWN_PERF_TESTS_COUNT_ALLOCATIONS)
+        PrintResult("serialize_allocations",
+                    static_cast<double>(mSerializeAllocations) / commandCount, "count", false);
+        PrintResult("deserialize_allocations",
+                    static_cast<double>(mDeserializeAllocations) / commandCount, "count", false);
+#endif
+    }
+
+  private:
+    template <typename T>
+    static void ReleaseIfNotNull(T object, void (*release)(T)) {
+        if (object != nullptr) {
+            release(object);
+        }
+    }
+
+    WGPUShaderModule CreateShaderModule() {
+        WGPUShaderModuleWGSLDescriptor wgslDesc = {};
+        wgslDesc.chain.sType = WGPUSType_ShaderModuleWGSLDescriptor;
+        wgslDesc.source = kShader;
+        WGPUShaderModuleDescriptor desc = {};
+        desc.nextInChain = &wgslDesc.chain;
+        return mClientProcs.deviceCreateShaderModule(mClientDevice, &desc);
+    }
+
+    void CreatePipeline() {
+        WGPUShaderModule module = CreateShaderModule();
+
+        WGPUColorTargetState target = {};
+        target.format = WGPUTextureFormat_RGBA8Unorm;
+        target.writeMask = WGPUColorWriteMask_All;
+        WGPUFragmentState fragment = {};
+        fragment.module = module;
+        fragment.entryPoint = "fs_main";
+        fragment.targetCount = 1;
+        fragment.targets = &target;
+
+        WGPURenderPipelineDescriptor desc = {};
+        desc.vertex.module = module;
+        desc.vertex.entryPoint = "vs_main";
+        desc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+        desc.multisample.count = 1;
+        desc.multisample.mask = 0xFFFFFFFF;
+        desc.fragment = &fragment;
+        mPipeline = mClientProcs.deviceCreateRenderPipeline(mClientDevice, &desc);
+        mClientProcs.shaderModuleRelease(module);
+    }
+
+    void CreateBindGroups() {
+        WGPUBufferDescriptor bufferDesc = {};
+        bufferDesc.size = kUniformBufferSize;
+        bufferDesc.usage = WGPUBufferUsage_Uniform;
+        mBuffer = mClientProcs.deviceCreateBuffer(mClientDevice, &bufferDesc);
+
+        WGPUBindGroupLayoutEntry layoutEntry = {};
+        layoutEntry.binding = 0;
+        layoutEntry.visibility = WGPUShaderStage_Fragment;
+        layoutEntry.buffer.type = WGPUBufferBindingType_Uniform;
+        layoutEntry.buffer.hasDynamicOffset = true;
+        WGPUBindGroupLayoutDescriptor layoutDesc = {};
+        layoutDesc.entryCount = 1;
+        layoutDesc.entries = &layoutEntry;
+        WGPUBindGroupLayout layout =
+            mClientProcs.deviceCreateBindGroupLayout(mClientDevice, &layoutDesc);
+
+        // Two bind groups on different ranges of the buffer, alternated so that each
+        // SetBindGroup changes the state.
+        for (uint64_t offset : {uint64_t(0), kUniformBufferSize / 2}) {
+            WGPUBindGroupEntry entry = {};
+            entry.binding = 0;
+            entry.buffer = mBuffer;
+            entry.offset = offset;
+            entry.size = 16;
+            WGPUBindGroupDescriptor desc = {};
+            desc.layout = layout;
+            desc.entryCount = 1;
+            desc.entries = &entry;
+            mBindGroups.push_back(mClientProcs.deviceCreateBindGroup(mClientDevice, &desc));
+        }
+        mClientProcs.bindGroupLayoutRelease(layout);
+    }
+
+    // A layout with as many samplers as possible, so that the bind groups have many entries.
+    void CreateLargeBindGroupLayout() {
+        mSampler = mClientProcs.deviceCreateSampler(mClientDevice, nullptr);
+
+        std::vector<WGPUBindGroupLayoutEntry> layoutEntries;
+        for (WGPUShaderStage stage :
+             {WGPUShaderStage_Vertex, WGPUShaderStage_Fragment, WGPUShaderStage_Compute}) {
+            for (uint32_t i = 0; i < kSamplersPerStage; ++i) {
+                WGPUBindGroupLayoutEntry entry = {};
+                entry.binding = static_cast<uint32_t>(layoutEntries.size());
+                entry.visibility = stage;
+                entry.sampler.type = WGPUSamplerBindingType_Filtering;
+                layoutEntries.push_back(entry);
+            }
+        }
+        WGPUBindGroupLayoutDescriptor layoutDesc = {};
+        layoutDesc.entryCount = static_cast<uint32_t>(layoutEntries.size());
+        layoutDesc.entries = layoutEntries.data();
+        mLargeBindGroupLayout =
+            mClientProcs.deviceCreateBindGroupLayout(mClientDevice, &layoutDesc);
+
+        for (const WGPUBindGroupLayoutEntry& layoutEntry : layoutEntries) {
+            WGPUBindGroupEntry entry = {};
+            entry.binding = layoutEntry.binding;
+            entry.sampler = mSampler;
+            mLargeBindGroupEntries.push_back(entry);
+        }
+    }
+
+    void CreateUniformBindGroupLayout() {
+        WGPUBindGroupLayoutEntry layoutEntry = {};
+        layoutEntry.binding = 0;
+        layoutEntry.visibility = WGPUShaderStage_Fragment;
+        layoutEntry.buffer.type = WGPUBufferBindingType_Uniform;
+        WGPUBindGroupLayoutDescriptor layoutDesc = {};
+        layoutDesc.entryCount = 1;
+        layoutDesc.entries = &layoutEntry;
+        mUniformBindGroupLayout =
+            mClientProcs.deviceCreateBindGroupLayout(mClientDevice, &layoutDesc);
+    }
+
+    void CreateRenderTarget() {
+        WGPUTextureDescriptor desc = {};
+        desc.usage = WGPUTextureUsage_RenderAttachment;
+        desc.dimension = WGPUTextureDimension_2D;
+        desc.size = {1, 1, 1};
+        desc.format = WGPUTextureFormat_RGBA8Unorm;
+        desc.mipLevelCount = 1;
+        desc.sampleCount = 1;
+        mRenderTarget = mClientProcs.deviceCreateTexture(mClientDevice, &desc);
+        mRenderTargetView = mClientProcs.textureCreateView(mRenderTarget, nullptr);
+    }
+
+    void CreateWriteBufferTarget() {
+        WGPUBufferDescriptor desc = {};
+        desc.size = kWriteBufferSize;
+        desc.usage = WGPUBufferUsage_CopyDst;
+        mBuffer = mClientProcs.deviceCreateBuffer(mClientDevice, &desc);
+        mWriteBufferData.resize(kWriteBufferSize);
+    }
+
+    // Encodes and submits a render pass with the commands of the mix.
+    void EncodeRenderPass() {
+        WGPUCommandEncoder encoder =
+            mClientProcs.deviceCreateCommandEncoder(mClientDevice, nullptr);
+
+        WGPURenderPassColorAttachment attachment = {};
+        attachment.view = mRenderTargetView;
+        attachment.loadOp = WGPULoadOp_Load;
+        attachment.storeOp = WGPUStoreOp_Store;
+        attachment.clearColor = {NAN, NAN, NAN, NAN};
+        WGPURenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+        WGPURenderPassEncoder pass = mClientProcs.commandEncoderBeginRenderPass(encoder, &passDesc);
+
+        if (GetParam().commandMix == CommandMix::Draw) {
+            mClientProcs.renderPassEncoderSetPipeline(pass, mPipeline);
+            for (unsigned int i = 0; i < kEncoderCommandsPerStep; ++i) {
+                mClientProcs.renderPassEncoderDraw(pass, 3, 1, 0, 0);
+            }
+        } else {
+            for (unsigned int i = 0; i < kEncoderCommandsPerStep; ++i) {
+                uint32_t dynamicOffset = (i / 2 % 2) * 256;
+                mClientProcs.renderPassEncoderSetBindGroup(pass, 0, mBindGroups[i % 2], 1,
+                                                           &dynamicOffset);
+            }
+        }
+        mClientProcs.renderPassEncoderEnd(pass);
+
+        WGPUCommandBuffer commands = mClientProcs.commandEncoderFinish(encoder, nullptr);
+        mClientProcs.queueSubmit(mClientQueue, 1, &commands);
+        mClientProcs.commandBufferRelease(commands);
+        mClientProcs.renderPassEncoderRelease(pass);
+        mClientProcs.commandEncoderRelease(encoder);
+    }
+
+    void EncodeCommands() {
+        switch (GetParam().commandMix) {
+            case CommandMix::Draw:
+            case CommandMix::SetBindGroup:
+                EncodeRenderPass();
+                break;
+            case CommandMix::WriteBuffer:
+                for (unsigned int i = 0; i < kWriteBuffersPerStep; ++i) {
+                    mClientProcs.queueWriteBuffer(mClientQueue, mBuffer, 0,
+                                                  mWriteBufferData.data(), kWriteBufferSize);
+                }
+                break;
+            case CommandMix::CreateBindGroup: {
+                WGPUBindGroupDescriptor desc = {};
+                desc.layout = mLargeBindGroupLayout;
+                desc.entryCount = static_cast<uint32_t>(mLargeBindGroupEntries.size());
+                desc.entries = mLargeBindGroupEntries.data();
+                for (unsigned int i = 0; i < kBindGroupsPerStep; ++i) {
+                    mClientProcs.bindGroupRelease(
+                        mClientProcs.deviceCreateBindGroup(mClientDevice, &desc));
+                }
+                break;
+            }
+            case CommandMix::ObjectChurn: {
+                WGPUBufferDescriptor bufferDesc = {};
+                bufferDesc.size = kUniformBufferSize;
+                bufferDesc.usage = WGPUBufferUsage_Uniform;
+                WGPUBindGroupEntry entry = {};
+                entry.binding = 0;
+                entry.size = kUniformBufferSize;
+                WGPUBindGroupDescriptor desc = {};
+                desc.layout = mUniformBindGroupLayout;
+                desc.entryCount = 1;
+                desc.entries = &entry;
+                // The client reuses the IDs of the released objects right away, so the server
+                // recycles the same slots of its object storage at every iteration.
+                for (unsigned int i = 0; i < kChurnObjectsPerStep; ++i) {
+                    entry.buffer = mClientProcs.deviceCreateBuffer(mClientDevice, &bufferDesc);
+                    mClientProcs.bindGroupRelease(
+                        mClientProcs.deviceCreateBindGroup(mClientDevice, &desc));
+                    mClientProcs.bufferRelease(entry.buffer);
+                }
+                break;
+            }
+        }
+    }
+
+    // Handles the commands recorded so far on the server and the return commands on the client.
+    bool HandleRecordedCommands() {
+        bool success =
+            mWireServer->HandleCommands(mC2sBuf.GetCommands(), mC2sBuf.GetSize()) != nullptr;
+        mC2sBuf.Clear();
+        return success && mS2cBuf.Flush();
+    }
+
+    // Returns the number of commands in the recorded stream, or 0 if it is malformed.
+    uint64_t CountRecordedCommands() const {
+        const char* commands = mC2sBuf.GetCommands();
+        size_t size = mC2sBuf.GetSize();
+        uint64_t count = 0;
+        size_t offset = 0;
+        while (offset < size) {
+            uint64_t commandSize;
+            if (size - offset < kCommandHeaderSize) {
+                return 0;
+            }
+            memcpy(&commandSize, &commands[offset], sizeof(commandSize));
+            if (commandSize < kCommandHeaderSize || commandSize > size - offset) {
+                return 0;
+            }
+            offset += commandSize;
+            count++;
+        }
+        return count;
+    }
+
+    void Step() override {
+        uint64_t allocations = sAllocationCount;
+        {
+            ScopedAllocationCounter counter;
+            mTimer->Start();
+            EncodeCommands();
+            mTimer->Stop();
+        }
+        mSerializeSeconds += mTimer->GetElapsedTime();
+        mSerializeAllocations += sAllocationCount - allocations;
+
+        uint64_t commandCount = CountRecordedCommands();
+        if (commandCount == 0) {
+            AbortTest();
+            return;
+        }
+        mCommandCount += commandCount;
+        mByteCount += mC2sBuf.GetSize();
+
+        allocations = sAllocationCount;
+        bool success;
+        {
+            ScopedAllocationCounter counter;
+            mTimer->Start();
+            success =
+                mWireServer->HandleCommands(mC2sBuf.GetCommands(), mC2sBuf.GetSize()) != nullptr;
+            mTimer->Stop();
+        }
+        mDeserializeSeconds += mTimer->GetElapsedTime();
+        mDeserializeAllocations += sAllocationCount - allocations;
+
+        mC2sBuf.Clear();
+        if (!success || !mS2cBuf.Flush()) {
+            AbortTest();
+            return;
+        }
+        // Complete the submits so that they don't accumulate.
+        device.Tick();
+    }
+
+    std::unique_ptr<utils::Timer> mTimer;
+
+    DawnProcTable mNativeProcs;
+    DawnProcTable mClientProcs;
+
+    RecordingCommandSerializer mC2sBuf;
+    utils::TerribleCommandBuffer mS2cBuf;
+    std::unique_ptr<dawn::wire::WireServer> mWireServer;
+    std::unique_ptr<dawn::wire::WireClient> mWireClient;
+
+    WGPUDevice mClientDevice = nullptr;
+    WGPUQueue mClientQueue = nullptr;
+    WGPURenderPipeline mPipeline = nullptr;
+    WGPUTexture mRenderTarget = nullptr;
+    WGPUTextureView mRenderTargetView = nullptr;
+    WGPUBuffer mBuffer = nullptr;
+    std::vector<WGPUBindGroup> mBindGroups;
+    WGPUSampler mSampler = nullptr;
+    WGPUBindGroupLayout mLargeBindGroupLayout = nullptr;
+    WGPUBindGroupLayout mUniformBindGroupLayout = nullptr;
+    std::vector<WGPUBindGroupEntry> mLargeBindGroupEntries;
+    std::vector<char> mWriteBufferData;
+
+    // The statistics accumulated over all the steps, including those of the warmup.
+    uint64_t mCommandCount = 0;
+    uint64_t mByteCount = 0;
+    double mSerializeSeconds = 0.0;
+    double mDeserializeSeconds = 0.0;
+    uint64_t mSerializeAllocations = 0;
+    uint64_t mDeserializeAllocations = 0;
+};
+
+TEST_P(WireSerializationPerf, Run) {
+    RunTest();
+    PrintSerializationResults();
+}
+
+DAWN_INSTANTIATE_TEST_P(WireSerializationPerf,
+                        {NullBackend()},
+                        {CommandMix::Draw, CommandMix::SetBindGroup, CommandMix::WriteBuffer,
+                         CommandMix::CreateBindGroup, CommandMix::ObjectChurn});
@@ -0,0 +1,376 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/SharedMemoryRing.h"
+#include "dawn/wire/Wire.h"
+
+namespace {
+
+constexpr size_t kRingCapacity = 1 << 20;
+constexpr size_t kSocketBufferSize = 1 << 20;
+
+constexpr unsigned int kCommandsPerStep = 4096;
+constexpr unsigned int kCommandsPerFlush = 16;
+constexpr size_t kCommandSize = 64;
+constexpr unsigned int kRoundTripsPerStep = 64;
+
+enum class Transport {
+    SharedMemoryRing,  // A SharedMemoryRing in each direction.
+    Socket,            // A Unix socket, with a copy of the commands on each side.
+};
+
+enum class Measurement {
+    Throughput,  // Many small commands, flushed in batches.
+    Latency,     // Round trips of a single command.
+};
+
+std::ostream& operator<<(std::ostream& ostream, const Transport& transport) {
+    switch (transport) {
+        case Transport::SharedMemoryRing:
+            ostream << "SharedMemoryRing";
+            break;
+        case Transport::Socket:
+            ostream << "Socket";
+            break;
+    }
+    return ostream;
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Measurement& measurement) {
+    switch (measurement) {
+        case Measurement::Throughput:
+            ostream << "Throughput";
+            break;
+        case Measurement::Latency:
+            ostream << "Latency";
+            break;
+    }
+    return ostream;
+}
+
+struct WireTransportParams : AdapterTestParam {
+    WireTransportParams(const AdapterTestParam& param,
+                        Transport transportIn,
+                        Measurement measurementIn)
+        : AdapterTestParam(param), transport(transportIn), measurement(measurementIn) {}
+    Transport transport;
+    Measurement measurement;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const WireTransportParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.transport << "_" << param.measurement;
+    return ostream;
+}
+
+// The commands sent by the benchmark: a header followed by an unused payload.
+enum class CommandType : uint32_t {
+    Data,
+    Ping,
+    Pong,
+};
+
+struct CommandHeader {
+    uint32_t size;
+    CommandType type;
+};
+
+bool WriteCommand(dawn::wire::CommandSerializer* serializer, CommandType type, size_t size) {
+    char* space = static_cast<char*>(serializer->GetCmdSpace(size));
+    if (space == nullptr) {
+        return false;
+    }
+    CommandHeader header = {static_cast<uint32_t>(size), type};
+    memcpy(space, &header, sizeof(header));
+    memset(space + sizeof(header), 0, size - sizeof(header));
+    return true;
+}
+
+// Handles the commands in the consumer process and answers the pings with pongs.
+class EchoHandler : public dawn::wire::CommandHandler {
+  public:
+    explicit EchoHandler(dawn::wire::CommandSerializer* returnSerializer)
+        : mReturnSerializer(returnSerializer) {}
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        while (size > 0) {
+            if (size < sizeof(CommandHeader)) {
+                return nullptr;
+            }
+            const volatile CommandHeader* header =
+                reinterpret_cast<const volatile CommandHeader*>(commands);
+            uint32_t commandSize = header->size;
+            if (commandSize < sizeof(CommandHeader) || commandSize > size) {
+                return nullptr;
+            }
+            if (header->type == CommandType::Ping) {
+                if (!WriteCommand(mReturnSerializer, CommandType::Pong, sizeof(CommandHeader)) ||
+                    !mReturnSerializer->Flush()) {
+                    return nullptr;
+                }
+            }
+            commands += commandSize;
+            size -= commandSize;
+        }
+        return commands;
+    }
+
+  private:
+    dawn::wire::CommandSerializer* mReturnSerializer;
+};
+
+// Counts the pongs received in the producer process.
+class PongCounter : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        mPongCount += size / sizeof(CommandHeader);
+        return commands + size;
+    }
+
+    uint64_t GetPongCount() const { return mPongCount; }
+
+  private:
+    uint64_t mPongCount = 0;
+};
+
+bool WriteAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool ReadAll(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t result = read(fd, data, size);
+        if (result <= 0) {
+            return false;
+        }
+        data += result;
+        size -= result;
+    }
+    return true;
+}
+
+// The socket transport used as a baseline, similar to a typical IPC channel: the commands are
+// serialized in a local buffer and each flush sends them, prefixed by their size.
+class SocketSerializer : public dawn::wire::CommandSerializer {
+  public:
+    explicit SocketSerializer(int fd) : mFd(fd), mBuffer(kSocketBufferSize) {}
+
+    size_t GetMaximumAllocationSize() const override { return mBuffer.size(); }
+
+    void* GetCmdSpace(size_t size) override {
+        if (size > mBuffer.size()) {
+            return nullptr;
+        }
+        if (mBuffer.size() - size < mOffset && !Flush()) {
+            return nullptr;
+        }
+        char* result = mBuffer.data() + mOffset;
+        mOffset += size;
+        return result;
+    }
+
+    bool Flush() override {
+        if (mOffset == 0) {
+            return true;
+        }
+        uint32_t size = static_cast<uint32_t>(mOffset);
+        mOffset = 0;
+        return WriteAll(mFd, reinterpret_cast<const char*>(&size), sizeof(size)) &&
+               WriteAll(mFd, mBuffer.data(), size);
+    }
+
+  private:
+    int mFd;
+    size_t mOffset = 0;
+    std::vector<char> mBuffer;
+};
+
+// Receives one flush of a SocketSerializer and passes it to the handler. Returns false if the
+// socket is closed.
+bool HandleSocketCommands(int fd, std::vector<char>* buffer, dawn::wire::CommandHandler* handler) {
+    uint32_t size;
+    if (!ReadAll(fd, reinterpret_cast<char*>(&size), sizeof(size)) || size > buffer->size() ||
+        !ReadAll(fd, buffer->data(), size)) {
+        return false;
+    }
+    return handler->HandleCommands(buffer->data(), size) != nullptr;
+}
+
+unsigned int GetIterationsPerStep(const WireTransportParams& param) {
+    return param.measurement == Measurement::Throughput ? kCommandsPerStep : kRoundTripsPerStep;
+}
+
+}  // anonymous namespace
+
+// Test the performance of transporting commands to another process, either through a pair of
+// utils::SharedMemoryRing or through a socket. Throughput reports the time per small command
+// (including its handling by the other process) and Latency reports the time per round trip.
+// The device isn't used, so this only runs on the Null backend.
+class WireTransportPerf : public DawnPerfTestWithParams<WireTransportParams> {
+  public:
+    WireTransportPerf() : DawnPerfTestWithParams(GetIterationsPerStep(GetParam()), 1) {}
+    ~WireTransportPerf() override = default;
+
+    void SetUp() override {
+        // Skip the check in DawnPerfTest::SetUp that disallows CPU adapters.
+        DawnTestWithParams<WireTransportParams>::SetUp();
+
+        std::unique_ptr<dawn::wire::CommandSerializer> consumerSerializer;
+        std::unique_ptr<EchoHandler> echoHandler;
+        std::unique_ptr<utils::SharedMemoryRingReader> consumerReader;
+        std::vector<char> socketBuffer;
+        int sockets[2] = {-1, -1};
+
+        // Create all the objects of the consumer before forking so that it doesn't need to
+        // allocate memory.
+        if (GetParam().transport == Transport::SharedMemoryRing) {
+            mCommandRing = utils::SharedMemoryRing::Create(kRingCapacity);
+            mReturnRing = utils::SharedMemoryRing::Create(kRingCapacity);
+            ASSERT_NE(mCommandRing, nullptr);
+            ASSERT_NE(mReturnRing, nullptr);
+            mSerializer = std::make_unique<utils::SharedMemoryRingSerializer>(mCommandRing.get());
+            mReturnReader =
+                std::make_unique<utils::SharedMemoryRingReader>(mReturnRing.get(), &mPongCounter);
+
+            consumerSerializer =
+                std::make_unique<utils::SharedMemoryRingSerializer>(mReturnRing.get());
+            echoHandler = std::make_unique<EchoHandler>(consumerSerializer.get());
+            consumerReader = std::make_unique<utils::SharedMemoryRingReader>(mCommandRing.get(),
+                                                                             echoHandler.get());
+        } else {
+            ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+            mSocket = sockets[0];
+            mSerializer = std::make_unique<SocketSerializer>(mSocket);
+            mSocketBuffer.resize(kSocketBufferSize);
+
+            consumerSerializer = std::make_unique<SocketSerializer>(sockets[1]);
+            echoHandler = std::make_unique<EchoHandler>(consumerSerializer.get());
+            socketBuffer.resize(kSocketBufferSize);
+        }
+
+        mConsumerPid = fork();
+        ASSERT_GE(mConsumerPid, 0);
+        if (mConsumerPid == 0) {
+            if (consumerReader != nullptr) {
+                while (consumerReader->WaitForCommands() && consumerReader->HandleCommands()) {
+                }
+            } else {
+                close(sockets[0]);
+                while (HandleSocketCommands(sockets[1], &socketBuffer, echoHandler.get())) {
+                }
+            }
+            _exit(0);
+        }
+        if (sockets[1] != -1) {
+            close(sockets[1]);
+        }
+    }
+
+    void TearDown() override {
+        if (mCommandRing != nullptr) {
+            mCommandRing->Close();
+        }
+        if (mSocket != -1) {
+            close(mSocket);
+        }
+        if (mConsumerPid > 0) {
+            waitpid(mConsumerPid, nullptr, 0);
+        }
+        DawnTestWithParams<WireTransportParams>::TearDown();
+    }
+
+  private:
+    void Step() override {
+        switch (GetParam().measurement) {
+            case Measurement::Throughput:
+                for (unsigned int i = 0; i < kCommandsPerStep; ++i) {
+                    if (!WriteCommand(mSerializer.get(), CommandType::Data, kCommandSize) ||
+                        ((i + 1) % kCommandsPerFlush == 0 && !mSerializer->Flush())) {
+                        AbortTest();
+                        return;
+                    }
+                }
+                // Wait for the consumer to handle all the commands.
+                RoundTrip();
+                break;
+
+            case Measurement::Latency:
+                for (unsigned int i = 0; i < kRoundTripsPerStep; ++i) {
+                    RoundTrip();
+                }
+                break;
+        }
+    }
+
+    void RoundTrip() {
+        uint64_t expectedPongCount = mPongCounter.GetPongCount() + 1;
+        if (!WriteCommand(mSerializer.get(), CommandType::Ping, sizeof(CommandHeader)) ||
+            !mSerializer->Flush()) {
+            AbortTest();
+            return;
+        }
+        while (mPongCounter.GetPongCount() < expectedPongCount) {
+            if (!ReceiveReturnCommands()) {
+                AbortTest();
+                return;
+            }
+        }
+    }
+
+    bool ReceiveReturnCommands() {
+        if (mReturnReader != nullptr) {
+            return mReturnReader->WaitForCommands() && mReturnReader->HandleCommands();
+        }
+        return HandleSocketCommands(mSocket, &mSocketBuffer, &mPongCounter);
+    }
+
+    pid_t mConsumerPid = -1;
+    std::unique_ptr<dawn::wire::CommandSerializer> mSerializer;
+    PongCounter mPongCounter;
+
+    // Used with Transport::SharedMemoryRing.
+    std::unique_ptr<utils::SharedMemoryRing> mCommandRing;
+    std::unique_ptr<utils::SharedMemoryRing> mReturnRing;
+    std::unique_ptr<utils::SharedMemoryRingReader> mReturnReader;
+
+    // Used with Transport::Socket.
+    int mSocket = -1;
+    std::vector<char> mSocketBuffer;
+};
+
+TEST_P(WireTransportPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(WireTransportPerf,
+                        {NullBackend()},
+                        {Transport::SharedMemoryRing, Transport::Socket},
+                        {Measurement::Throughput, Measurement::Latency});
@@ -16,9 +16,12 @@
 // AsyncTaskTests:
 //     Simple tests for dawn::native::AsyncTask and dawn::native::AsnycTaskManager.
 
+#include <algorithm>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -61,6 +64,26 @@ void DoTask(ConcurrentTaskResultQueue* resultQueue, uint32_t id) {
     resultQueue->AddResult(std::move(result));
 }
 
+// Occupies one of the concurrent tasks of a task manager until it is unblocked, so that the tasks
+// posted after it are queued.
+class BlockingTask {
+  public:
+    explicit BlockingTask(dawn::native::AsyncTaskManager* taskManager) {
+        std::shared_future<void> unblocked = mUnblocked.get_future().share();
+        taskManager->PostTask([this, unblocked] {
+            mStarted.set_value();
+            unblocked.wait();
+        });
+        mStarted.get_future().wait();
+    }
+
+    void Unblock() { mUnblocked.set_value(); }
+
+  private:
+    std::promise<void> mStarted;
+    std::promise<void> mUnblocked;
+};
+
 }  // anonymous namespace
 
 class AsyncTaskTest : public testing::Test {};
@@ -90,3 +113,99 @@ TEST_F(AsyncTaskTest, Basic) {
     }
     ASSERT_TRUE(idset.empty());
 }
+
+// Test that queued tasks start in order of decreasing priority, then in the order they were
+// posted.
+TEST_F(AsyncTaskTest, Priority) {
+    dawn::platform::Platform platform;
+    std::unique_ptr<dawn::platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    dawn::native::AsyncTaskManager taskManager(pool.get(), 1);
+    ConcurrentTaskResultQueue taskResultQueue;
+
+    BlockingTask blockingTask(&taskManager);
+    constexpr int32_t kPriorities[] = {0, 5, -1, 5, 2, 0};
+    for (uint32_t i = 0; i < 6; ++i) {
+        taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); },
+                             kPriorities[i]);
+    }
+    EXPECT_TRUE(taskManager.HasPendingTasks());
+    blockingTask.Unblock();
+    taskManager.WaitAllPendingTasks();
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    constexpr uint32_t kExpectedOrder[] = {1, 3, 4, 0, 5, 2};
+    ASSERT_EQ(results.size(), 6u);
+    for (uint32_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(results[i]->id, kExpectedOrder[i]);
+    }
+}
+
+// Test that cancelling a group calls the cancel task of its queued tasks instead of running them
+// and doesn't affect the other tasks.
+TEST_F(AsyncTaskTest, Cancellation) {
+    dawn::platform::Platform platform;
+    std::unique_ptr<dawn::platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    dawn::native::AsyncTaskManager taskManager(pool.get(), 1);
+    ConcurrentTaskResultQueue taskResultQueue;
+    ConcurrentTaskResultQueue cancelResultQueue;
+
+    BlockingTask blockingTask(&taskManager);
+    for (uint32_t i = 0; i < 6; ++i) {
+        uint64_t cancellationGroup = i % 2 == 0 ? 1 : 2;
+        taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); }, 0,
+                             cancellationGroup,
+                             [&cancelResultQueue, i] { DoTask(&cancelResultQueue, i); });
+    }
+
+    EXPECT_EQ(taskManager.CancelTasks(1), 3u);
+    EXPECT_EQ(taskManager.CancelTasks(1), 0u);
+    EXPECT_EQ(taskManager.CancelTasks(3), 0u);
+
+    std::vector<std::unique_ptr<SimpleTaskResult>> cancelled = cancelResultQueue.GetAllResults();
+    ASSERT_EQ(cancelled.size(), 3u);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(cancelled[i]->id, 2 * i);
+    }
+
+    blockingTask.Unblock();
+    taskManager.WaitAllPendingTasks();
+
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    ASSERT_EQ(results.size(), 3u);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(results[i]->id, 2 * i + 1);
+    }
+    EXPECT_EQ(taskManager.CancelTasks(2), 0u);
+}
+
+// Test that no more than the maximum number of tasks run at the same time.
+TEST_F(AsyncTaskTest, MaxConcurrentTasks) {
+    dawn::platform::Platform platform;
+    std::unique_ptr<dawn::platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    constexpr uint32_t kMaxConcurrentTasks = 3;
+    dawn::native::AsyncTaskManager taskManager(pool.get(), kMaxConcurrentTasks);
+
+    std::mutex mutex;
+    uint32_t runningCount = 0;
+    uint32_t maxRunningCount = 0;
+    for (uint32_t i = 0; i < 50; ++i) {
+        taskManager.PostTask([&] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                runningCount++;
+                maxRunningCount = std::max(maxRunningCount, runningCount);
+            }
+            std::this_thread::yield();
+            std::lock_guard<std::mutex> lock(mutex);
+            runningCount--;
+        });
+    }
+    taskManager.WaitAllPendingTasks();
+
+    EXPECT_EQ(runningCount, 0u);
+    EXPECT_LE(maxRunningCount, kMaxConcurrentTasks);
+}
@@ -0,0 +1,85 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "dawn/common/HashUtils.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// The sizes around the boundaries of the different code paths of HashBytes.
+constexpr size_t kMaxTestedSize = 200;
+
+std::vector<uint8_t> MakeData(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    return data;
+}
+
+// Test that hashing the same bytes gives the same hash, independently of their alignment.
+TEST(HashBytes, Deterministic) {
+    std::vector<uint8_t> data = MakeData(kMaxTestedSize);
+    std::vector<uint8_t> shifted(kMaxTestedSize + 1);
+    memcpy(shifted.data() + 1, data.data(), kMaxTestedSize);
+
+    for (size_t size = 0; size <= kMaxTestedSize; ++size) {
+        EXPECT_EQ(HashBytes(data.data(), size), HashBytes(data.data(), size));
+        EXPECT_EQ(HashBytes(data.data(), size), HashBytes(shifted.data() + 1, size));
+    }
+}
+
+// Test that data with different sizes have different hashes, even when zero-filled.
+TEST(HashBytes, DifferentSizes) {
+    std::vector<uint8_t> data = MakeData(kMaxTestedSize);
+    std::vector<uint8_t> zeroes(kMaxTestedSize, 0);
+
+    std::set<uint64_t> hashes;
+    for (size_t size = 0; size <= kMaxTestedSize; ++size) {
+        hashes.insert(HashBytes(data.data(), size));
+        hashes.insert(HashBytes(zeroes.data(), size));
+    }
+    // Both sizes of 0 hash the same empty data.
+    EXPECT_EQ(hashes.size(), 2 * (kMaxTestedSize + 1) - 1);
+}
+
+// Test that changing any single bit of the data changes the hash.
+TEST(HashBytes, EveryBitMatters) {
+    for (size_t size : {1u, 3u, 4u, 8u, 16u, 17u, 48u, 49u, 100u}) {
+        std::vector<uint8_t> data = MakeData(size);
+        uint64_t hash = HashBytes(data.data(), size);
+
+        for (size_t byte = 0; byte < size; ++byte) {
+            for (uint32_t bit = 0; bit < 8; ++bit) {
+                data[byte] ^= 1 << bit;
+                EXPECT_NE(hash, HashBytes(data.data(), size));
+                data[byte] ^= 1 << bit;
+            }
+        }
+    }
+}
+
+// Test that the seed changes the hash.
+TEST(HashBytes, Seed) {
+    std::vector<uint8_t> data = MakeData(64);
+    for (size_t size : {0u, 5u, 64u}) {
+        EXPECT_NE(HashBytes(data.data(), size, 0), HashBytes(data.data(), size, 1));
+    }
+}
+
+}  // anonymous namespace
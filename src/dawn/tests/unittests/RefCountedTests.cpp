@@ -34,6 +34,8 @@ class RCTest : public RefCounted {
 
     RCTest* GetThis() { return this; }
 
+    using RefCounted::SetRefCountSingleThreaded;
+
   private:
     bool* mDeleted = nullptr;
 };
@@ -97,6 +99,27 @@ TEST(RefCounted, RaceOnReferenceRelease) {
     EXPECT_TRUE(deleted);
 }
 
+// Test that single-threaded refcounts count references and destroy the object like atomic ones.
+TEST(RefCounted, SingleThreaded) {
+    bool deleted = false;
+    auto* test = new RCTest(&deleted);
+    test->SetRefCountSingleThreaded();
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        test->Reference();
+    }
+    EXPECT_EQ(test->GetRefCountForTesting(), 11u);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        test->Release();
+    }
+    EXPECT_EQ(test->GetRefCountForTesting(), 1u);
+    EXPECT_FALSE(deleted);
+
+    test->Release();
+    EXPECT_TRUE(deleted);
+}
+
 // Test Ref remove reference when going out of scope
 TEST(Ref, EndOfScopeRemovesRef) {
     bool deleted = false;
@@ -267,6 +290,20 @@ TEST(Ref, PayloadUnchangedByRefCounting) {
     test->Release();
 }
 
+// Test that the payload is unchanged when the refcount is made single-threaded.
+TEST(Ref, PayloadUnchangedBySingleThreaded) {
+    RCTest* test = new RCTest(1ull);
+    test->SetRefCountSingleThreaded();
+    EXPECT_EQ(test->GetRefCountPayload(), 1u);
+
+    test->Reference();
+    EXPECT_EQ(test->GetRefCountPayload(), 1u);
+    test->Release();
+    EXPECT_EQ(test->GetRefCountPayload(), 1u);
+
+    test->Release();
+}
+
 // Test that Detach pulls out the pointer and stops tracking it.
 TEST(Ref, Detach) {
     bool deleted = false;
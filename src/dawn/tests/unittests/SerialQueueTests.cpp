@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -175,3 +177,164 @@ TEST(SerialQueue, TypedInteger) {
     }
     ASSERT_TRUE(expectedValues.empty());
 }
+
+// Test that ClearUpTo works when called repeatedly on a queue that is continuously enqueued to,
+// which exercises the reuse of the cleared storage.
+TEST(SerialQueue, ClearUpToWhileEnqueuing) {
+    TestSerialQueue queue;
+
+    uint64_t firstSerial = 0;
+    uint64_t nextSerial = 0;
+    for (int i = 0; i < 100; ++i) {
+        // Enqueue a varying number of serials, each with a varying number of values.
+        for (int j = 0; j < i % 7 + 1; ++j) {
+            for (int k = 0; k < j % 3 + 1; ++k) {
+                queue.Enqueue(static_cast<int>(nextSerial), nextSerial);
+            }
+            nextSerial++;
+        }
+
+        // Clear a varying number of serials, but never all of them.
+        uint64_t newFirstSerial = std::min(nextSerial - 1, firstSerial + i % 5);
+        if (newFirstSerial > firstSerial) {
+            queue.ClearUpTo(newFirstSerial - 1);
+            firstSerial = newFirstSerial;
+        }
+
+        ASSERT_FALSE(queue.Empty());
+        EXPECT_EQ(queue.FirstSerial(), firstSerial);
+        EXPECT_EQ(queue.LastSerial(), nextSerial - 1);
+
+        uint64_t expectedSerial = firstSerial;
+        for (int value : queue.IterateAll()) {
+            if (static_cast<uint64_t>(value) != expectedSerial) {
+                EXPECT_EQ(static_cast<uint64_t>(value), expectedSerial + 1);
+                expectedSerial++;
+            }
+        }
+        EXPECT_EQ(expectedSerial, nextSerial - 1);
+    }
+}
+
+// Test that the storage of cleared serials is reused for the next serials.
+TEST(SerialQueue, ReusesClearedStorage) {
+    TestSerialQueue queue;
+
+    queue.Enqueue(std::vector<int>{1, 2, 3, 4}, 0);
+    const int* storage = &*queue.IterateAll().begin();
+    queue.ClearUpTo(0);
+    ASSERT_TRUE(queue.Empty());
+
+    queue.Enqueue(5, 1);
+    queue.Enqueue(6, 1);
+    EXPECT_EQ(&*queue.IterateAll().begin(), storage);
+}
+
+// Test that the buckets of a burst of serials are freed once the burst is cleared.
+TEST(SerialQueue, TrimsClearedBuckets) {
+    SerialQueueStorage<uint64_t, int> storage;
+    for (uint64_t serial = 0; serial < 1000; ++serial) {
+        storage.AppendBucket(serial).push_back(static_cast<int>(serial));
+    }
+    EXPECT_EQ(storage.GetBucketCountForTesting(), 1000u);
+
+    // Clearing the front rotates the live buckets back to the front and frees the cleared buckets
+    // past twice the live ones.
+    storage.erase(storage.begin(), storage.begin() + 990);
+    EXPECT_LE(storage.GetBucketCountForTesting(), 20u);
+    EXPECT_EQ(storage.begin()->first, 990u);
+    EXPECT_EQ(storage.back().first, 999u);
+
+    // Draining the queue keeps only a few buckets for reuse.
+    storage.clear();
+    EXPECT_TRUE(storage.empty());
+    EXPECT_LE(storage.GetBucketCountForTesting(), 4u);
+
+    // A queue in steady state doesn't trim the buckets it keeps reusing.
+    for (uint64_t serial = 1000; serial < 1100; ++serial) {
+        storage.AppendBucket(serial).push_back(static_cast<int>(serial));
+        if (serial >= 1003) {
+            storage.erase(storage.begin(), storage.begin() + 1);
+        }
+        EXPECT_LE(storage.GetBucketCountForTesting(), 8u);
+    }
+}
+
+// Test a queue in steady state where a fixed number of serials are in flight, like the per-submit
+// queues of the backends: the serials are cleared in order and their storage is reused.
+TEST(SerialQueue, SteadyState) {
+    constexpr uint64_t kSerialsInFlight = 3;
+    constexpr uint64_t kSerialCount = 1000;
+    constexpr int kValuesPerSerial = 8;
+
+    TestSerialQueue queue;
+    std::set<const int*> warmupStorage;
+    for (uint64_t serial = 0; serial < kSerialCount; ++serial) {
+        for (int i = 0; i < kValuesPerSerial; ++i) {
+            queue.Enqueue(static_cast<int>(serial) * kValuesPerSerial + i, serial);
+        }
+
+        // After a few serials, the values of the new serials are stored in the storage of the
+        // cleared ones.
+        const int* storage = nullptr;
+        for (const int& value : queue.IterateAll()) {
+            if (value == static_cast<int>(serial) * kValuesPerSerial) {
+                storage = &value;
+            }
+        }
+        ASSERT_NE(storage, nullptr);
+        if (serial < 2 * kSerialsInFlight) {
+            warmupStorage.insert(storage);
+        } else {
+            EXPECT_EQ(warmupStorage.count(storage), 1u);
+        }
+
+        if (serial >= kSerialsInFlight) {
+            uint64_t completedSerial = serial - kSerialsInFlight;
+            int expectedValue = static_cast<int>(completedSerial) * kValuesPerSerial;
+            for (int value : queue.IterateUpTo(completedSerial)) {
+                EXPECT_EQ(value, expectedValue++);
+            }
+            EXPECT_EQ(expectedValue, static_cast<int>(completedSerial + 1) * kValuesPerSerial);
+            queue.ClearUpTo(completedSerial);
+            EXPECT_EQ(queue.FirstSerial(), completedSerial + 1);
+        }
+    }
+
+    EXPECT_EQ(queue.FirstSerial(), kSerialCount - kSerialsInFlight);
+    EXPECT_EQ(queue.LastSerial(), kSerialCount - 1);
+}
+
+// Test a queue where many serials accumulate before they are cleared in a few steps, front first.
+TEST(SerialQueue, Bursts) {
+    constexpr uint64_t kSerialsPerBurst = 1000;
+    constexpr int kBurstCount = 4;
+
+    TestSerialQueue queue;
+    uint64_t serial = 0;
+    for (int burst = 0; burst < kBurstCount; ++burst) {
+        uint64_t firstSerial = serial;
+        for (uint64_t i = 0; i < kSerialsPerBurst; ++i) {
+            queue.Enqueue(burst, serial++);
+        }
+
+        for (uint64_t step = 1; step <= 4; ++step) {
+            uint64_t clearedSerial = firstSerial + step * kSerialsPerBurst / 4 - 1;
+            queue.ClearUpTo(clearedSerial);
+            if (step == 4) {
+                break;
+            }
+
+            // The serials after the cleared ones are all still in the queue.
+            EXPECT_EQ(queue.FirstSerial(), clearedSerial + 1);
+            EXPECT_EQ(queue.LastSerial(), serial - 1);
+            uint64_t valueCount = 0;
+            for (int value : queue.IterateAll()) {
+                EXPECT_EQ(value, burst);
+                valueCount++;
+            }
+            EXPECT_EQ(valueCount, serial - clearedSerial - 1);
+        }
+        ASSERT_TRUE(queue.Empty());
+    }
+}
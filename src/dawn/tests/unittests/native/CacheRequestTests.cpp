@@ -18,6 +18,9 @@
 
 #include "dawn/native/Blob.h"
 #include "dawn/native/CacheRequest.h"
+#include "dawn/native/Serializable.h"
+#include "dawn/native/TransformedShaderCache.h"
+#include "dawn/native/stream/ByteVectorSink.h"
 #include "dawn/tests/DawnNativeTest.h"
 #include "dawn/tests/mocks/platform/CachingInterfaceMock.h"
 
@@ -316,6 +319,147 @@ TEST_F(CacheRequestTests, CacheHitError) {
     EXPECT_FALSE(result.IsCached());
 }
 
+// A result type that can be stored in a TransformedShaderCache.
+struct IntResult {
+    static IntResult FromBlob(Blob blob) {
+        IntResult result;
+        EXPECT_EQ(blob.Size(), sizeof(result.value));
+        memcpy(&result.value, blob.Data(), sizeof(result.value));
+        return result;
+    }
+
+    Blob ToBlob() const {
+        Blob blob = CreateBlob(sizeof(value));
+        memcpy(blob.Data(), &value, sizeof(value));
+        return blob;
+    }
+
+    int value = 0;
+};
+
+// Test that the result of a cache miss is stored in the TransformedShaderCache and that the next
+// identical request uses it without looking up the BlobCache.
+TEST_F(CacheRequestTests, TransformedShaderCacheHit) {
+    TransformedShaderCache transformedShaderCache(4);
+
+    static StrictMock<MockFunction<IntResult(CacheRequestForTesting)>> cacheMissFn;
+    auto makeRequest = []() {
+        CacheRequestForTesting req;
+        req.a = 1;
+        req.b = 0.2;
+        req.c = {3, 4, 5};
+        return req;
+    };
+
+    // The first request misses both caches.
+    EXPECT_CALL(mMockCache, LoadData(_, _, nullptr, 0)).WillOnce(Return(0));
+    EXPECT_CALL(cacheMissFn, Call(_)).WillOnce(Return(IntResult{}));
+    auto result1 = LoadOrRun(GetDevice(), &transformedShaderCache, makeRequest(),
+                             IntResult::FromBlob,
+                             [](CacheRequestForTesting req) -> ResultOrError<IntResult> {
+                                 IntResult result = cacheMissFn.Call(std::move(req));
+                                 result.value = 42;
+                                 return result;
+                             })
+                       .AcquireSuccess();
+    EXPECT_EQ(result1->value, 42);
+    EXPECT_FALSE(result1.IsCached());
+    EXPECT_EQ(transformedShaderCache.GetEntryCountForTesting(), 1u);
+
+    // The second request is a hit in the TransformedShaderCache. The StrictMocks check that
+    // neither the BlobCache nor the cache miss function are called.
+    auto result2 = LoadOrRun(GetDevice(), &transformedShaderCache, makeRequest(),
+                             IntResult::FromBlob,
+                             [](CacheRequestForTesting req) -> ResultOrError<IntResult> {
+                                 return cacheMissFn.Call(std::move(req));
+                             })
+                       .AcquireSuccess();
+    EXPECT_EQ(result2->value, 42);
+    EXPECT_TRUE(result2.IsCached());
+}
+
+#define SERIALIZABLE_RESULT_MEMBERS(X) \
+    X(Blob, blob)                      \
+    X(std::vector<uint32_t>, words)
+DAWN_SERIALIZABLE(struct, SerializableResult, SERIALIZABLE_RESULT_MEMBERS){};
+#undef SERIALIZABLE_RESULT_MEMBERS
+
+// Test that a serializable result is stored with exactly its serialized size and bytes, and that
+// the blobs in the result loaded on a cache hit point into the loaded data instead of being
+// copied out of it.
+TEST_F(CacheRequestTests, SerializableResultStoredAndLoadedInPlace) {
+    static StrictMock<MockFunction<ResultOrError<SerializableResult>(Blob)>> cacheHitFn;
+    static StrictMock<MockFunction<SerializableResult(CacheRequestForTesting)>> cacheMissFn;
+    auto makeRequest = []() {
+        CacheRequestForTesting req;
+        req.a = 1;
+        req.b = 0.2;
+        req.c = {3, 4, 5};
+        return req;
+    };
+    auto makeResult = []() {
+        SerializableResult result;
+        result.blob = CreateBlob(std::vector<uint8_t>(1024, 0xAB));
+        result.words = {0x07230203, 0x00010000, 0, 42};
+        return result;
+    };
+
+    stream::ByteVectorSink expected;
+    StreamIn(&expected, makeResult());
+
+    // On a cache miss, the result is stored with its exact serialized size and bytes.
+    std::vector<uint8_t> storedData;
+    EXPECT_CALL(mMockCache, LoadData(_, _, nullptr, 0)).WillOnce(Return(0));
+    EXPECT_CALL(cacheMissFn, Call(_)).WillOnce(Return(ByMove(makeResult())));
+    EXPECT_CALL(mMockCache, StoreData(_, _, _, expected.size()))
+        .WillOnce(WithArg<2>(Invoke([&](const void* value) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(value);
+            storedData.assign(bytes, bytes + expected.size());
+        })));
+    {
+        auto result = LoadOrRun(
+                          GetDevice(), makeRequest(),
+                          [](Blob blob) -> ResultOrError<SerializableResult> {
+                              return cacheHitFn.Call(std::move(blob));
+                          },
+                          [](CacheRequestForTesting req) -> ResultOrError<SerializableResult> {
+                              return cacheMissFn.Call(std::move(req));
+                          })
+                          .AcquireSuccess();
+        EXPECT_FALSE(result.IsCached());
+        GetDevice()->GetBlobCache()->EnsureStored(result);
+    }
+    ASSERT_EQ(storedData.size(), expected.size());
+    EXPECT_EQ(memcmp(storedData.data(), expected.data(), expected.size()), 0);
+
+    // On a cache hit, the blob of the result points into the loaded data, after its size.
+    EXPECT_CALL(mMockCache, LoadData(_, _, nullptr, 0)).WillOnce(Return(storedData.size()));
+    EXPECT_CALL(mMockCache, LoadData(_, _, _, storedData.size()))
+        .WillOnce(WithArg<2>(Invoke([&](void* dataOut) {
+            memcpy(dataOut, storedData.data(), storedData.size());
+            return storedData.size();
+        })));
+    EXPECT_CALL(cacheHitFn, Call(_)).WillOnce(WithArg<0>(Invoke([](Blob blob) {
+        const uint8_t* loadedData = blob.Data();
+        SerializableResult result = SerializableResult::FromBlob(std::move(blob)).AcquireSuccess();
+        EXPECT_EQ(result.blob.Data(), loadedData + sizeof(size_t));
+        return result;
+    })));
+    auto result = LoadOrRun(
+                      GetDevice(), makeRequest(),
+                      [](Blob blob) -> ResultOrError<SerializableResult> {
+                          return cacheHitFn.Call(std::move(blob));
+                      },
+                      [](CacheRequestForTesting req) -> ResultOrError<SerializableResult> {
+                          return cacheMissFn.Call(std::move(req));
+                      })
+                      .AcquireSuccess();
+    EXPECT_TRUE(result.IsCached());
+    ASSERT_EQ(result->blob.Size(), 1024u);
+    EXPECT_EQ(result->blob.Data()[0], 0xAB);
+    EXPECT_EQ(result->words, makeResult().words);
+}
+
 }  // namespace
 
 }  // namespace dawn::native
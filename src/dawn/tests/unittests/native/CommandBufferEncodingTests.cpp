@@ -19,6 +19,7 @@
 #include "dawn/native/Commands.h"
 #include "dawn/native/ComputePassEncoder.h"
 #include "dawn/tests/DawnNativeTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
 #include "dawn/utils/WGPUHelpers.h"
 
 namespace dawn::native {
@@ -37,8 +38,262 @@ class CommandBufferEncodingTests : public DawnNativeTest {
             expectedCommands[commandIndex].second(commands);
         }
     }
+
+    // Returns the IDs of all the commands in the command buffer, and the indirect offsets of its
+    // DrawIndirect commands.
+    std::vector<Command> GetCommandIds(const wgpu::CommandBuffer& commandBuffer,
+                                       std::vector<uint64_t>* drawIndirectOffsets) {
+        CommandIterator* commands = FromAPI(commandBuffer.Get())->GetCommandIteratorForTesting();
+        std::vector<Command> commandIds;
+        Command commandId;
+        while (commands->NextCommandId(&commandId)) {
+            commandIds.push_back(commandId);
+            if (commandId == Command::DrawIndirect) {
+                drawIndirectOffsets->push_back(
+                    commands->NextCommand<DrawIndirectCmd>()->indirectOffset);
+            } else {
+                SkipCommand(commands, commandId);
+            }
+        }
+        commands->Reset();
+        return commandIds;
+    }
+
+    wgpu::RenderPipeline CreateRenderPipeline() {
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.vertex.module = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4<f32> {
+                return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+            })");
+        descriptor.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4<f32> {
+                return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+            })");
+        return device.CreateRenderPipeline(&descriptor);
+    }
 };
 
+// Test that the indirect draws of consecutive render passes are validated together before the
+// first render pass, and that draws using the same indirect offset are validated once.
+TEST_F(CommandBufferEncodingTests, IndirectDrawValidationBatchedAcrossRenderPasses) {
+    wgpu::RenderPipeline pipeline = CreateRenderPipeline();
+    wgpu::Buffer indirectBuffer = utils::CreateBufferFromData<uint32_t>(
+        device, wgpu::BufferUsage::Indirect, {1, 1, 0, 0, 2, 1, 0, 0});
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        pass.DrawIndirect(indirectBuffer, 0);
+        pass.DrawIndirect(indirectBuffer, 16);
+        pass.End();
+    }
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        pass.DrawIndirect(indirectBuffer, 0);
+        pass.End();
+    }
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    std::vector<uint64_t> drawIndirectOffsets;
+    std::vector<Command> expectedCommands = {
+        // The validation of all the draws, in a single dispatch.
+        Command::WriteBuffer,
+        Command::BeginComputePass,
+        Command::SetComputePipeline,
+        Command::SetBindGroup,
+        Command::Dispatch,
+        Command::EndComputePass,
+
+        Command::BeginRenderPass,
+        Command::SetRenderPipeline,
+        Command::DrawIndirect,
+        Command::DrawIndirect,
+        Command::EndRenderPass,
+
+        Command::BeginRenderPass,
+        Command::SetRenderPipeline,
+        Command::DrawIndirect,
+        Command::EndRenderPass,
+    };
+    EXPECT_EQ(GetCommandIds(commandBuffer, &drawIndirectOffsets), expectedCommands);
+
+    // The draws with the same indirect offset use the same validated parameters.
+    ASSERT_EQ(drawIndirectOffsets.size(), 3u);
+    EXPECT_NE(drawIndirectOffsets[0], drawIndirectOffsets[1]);
+    EXPECT_EQ(drawIndirectOffsets[0], drawIndirectOffsets[2]);
+}
+
+// Test that commands encoded between render passes, which may write to the indirect buffers, end
+// the batching of indirect draw validation.
+TEST_F(CommandBufferEncodingTests, IndirectDrawValidationNotBatchedAcrossCommands) {
+    wgpu::RenderPipeline pipeline = CreateRenderPipeline();
+    wgpu::Buffer indirectBuffer = utils::CreateBufferFromData<uint32_t>(
+        device, wgpu::BufferUsage::Indirect, {1, 1, 0, 0});
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < 2; ++i) {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        pass.DrawIndirect(indirectBuffer, 0);
+        pass.End();
+
+        if (i == 0) {
+            encoder.ClearBuffer(indirectBuffer, 0, 16);
+        }
+    }
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    std::vector<uint64_t> drawIndirectOffsets;
+    std::vector<Command> expectedCommands = {
+        Command::WriteBuffer,
+        Command::BeginComputePass,
+        Command::SetComputePipeline,
+        Command::SetBindGroup,
+        Command::Dispatch,
+        Command::EndComputePass,
+        Command::BeginRenderPass,
+        Command::SetRenderPipeline,
+        Command::DrawIndirect,
+        Command::EndRenderPass,
+
+        Command::ClearBuffer,
+
+        Command::WriteBuffer,
+        Command::BeginComputePass,
+        Command::SetComputePipeline,
+        Command::SetBindGroup,
+        Command::Dispatch,
+        Command::EndComputePass,
+        Command::BeginRenderPass,
+        Command::SetRenderPipeline,
+        Command::DrawIndirect,
+        Command::EndRenderPass,
+    };
+    EXPECT_EQ(GetCommandIds(commandBuffer, &drawIndirectOffsets), expectedCommands);
+}
+
+// Test that a render pass writing to a storage buffer ends the batching of indirect draw
+// validation before a render pass using it as an indirect buffer.
+TEST_F(CommandBufferEncodingTests, IndirectDrawValidationNotBatchedAfterStorageWrite) {
+    wgpu::RenderPipeline pipeline = CreateRenderPipeline();
+    wgpu::Buffer indirectBuffer = utils::CreateBufferFromData<uint32_t>(
+        device, wgpu::BufferUsage::Indirect | wgpu::BufferUsage::Storage, {1, 1, 0, 0});
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Storage}});
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, layout, {{0, indirectBuffer}});
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetBindGroup(0, bindGroup);
+        pass.End();
+    }
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        pass.DrawIndirect(indirectBuffer, 0);
+        pass.End();
+    }
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    std::vector<uint64_t> drawIndirectOffsets;
+    std::vector<Command> expectedCommands = {
+        Command::BeginRenderPass,
+        Command::SetBindGroup,
+        Command::EndRenderPass,
+
+        Command::WriteBuffer,
+        Command::BeginComputePass,
+        Command::SetComputePipeline,
+        Command::SetBindGroup,
+        Command::Dispatch,
+        Command::EndComputePass,
+        Command::BeginRenderPass,
+        Command::SetRenderPipeline,
+        Command::DrawIndirect,
+        Command::EndRenderPass,
+    };
+    EXPECT_EQ(GetCommandIds(commandBuffer, &drawIndirectOffsets), expectedCommands);
+}
+
+// Test that a compute pass ends the batching of indirect draw validation, so that the usages of
+// the compute passes are in the order of the compute passes in the commands.
+TEST_F(CommandBufferEncodingTests, IndirectDrawValidationNotBatchedAcrossComputePass) {
+    wgpu::RenderPipeline renderPipeline = CreateRenderPipeline();
+    wgpu::Buffer indirectBuffer = utils::CreateBufferFromData<uint32_t>(
+        device, wgpu::BufferUsage::Indirect, {1, 1, 0, 0});
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, 1, 1);
+
+    wgpu::ComputePipelineDescriptor computePipelineDesc = {};
+    computePipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : array<u32>;
+        @compute @workgroup_size(1) fn main() {
+            data[0] = 1u;
+        })");
+    computePipelineDesc.compute.entryPoint = "main";
+    wgpu::ComputePipeline computePipeline = device.CreateComputePipeline(&computePipelineDesc);
+
+    wgpu::BufferDescriptor storageBufferDesc = {};
+    storageBufferDesc.size = 4;
+    storageBufferDesc.usage = wgpu::BufferUsage::Storage;
+    wgpu::Buffer storageBuffer = device.CreateBuffer(&storageBufferDesc);
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(
+        device, computePipeline.GetBindGroupLayout(0), {{0, storageBuffer}});
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(renderPipeline);
+        pass.DrawIndirect(indirectBuffer, 0);
+        pass.End();
+    }
+    {
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(computePipeline);
+        pass.SetBindGroup(0, bindGroup);
+        pass.DispatchWorkgroups(1);
+        pass.End();
+    }
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    std::vector<uint64_t> drawIndirectOffsets;
+    std::vector<Command> expectedCommands = {
+        Command::WriteBuffer,
+        Command::BeginComputePass,
+        Command::SetComputePipeline,
+        Command::SetBindGroup,
+        Command::Dispatch,
+        Command::EndComputePass,
+        Command::BeginRenderPass,
+        Command::SetRenderPipeline,
+        Command::DrawIndirect,
+        Command::EndRenderPass,
+
+        Command::BeginComputePass,
+        Command::SetComputePipeline,
+        Command::SetBindGroup,
+        Command::Dispatch,
+        Command::EndComputePass,
+    };
+    EXPECT_EQ(GetCommandIds(commandBuffer, &drawIndirectOffsets), expectedCommands);
+
+    // The validation compute pass reads the indirect buffer, and comes before the user's compute
+    // pass.
+    const ComputePassUsages& computePasses =
+        FromAPI(commandBuffer.Get())->GetResourceUsages().computePasses;
+    ASSERT_EQ(computePasses.size(), 2u);
+    EXPECT_EQ(computePasses[0].referencedBuffers.count(FromAPI(indirectBuffer.Get())), 1u);
+    EXPECT_EQ(computePasses[0].referencedBuffers.count(FromAPI(storageBuffer.Get())), 0u);
+    EXPECT_EQ(computePasses[1].referencedBuffers.count(FromAPI(indirectBuffer.Get())), 0u);
+    EXPECT_EQ(computePasses[1].referencedBuffers.count(FromAPI(storageBuffer.Get())), 1u);
+}
+
 // Indirect dispatch validation changes the bind groups in the middle
 // of a pass. Test that bindings are restored after the validation runs.
 TEST_F(CommandBufferEncodingTests, ComputePassEncoderIndirectDispatchStateRestoration) {
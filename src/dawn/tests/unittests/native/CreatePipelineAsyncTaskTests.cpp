@@ -71,3 +71,29 @@ TEST_F(CreatePipelineAsyncTaskTests, InitializationErrorInCreateComputePipelineA
 
     EXPECT_CALL(*computePipelineMock.Get(), DestroyImpl).Times(1);
 }
+
+// Test that cancelling a task calls the callback with an error without initializing the pipeline.
+TEST_F(CreatePipelineAsyncTaskTests, CancelCreateComputePipelineAsync) {
+    dawn::native::DeviceBase* deviceBase =
+        reinterpret_cast<dawn::native::DeviceBase*>(device.Get());
+    Ref<dawn::native::ComputePipelineMock> computePipelineMock =
+        AcquireRef(new dawn::native::ComputePipelineMock(deviceBase));
+    EXPECT_CALL(*computePipelineMock.Get(), Initialize).Times(0);
+
+    bool callbackCalled = false;
+    dawn::native::CreateComputePipelineAsyncTask asyncTask(
+        computePipelineMock,
+        [](WGPUCreatePipelineAsyncStatus status, WGPUComputePipeline returnPipeline,
+           const char* message, void* userdata) {
+            EXPECT_EQ(WGPUCreatePipelineAsyncStatus::WGPUCreatePipelineAsyncStatus_Error, status);
+            EXPECT_EQ(returnPipeline, nullptr);
+            *static_cast<bool*>(userdata) = true;
+        },
+        &callbackCalled);
+
+    asyncTask.Cancel();
+    device.Tick();
+    EXPECT_TRUE(callbackCalled);
+
+    EXPECT_CALL(*computePipelineMock.Get(), DestroyImpl).Times(1);
+}
@@ -14,6 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "dawn/native/Toggles.h"
 #include "dawn/tests/DawnNativeTest.h"
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
@@ -754,6 +758,43 @@ TEST_F(DestroyObjectTests, DestroyObjects) {
     EXPECT_FALSE(textureView->IsAlive());
 }
 
+// Objects created on different threads are tracked in different segments of the device's object
+// lists. Test that they can be destroyed from another thread, and that destroying the device
+// destroys all of them.
+TEST_F(DestroyObjectTests, ObjectsCreatedOnMultipleThreads) {
+    constexpr uint32_t kThreadCount = 12;
+    constexpr uint32_t kObjectsPerThread = 4;
+
+    std::vector<std::unique_ptr<SamplerMock>> samplers(kThreadCount * kObjectsPerThread);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0; i < kObjectsPerThread; ++i) {
+                samplers[t * kObjectsPerThread + i] = std::make_unique<SamplerMock>(&mDevice);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (const std::unique_ptr<SamplerMock>& sampler : samplers) {
+        EXPECT_CALL(*sampler, DestroyImpl).Times(1);
+        EXPECT_TRUE(sampler->IsAlive());
+    }
+
+    // Explicitly destroy the first object created by each thread from the test thread.
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        samplers[t * kObjectsPerThread]->Destroy();
+        EXPECT_FALSE(samplers[t * kObjectsPerThread]->IsAlive());
+    }
+
+    mDevice.DestroyObjects();
+    for (const std::unique_ptr<SamplerMock>& sampler : samplers) {
+        EXPECT_FALSE(sampler->IsAlive());
+    }
+}
+
 static constexpr std::string_view kComputeShader = R"(
         @compute @workgroup_size(1) fn main() {}
     )";
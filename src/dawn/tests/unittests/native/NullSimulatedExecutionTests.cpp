@@ -0,0 +1,187 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/NullBackend.h"
+#include "dawn/tests/MockCallback.h"
+#include "dawn/webgpu_cpp.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using testing::_;
+using testing::MockCallback;
+
+class NullSimulatedExecutionTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        dawnProcSetProcs(&dawn::native::GetProcs());
+
+        instance = std::make_unique<dawn::native::Instance>();
+        instance->DiscoverDefaultAdapters();
+        for (dawn::native::Adapter& nativeAdapter : instance->GetAdapters()) {
+            wgpu::AdapterProperties properties;
+            nativeAdapter.GetProperties(&properties);
+
+            if (properties.backendType == wgpu::BackendType::Null) {
+                wgpu::Adapter adapter = wgpu::Adapter(nativeAdapter.Get());
+                device = adapter.CreateDevice();
+                break;
+            }
+        }
+        ASSERT_NE(device, nullptr);
+        queue = device.GetQueue();
+    }
+
+    void TearDown() override {
+        queue = nullptr;
+        device = nullptr;
+        instance = nullptr;
+        dawnProcSetProcs(nullptr);
+    }
+
+    void SubmitEmptyCommandBuffer() {
+        wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+        queue.Submit(1, &commands);
+    }
+
+    void ExpectWorkDoneAfter(uint64_t durationNs) {
+        MockCallback<WGPUQueueWorkDoneCallback> workDone;
+        queue.OnSubmittedWorkDone(0u, workDone.Callback(), workDone.MakeUserdata(this));
+
+        EXPECT_CALL(workDone, Call(_, _)).Times(0);
+        dawn::native::null::AdvanceSimulatedTime(device.Get(), durationNs - 1);
+        device.Tick();
+        testing::Mock::VerifyAndClearExpectations(&workDone);
+
+        EXPECT_CALL(workDone, Call(WGPUQueueWorkDoneStatus_Success, this)).Times(1);
+        dawn::native::null::AdvanceSimulatedTime(device.Get(), 1);
+        device.Tick();
+    }
+
+    std::unique_ptr<dawn::native::Instance> instance;
+    wgpu::Device device;
+    wgpu::Queue queue;
+};
+
+// Test that with the default costs, submitted work completes without advancing the clock.
+TEST_F(NullSimulatedExecutionTest, DefaultCostsCompleteInstantly) {
+    SubmitEmptyCommandBuffer();
+
+    MockCallback<WGPUQueueWorkDoneCallback> workDone;
+    EXPECT_CALL(workDone, Call(WGPUQueueWorkDoneStatus_Success, this)).Times(1);
+    queue.OnSubmittedWorkDone(0u, workDone.Callback(), workDone.MakeUserdata(this));
+    device.Tick();
+    device.Tick();
+
+    EXPECT_EQ(dawn::native::null::GetSimulatedTime(device.Get()), 0u);
+}
+
+// Test that the submit latency delays the completion of submitted work.
+TEST_F(NullSimulatedExecutionTest, SubmitLatency) {
+    dawn::native::null::SimulatedExecutionCosts costs;
+    costs.submitLatencyNs = 1000;
+    dawn::native::null::SetSimulatedExecutionCosts(device.Get(), costs);
+
+    SubmitEmptyCommandBuffer();
+    ExpectWorkDoneAfter(1000);
+}
+
+// Test that each recorded command and each queue write adds to the execution time.
+TEST_F(NullSimulatedExecutionTest, CommandAndWriteCosts) {
+    dawn::native::null::SimulatedExecutionCosts costs;
+    costs.perCommandNs = 100;
+    costs.perKilobyteWrittenNs = 1024;
+    dawn::native::null::SetSimulatedExecutionCosts(device.Get(), costs);
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer src = device.CreateBuffer(&descriptor);
+    wgpu::Buffer dst = device.CreateBuffer(&descriptor);
+
+    uint32_t data = 0;
+    queue.WriteBuffer(src, 0, &data, sizeof(data));
+
+    // Two copies are recorded, each costing 100ns, and 4 bytes are written costing 4ns.
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(src, 0, dst, 0, 4);
+    encoder.CopyBufferToBuffer(dst, 0, src, 0, 4);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    ExpectWorkDoneAfter(204);
+}
+
+// Test that the simulated GPU executes submissions one after the other while the submit latency
+// is overlapped.
+TEST_F(NullSimulatedExecutionTest, SubmissionsArePipelined) {
+    dawn::native::null::SimulatedExecutionCosts costs;
+    costs.submitLatencyNs = 1000;
+    costs.perCommandNs = 100;
+    dawn::native::null::SetSimulatedExecutionCosts(device.Get(), costs);
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer src = device.CreateBuffer(&descriptor);
+    wgpu::Buffer dst = device.CreateBuffer(&descriptor);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(src, 0, dst, 0, 4);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    ExpectWorkDoneAfter(3 * 100 + 1000);
+}
+
+// Test that ticking the device advances the virtual clock by the tick duration.
+TEST_F(NullSimulatedExecutionTest, TickDuration) {
+    dawn::native::null::SimulatedExecutionCosts costs;
+    costs.submitLatencyNs = 250;
+    costs.tickDurationNs = 100;
+    dawn::native::null::SetSimulatedExecutionCosts(device.Get(), costs);
+
+    SubmitEmptyCommandBuffer();
+
+    MockCallback<WGPUQueueWorkDoneCallback> workDone;
+    EXPECT_CALL(workDone, Call(WGPUQueueWorkDoneStatus_Success, this)).Times(1);
+    queue.OnSubmittedWorkDone(0u, workDone.Callback(), workDone.MakeUserdata(this));
+    for (uint32_t i = 0; i < 4; ++i) {
+        device.Tick();
+    }
+}
+
+// Test that destroying the device completes the work in flight.
+TEST_F(NullSimulatedExecutionTest, DestroyCompletesWorkInFlight) {
+    dawn::native::null::SimulatedExecutionCosts costs;
+    costs.submitLatencyNs = 1000;
+    dawn::native::null::SetSimulatedExecutionCosts(device.Get(), costs);
+
+    SubmitEmptyCommandBuffer();
+
+    MockCallback<WGPUQueueWorkDoneCallback> workDone;
+    EXPECT_CALL(workDone, Call(WGPUQueueWorkDoneStatus_Success, this)).Times(1);
+    queue.OnSubmittedWorkDone(0u, workDone.Callback(), workDone.MakeUserdata(this));
+    device.Destroy();
+
+    EXPECT_GE(dawn::native::null::GetSimulatedTime(device.Get()), 1000u);
+}
+
+}  // namespace
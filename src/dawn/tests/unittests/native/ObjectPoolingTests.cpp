@@ -0,0 +1,170 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/WGPUHelpers.h"
+#include "dawn/webgpu_cpp.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class ObjectPoolingTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        dawnProcSetProcs(&dawn::native::GetProcs());
+
+        instance = std::make_unique<dawn::native::Instance>();
+        instance->DiscoverDefaultAdapters();
+        for (dawn::native::Adapter& nativeAdapter : instance->GetAdapters()) {
+            wgpu::AdapterProperties properties;
+            nativeAdapter.GetProperties(&properties);
+
+            if (properties.backendType == wgpu::BackendType::Null) {
+                adapter = wgpu::Adapter(nativeAdapter.Get());
+                break;
+            }
+        }
+        ASSERT_NE(adapter, nullptr);
+
+        const char* const kPoolingToggle = "pool_texture_views_and_bind_groups";
+        wgpu::DawnTogglesDeviceDescriptor togglesDesc;
+        togglesDesc.forceEnabledToggles = &kPoolingToggle;
+        togglesDesc.forceEnabledTogglesCount = 1;
+
+        wgpu::DeviceDescriptor deviceDesc;
+        deviceDesc.nextInChain = &togglesDesc;
+        device = adapter.CreateDevice(&deviceDesc);
+        ASSERT_NE(device, nullptr);
+    }
+
+    void TearDown() override {
+        device = nullptr;
+        adapter = nullptr;
+        instance = nullptr;
+        dawnProcSetProcs(nullptr);
+    }
+
+    dawn::native::ObjectPoolStats GetStats() {
+        return dawn::native::GetObjectPoolStats(device.Get());
+    }
+
+    wgpu::Texture CreateTexture() {
+        wgpu::TextureDescriptor desc;
+        desc.size = {4, 4, 2};
+        desc.mipLevelCount = 2;
+        desc.format = wgpu::TextureFormat::RGBA8Unorm;
+        desc.usage = wgpu::TextureUsage::TextureBinding;
+        return device.CreateTexture(&desc);
+    }
+
+    wgpu::Buffer CreateUniformBuffer() {
+        wgpu::BufferDescriptor desc;
+        desc.size = 512;
+        desc.usage = wgpu::BufferUsage::Uniform;
+        return device.CreateBuffer(&desc);
+    }
+
+    std::unique_ptr<dawn::native::Instance> instance;
+    wgpu::Adapter adapter;
+    wgpu::Device device;
+};
+
+// Test that creating a view with the same descriptor as a live view returns that view.
+TEST_F(ObjectPoolingTest, TextureViewReused) {
+    wgpu::Texture texture = CreateTexture();
+
+    wgpu::TextureView view = texture.CreateView();
+    EXPECT_EQ(texture.CreateView().Get(), view.Get());
+
+    // Explicitly specifying the default values is the same descriptor.
+    wgpu::TextureViewDescriptor desc;
+    desc.format = wgpu::TextureFormat::RGBA8Unorm;
+    desc.dimension = wgpu::TextureViewDimension::e2DArray;
+    desc.mipLevelCount = 2;
+    desc.arrayLayerCount = 2;
+    EXPECT_EQ(texture.CreateView(&desc).Get(), view.Get());
+
+    EXPECT_EQ(GetStats().textureViewHits, 2u);
+    EXPECT_EQ(GetStats().textureViewMisses, 1u);
+
+    // Different descriptors or textures give different views.
+    desc.baseMipLevel = 1;
+    desc.mipLevelCount = 1;
+    EXPECT_NE(texture.CreateView(&desc).Get(), view.Get());
+    EXPECT_NE(CreateTexture().CreateView().Get(), view.Get());
+    EXPECT_EQ(GetStats().textureViewHits, 2u);
+    EXPECT_EQ(GetStats().textureViewMisses, 3u);
+}
+
+// Test that views are removed from the pool when they are released or when their texture is
+// destroyed.
+TEST_F(ObjectPoolingTest, TextureViewInvalidation) {
+    wgpu::Texture texture = CreateTexture();
+
+    texture.CreateView();
+    texture.CreateView();
+    EXPECT_EQ(GetStats().textureViewHits, 0u);
+    EXPECT_EQ(GetStats().textureViewMisses, 2u);
+
+    wgpu::TextureView view = texture.CreateView();
+    texture.Destroy();
+    EXPECT_NE(texture.CreateView().Get(), view.Get());
+    EXPECT_EQ(GetStats().textureViewHits, 0u);
+    EXPECT_EQ(GetStats().textureViewMisses, 3u);
+}
+
+// Test that creating a bind group with the same entries as a live bind group returns it,
+// independently of the order of the entries.
+TEST_F(ObjectPoolingTest, BindGroupReused) {
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform},
+                 {1, wgpu::ShaderStage::Fragment, wgpu::SamplerBindingType::Filtering}});
+    wgpu::Buffer buffer = CreateUniformBuffer();
+    wgpu::Sampler sampler = device.CreateSampler();
+
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, layout, {{0, buffer}, {1, sampler}});
+    EXPECT_EQ(utils::MakeBindGroup(device, layout, {{1, sampler}, {0, buffer}}).Get(),
+              bindGroup.Get());
+    EXPECT_EQ(utils::MakeBindGroup(device, layout, {{0, buffer, 0, 512}, {1, sampler}}).Get(),
+              bindGroup.Get());
+    EXPECT_EQ(GetStats().bindGroupHits, 2u);
+    EXPECT_EQ(GetStats().bindGroupMisses, 1u);
+
+    // Different entries give different bind groups.
+    EXPECT_NE(utils::MakeBindGroup(device, layout, {{0, buffer, 256, 256}, {1, sampler}}).Get(),
+              bindGroup.Get());
+    EXPECT_NE(
+        utils::MakeBindGroup(device, layout, {{0, CreateUniformBuffer()}, {1, sampler}}).Get(),
+        bindGroup.Get());
+    EXPECT_EQ(GetStats().bindGroupHits, 2u);
+    EXPECT_EQ(GetStats().bindGroupMisses, 3u);
+}
+
+// Test that bind groups using a destroyed resource aren't reused.
+TEST_F(ObjectPoolingTest, BindGroupInvalidation) {
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+    wgpu::Buffer buffer = CreateUniformBuffer();
+
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, layout, {{0, buffer}});
+    buffer.Destroy();
+    EXPECT_NE(utils::MakeBindGroup(device, layout, {{0, buffer}}).Get(), bindGroup.Get());
+    EXPECT_EQ(GetStats().bindGroupHits, 0u);
+    EXPECT_EQ(GetStats().bindGroupMisses, 2u);
+}
+
+}  // anonymous namespace
@@ -23,8 +23,10 @@
 #include "dawn/common/TypedInteger.h"
 #include "dawn/native/Blob.h"
 #include "dawn/native/Serializable.h"
+#include "dawn/native/stream/BlobSink.h"
 #include "dawn/native/stream/BlobSource.h"
 #include "dawn/native/stream/ByteVectorSink.h"
+#include "dawn/native/stream/SizeCountingSink.h"
 #include "dawn/native/stream/Stream.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -208,6 +210,20 @@ TEST(SerializeTests, ByteVectorSinks) {
     EXPECT_CACHE_KEY_EQ(data, expected);
 }
 
+// Test that vectors of fundamental types, which are copied in bulk, serialize the same as if
+// their elements were serialized one by one.
+TEST(SerializeTests, StdVectorOfFundamentals) {
+    std::vector<uint32_t> words = {0x07230203, 0x00010000, 0, 42};
+
+    ByteVectorSink expected;
+    StreamIn(&expected, words.size());
+    for (uint32_t word : words) {
+        StreamIn(&expected, word);
+    }
+
+    EXPECT_CACHE_KEY_EQ(words, expected);
+}
+
 // Test that ByteVectorSink serializes std::pair as expected.
 TEST(SerializeTests, StdPair) {
     std::string_view s = "hi!";
@@ -366,6 +382,94 @@ TEST(StreamTests, SerializeDeserializeBlobs) {
     }
 }
 
+// Test that deserializing a Blob from a BlobSource doesn't copy the data, and that the data
+// outlives the source.
+TEST(StreamTests, DeserializeBlobInPlace) {
+    Blob blob = CreateBlob(std::vector<uint32_t>{1, 2, 3, 4});
+
+    ByteVectorSink sink;
+    StreamIn(&sink, blob);
+    Blob serialized = CreateBlob(std::move(sink));
+    const uint8_t* serializedData = serialized.Data();
+
+    Blob out;
+    {
+        BlobSource src(std::move(serialized));
+        auto err = StreamOut(&src, &out);
+        EXPECT_FALSE(err.IsError());
+    }
+    EXPECT_EQ(out.Data(), serializedData + sizeof(size_t));
+    ASSERT_EQ(blob.Size(), out.Size());
+    EXPECT_EQ(memcmp(blob.Data(), out.Data(), blob.Size()), 0);
+}
+
+// Test that SizeCountingSink measures the same size as the data streamed in a ByteVectorSink.
+TEST(StreamTests, SizeCountingSink) {
+    std::vector<std::string> strings = {"dawn", "", "native"};
+    Blob blob = CreateBlob(std::vector<double>{6.24, 3.12222});
+    ByteVectorSink nested = {'d', 'a', 't', 'a'};
+
+    ByteVectorSink expected;
+    StreamIn(&expected, 1, 2.0f, strings, blob, nested);
+
+    SizeCountingSink counter;
+    StreamIn(&counter, 1, 2.0f, strings, blob, nested);
+    EXPECT_EQ(counter.GetSize(), expected.size());
+
+    // Writers using GetSpace directly are counted too.
+    memset(counter.GetSpace(16), 0, 16);
+    EXPECT_EQ(counter.GetSize(), expected.size() + 16);
+}
+
+// Test that BlobSink writes in place in the blob it is given.
+TEST(StreamTests, BlobSink) {
+    std::vector<uint32_t> words = {0x07230203, 0x00010000, 0, 42};
+
+    ByteVectorSink expected;
+    StreamIn(&expected, words);
+
+    Blob blob = CreateBlob(expected.size());
+    const uint8_t* data = blob.Data();
+    BlobSink sink(std::move(blob));
+    StreamIn(&sink, words);
+
+    Blob out = sink.AcquireBlob();
+    EXPECT_EQ(out.Data(), data);
+    ASSERT_EQ(out.Size(), expected.size());
+    EXPECT_EQ(memcmp(out.Data(), expected.data(), expected.size()), 0);
+}
+
+#define BAR_MEMBERS(X)              \
+    X(Blob, blob)                   \
+    X(std::vector<uint32_t>, words) \
+    X(std::string, name)
+DAWN_SERIALIZABLE(struct, Bar, BAR_MEMBERS){};
+#undef BAR_MEMBERS
+
+// Test that ToBlob and FromBlob of a struct made with DAWN_SERIALIZABLE, which go through
+// BlobSink and BlobSource, round trip and give the same bytes as a ByteVectorSink.
+TEST(StreamTests, SerializableToBlobFromBlob) {
+    Bar bar;
+    bar.blob = CreateBlob(std::vector<uint8_t>{1, 2, 3, 4, 5});
+    bar.words = {0x07230203, 0x00010000, 0, 42};
+    bar.name = "dawn";
+
+    ByteVectorSink expected;
+    StreamIn(&expected, bar);
+
+    Blob blob = bar.ToBlob();
+    ASSERT_EQ(blob.Size(), expected.size());
+    EXPECT_EQ(memcmp(blob.Data(), expected.data(), expected.size()), 0);
+
+    auto result = Bar::FromBlob(std::move(blob));
+    ASSERT_TRUE(result.IsSuccess());
+    Bar out = result.AcquireSuccess();
+    ASSERT_EQ(out.blob.Size(), bar.blob.Size());
+    EXPECT_EQ(memcmp(out.blob.Data(), bar.blob.Data(), bar.blob.Size()), 0);
+    EXPECT_EQ(out.words, bar.words);
+    EXPECT_EQ(out.name, bar.name);
+}
+
 template <size_t N>
 std::bitset<N - 1> BitsetFromBitString(const char (&str)[N]) {
     // N - 1 because the last character is the null terminator.
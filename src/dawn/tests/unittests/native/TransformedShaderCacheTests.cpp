@@ -0,0 +1,127 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+
+#include "dawn/native/TransformedShaderCache.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+
+namespace {
+
+CacheKey MakeKey(int value) {
+    CacheKey key;
+    StreamIn(&key, value);
+    return key;
+}
+
+void StoreInt(TransformedShaderCache* cache, int key, int value) {
+    cache->Store(MakeKey(key), sizeof(value), &value);
+}
+
+// Returns the value stored for key, or -1 if there is none.
+int LoadInt(TransformedShaderCache* cache, int key) {
+    Blob blob = cache->Load(MakeKey(key));
+    if (blob.Empty()) {
+        return -1;
+    }
+    EXPECT_EQ(blob.Size(), sizeof(int));
+    int value;
+    memcpy(&value, blob.Data(), sizeof(value));
+    return value;
+}
+
+// Test that values can be stored and loaded by key.
+TEST(TransformedShaderCacheTests, StoreAndLoad) {
+    TransformedShaderCache cache(4);
+    EXPECT_EQ(LoadInt(&cache, 1), -1);
+
+    StoreInt(&cache, 1, 10);
+    StoreInt(&cache, 2, 20);
+    EXPECT_EQ(LoadInt(&cache, 1), 10);
+    EXPECT_EQ(LoadInt(&cache, 2), 20);
+    EXPECT_EQ(LoadInt(&cache, 3), -1);
+    EXPECT_EQ(cache.GetEntryCountForTesting(), 2u);
+}
+
+// Test that keys are compared by content and not only by hash or size.
+TEST(TransformedShaderCacheTests, KeysComparedByContent) {
+    TransformedShaderCache cache(4);
+    StoreInt(&cache, 0x0102, 1);
+    StoreInt(&cache, 0x0201, 2);
+    EXPECT_EQ(LoadInt(&cache, 0x0102), 1);
+    EXPECT_EQ(LoadInt(&cache, 0x0201), 2);
+}
+
+// Test that storing an existing key replaces its value without adding an entry.
+TEST(TransformedShaderCacheTests, StoreReplaces) {
+    TransformedShaderCache cache(4);
+    StoreInt(&cache, 1, 10);
+    StoreInt(&cache, 1, 11);
+    EXPECT_EQ(LoadInt(&cache, 1), 11);
+    EXPECT_EQ(cache.GetEntryCountForTesting(), 1u);
+}
+
+// Test that the least recently used entry is evicted when the cache is full, and that loading an
+// entry makes it the most recently used.
+TEST(TransformedShaderCacheTests, EvictsLeastRecentlyUsed) {
+    TransformedShaderCache cache(3);
+    StoreInt(&cache, 1, 10);
+    StoreInt(&cache, 2, 20);
+    StoreInt(&cache, 3, 30);
+
+    // Use 1 so that 2 is the least recently used.
+    EXPECT_EQ(LoadInt(&cache, 1), 10);
+
+    StoreInt(&cache, 4, 40);
+    EXPECT_EQ(cache.GetEntryCountForTesting(), 3u);
+    EXPECT_EQ(LoadInt(&cache, 2), -1);
+    EXPECT_EQ(LoadInt(&cache, 1), 10);
+    EXPECT_EQ(LoadInt(&cache, 3), 30);
+    EXPECT_EQ(LoadInt(&cache, 4), 40);
+
+    // 1 is now the least recently used.
+    StoreInt(&cache, 5, 50);
+    EXPECT_EQ(LoadInt(&cache, 1), -1);
+    EXPECT_EQ(LoadInt(&cache, 5), 50);
+}
+
+// Test that loaded blobs stay valid after their entry is evicted.
+TEST(TransformedShaderCacheTests, LoadedBlobOutlivesEntry) {
+    TransformedShaderCache cache(1);
+    StoreInt(&cache, 1, 10);
+    Blob blob = cache.Load(MakeKey(1));
+
+    StoreInt(&cache, 2, 20);
+    EXPECT_EQ(LoadInt(&cache, 1), -1);
+
+    int value;
+    memcpy(&value, blob.Data(), sizeof(value));
+    EXPECT_EQ(value, 10);
+}
+
+// Test that Clear removes all the entries.
+TEST(TransformedShaderCacheTests, Clear) {
+    TransformedShaderCache cache(4);
+    StoreInt(&cache, 1, 10);
+    StoreInt(&cache, 2, 20);
+    cache.Clear();
+    EXPECT_EQ(cache.GetEntryCountForTesting(), 0u);
+    EXPECT_EQ(LoadInt(&cache, 1), -1);
+}
+
+}  // namespace
+
+}  // namespace dawn::native
@@ -0,0 +1,208 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/unittests/validation/ValidationTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+constexpr uint64_t kBackingSize = 1024;
+constexpr uint64_t kViewSize = 256;
+
+class SuballocatedBufferValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+        // Suballocated buffers are only available through the native API.
+        DAWN_SKIP_TEST_IF(UsesWire());
+
+        mBacking = CreateBackingBuffer(wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Storage |
+                                       wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+    }
+
+    wgpu::Buffer CreateBackingBuffer(wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor desc;
+        desc.size = kBackingSize;
+        desc.usage = usage;
+        return device.CreateBuffer(&desc);
+    }
+
+    wgpu::Buffer Suballocate(const wgpu::Buffer& backing, uint64_t offset, uint64_t size) {
+        return wgpu::Buffer::Acquire(
+            dawn::native::CreateSuballocatedBuffer(backing.Get(), offset, size));
+    }
+
+    wgpu::Buffer mBacking;
+};
+
+// Test the validation of the range of suballocated buffers.
+TEST_F(SuballocatedBufferValidationTest, CreationRange) {
+    // Success cases, including the full backing buffer and nested suballocations.
+    Suballocate(mBacking, 0, kViewSize);
+    Suballocate(mBacking, kBackingSize - kViewSize, kViewSize);
+    Suballocate(mBacking, 0, kBackingSize);
+    Suballocate(Suballocate(mBacking, kViewSize, 2 * kViewSize), kViewSize, kViewSize);
+
+    // The offset must be aligned for bindings.
+    ASSERT_DEVICE_ERROR(Suballocate(mBacking, 4, kViewSize));
+
+    // The range must fit in the backing buffer.
+    ASSERT_DEVICE_ERROR(Suballocate(mBacking, kBackingSize - kViewSize, kViewSize + 4));
+    ASSERT_DEVICE_ERROR(Suballocate(mBacking, kBackingSize + kViewSize, 0));
+
+    // Backing buffers that can only be mapped can't be suballocated.
+    wgpu::Buffer mapReadBacking =
+        CreateBackingBuffer(wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst);
+    Suballocate(mapReadBacking, 0, kViewSize);
+    wgpu::Buffer mapWriteBacking = CreateBackingBuffer(wgpu::BufferUsage::MapWrite);
+    ASSERT_DEVICE_ERROR(Suballocate(mapWriteBacking, 0, kViewSize));
+}
+
+// Test that suballocated buffers can't be mapped or destroyed.
+TEST_F(SuballocatedBufferValidationTest, MapAndDestroy) {
+    wgpu::Buffer mapReadBacking =
+        CreateBackingBuffer(wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst);
+    wgpu::Buffer view = Suballocate(mapReadBacking, 0, kViewSize);
+    EXPECT_EQ(view.GetUsage(), wgpu::BufferUsage::CopyDst);
+    EXPECT_EQ(view.GetSize(), kViewSize);
+
+    ASSERT_DEVICE_ERROR(view.MapAsync(wgpu::MapMode::Read, 0, 4, nullptr, nullptr));
+    ASSERT_DEVICE_ERROR(view.Destroy());
+}
+
+// Test that suballocated buffers can be used in bind groups with the validation of their own size
+// and usage.
+TEST_F(SuballocatedBufferValidationTest, BindGroup) {
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform}});
+    wgpu::Buffer view = Suballocate(mBacking, kViewSize, kViewSize);
+
+    utils::MakeBindGroup(device, layout, {{0, view}});
+    utils::MakeBindGroup(device, layout, {{0, view, 0, kViewSize}});
+    ASSERT_DEVICE_ERROR(utils::MakeBindGroup(device, layout, {{0, view, 0, kViewSize + 4}}));
+
+    wgpu::Buffer storageBacking = CreateBackingBuffer(wgpu::BufferUsage::Storage);
+    ASSERT_DEVICE_ERROR(
+        utils::MakeBindGroup(device, layout, {{0, Suballocate(storageBacking, 0, kViewSize)}}));
+}
+
+// Test that dynamic offsets are validated against the range of suballocated buffers and not the
+// range of their backing buffer.
+TEST_F(SuballocatedBufferValidationTest, DynamicOffsetsInView) {
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform, true}});
+    wgpu::Buffer view = Suballocate(mBacking, kViewSize, 2 * kViewSize);
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, layout, {{0, view, 0, 16}});
+
+    auto TestSetBindGroup = [&](uint32_t dynamicOffset) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetBindGroup(0, bindGroup, 1, &dynamicOffset);
+        pass.End();
+        return encoder.Finish();
+    };
+
+    // The binding can be moved anywhere in the view.
+    TestSetBindGroup(0);
+    TestSetBindGroup(kViewSize);
+
+    // The binding can't be moved past the end of the view, even if it stays in the backing
+    // buffer.
+    ASSERT_DEVICE_ERROR(TestSetBindGroup(2 * kViewSize));
+}
+
+// Test that the usages of suballocated buffers are tracked on their backing buffer.
+TEST_F(SuballocatedBufferValidationTest, UsageTrackedOnBackingBuffer) {
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+        struct S {
+            value : f32
+        };
+        @group(0) @binding(0) var<storage, read_write> sBuffer : S;
+        @group(0) @binding(1) var<uniform> uBuffer : S;
+        @compute @workgroup_size(1) fn main() {
+            sBuffer.value = uBuffer.value;
+        })");
+    pipelineDesc.compute.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDesc);
+
+    auto TestDispatch = [&](const wgpu::Buffer& storage, const wgpu::Buffer& uniform) {
+        wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0),
+                                                         {{0, storage}, {1, uniform}});
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, bindGroup);
+        pass.DispatchWorkgroups(1);
+        pass.End();
+        return encoder.Finish();
+    };
+
+    // Views of different backing buffers can be written and read in the same dispatch.
+    wgpu::Buffer otherBacking =
+        CreateBackingBuffer(wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Storage);
+    TestDispatch(Suballocate(mBacking, 0, kViewSize), Suballocate(otherBacking, 0, kViewSize));
+
+    // Views of the same backing buffer can't, even if they don't overlap.
+    ASSERT_DEVICE_ERROR(TestDispatch(Suballocate(mBacking, 0, kViewSize),
+                                     Suballocate(mBacking, kViewSize, kViewSize)));
+}
+
+// Test that copies between suballocated buffers of the same backing buffer are disallowed.
+TEST_F(SuballocatedBufferValidationTest, CopyBufferToBuffer) {
+    wgpu::Buffer otherBacking =
+        CreateBackingBuffer(wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(Suballocate(mBacking, 0, kViewSize), 0,
+                                   Suballocate(otherBacking, kViewSize, kViewSize), 0, kViewSize);
+        encoder.CopyBufferToBuffer(Suballocate(mBacking, 0, kViewSize), 0, otherBacking, 0,
+                                   kViewSize);
+        encoder.Finish();
+    }
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(Suballocate(mBacking, 0, kViewSize), 0,
+                                   Suballocate(mBacking, kViewSize, kViewSize), 0, kViewSize);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(Suballocate(mBacking, 0, kViewSize), 0, mBacking, kViewSize,
+                                   kViewSize);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
+// Test that suballocated buffers can't be used once their backing buffer is destroyed.
+TEST_F(SuballocatedBufferValidationTest, DestroyedBackingBuffer) {
+    wgpu::Buffer view = Suballocate(mBacking, kViewSize, kViewSize);
+    wgpu::Buffer destination = CreateBackingBuffer(wgpu::BufferUsage::CopyDst);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(view, 0, destination, 0, kViewSize);
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    wgpu::Queue queue = device.GetQueue();
+    uint32_t data = 0;
+    queue.WriteBuffer(view, 0, &data, sizeof(data));
+
+    mBacking.Destroy();
+    ASSERT_DEVICE_ERROR(queue.Submit(1, &commands));
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(view, 0, &data, sizeof(data)));
+}
+
+}  // anonymous namespace
@@ -0,0 +1,272 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dawn/wire/BufferConsumer_impl.h"
+#include "dawn/wire/ChunkedCommandHandler.h"
+#include "dawn/wire/ChunkedCommandSerializer.h"
+#include "dawn/wire/WireCmd_autogen.h"
+#include "dawn/wire/WireDeserializeAllocator.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using dawn::wire::ChunkedCommandSerializer;
+using dawn::wire::CmdHeader;
+using dawn::wire::QueueWriteBufferCmd;
+using dawn::wire::ReturnQueueWorkDoneCallbackCmd;
+using dawn::wire::WireResult;
+
+// A serializer that records each allocation it returns, with a configurable maximum size.
+class ChunkRecorder : public dawn::wire::CommandSerializer {
+  public:
+    explicit ChunkRecorder(size_t maxAllocationSize) : mMaxAllocationSize(maxAllocationSize) {}
+
+    size_t GetMaximumAllocationSize() const override { return mMaxAllocationSize; }
+    void* GetCmdSpace(size_t size) override {
+        EXPECT_LE(size, mMaxAllocationSize);
+        chunks.emplace_back(size, '\0');
+        return chunks.back().data();
+    }
+    bool Flush() override { return true; }
+
+    std::vector<std::string> chunks;
+
+  private:
+    size_t mMaxAllocationSize;
+};
+
+// A handler that reassembles the chunked commands and records each complete command.
+class RecordingCmdHandler : public dawn::wire::ChunkedCommandHandler {
+  public:
+    std::vector<std::string> commands;
+
+  private:
+    const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override {
+        while (size >= sizeof(CmdHeader)) {
+            switch (HandleChunkedCommands(commands, size)) {
+                case ChunkedCommandsResult::Consumed:
+                    return commands + size;
+                case ChunkedCommandsResult::Error:
+                    return nullptr;
+                case ChunkedCommandsResult::Passthrough:
+                    break;
+            }
+
+            uint64_t commandSize =
+                reinterpret_cast<const volatile CmdHeader*>(commands)->commandSize;
+            if (commandSize < sizeof(CmdHeader)) {
+                return nullptr;
+            }
+            this->commands.emplace_back(const_cast<const char*>(commands), commandSize);
+            commands += commandSize;
+            size -= commandSize;
+        }
+        return size == 0 ? commands : nullptr;
+    }
+};
+
+std::string Concatenate(const std::vector<std::string>& chunks) {
+    std::string commands;
+    for (const std::string& chunk : chunks) {
+        commands += chunk;
+    }
+    return commands;
+}
+
+std::vector<uint8_t> MakeData(size_t size, uint8_t seed) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(seed + i * 7);
+    }
+    return data;
+}
+
+QueueWriteBufferCmd MakeWriteBufferCmd(const std::vector<uint8_t>& data) {
+    QueueWriteBufferCmd cmd = {};
+    cmd.queueId = 1;
+    cmd.bufferId = 2;
+    cmd.bufferOffset = 256;
+    cmd.data = data.data();
+    cmd.size = data.size();
+    return cmd;
+}
+
+// Returns the chunks of |cmd| serialized with a maximum allocation size of |maxAllocationSize|.
+std::vector<std::string> SerializeInChunks(const QueueWriteBufferCmd& cmd,
+                                           size_t maxAllocationSize) {
+    ChunkRecorder recorder(maxAllocationSize);
+    ChunkedCommandSerializer(&recorder).SerializeCommand(cmd);
+    return std::move(recorder.chunks);
+}
+
+// Checks that |commands| starts with a serialized MakeWriteBufferCmd(data) of |commandSize|
+// bytes. The commands are deserialized instead of compared byte for byte because the padding of
+// the serialized structures isn't initialized.
+void ExpectWriteBufferCmd(const std::string& commands,
+                          const std::vector<uint8_t>& data,
+                          size_t commandSize) {
+    QueueWriteBufferCmd expected = MakeWriteBufferCmd(data);
+    ASSERT_GE(commands.size(), commandSize);
+    ASSERT_GE(commandSize, expected.GetRequiredSize());
+
+    uint64_t serializedCommandSize;
+    memcpy(&serializedCommandSize, commands.data(), sizeof(serializedCommandSize));
+    EXPECT_EQ(serializedCommandSize, commandSize);
+
+    dawn::wire::DeserializeBuffer buffer(commands.data(), expected.GetRequiredSize());
+    dawn::wire::WireDeserializeAllocator allocator;
+    QueueWriteBufferCmd cmd;
+    ASSERT_EQ(cmd.Deserialize(&buffer, &allocator), WireResult::Success);
+    EXPECT_EQ(cmd.queueId, expected.queueId);
+    EXPECT_EQ(cmd.bufferId, expected.bufferId);
+    EXPECT_EQ(cmd.bufferOffset, expected.bufferOffset);
+    ASSERT_EQ(cmd.size, expected.size);
+    EXPECT_EQ(std::vector<uint8_t>(cmd.data, cmd.data + cmd.size), data);
+}
+
+// Test that the data-only members are only counted in GetDataOnlySize.
+TEST(WireChunkedCommandTests, DataOnlySize) {
+    std::vector<uint8_t> data = MakeData(1000, 0);
+    QueueWriteBufferCmd cmd = MakeWriteBufferCmd(data);
+    EXPECT_EQ(cmd.GetDataOnlySize(), data.size());
+    EXPECT_GE(cmd.GetRequiredSize(), data.size());
+}
+
+// Test that chunking a command whose data is gathered from its source produces the same
+// command as serializing it in one allocation, for various chunk sizes.
+TEST(WireChunkedCommandTests, ChunkedWriteBuffer) {
+    std::vector<uint8_t> data = MakeData(1000, 3);
+    QueueWriteBufferCmd cmd = MakeWriteBufferCmd(data);
+    size_t commandSize = cmd.GetRequiredSize();
+
+    for (size_t maxAllocationSize : {commandSize, size_t(8), size_t(13), size_t(64), size_t(999),
+                                     size_t(1000)}) {
+        std::vector<std::string> chunks = SerializeInChunks(cmd, maxAllocationSize);
+        EXPECT_EQ(chunks.size(), (commandSize + maxAllocationSize - 1) / maxAllocationSize);
+        ExpectWriteBufferCmd(Concatenate(chunks), data, commandSize);
+    }
+}
+
+// Test that the serialized bytes that follow the gathered data, here the extra size of the
+// command, are placed after it in the chunks.
+TEST(WireChunkedCommandTests, ChunkedExtraSizeAfterGatheredData) {
+    std::vector<uint8_t> data = MakeData(300, 5);
+    std::string extra(123, 'e');
+    QueueWriteBufferCmd cmd = MakeWriteBufferCmd(data);
+    size_t commandSize = cmd.GetRequiredSize() + extra.size();
+    auto SerializeExtra = [&](dawn::wire::SerializeBuffer* buffer) {
+        char* dst;
+        WIRE_TRY(buffer->NextN(extra.size(), &dst));
+        memcpy(dst, extra.data(), extra.size());
+        return WireResult::Success;
+    };
+
+    for (size_t maxAllocationSize : {commandSize, size_t(8), size_t(100), size_t(301)}) {
+        ChunkRecorder recorder(maxAllocationSize);
+        ChunkedCommandSerializer(&recorder).SerializeCommand(cmd, extra.size(), SerializeExtra);
+        std::string commands = Concatenate(recorder.chunks);
+        ExpectWriteBufferCmd(commands, data, commandSize);
+        EXPECT_EQ(commands.substr(cmd.GetRequiredSize()), extra);
+    }
+}
+
+// Test that the handler reassembles successive chunked commands of different sizes, reusing its
+// reassembly memory when it is large enough.
+TEST(WireChunkedCommandTests, Reassembly) {
+    constexpr size_t kMaxAllocationSize = 64;
+
+    std::vector<std::vector<uint8_t>> datas = {MakeData(1000, 1), MakeData(100, 2), MakeData(10, 3),
+                                               MakeData(3000, 4), MakeData(1000, 5)};
+    ChunkRecorder recorder(kMaxAllocationSize);
+    ChunkedCommandSerializer serializer(&recorder);
+    for (const std::vector<uint8_t>& data : datas) {
+        serializer.SerializeCommand(MakeWriteBufferCmd(data));
+    }
+
+    RecordingCmdHandler handler;
+    for (const std::string& chunk : recorder.chunks) {
+        ASSERT_NE(handler.HandleCommands(chunk.data(), chunk.size()), nullptr);
+    }
+    ASSERT_EQ(handler.commands.size(), datas.size());
+    for (size_t i = 0; i < datas.size(); ++i) {
+        ExpectWriteBufferCmd(handler.commands[i], datas[i], handler.commands[i].size());
+    }
+}
+
+ReturnQueueWorkDoneCallbackCmd MakeWorkDoneCmd() {
+    ReturnQueueWorkDoneCallbackCmd cmd = {};
+    cmd.queue = {3, 4};
+    cmd.requestSerial = 0x123456789;
+    cmd.status = WGPUQueueWorkDoneStatus_DeviceLost;
+    return cmd;
+}
+
+// Checks that |commands| is exactly a serialized MakeWorkDoneCmd().
+void ExpectWorkDoneCmd(const std::string& commands) {
+    ASSERT_EQ(commands.size(), ReturnQueueWorkDoneCallbackCmd::kFixedSize);
+
+    uint64_t serializedCommandSize;
+    memcpy(&serializedCommandSize, commands.data(), sizeof(serializedCommandSize));
+    EXPECT_EQ(serializedCommandSize, ReturnQueueWorkDoneCallbackCmd::kFixedSize);
+
+    dawn::wire::DeserializeBuffer buffer(commands.data(), commands.size());
+    ReturnQueueWorkDoneCallbackCmd cmd;
+    ASSERT_EQ(cmd.DeserializeFixedSize(&buffer), WireResult::Success);
+    EXPECT_EQ(buffer.AvailableSize(), 0u);
+    ReturnQueueWorkDoneCallbackCmd expected = MakeWorkDoneCmd();
+    EXPECT_EQ(cmd.queue.id, expected.queue.id);
+    EXPECT_EQ(cmd.queue.generation, expected.queue.generation);
+    EXPECT_EQ(cmd.requestSerial, expected.requestSerial);
+    EXPECT_EQ(cmd.status, expected.status);
+}
+
+// Test that only the commands without pointed-to data have a fixed size.
+TEST(WireChunkedCommandTests, FixedSize) {
+    static_assert(ReturnQueueWorkDoneCallbackCmd::kFixedSize ==
+                  sizeof(dawn::wire::ReturnQueueWorkDoneCallbackTransfer));
+    static_assert(QueueWriteBufferCmd::kFixedSize == 0);
+    EXPECT_EQ(MakeWorkDoneCmd().GetRequiredSize(), ReturnQueueWorkDoneCallbackCmd::kFixedSize);
+}
+
+// Test that fixed-size commands are serialized in a single allocation of their fixed size, and
+// that they are still chunked if the serializer's allocations are smaller.
+TEST(WireChunkedCommandTests, FixedSizeCommand) {
+    constexpr size_t kFixedSize = ReturnQueueWorkDoneCallbackCmd::kFixedSize;
+
+    for (size_t maxAllocationSize : {size_t(1024), kFixedSize, size_t(8), kFixedSize - 1}) {
+        ChunkRecorder recorder(maxAllocationSize);
+        ChunkedCommandSerializer(&recorder).SerializeCommand(MakeWorkDoneCmd());
+        EXPECT_EQ(recorder.chunks.size(), (kFixedSize + maxAllocationSize - 1) / maxAllocationSize);
+        ExpectWorkDoneCmd(Concatenate(recorder.chunks));
+    }
+}
+
+// Test that deserializing a truncated fixed-size command is an error.
+TEST(WireChunkedCommandTests, FixedSizeCommandTruncated) {
+    ChunkRecorder recorder(1024);
+    ChunkedCommandSerializer(&recorder).SerializeCommand(MakeWorkDoneCmd());
+    ASSERT_EQ(recorder.chunks.size(), 1u);
+
+    dawn::wire::DeserializeBuffer buffer(recorder.chunks[0].data(),
+                                         ReturnQueueWorkDoneCallbackCmd::kFixedSize - 1);
+    ReturnQueueWorkDoneCallbackCmd cmd;
+    EXPECT_EQ(cmd.DeserializeFixedSize(&buffer), WireResult::FatalError);
+}
+
+}  // namespace
@@ -0,0 +1,293 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dawn/wire/LZCompression.h"
+#include "dawn/wire/WireCompression.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using dawn::wire::CompressingCommandSerializer;
+using dawn::wire::DecompressingCommandHandler;
+using dawn::wire::LZCompressor;
+using dawn::wire::LZDecompress;
+using dawn::wire::LZDictionary;
+
+// Data that looks like a stream of small commands, which repeats with small differences.
+std::string MakeCommandLikeData(size_t size) {
+    std::string data;
+    uint32_t i = 0;
+    while (data.size() < size) {
+        uint32_t command[6] = {24, 0, 42, 7, i % 3, 1};
+        data.append(reinterpret_cast<const char*>(command), sizeof(command));
+        i++;
+    }
+    data.resize(size);
+    return data;
+}
+
+std::string MakeRandomData(size_t size) {
+    std::mt19937 generator(1234);
+    std::string data(size, '\0');
+    for (char& c : data) {
+        c = static_cast<char>(generator());
+    }
+    return data;
+}
+
+class WireCompressionTests : public testing::Test {
+  protected:
+    // Compresses |data| and checks that it decompresses to the same data. Returns the compressed
+    // size.
+    size_t CompressRoundTrip(const std::string& data, const LZDictionary& dictionary) {
+        LZCompressor compressor(&dictionary);
+        std::vector<char> compressed(LZCompressor::GetCompressedSizeBound(data.size()));
+        size_t compressedSize = compressor.Compress(data.data(), data.size(), compressed.data());
+        EXPECT_LE(compressedSize, compressed.size());
+
+        std::string decompressed(data.size(), '\0');
+        EXPECT_TRUE(LZDecompress(compressed.data(), compressedSize, decompressed.data(),
+                                 decompressed.size(), dictionary));
+        EXPECT_EQ(decompressed, data);
+        return compressedSize;
+    }
+
+    LZDictionary mEmptyDictionary{std::vector<char>()};
+};
+
+// Test compressing and decompressing various kinds of data.
+TEST_F(WireCompressionTests, LZRoundTrip) {
+    CompressRoundTrip("", mEmptyDictionary);
+    CompressRoundTrip("abc", mEmptyDictionary);
+    CompressRoundTrip(MakeRandomData(100000), mEmptyDictionary);
+    // Runs of the same byte are matches that overlap the bytes they produce.
+    EXPECT_LT(CompressRoundTrip(std::string(100000, '\0'), mEmptyDictionary), 500u);
+    EXPECT_LT(CompressRoundTrip(MakeCommandLikeData(100000), mEmptyDictionary), 10000u);
+}
+
+// Test that the same compressor can be used for successive blocks, which don't reference each
+// other.
+TEST_F(WireCompressionTests, LZSuccessiveBlocks) {
+    LZCompressor compressor(&mEmptyDictionary);
+    std::string data = MakeCommandLikeData(1000);
+    for (int i = 0; i < 3; ++i) {
+        std::vector<char> compressed(LZCompressor::GetCompressedSizeBound(data.size()));
+        size_t compressedSize = compressor.Compress(data.data(), data.size(), compressed.data());
+
+        std::string decompressed(data.size(), '\0');
+        ASSERT_TRUE(LZDecompress(compressed.data(), compressedSize, decompressed.data(),
+                                 decompressed.size(), mEmptyDictionary));
+        EXPECT_EQ(decompressed, data);
+    }
+}
+
+// Test that blocks can reference the dictionary, including matches that continue from the end of
+// the dictionary into the block.
+TEST_F(WireCompressionTests, LZDictionary) {
+    std::string random = MakeRandomData(1000);
+    LZDictionary dictionary(std::vector<char>(random.begin(), random.end()));
+
+    EXPECT_LT(CompressRoundTrip(random, dictionary), 20u);
+    EXPECT_LT(CompressRoundTrip(random.substr(100, 500), dictionary), 20u);
+    EXPECT_LT(CompressRoundTrip(random.substr(900) + random.substr(0, 500), dictionary), 20u);
+    EXPECT_GT(CompressRoundTrip(random, mEmptyDictionary), 1000u);
+}
+
+// Test that invalid compressed blocks are rejected.
+TEST_F(WireCompressionTests, LZInvalidBlocks) {
+    std::string data = MakeCommandLikeData(1000);
+    LZCompressor compressor(&mEmptyDictionary);
+    std::vector<char> compressed(LZCompressor::GetCompressedSizeBound(data.size()));
+    size_t compressedSize = compressor.Compress(data.data(), data.size(), compressed.data());
+    std::string decompressed(data.size() + 1, '\0');
+
+    // Truncated blocks.
+    for (size_t size = 0; size < compressedSize; ++size) {
+        EXPECT_FALSE(LZDecompress(compressed.data(), size, decompressed.data(), data.size(),
+                                  mEmptyDictionary));
+    }
+    // Another decompressed size.
+    EXPECT_FALSE(LZDecompress(compressed.data(), compressedSize, decompressed.data(),
+                              data.size() - 1, mEmptyDictionary));
+    EXPECT_FALSE(LZDecompress(compressed.data(), compressedSize, decompressed.data(),
+                              data.size() + 1, mEmptyDictionary));
+
+    // A match before the start of the block, and of the dictionary.
+    const char beforeStart[] = {0x10, 'a', 0x02, 0x00, 0x00};
+    EXPECT_FALSE(LZDecompress(beforeStart, sizeof(beforeStart), decompressed.data(), 5,
+                              mEmptyDictionary));
+    LZDictionary dictionary(std::vector<char>{'x'});
+    EXPECT_TRUE(
+        LZDecompress(beforeStart, sizeof(beforeStart), decompressed.data(), 5, dictionary));
+    EXPECT_EQ(std::string(decompressed.data(), 5), "axaxa");
+    EXPECT_FALSE(
+        LZDecompress(beforeStart, sizeof(beforeStart), decompressed.data(), 4, dictionary));
+
+    // A match with a zero offset.
+    const char zeroOffset[] = {0x10, 'a', 0x00, 0x00, 0x00};
+    EXPECT_FALSE(LZDecompress(zeroOffset, sizeof(zeroOffset), decompressed.data(), 5,
+                              mEmptyDictionary));
+}
+
+// Stores the messages written to the transport: the content of the serializer at each flush.
+class MessageRecorder : public dawn::wire::CommandSerializer {
+  public:
+    explicit MessageRecorder(size_t maxAllocationSize) : mMaxAllocationSize(maxAllocationSize) {}
+
+    size_t GetMaximumAllocationSize() const override { return mMaxAllocationSize; }
+    void* GetCmdSpace(size_t size) override {
+        EXPECT_LE(size, mMaxAllocationSize);
+        size_t offset = mPending.size();
+        mPending.resize(offset + size);
+        return &mPending[offset];
+    }
+    bool Flush() override {
+        messages.push_back(std::move(mPending));
+        mPending.clear();
+        return true;
+    }
+
+    std::vector<std::string> messages;
+
+  private:
+    size_t mMaxAllocationSize;
+    std::string mPending;
+};
+
+// Stores the commands passed to the wire.
+class CommandRecorder : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        this->commands.append(const_cast<const char*>(commands), size);
+        return commands + size;
+    }
+
+    std::string commands;
+};
+
+class WireCompressionStreamTests : public WireCompressionTests {
+  protected:
+    void Serialize(CompressingCommandSerializer* serializer, const std::string& commands) {
+        size_t maxSize = serializer->GetMaximumAllocationSize();
+        for (size_t offset = 0; offset < commands.size(); offset += maxSize) {
+            size_t size = std::min(maxSize, commands.size() - offset);
+            void* space = serializer->GetCmdSpace(size);
+            ASSERT_NE(space, nullptr);
+            memcpy(space, &commands[offset], size);
+        }
+    }
+
+    // Passes the recorded messages to the handler. Returns false if it fails to handle them.
+    bool HandleMessages(const MessageRecorder& transport) {
+        for (const std::string& message : transport.messages) {
+            if (mHandler.HandleCommands(message.data(), message.size()) == nullptr) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    CommandRecorder mWire;
+    DecompressingCommandHandler mHandler{&mWire};
+};
+
+// Test that the commands go through compression and decompression unchanged, in frames of at
+// most kMaxFrameSize.
+TEST_F(WireCompressionStreamTests, RoundTrip) {
+    MessageRecorder transport(1024 * 1024);
+    CompressingCommandSerializer serializer(&transport);
+    EXPECT_EQ(serializer.GetMaximumAllocationSize(), CompressingCommandSerializer::kMaxFrameSize);
+
+    std::string commands = MakeCommandLikeData(1000);
+    Serialize(&serializer, commands);
+    ASSERT_TRUE(serializer.Flush());
+    std::string largeCommands =
+        MakeCommandLikeData(CompressingCommandSerializer::kMaxFrameSize * 2);
+    Serialize(&serializer, largeCommands);
+    ASSERT_TRUE(serializer.Flush());
+
+    ASSERT_TRUE(HandleMessages(transport));
+    EXPECT_TRUE(mHandler.IsCompressed());
+    EXPECT_EQ(mWire.commands, commands + largeCommands);
+
+    dawn::wire::WireCompressionStats stats = serializer.GetStats();
+    EXPECT_EQ(stats.frames, 3u);
+    EXPECT_EQ(stats.uncompressedBytes, commands.size() + largeCommands.size());
+    EXPECT_EQ(stats.compressedBytes, transport.messages[0].size() + transport.messages[1].size());
+    EXPECT_LT(stats.compressedBytes * 10, stats.uncompressedBytes);
+}
+
+// Test that the frames fit in the maximum allocation size of the transport, including
+// incompressible commands that are stored as is.
+TEST_F(WireCompressionStreamTests, SmallTransportAllocations) {
+    MessageRecorder transport(4096);
+    CompressingCommandSerializer serializer(&transport);
+    EXPECT_LT(serializer.GetMaximumAllocationSize(), 4096u);
+
+    std::string commands = MakeRandomData(10000) + MakeCommandLikeData(10000);
+    Serialize(&serializer, commands);
+    ASSERT_TRUE(serializer.Flush());
+
+    ASSERT_TRUE(HandleMessages(transport));
+    EXPECT_EQ(mWire.commands, commands);
+}
+
+// Test that uncompressed commands are passed through as is.
+TEST_F(WireCompressionStreamTests, UncompressedStream) {
+    std::string commands = MakeCommandLikeData(1000);
+    ASSERT_NE(mHandler.HandleCommands(commands.data(), commands.size()), nullptr);
+    ASSERT_NE(mHandler.HandleCommands(commands.data(), commands.size()), nullptr);
+    EXPECT_FALSE(mHandler.IsCompressed());
+    EXPECT_EQ(mWire.commands, commands + commands);
+}
+
+// Test that compressed streams with an unknown format or invalid frames are rejected.
+TEST_F(WireCompressionStreamTests, InvalidStream) {
+    MessageRecorder transport(1024 * 1024);
+    CompressingCommandSerializer serializer(&transport);
+    Serialize(&serializer, MakeCommandLikeData(1000));
+    ASSERT_TRUE(serializer.Flush());
+    const std::string message = transport.messages[0];
+
+    auto HandleModified = [&](size_t offset, char value) {
+        std::string modified = message;
+        modified[offset] ^= value;
+        DecompressingCommandHandler handler(&mWire);
+        return handler.HandleCommands(modified.data(), modified.size()) != nullptr;
+    };
+
+    // The stream header is the magic, the format version and the dictionary checksum, then each
+    // frame has its compressed and decompressed sizes.
+    constexpr size_t kFormatVersionOffset = 8;
+    constexpr size_t kDictionaryChecksumOffset = 12;
+    constexpr size_t kCompressedSizeOffset = 16;
+    constexpr size_t kDecompressedSizeOffset = 20;
+    EXPECT_TRUE(HandleModified(kFormatVersionOffset, 0));
+    EXPECT_FALSE(HandleModified(kFormatVersionOffset, 1));
+    EXPECT_FALSE(HandleModified(kDictionaryChecksumOffset, 1));
+    EXPECT_FALSE(HandleModified(kCompressedSizeOffset, 1));
+    EXPECT_FALSE(HandleModified(kDecompressedSizeOffset, 1));
+
+    // Truncated messages.
+    DecompressingCommandHandler handler(&mWire);
+    EXPECT_EQ(handler.HandleCommands(message.data(), message.size() - 1), nullptr);
+}
+
+}  // anonymous namespace
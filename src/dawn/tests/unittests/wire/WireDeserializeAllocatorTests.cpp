@@ -0,0 +1,137 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "dawn/common/Math.h"
+#include "dawn/wire/WireDeserializeAllocator.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+namespace {
+
+// Test that allocations are aligned and don't overlap, inside and outside of the inline storage.
+TEST(WireDeserializeAllocatorTests, AlignedAndDisjoint) {
+    WireDeserializeAllocator allocator;
+
+    std::vector<char*> allocations;
+    for (size_t i = 0; i < 200; ++i) {
+        size_t size = i % 7 + 1;
+        char* allocation = static_cast<char*>(allocator.GetSpace(size));
+        ASSERT_NE(allocation, nullptr);
+        EXPECT_TRUE(IsPtrAligned(allocation, alignof(std::max_align_t)));
+        memset(allocation, static_cast<int>(i), size);
+        allocations.push_back(allocation);
+    }
+    for (size_t i = 0; i < allocations.size(); ++i) {
+        for (size_t j = 0; j < i % 7 + 1; ++j) {
+            EXPECT_EQ(allocations[i][j], static_cast<char>(i));
+        }
+    }
+}
+
+// Test that the arena grows to the size used by a command that didn't fit, and that the next
+// commands of that size reuse it.
+TEST(WireDeserializeAllocatorTests, ArenaGrows) {
+    WireDeserializeAllocator allocator;
+    size_t initialSize = allocator.GetArenaSize();
+
+    // Small commands fit in the inline storage.
+    void* inlineAllocation = allocator.GetSpace(64);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetSpace(64), inlineAllocation);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetArenaSize(), initialSize);
+
+    // A command that doesn't fit grows the arena on Reset.
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_NE(allocator.GetSpace(1000), nullptr);
+    }
+    allocator.Reset();
+    EXPECT_GE(allocator.GetArenaSize(), 10000u);
+
+    // The next commands of the same size all use the same memory.
+    void* arenaAllocation = allocator.GetSpace(1000);
+    for (size_t i = 1; i < 10; ++i) {
+        ASSERT_NE(allocator.GetSpace(1000), nullptr);
+    }
+    size_t arenaSize = allocator.GetArenaSize();
+    for (size_t command = 0; command < 3; ++command) {
+        allocator.Reset();
+        EXPECT_EQ(allocator.GetSpace(1000), arenaAllocation);
+        for (size_t i = 1; i < 10; ++i) {
+            ASSERT_NE(allocator.GetSpace(1000), nullptr);
+        }
+    }
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetArenaSize(), arenaSize);
+}
+
+// Test that the arena doesn't grow past its maximum size, but that larger commands still work.
+TEST(WireDeserializeAllocatorTests, MaxArenaSize) {
+    WireDeserializeAllocator allocator(16 * 1024);
+
+    // Grow to the maximum size.
+    ASSERT_NE(allocator.GetSpace(16 * 1024), nullptr);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetArenaSize(), 16 * 1024u);
+
+    // Larger commands don't grow the arena further.
+    for (size_t command = 0; command < 3; ++command) {
+        char* allocation = static_cast<char*>(allocator.GetSpace(64 * 1024));
+        ASSERT_NE(allocation, nullptr);
+        memset(allocation, 0, 64 * 1024);
+        allocator.Reset();
+        EXPECT_EQ(allocator.GetArenaSize(), 16 * 1024u);
+    }
+}
+
+// Test that the geometric growth of the arena is clamped to its maximum size, so that commands
+// close to the maximum size don't keep allocating.
+TEST(WireDeserializeAllocatorTests, GrowthClampedToMaxArenaSize) {
+    WireDeserializeAllocator allocator(16 * 1024);
+
+    ASSERT_NE(allocator.GetSpace(10 * 1024), nullptr);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetArenaSize(), 10 * 1024u);
+
+    // Doubling the arena would go past the maximum size, so it grows to the maximum size instead.
+    ASSERT_NE(allocator.GetSpace(12 * 1024), nullptr);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetArenaSize(), 16 * 1024u);
+
+    // The next commands of that size use the arena.
+    void* arenaAllocation = allocator.GetSpace(12 * 1024);
+    for (size_t command = 0; command < 3; ++command) {
+        allocator.Reset();
+        EXPECT_EQ(allocator.GetSpace(12 * 1024), arenaAllocation);
+    }
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetArenaSize(), 16 * 1024u);
+}
+
+// Test that allocations whose size overflows fail.
+TEST(WireDeserializeAllocatorTests, SizeOverflow) {
+    WireDeserializeAllocator allocator;
+    EXPECT_EQ(allocator.GetSpace(std::numeric_limits<size_t>::max()), nullptr);
+    EXPECT_EQ(allocator.GetSpace(std::numeric_limits<size_t>::max() - 1), nullptr);
+    allocator.Reset();
+    EXPECT_NE(allocator.GetSpace(16), nullptr);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
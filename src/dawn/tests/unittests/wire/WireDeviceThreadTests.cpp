@@ -0,0 +1,401 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dawn/dawn_proc.h"
+#include "dawn/tests/MockCallback.h"
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+using testing::InvokeWithoutArgs;
+using testing::Mock;
+using testing::MockCallback;
+using testing::NotNull;
+using testing::Return;
+using testing::SaveArg;
+using testing::WithArg;
+
+constexpr uint32_t kDeviceThreadCount = 2;
+constexpr uint32_t kDeviceCount = 4;
+
+// Records the return commands serialized by the device threads so that the test gives them to
+// the client on its own thread.
+class ReturnCommandRecorder : public CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 64 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        size_t offset = mCommands.size();
+        mCommands.resize(offset + size);
+        return &mCommands[offset];
+    }
+    bool Flush() override { return true; }
+
+    bool HandleCommands(CommandHandler* handler) {
+        std::vector<char> commands;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::swap(commands, mCommands);
+        }
+        return commands.empty() ||
+               handler->HandleCommands(commands.data(), commands.size()) != nullptr;
+    }
+
+  private:
+    std::mutex mMutex;
+    std::vector<char> mCommands;
+};
+
+class WireDeviceThreadTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        DawnProcTable mockProcs;
+        api.GetProcTable(&mockProcs);
+
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &mockProcs;
+        serverDesc.serializer = &mS2cBuf;
+        serverDesc.deviceThreadCount = kDeviceThreadCount;
+        mWireServer = std::make_unique<WireServer>(serverDesc);
+        mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>(mWireServer.get());
+
+        dawn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = mC2sBuf.get();
+        mWireClient = std::make_unique<WireClient>(clientDesc);
+
+        dawnProcSetProcs(&dawn::wire::client::GetProcs());
+
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(_, NotNull(), NotNull()))
+            .Times(kDeviceCount);
+        EXPECT_CALL(api, OnDeviceSetLoggingCallback(_, NotNull(), NotNull())).Times(kDeviceCount);
+        EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(_, NotNull(), NotNull()))
+            .Times(kDeviceCount);
+        for (uint32_t i = 0; i < kDeviceCount; ++i) {
+            apiDevices[i] = api.GetNewDevice();
+            ReservedDevice reservation = mWireClient->ReserveDevice();
+            EXPECT_CALL(api, DeviceReference(apiDevices[i]));
+            ASSERT_TRUE(
+                mWireServer->InjectDevice(apiDevices[i], reservation.id, reservation.generation));
+            devices[i] = reservation.device;
+        }
+        Mock::VerifyAndClearExpectations(&api);
+    }
+
+    void TearDown() override {
+        dawnProcSetProcs(nullptr);
+
+        api.IgnoreAllReleaseCalls();
+        mWireClient = nullptr;
+
+        // Cleared when the servers of the device threads are destroyed.
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(_, nullptr, nullptr))
+            .Times(testing::AnyNumber());
+        EXPECT_CALL(api, OnDeviceSetLoggingCallback(_, nullptr, nullptr))
+            .Times(testing::AnyNumber());
+        EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(_, nullptr, nullptr))
+            .Times(testing::AnyNumber());
+        mWireServer = nullptr;
+    }
+
+    // Sends the commands of the client and waits for the device threads to handle them. The
+    // expectations must be set before since the device threads call the mocks.
+    bool FlushClient() {
+        bool success = mC2sBuf->Flush();
+        mWireServer->WaitForIdle();
+        Mock::VerifyAndClearExpectations(&api);
+        return success;
+    }
+
+    bool FlushServer() { return mS2cBuf.HandleCommands(mWireClient.get()); }
+
+    WGPUInstance InjectInstance() {
+        ReservedInstance reservation = mWireClient->ReserveInstance();
+        apiInstance = api.GetNewInstance();
+        EXPECT_CALL(api, InstanceReference(apiInstance));
+        EXPECT_TRUE(
+            mWireServer->InjectInstance(apiInstance, reservation.id, reservation.generation));
+        return reservation.instance;
+    }
+
+    WGPUAdapter RequestAdapter(WGPUInstance instance) {
+        MockCallback<WGPURequestAdapterCallback> cb;
+        WGPURequestAdapterOptions options = {};
+        wgpuInstanceRequestAdapter(instance, &options, cb.Callback(), cb.MakeUserdata(this));
+
+        apiAdapter = api.GetNewAdapter();
+        EXPECT_CALL(api, OnInstanceRequestAdapter(apiInstance, NotNull(), NotNull(), NotNull()))
+            .WillOnce(InvokeWithoutArgs([&]() {
+                // Instance commands are handled on the thread of HandleCommands.
+                EXPECT_EQ(std::this_thread::get_id(), mMainThread);
+                EXPECT_CALL(api, AdapterGetProperties(apiAdapter, NotNull()))
+                    .WillOnce(WithArg<1>(Invoke([](WGPUAdapterProperties* properties) {
+                        *properties = {};
+                        properties->vendorName = "";
+                        properties->architecture = "";
+                        properties->name = "";
+                        properties->driverDescription = "";
+                    })));
+                EXPECT_CALL(api, AdapterGetLimits(apiAdapter, NotNull()))
+                    .WillOnce(WithArg<1>(Invoke([](WGPUSupportedLimits* limits) {
+                        *limits = {};
+                        return true;
+                    })));
+                EXPECT_CALL(api, AdapterEnumerateFeatures(apiAdapter, nullptr))
+                    .WillOnce(Return(0))
+                    .WillOnce(Return(0));
+                api.CallInstanceRequestAdapterCallback(
+                    apiInstance, WGPURequestAdapterStatus_Success, apiAdapter, nullptr);
+            }));
+        EXPECT_TRUE(FlushClient());
+
+        WGPUAdapter adapter = nullptr;
+        EXPECT_CALL(cb, Call(WGPURequestAdapterStatus_Success, NotNull(), nullptr, this))
+            .WillOnce(SaveArg<1>(&adapter));
+        EXPECT_TRUE(FlushServer());
+        return adapter;
+    }
+
+    WGPUBuffer CreateBuffer(WGPUDevice device, uint64_t size) {
+        WGPUBufferDescriptor descriptor = {};
+        descriptor.size = size;
+        descriptor.usage = WGPUBufferUsage_CopyDst;
+        return wgpuDeviceCreateBuffer(device, &descriptor);
+    }
+
+    WireServer* GetWireServer() { return mWireServer.get(); }
+
+    testing::StrictMock<MockProcTable> api;
+    std::array<WGPUDevice, kDeviceCount> devices;
+    std::array<WGPUDevice, kDeviceCount> apiDevices;
+    WGPUInstance apiInstance = nullptr;
+    WGPUAdapter apiAdapter = nullptr;
+    const std::thread::id mMainThread = std::this_thread::get_id();
+
+  private:
+    ReturnCommandRecorder mS2cBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<WireServer> mWireServer;
+    std::unique_ptr<WireClient> mWireClient;
+};
+
+// Test that the commands of each device are handled in order on one of the device threads, and
+// that the devices are spread over all the threads.
+TEST_F(WireDeviceThreadTests, CommandsOfEachDeviceAreHandledInOrder) {
+    constexpr uint64_t kBufferCount = 64;
+
+    struct HandledCommand {
+        std::thread::id thread;
+        uint64_t size;
+    };
+    std::mutex mutex;
+    std::array<std::vector<HandledCommand>, kDeviceCount> handled;
+
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    for (uint32_t i = 0; i < kDeviceCount; ++i) {
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevices[i], NotNull()))
+            .Times(kBufferCount)
+            .WillRepeatedly(WithArg<1>(Invoke([&, i](const WGPUBufferDescriptor* descriptor) {
+                std::lock_guard<std::mutex> lock(mutex);
+                handled[i].push_back({std::this_thread::get_id(), descriptor->size});
+                return apiBuffer;
+            })));
+    }
+
+    // Interleave the commands of the devices.
+    for (uint64_t size = 0; size < kBufferCount; ++size) {
+        for (WGPUDevice device : devices) {
+            CreateBuffer(device, size);
+        }
+    }
+    ASSERT_TRUE(FlushClient());
+
+    std::set<std::thread::id> threads;
+    for (const std::vector<HandledCommand>& commands : handled) {
+        ASSERT_EQ(commands.size(), kBufferCount);
+        for (uint64_t i = 0; i < kBufferCount; ++i) {
+            EXPECT_EQ(commands[i].size, i);
+            EXPECT_EQ(commands[i].thread, commands[0].thread);
+        }
+        EXPECT_NE(commands[0].thread, mMainThread);
+        threads.insert(commands[0].thread);
+    }
+    EXPECT_EQ(threads.size(), kDeviceThreadCount);
+}
+
+// Test that the return commands of the device threads are received by the client.
+TEST_F(WireDeviceThreadTests, ReturnCommands) {
+    MockCallback<WGPUErrorCallback> cb;
+    for (uint32_t i = 0; i < kDeviceCount; ++i) {
+        EXPECT_CALL(api, DevicePushErrorScope(apiDevices[i], WGPUErrorFilter_Validation));
+        EXPECT_CALL(api, OnDevicePopErrorScope(apiDevices[i], NotNull(), NotNull()))
+            .WillOnce(InvokeWithoutArgs([&, i]() {
+                EXPECT_NE(std::this_thread::get_id(), mMainThread);
+                api.CallDevicePopErrorScopeCallback(apiDevices[i], WGPUErrorType_Validation,
+                                                    "Error");
+                return true;
+            }));
+
+        wgpuDevicePushErrorScope(devices[i], WGPUErrorFilter_Validation);
+        wgpuDevicePopErrorScope(devices[i], cb.Callback(), cb.MakeUserdata(this));
+    }
+    ASSERT_TRUE(FlushClient());
+
+    EXPECT_CALL(cb, Call(WGPUErrorType_Validation, testing::StrEq("Error"), this))
+        .Times(kDeviceCount);
+    EXPECT_TRUE(FlushServer());
+}
+
+// Test that TickDevices ticks each device on its thread.
+TEST_F(WireDeviceThreadTests, TickDevices) {
+    for (uint32_t i = 0; i < kDeviceCount; ++i) {
+        EXPECT_CALL(api, DeviceTick(apiDevices[i])).WillOnce(InvokeWithoutArgs([&]() {
+            EXPECT_NE(std::this_thread::get_id(), mMainThread);
+        }));
+    }
+    GetWireServer()->TickDevices();
+    ASSERT_TRUE(FlushClient());
+}
+
+// Test that a device created with Adapter::RequestDevice on the thread of HandleCommands moves
+// to a device thread when it is used.
+TEST_F(WireDeviceThreadTests, RequestedDeviceMovesToDeviceThread) {
+    WGPUAdapter adapter = RequestAdapter(InjectInstance());
+    ASSERT_NE(adapter, nullptr);
+
+    MockCallback<WGPURequestDeviceCallback> cb;
+    WGPUDeviceDescriptor desc = {};
+    wgpuAdapterRequestDevice(adapter, &desc, cb.Callback(), cb.MakeUserdata(this));
+
+    WGPUDevice apiDevice = api.GetNewDevice();
+    EXPECT_CALL(api, OnAdapterRequestDevice(apiAdapter, NotNull(), NotNull(), NotNull()))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            EXPECT_EQ(std::this_thread::get_id(), mMainThread);
+            EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(apiDevice, NotNull(), NotNull()));
+            EXPECT_CALL(api, OnDeviceSetLoggingCallback(apiDevice, NotNull(), NotNull()));
+            EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(apiDevice, NotNull(), NotNull()));
+            EXPECT_CALL(api, DeviceGetLimits(apiDevice, NotNull()))
+                .WillOnce(WithArg<1>(Invoke([](WGPUSupportedLimits* limits) {
+                    *limits = {};
+                    return true;
+                })));
+            EXPECT_CALL(api, DeviceEnumerateFeatures(apiDevice, nullptr))
+                .WillOnce(Return(0))
+                .WillOnce(Return(0));
+            api.CallAdapterRequestDeviceCallback(apiAdapter, WGPURequestDeviceStatus_Success,
+                                                 apiDevice, nullptr);
+        }));
+    ASSERT_TRUE(FlushClient());
+
+    WGPUDevice device = nullptr;
+    EXPECT_CALL(cb, Call(WGPURequestDeviceStatus_Success, NotNull(), nullptr, this))
+        .WillOnce(SaveArg<1>(&device));
+    ASSERT_TRUE(FlushServer());
+    ASSERT_NE(device, nullptr);
+    EXPECT_TRUE(GetWireServer()->IsDeviceKnown(apiDevice));
+
+    // The first command of the device moves it to a device thread: the callbacks are forwarded
+    // by the server of the thread, which takes over the reference of the device.
+    {
+        testing::InSequence sequence;
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(apiDevice, nullptr, nullptr));
+        EXPECT_CALL(api, OnDeviceSetLoggingCallback(apiDevice, nullptr, nullptr));
+        EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(apiDevice, nullptr, nullptr));
+        EXPECT_CALL(api, DeviceReference(apiDevice));
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(apiDevice, NotNull(), NotNull()));
+        EXPECT_CALL(api, OnDeviceSetLoggingCallback(apiDevice, NotNull(), NotNull()));
+        EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(apiDevice, NotNull(), NotNull()));
+        EXPECT_CALL(api, DeviceRelease(apiDevice));
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, NotNull()))
+            .WillOnce(InvokeWithoutArgs([&]() {
+                EXPECT_NE(std::this_thread::get_id(), mMainThread);
+                return api.GetNewBuffer();
+            }));
+    }
+    CreateBuffer(device, 4);
+    ASSERT_TRUE(FlushClient());
+}
+
+// Test that the commands of a device using objects of a device of another thread aren't fatal:
+// they are handled on the thread of HandleCommands with the objects of the other device, so that
+// the device can produce a validation error like when there are no device threads.
+TEST_F(WireDeviceThreadTests, ObjectOfDeviceOfAnotherThreadIsNotFatal) {
+    // The devices are assigned to the threads in turn.
+    WGPUDevice device0 = devices[0];
+    WGPUDevice device1 = devices[1];
+
+    WGPUBuffer buffer = CreateBuffer(device0, 4);
+    WGPUQueue queue = wgpuDeviceGetQueue(device1);
+    WGPUBindGroupLayoutDescriptor layoutDesc = {};
+    WGPUBindGroupLayout layout = wgpuDeviceCreateBindGroupLayout(device1, &layoutDesc);
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUQueue apiQueue = api.GetNewQueue();
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevices[0], NotNull())).WillOnce(Return(apiBuffer));
+    EXPECT_CALL(api, DeviceGetQueue(apiDevices[1])).WillOnce(Return(apiQueue));
+    EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevices[1], NotNull()))
+        .WillOnce(Return(api.GetNewBindGroupLayout()));
+    ASSERT_TRUE(FlushClient());
+
+    // An object in the fixed part of the command.
+    uint32_t data = 0;
+    wgpuQueueWriteBuffer(queue, buffer, 0, &data, sizeof(data));
+    EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer, 0, NotNull(), sizeof(data)))
+        .WillOnce(InvokeWithoutArgs(
+            [&]() { EXPECT_EQ(std::this_thread::get_id(), mMainThread); }));
+    ASSERT_TRUE(FlushClient());
+
+    // An object in a structure of the command.
+    WGPUBindGroupEntry entry = {};
+    entry.binding = 0;
+    entry.buffer = buffer;
+    entry.size = 4;
+    WGPUBindGroupDescriptor bindGroupDesc = {};
+    bindGroupDesc.layout = layout;
+    bindGroupDesc.entryCount = 1;
+    bindGroupDesc.entries = &entry;
+    wgpuDeviceCreateBindGroup(device1, &bindGroupDesc);
+    EXPECT_CALL(api, DeviceCreateBindGroup(apiDevices[1], NotNull()))
+        .WillOnce(WithArg<1>(Invoke([&](const WGPUBindGroupDescriptor* desc) {
+            EXPECT_EQ(std::this_thread::get_id(), mMainThread);
+            EXPECT_EQ(desc->entries[0].buffer, apiBuffer);
+            return api.GetNewBindGroup();
+        })));
+    ASSERT_TRUE(FlushClient());
+
+    // The commands that only use objects of their device are still handled on the device
+    // threads.
+    CreateBuffer(device1, 4);
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevices[1], NotNull()))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            EXPECT_NE(std::this_thread::get_id(), mMainThread);
+            return api.GetNewBuffer();
+        }));
+    ASSERT_TRUE(FlushClient());
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
@@ -0,0 +1,230 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/wire/WireClient.h"
+
+namespace dawn::wire {
+
+using testing::_;
+using testing::Between;
+using testing::Mock;
+using testing::Return;
+
+class WireFlushPolicyTests : public WireTest {
+  protected:
+    static constexpr size_t kMaxPendingBytes = 1024;
+    static constexpr size_t kMaxPendingCommands = 8;
+
+    WireClientFlushPolicy GetClientFlushPolicy() override { return mFlushPolicy; }
+
+    void SetUp() override {
+        WireTest::SetUp();
+        // WireTest flushes the serializer directly, so flush through the client to let it know
+        // that nothing is pending.
+        ASSERT_TRUE(GetWireClient()->Flush());
+        mInitialStats = GetWireClient()->GetFlushStats();
+    }
+
+    // Checks that the server already received the expected calls, without flushing the client
+    // explicitly.
+    void ExpectAutoFlushed() {
+        EXPECT_TRUE(Mock::VerifyAndClearExpectations(&api));
+        FlushClient();
+    }
+
+    WGPUBuffer CreateBuffer(WGPUBufferUsageFlags usage, WGPUBuffer apiBuffer) {
+        WGPUBufferDescriptor descriptor = {};
+        descriptor.size = kBufferSize;
+        descriptor.usage = usage;
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+        EXPECT_TRUE(GetWireClient()->Flush());
+        FlushClient();
+
+        // Only count the flushes of the commands of the test.
+        mInitialStats = GetWireClient()->GetFlushStats();
+        return buffer;
+    }
+
+    // The stats since the end of SetUp or the last CreateBuffer.
+    WireClientFlushStats GetFlushStats() {
+        WireClientFlushStats stats = GetWireClient()->GetFlushStats();
+        stats.flushes -= mInitialStats.flushes;
+        stats.explicitFlushes -= mInitialStats.explicitFlushes;
+        stats.flushedCommands -= mInitialStats.flushedCommands;
+        stats.flushedBytes -= mInitialStats.flushedBytes;
+        return stats;
+    }
+
+    static constexpr uint64_t kBufferSize = 4096;
+
+    WireClientFlushPolicy mFlushPolicy = {kMaxPendingBytes, kMaxPendingCommands, true, true, 0};
+    WireClientFlushStats mInitialStats;
+};
+
+// Test that the commands are flushed once maxPendingCommands of them are pending.
+TEST_F(WireFlushPolicyTests, PendingCommands) {
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+
+    // The StrictMock fails if the server receives the commands before the threshold.
+    for (size_t i = 0; i < kMaxPendingCommands - 1; ++i) {
+        wgpuDeviceCreateCommandEncoder(device, nullptr);
+    }
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, _))
+        .Times(kMaxPendingCommands)
+        .WillRepeatedly(Return(apiEncoder));
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    ExpectAutoFlushed();
+
+    WireClientFlushStats stats = GetFlushStats();
+    EXPECT_EQ(stats.flushes, 1u);
+    EXPECT_EQ(stats.pendingCommandsFlushes, 1u);
+    EXPECT_EQ(stats.flushedCommands, kMaxPendingCommands);
+}
+
+// Test that the commands are flushed once maxPendingBytes of them are pending.
+TEST_F(WireFlushPolicyTests, PendingBytes) {
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer buffer = CreateBuffer(WGPUBufferUsage_CopyDst, apiBuffer);
+    std::vector<uint8_t> data(kBufferSize);
+
+    wgpuQueueWriteBuffer(queue, buffer, 0, data.data(), 16);
+
+    EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer, 0, _, 16)).Times(1);
+    EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer, 0, _, kMaxPendingBytes)).Times(1);
+    wgpuQueueWriteBuffer(queue, buffer, 0, data.data(), kMaxPendingBytes);
+    ExpectAutoFlushed();
+
+    WireClientFlushStats stats = GetFlushStats();
+    EXPECT_EQ(stats.pendingBytesFlushes, 1u);
+    EXPECT_EQ(stats.flushedCommands, 2u);
+    EXPECT_GT(stats.flushedBytes, 16u + kMaxPendingBytes);
+}
+
+// Test that Queue::Submit is flushed immediately with flushOnSubmit.
+TEST_F(WireFlushPolicyTests, Submit) {
+    EXPECT_CALL(api, QueueSubmit(apiQueue, 0, _)).Times(1);
+    wgpuQueueSubmit(queue, 0, nullptr);
+    ExpectAutoFlushed();
+
+    WireClientFlushStats stats = GetFlushStats();
+    EXPECT_EQ(stats.submitFlushes, 1u);
+    EXPECT_EQ(stats.flushedCommands, 1u);
+}
+
+// Test that Buffer::MapAsync is flushed immediately with flushOnMapAsync.
+TEST_F(WireFlushPolicyTests, MapAsync) {
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer buffer = CreateBuffer(WGPUBufferUsage_MapRead, apiBuffer);
+
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Read, 0, kBufferSize, _, _))
+        .Times(1);
+    wgpuBufferMapAsync(
+        buffer, WGPUMapMode_Read, 0, kBufferSize, [](WGPUBufferMapAsyncStatus, void*) {},
+        nullptr);
+    ExpectAutoFlushed();
+
+    EXPECT_EQ(GetFlushStats().mapAsyncFlushes, 1u);
+}
+
+// Test that flushing through the client resets the pending commands.
+TEST_F(WireFlushPolicyTests, ExplicitFlush) {
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+
+    for (size_t i = 0; i < kMaxPendingCommands - 1; ++i) {
+        wgpuDeviceCreateCommandEncoder(device, nullptr);
+    }
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, _))
+        .Times(kMaxPendingCommands - 1)
+        .WillRepeatedly(Return(apiEncoder));
+    EXPECT_TRUE(GetWireClient()->Flush());
+    ExpectAutoFlushed();
+
+    // The threshold isn't reached again with the same number of commands.
+    for (size_t i = 0; i < kMaxPendingCommands - 1; ++i) {
+        wgpuDeviceCreateCommandEncoder(device, nullptr);
+    }
+    EXPECT_TRUE(Mock::VerifyAndClearExpectations(&api));
+
+    WireClientFlushStats stats = GetFlushStats();
+    EXPECT_EQ(stats.flushes, 1u);
+    EXPECT_EQ(stats.explicitFlushes, 1u);
+    EXPECT_EQ(stats.pendingCommandsFlushes, 0u);
+    EXPECT_EQ(stats.flushedCommands, kMaxPendingCommands - 1);
+}
+
+// Test that the client doesn't flush anymore once disconnected.
+TEST_F(WireFlushPolicyTests, Disconnect) {
+    GetWireClient()->Disconnect();
+    for (size_t i = 0; i < kMaxPendingCommands; ++i) {
+        wgpuDeviceCreateCommandEncoder(device, nullptr);
+    }
+    EXPECT_FALSE(GetWireClient()->Flush());
+    EXPECT_EQ(GetFlushStats().flushes, 0u);
+}
+
+class WireFlushPolicyTimeTests : public WireFlushPolicyTests {
+  protected:
+    static constexpr uint64_t kMaxPendingTimeUs = 1000;
+
+    WireFlushPolicyTimeTests() {
+        mFlushPolicy = {};
+        mFlushPolicy.maxPendingTimeUs = kMaxPendingTimeUs;
+    }
+};
+
+// Test that FlushIfExpired flushes the commands once the oldest one is old enough.
+TEST_F(WireFlushPolicyTimeTests, FlushIfExpired) {
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    std::this_thread::sleep_for(std::chrono::microseconds(2 * kMaxPendingTimeUs));
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, _)).WillOnce(Return(apiEncoder));
+    EXPECT_TRUE(GetWireClient()->FlushIfExpired());
+    ExpectAutoFlushed();
+
+    // Nothing is pending anymore.
+    EXPECT_TRUE(GetWireClient()->FlushIfExpired());
+    EXPECT_EQ(GetFlushStats().pendingTimeFlushes, 1u);
+}
+
+// Test that the next commands flush the pending commands once the oldest one is old enough. The
+// pending time is only checked every few commands.
+TEST_F(WireFlushPolicyTimeTests, NextCommands) {
+    constexpr size_t kMaxCommandsBeforeCheck = 16;
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    std::this_thread::sleep_for(std::chrono::microseconds(2 * kMaxPendingTimeUs));
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, _))
+        .Times(Between(2, kMaxCommandsBeforeCheck))
+        .WillRepeatedly(Return(apiEncoder));
+    for (size_t i = 1; i < kMaxCommandsBeforeCheck && GetFlushStats().flushes == 0; ++i) {
+        wgpuDeviceCreateCommandEncoder(device, nullptr);
+    }
+    ExpectAutoFlushed();
+
+    EXPECT_EQ(GetFlushStats().pendingTimeFlushes, 1u);
+}
+
+}  // namespace dawn::wire
@@ -0,0 +1,136 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+
+#include "dawn/wire/server/ObjectStorage.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using dawn::wire::server::AllocationState;
+using dawn::wire::server::BufferMapWriteState;
+using dawn::wire::server::KnownObjects;
+
+template <typename T>
+T FakeHandle(uintptr_t value) {
+    return reinterpret_cast<T>(value * 8);
+}
+
+// Test that ID 0 and the IDs past the known ones are never found.
+TEST(WireObjectStorageTests, GetUnknownIds) {
+    KnownObjects<WGPUBindGroup> known;
+    EXPECT_EQ(known.Get(0), nullptr);
+    EXPECT_EQ(known.Get(1), nullptr);
+    EXPECT_EQ(known.Get(0xFFFFFFFF), nullptr);
+    EXPECT_EQ(known.Allocate(0), nullptr);
+
+    ASSERT_NE(known.Allocate(1), nullptr);
+    EXPECT_NE(known.Get(1), nullptr);
+    EXPECT_EQ(known.Get(2), nullptr);
+}
+
+// Test that IDs can only be allocated right after the known ones, unless sparse IDs are allowed.
+TEST(WireObjectStorageTests, SparseIds) {
+    KnownObjects<WGPUBindGroup> known;
+    EXPECT_EQ(known.Allocate(3), nullptr);
+
+    known.AllowSparseIds();
+    ASSERT_NE(known.Allocate(3), nullptr);
+    EXPECT_EQ(known.Get(1), nullptr);
+    EXPECT_EQ(known.Get(2), nullptr);
+    EXPECT_NE(known.Get(3), nullptr);
+
+    // The skipped IDs are free.
+    EXPECT_NE(known.Allocate(1), nullptr);
+    EXPECT_NE(known.Allocate(2), nullptr);
+    EXPECT_EQ(known.Allocate(3), nullptr);
+}
+
+// Test that the slot of a freed ID is reset for the next object that reuses the ID.
+TEST(WireObjectStorageTests, FreedSlotIsReset) {
+    KnownObjects<WGPUBuffer> known;
+    auto* data = known.Allocate(1);
+    ASSERT_NE(data, nullptr);
+    data->handle = FakeHandle<WGPUBuffer>(1);
+    data->generation = 7;
+    data->mapWriteState = BufferMapWriteState::Mapped;
+    data->usage = WGPUBufferUsage_MapWrite;
+    data->mappedAtCreation = true;
+
+    // The ID can't be allocated again until it is freed.
+    EXPECT_EQ(known.Allocate(1), nullptr);
+    known.Free(1);
+    EXPECT_EQ(known.Get(1), nullptr);
+
+    data = known.Allocate(1);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->handle, nullptr);
+    EXPECT_EQ(data->generation, 0u);
+    EXPECT_EQ(data->mapWriteState, BufferMapWriteState::Unmapped);
+    EXPECT_EQ(data->usage, WGPUBufferUsage_None);
+    EXPECT_FALSE(data->mappedAtCreation);
+    EXPECT_EQ(data->readHandle, nullptr);
+    EXPECT_EQ(data->writeHandle, nullptr);
+}
+
+// Test that the lookups with a generation only find the object of that generation.
+TEST(WireObjectStorageTests, GetWithGeneration) {
+    KnownObjects<WGPUBindGroup> known;
+    auto* data = known.Allocate(1);
+    ASSERT_NE(data, nullptr);
+    data->generation = 3;
+
+    EXPECT_EQ(known.Get(1, 3), data);
+    EXPECT_EQ(known.Get(1, 2), nullptr);
+    EXPECT_EQ(known.Get(2, 3), nullptr);
+
+    // The ID is reused by an object of the next generation.
+    known.Free(1);
+    EXPECT_EQ(known.Get(1, 3), nullptr);
+    data = known.Allocate(1);
+    ASSERT_NE(data, nullptr);
+    data->generation = 4;
+    EXPECT_EQ(known.Get(1, 3), nullptr);
+    EXPECT_EQ(known.Get(1, 4), data);
+}
+
+// Test that reserved objects are only found once their reservation is filled.
+TEST(WireObjectStorageTests, Reservation) {
+    KnownObjects<WGPUBindGroup> known;
+    ASSERT_NE(known.Allocate(1, AllocationState::Reserved), nullptr);
+    EXPECT_EQ(known.Get(1), nullptr);
+    EXPECT_EQ(known.Allocate(1), nullptr);
+
+    auto* data = known.FillReservation(1, FakeHandle<WGPUBindGroup>(1));
+    EXPECT_EQ(known.Get(1), data);
+    EXPECT_EQ(data->handle, FakeHandle<WGPUBindGroup>(1));
+}
+
+// Test that the known devices are tracked as their IDs are allocated and freed.
+TEST(WireObjectStorageTests, KnownDevices) {
+    KnownObjects<WGPUDevice> known;
+    WGPUDevice device = FakeHandle<WGPUDevice>(1);
+    EXPECT_FALSE(known.IsKnown(device));
+
+    known.Allocate(1, AllocationState::Reserved);
+    EXPECT_FALSE(known.IsKnown(device));
+    known.FillReservation(1, device);
+    EXPECT_TRUE(known.IsKnown(device));
+
+    known.Free(1);
+    EXPECT_FALSE(known.IsKnown(device));
+}
+
+}  // namespace
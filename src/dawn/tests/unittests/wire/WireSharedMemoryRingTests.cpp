@@ -0,0 +1,373 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dawn/utils/SharedMemoryRing.h"
+#include "dawn/wire/BufferConsumer_impl.h"
+#include "dawn/wire/ChunkedCommandHandler.h"
+#include "dawn/wire/ChunkedCommandSerializer.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using dawn::wire::CmdHeader;
+using dawn::wire::SerializeBuffer;
+using dawn::wire::WireResult;
+
+constexpr size_t kCapacity = 4096;
+
+// A command handler that records the commands it receives, each call being one element.
+class RecordingHandler : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        if (fail) {
+            return nullptr;
+        }
+        received.emplace_back(const_cast<const char*>(commands), size);
+        return commands + size;
+    }
+
+    bool fail = false;
+    std::vector<std::string> received;
+};
+
+// A fake wire command made of a CmdHeader followed by a payload, to test chunking.
+struct FakeCmd {
+    // FakeCmds have a variable size and don't take the fixed-size fast path.
+    static constexpr size_t kFixedSize = 0;
+
+    std::string payload;
+
+    size_t GetRequiredSize() const { return sizeof(CmdHeader) + payload.size(); }
+    size_t GetDataOnlySize() const { return payload.size(); }
+
+    WireResult Serialize(size_t commandSize, SerializeBuffer* buffer) const {
+        CmdHeader* header;
+        WIRE_TRY(buffer->Next(&header));
+        header->commandSize = commandSize;
+
+        WIRE_TRY(buffer->NextData(payload.size(), payload.data()));
+        return WireResult::Success;
+    }
+};
+
+// A handler of FakeCmds that reassembles the chunked ones, like WireServer and WireClient do.
+class FakeCmdHandler : public dawn::wire::ChunkedCommandHandler {
+  public:
+    std::vector<std::string> payloads;
+
+  private:
+    const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override {
+        while (size >= sizeof(CmdHeader)) {
+            switch (HandleChunkedCommands(commands, size)) {
+                case ChunkedCommandsResult::Consumed:
+                    return commands + size;
+                case ChunkedCommandsResult::Error:
+                    return nullptr;
+                case ChunkedCommandsResult::Passthrough:
+                    break;
+            }
+
+            uint64_t commandSize =
+                reinterpret_cast<const volatile CmdHeader*>(commands)->commandSize;
+            if (commandSize < sizeof(CmdHeader)) {
+                return nullptr;
+            }
+            payloads.emplace_back(const_cast<const char*>(commands) + sizeof(CmdHeader),
+                                  commandSize - sizeof(CmdHeader));
+            commands += commandSize;
+            size -= commandSize;
+        }
+        return size == 0 ? commands : nullptr;
+    }
+};
+
+std::string MakePayload(size_t size, char seed) {
+    std::string payload(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        payload[i] = static_cast<char>(seed + i * 7);
+    }
+    return payload;
+}
+
+class SharedMemoryRingTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        mRing = utils::SharedMemoryRing::Create(kCapacity);
+        ASSERT_NE(mRing, nullptr);
+    }
+
+    // Serializes |payload| in a single allocation.
+    void Write(utils::SharedMemoryRingSerializer* serializer, const std::string& payload) {
+        void* space = serializer->GetCmdSpace(payload.size());
+        ASSERT_NE(space, nullptr);
+        memcpy(space, payload.data(), payload.size());
+    }
+
+    std::unique_ptr<utils::SharedMemoryRing> mRing;
+};
+
+// Test that the capacity is rounded up to a power of two and that the allocations are limited
+// to half of the ring.
+TEST_F(SharedMemoryRingTests, Capacity) {
+    EXPECT_EQ(mRing->GetCapacity(), kCapacity);
+
+    std::unique_ptr<utils::SharedMemoryRing> ring = utils::SharedMemoryRing::Create(5000);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(ring->GetCapacity(), 8192u);
+
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    size_t maxSize = serializer.GetMaximumAllocationSize();
+    EXPECT_LT(maxSize, kCapacity / 2);
+    EXPECT_NE(serializer.GetCmdSpace(maxSize), nullptr);
+    EXPECT_EQ(serializer.GetCmdSpace(maxSize + 1), nullptr);
+}
+
+// Test opening a ring from the file descriptor of another one, and that opening file descriptors
+// that don't contain a ring fails.
+TEST_F(SharedMemoryRingTests, Open) {
+    std::unique_ptr<utils::SharedMemoryRing> opened =
+        utils::SharedMemoryRing::Open(dup(mRing->GetFd()));
+    ASSERT_NE(opened, nullptr);
+    EXPECT_EQ(opened->GetCapacity(), kCapacity);
+
+    // Commands written through one mapping are read through the other.
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    utils::SharedMemoryRingReader reader(opened.get(), &handler);
+    Write(&serializer, "commands");
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(reader.HandleCommands());
+    ASSERT_EQ(handler.received.size(), 1u);
+    EXPECT_EQ(handler.received[0], "commands");
+
+    int fd = memfd_create("not_a_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 2 * kCapacity), 0);
+    ASSERT_EQ(fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW), 0);
+    EXPECT_EQ(utils::SharedMemoryRing::Open(fd), nullptr);
+}
+
+// Test that opening a valid ring in a file descriptor that isn't sealed against shrinking fails,
+// since the other process could truncate it while it is mapped.
+TEST_F(SharedMemoryRingTests, OpenUnsealed) {
+    struct stat fileStat;
+    ASSERT_EQ(fstat(mRing->GetFd(), &fileStat), 0);
+    std::vector<char> contents(static_cast<size_t>(fileStat.st_size));
+    ASSERT_EQ(pread(mRing->GetFd(), contents.data(), contents.size(), 0),
+              static_cast<ssize_t>(contents.size()));
+
+    // A copy of the ring in a memfd that allows sealing but isn't sealed.
+    int fd = memfd_create("unsealed_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+    EXPECT_EQ(utils::SharedMemoryRing::Open(fd), nullptr);
+
+    // The same copy opens once it is sealed.
+    fd = memfd_create("sealed_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+    ASSERT_EQ(fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW), 0);
+    EXPECT_NE(utils::SharedMemoryRing::Open(fd), nullptr);
+}
+
+// Test that commands are only visible after a flush and that the allocations between two flushes
+// are handled in a single call.
+TEST_F(SharedMemoryRingTests, Flush) {
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    utils::SharedMemoryRingReader reader(mRing.get(), &handler);
+
+    Write(&serializer, "abc");
+    Write(&serializer, "defgh");
+    ASSERT_TRUE(reader.HandleCommands());
+    EXPECT_TRUE(handler.received.empty());
+
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(reader.HandleCommands());
+    ASSERT_EQ(handler.received.size(), 1u);
+    EXPECT_EQ(handler.received[0], "abcdefgh");
+
+    // Flushing without new commands doesn't produce anything.
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(reader.HandleCommands());
+    EXPECT_EQ(handler.received.size(), 1u);
+}
+
+// Test that allocations are never split at the end of the ring, by going around it many times
+// with sizes that don't divide the capacity.
+TEST_F(SharedMemoryRingTests, Wraparound) {
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    utils::SharedMemoryRingReader reader(mRing.get(), &handler);
+
+    std::string expected;
+    for (size_t i = 0; i < 200; ++i) {
+        std::string payload = MakePayload(1 + (i * 37) % 700, static_cast<char>(i));
+        Write(&serializer, payload);
+        expected += payload;
+        if (i % 3 == 2) {
+            ASSERT_TRUE(serializer.Flush());
+            ASSERT_TRUE(reader.HandleCommands());
+        }
+    }
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(reader.HandleCommands());
+
+    std::string received;
+    for (const std::string& commands : handler.received) {
+        received += commands;
+    }
+    EXPECT_EQ(received, expected);
+}
+
+// Test that the producer waits for the consumer when the ring is full and that commands larger
+// than the maximum allocation size are chunked by ChunkedCommandSerializer.
+TEST_F(SharedMemoryRingTests, ConcurrentChunkedCommands) {
+    std::vector<std::string> payloads;
+    for (size_t i = 0; i < 100; ++i) {
+        payloads.push_back(MakePayload(8 * (1 + (i * 131) % (i % 10 == 0 ? 1500 : 100)),
+                                       static_cast<char>(i)));
+    }
+
+    std::thread producer([&] {
+        utils::SharedMemoryRingSerializer serializer(mRing.get());
+        dawn::wire::ChunkedCommandSerializer chunkedSerializer(&serializer);
+        for (size_t i = 0; i < payloads.size(); ++i) {
+            chunkedSerializer.SerializeCommand(FakeCmd{payloads[i]});
+            if (i % 4 == 3) {
+                serializer.Flush();
+            }
+        }
+        serializer.Flush();
+        mRing->Close();
+    });
+
+    FakeCmdHandler handler;
+    utils::SharedMemoryRingReader reader(mRing.get(), &handler);
+    while (reader.WaitForCommands()) {
+        ASSERT_TRUE(reader.HandleCommands());
+    }
+    producer.join();
+
+    EXPECT_EQ(handler.payloads, payloads);
+}
+
+// Test that closing the ring wakes up a waiting consumer and makes the producer fail.
+TEST_F(SharedMemoryRingTests, Close) {
+    RecordingHandler handler;
+    utils::SharedMemoryRingReader reader(mRing.get(), &handler);
+
+    std::thread closer([&] { mRing->Close(); });
+    EXPECT_FALSE(reader.WaitForCommands());
+    closer.join();
+
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    EXPECT_TRUE(mRing->IsClosed());
+    EXPECT_EQ(serializer.GetCmdSpace(16), nullptr);
+    EXPECT_FALSE(serializer.Flush());
+}
+
+// Test that the commands flushed before closing the ring are still handled.
+TEST_F(SharedMemoryRingTests, CommandsHandledAfterClose) {
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    utils::SharedMemoryRingReader reader(mRing.get(), &handler);
+
+    Write(&serializer, "last commands");
+    ASSERT_TRUE(serializer.Flush());
+    mRing->Close();
+
+    ASSERT_TRUE(reader.WaitForCommands());
+    ASSERT_TRUE(reader.HandleCommands());
+    ASSERT_EQ(handler.received.size(), 1u);
+    EXPECT_EQ(handler.received[0], "last commands");
+    EXPECT_FALSE(reader.WaitForCommands());
+}
+
+// Test that errors of the handler and corrupted segments are reported by the reader.
+TEST_F(SharedMemoryRingTests, Errors) {
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    utils::SharedMemoryRingReader reader(mRing.get(), &handler);
+
+    handler.fail = true;
+    Write(&serializer, "commands");
+    ASSERT_TRUE(serializer.Flush());
+    EXPECT_FALSE(reader.HandleCommands());
+
+    // The segment header is right before the first allocation of the segment. Make the size of
+    // the segment larger than the ring.
+    std::unique_ptr<utils::SharedMemoryRing> ring = utils::SharedMemoryRing::Create(kCapacity);
+    utils::SharedMemoryRingSerializer corruptedSerializer(ring.get());
+    utils::SharedMemoryRingReader corruptedReader(ring.get(), &handler);
+    handler.fail = false;
+    char* space = static_cast<char*>(corruptedSerializer.GetCmdSpace(8));
+    ASSERT_NE(space, nullptr);
+    ASSERT_TRUE(corruptedSerializer.Flush());
+    uint32_t size = 2 * kCapacity;
+    memcpy(space - 8, &size, sizeof(size));
+    EXPECT_FALSE(corruptedReader.HandleCommands());
+    EXPECT_TRUE(handler.received.empty());
+}
+
+// Test the transport of commands to another process.
+TEST_F(SharedMemoryRingTests, CrossProcess) {
+    std::vector<std::string> payloads;
+    for (size_t i = 0; i < 64; ++i) {
+        payloads.push_back(MakePayload(8 * (1 + (i * 53) % 600), static_cast<char>(i)));
+    }
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // The child opens its own mapping of the ring, as a separate process would.
+        std::unique_ptr<utils::SharedMemoryRing> ring =
+            utils::SharedMemoryRing::Open(dup(mRing->GetFd()));
+        FakeCmdHandler handler;
+        utils::SharedMemoryRingReader reader(ring.get(), &handler);
+        while (reader.WaitForCommands()) {
+            if (!reader.HandleCommands()) {
+                _exit(1);
+            }
+        }
+        _exit(handler.payloads == payloads ? 0 : 2);
+    }
+
+    utils::SharedMemoryRingSerializer serializer(mRing.get());
+    dawn::wire::ChunkedCommandSerializer chunkedSerializer(&serializer);
+    for (const std::string& payload : payloads) {
+        chunkedSerializer.SerializeCommand(FakeCmd{payload});
+        serializer.Flush();
+    }
+    mRing->Close();
+
+    int status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+}  // anonymous namespace
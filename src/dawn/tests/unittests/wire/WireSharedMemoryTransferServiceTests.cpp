@@ -0,0 +1,244 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/utils/SharedMemoryTransferService.h"
+#include "dawn/wire/WireClient.h"
+
+namespace dawn::wire {
+
+using testing::_;
+using testing::InvokeWithoutArgs;
+using testing::Mock;
+using testing::Return;
+using testing::StrictMock;
+
+namespace {
+
+// Mock class to add expectations on the wire calling callbacks
+class MockBufferMapCallback {
+  public:
+    MOCK_METHOD(void, Call, (WGPUBufferMapAsyncStatus status, void* userdata));
+};
+
+std::unique_ptr<StrictMock<MockBufferMapCallback>> mockBufferMapCallback;
+void ToMockBufferMapCallback(WGPUBufferMapAsyncStatus status, void* userdata) {
+    mockBufferMapCallback->Call(status, userdata);
+}
+
+constexpr uint64_t kBufferSize = 4 * sizeof(uint32_t);
+
+}  // anonymous namespace
+
+// Test buffer mapping through the wire with the shared memory transfer services, which share
+// the regions between the client and the server directly instead of going through a process.
+class WireSharedMemoryTransferServiceTests : public WireTest {
+  public:
+    WireSharedMemoryTransferServiceTests() {}
+    ~WireSharedMemoryTransferServiceTests() override = default;
+
+    client::MemoryTransferService* GetClientMemoryTransferService() override {
+        return &clientMemoryTransferService;
+    }
+
+    server::MemoryTransferService* GetServerMemoryTransferService() override {
+        return &serverMemoryTransferService;
+    }
+
+    void SetUp() override {
+        WireTest::SetUp();
+        mockBufferMapCallback = std::make_unique<StrictMock<MockBufferMapCallback>>();
+    }
+
+    void TearDown() override {
+        WireTest::TearDown();
+
+        // Delete mock so that expectations are checked
+        mockBufferMapCallback = nullptr;
+    }
+
+    void FlushServer() {
+        WireTest::FlushServer();
+        Mock::VerifyAndClearExpectations(&mockBufferMapCallback);
+    }
+
+    WGPUBuffer CreateBuffer(WGPUBuffer apiBuffer, WGPUBufferUsageFlags usage) {
+        WGPUBufferDescriptor descriptor = {};
+        descriptor.size = kBufferSize;
+        descriptor.usage = usage;
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _))
+            .WillOnce(Return(apiBuffer))
+            .RetiresOnSaturation();
+        FlushClient();
+        return buffer;
+    }
+
+  protected:
+    // Controls what the export of the regions does.
+    enum class Export {
+        Import,  // The server imports the region.
+        Drop,    // The region never reaches the server.
+        Fail,    // The export fails.
+    };
+    Export exportBehavior = Export::Import;
+
+    utils::SharedMemoryServerTransferService serverMemoryTransferService;
+    utils::SharedMemoryClientTransferService clientMemoryTransferService{
+        [this](uint64_t id, int fd, size_t size) {
+            switch (exportBehavior) {
+                case Export::Import:
+                    return serverMemoryTransferService.ImportRegion(id, dup(fd), size);
+                case Export::Drop:
+                    return true;
+                case Export::Fail:
+                    return false;
+            }
+            return false;
+        }};
+};
+
+// Test that the data of a buffer mapped for reading is given to the client.
+TEST_F(WireSharedMemoryTransferServiceTests, MapRead) {
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer buffer = CreateBuffer(apiBuffer, WGPUBufferUsage_MapRead);
+
+    uint32_t serverContent[4] = {1, 2, 3, 4};
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Read, 0, kBufferSize, _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
+        }));
+    EXPECT_CALL(api, BufferGetConstMappedRange(apiBuffer, 0, kBufferSize))
+        .WillOnce(Return(&serverContent));
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+    FlushServer();
+
+    const uint32_t* mapped =
+        static_cast<const uint32_t*>(wgpuBufferGetConstMappedRange(buffer, 0, kBufferSize));
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(memcmp(mapped, serverContent, kBufferSize), 0);
+
+    wgpuBufferUnmap(buffer);
+    EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
+    FlushClient();
+}
+
+// Test that the data written in a buffer mapped for writing is given to the server on unmap.
+TEST_F(WireSharedMemoryTransferServiceTests, MapWrite) {
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer buffer = CreateBuffer(apiBuffer, WGPUBufferUsage_MapWrite);
+
+    uint32_t serverContent[4] = {};
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback,
+                       nullptr);
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kBufferSize, _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
+        }));
+    EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kBufferSize))
+        .WillOnce(Return(&serverContent));
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+    FlushServer();
+
+    uint32_t* mapped = static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 0, kBufferSize));
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(mapped[0], 0u);
+    mapped[0] = 42;
+    mapped[3] = 43;
+
+    wgpuBufferUnmap(buffer);
+    EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
+    FlushClient();
+
+    EXPECT_EQ(serverContent[0], 42u);
+    EXPECT_EQ(serverContent[3], 43u);
+}
+
+// Test that the data written in a buffer mapped at creation is given to the server on unmap.
+TEST_F(WireSharedMemoryTransferServiceTests, MappedAtCreation) {
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = kBufferSize;
+    descriptor.mappedAtCreation = true;
+
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    uint32_t serverContent[4] = {};
+
+    WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+    static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 0, kBufferSize))[1] = 1234;
+
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+    EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kBufferSize))
+        .WillOnce(Return(&serverContent));
+    FlushClient();
+
+    wgpuBufferUnmap(buffer);
+    EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
+    FlushClient();
+
+    EXPECT_EQ(serverContent[1], 1234u);
+}
+
+// Test that the creation of the buffer fails on the client if the region can't be exported.
+TEST_F(WireSharedMemoryTransferServiceTests, ExportFailure) {
+    exportBehavior = Export::Fail;
+
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = kBufferSize;
+    descriptor.usage = WGPUBufferUsage_MapRead;
+    wgpuDeviceCreateBuffer(device, &descriptor);
+}
+
+// Test that the server fails to create the handles of regions that it didn't import.
+TEST_F(WireSharedMemoryTransferServiceTests, UnknownRegion) {
+    exportBehavior = Export::Drop;
+
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = kBufferSize;
+    descriptor.usage = WGPUBufferUsage_MapRead;
+    wgpuDeviceCreateBuffer(device, &descriptor);
+
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(api.GetNewBuffer()));
+    FlushClient(false);
+}
+
+// Test the validation of the regions imported by the server.
+TEST_F(WireSharedMemoryTransferServiceTests, ImportValidation) {
+    std::unique_ptr<utils::SharedMemoryRegion> region = utils::SharedMemoryRegion::Create(64);
+    ASSERT_NE(region, nullptr);
+
+    // Regions can't be larger than their file or imported twice with the same ID.
+    EXPECT_FALSE(serverMemoryTransferService.ImportRegion(1000, dup(region->GetFd()), 4096));
+    EXPECT_TRUE(serverMemoryTransferService.ImportRegion(1000, dup(region->GetFd()), 64));
+    EXPECT_FALSE(serverMemoryTransferService.ImportRegion(1000, dup(region->GetFd()), 64));
+
+    // Files that can be shrunk aren't accepted.
+    int fd = memfd_create("unsealed", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 64), 0);
+    EXPECT_FALSE(serverMemoryTransferService.ImportRegion(1001, fd, 64));
+}
+
+}  // namespace dawn::wire
@@ -37,6 +37,10 @@ dawn::wire::server::MemoryTransferService* WireTest::GetServerMemoryTransferServ
     return nullptr;
 }
 
+dawn::wire::WireClientFlushPolicy WireTest::GetClientFlushPolicy() {
+    return {};
+}
+
 void WireTest::SetUp() {
     DawnProcTable mockProcs;
     api.GetProcTable(&mockProcs);
@@ -62,6 +66,7 @@ void WireTest::SetUp() {
     dawn::wire::WireClientDescriptor clientDesc = {};
     clientDesc.serializer = mC2sBuf.get();
     clientDesc.memoryTransferService = GetClientMemoryTransferService();
+    clientDesc.flushPolicy = GetClientFlushPolicy();
 
     mWireClient.reset(new dawn::wire::WireClient(clientDesc));
     mS2cBuf->SetHandler(mWireClient.get());
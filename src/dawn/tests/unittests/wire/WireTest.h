@@ -94,6 +94,7 @@ inline testing::Matcher<const char*> ValidStringMessage() {
 
 namespace dawn::wire {
 class WireClient;
+struct WireClientFlushPolicy;
 class WireServer;
 namespace client {
 class MemoryTransferService;
@@ -137,6 +138,7 @@ class WireTest : public testing::Test {
 
     virtual dawn::wire::client::MemoryTransferService* GetClientMemoryTransferService();
     virtual dawn::wire::server::MemoryTransferService* GetServerMemoryTransferService();
+    virtual dawn::wire::WireClientFlushPolicy GetClientFlushPolicy();
 
     std::unique_ptr<dawn::wire::WireServer> mWireServer;
     std::unique_ptr<dawn::wire::WireClient> mWireClient;
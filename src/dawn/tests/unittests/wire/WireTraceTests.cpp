@@ -0,0 +1,266 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/dawn_proc.h"
+#include "dawn/dawn_proc_table.h"
+#include "dawn/mock_webgpu.h"
+#include "dawn/utils/WireTrace.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireCmd_autogen.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::NotNull;
+using testing::Return;
+using testing::StrictMock;
+
+// A CommandSerializer that appends the commands of the client to a vector.
+class RecordingCommandSerializer : public CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        size_t offset = mData.size();
+        mData.resize(offset + size);
+        return &mData[offset];
+    }
+    bool Flush() override { return true; }
+
+    const std::vector<char>& GetData() const { return mData; }
+
+  private:
+    std::vector<char> mData;
+};
+
+class WireTraceTests : public testing::Test {
+  protected:
+    void SetUp() override { dawnProcSetProcs(&client::GetProcs()); }
+
+    void TearDown() override {
+        dawnProcSetProcs(nullptr);
+        for (const std::string& path : mFiles) {
+            std::remove(path.c_str());
+        }
+    }
+
+    // Writes the trace header followed by |commands| to a new file and returns its path.
+    std::string WriteTraceFile(const std::vector<char>& commands, size_t headerSize = 8) {
+        std::string path = testing::TempDir() + "WireTraceTests_" +
+                           testing::UnitTest::GetInstance()->current_test_info()->name() + "_" +
+                           std::to_string(mFiles.size());
+        std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        std::vector<char> header(headerSize, '\xFF');
+        file.write(header.data(), header.size());
+        file.write(commands.data(), commands.size());
+        mFiles.push_back(path);
+        return path;
+    }
+
+    // Returns the bytes of a command header with the given size and ID.
+    static std::vector<char> MakeCommandHeader(uint64_t size, WireCmd id) {
+        std::vector<char> data(sizeof(uint64_t) + sizeof(uint32_t));
+        memcpy(&data[0], &size, sizeof(size));
+        memcpy(&data[sizeof(uint64_t)], &id, sizeof(id));
+        return data;
+    }
+
+    // Returns the commands sent by a client that creates two surfaces from its first instance.
+    static std::vector<char> RecordCreateSurfaceCommands() {
+        RecordingCommandSerializer serializer;
+        WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = &serializer;
+        WireClient client(clientDesc);
+
+        ReservedInstance reservation = client.ReserveInstance();
+        EXPECT_EQ(reservation.id, 1u);
+        EXPECT_EQ(reservation.generation, 0u);
+
+        WGPUSurfaceDescriptor surfaceDesc = {};
+        wgpuSurfaceRelease(wgpuInstanceCreateSurface(reservation.instance, &surfaceDesc));
+        wgpuSurfaceRelease(wgpuInstanceCreateSurface(reservation.instance, &surfaceDesc));
+        EXPECT_TRUE(serializer.Flush());
+
+        std::vector<char> data = serializer.GetData();
+        client.Disconnect();
+        return data;
+    }
+
+    std::vector<std::string> mFiles;
+};
+
+// Test that loading a file that doesn't exist fails.
+TEST_F(WireTraceTests, LoadMissingFile) {
+    std::string path = testing::TempDir() + "WireTraceTests_missing";
+    std::remove(path.c_str());
+    EXPECT_EQ(utils::WireTrace::LoadFromFile(path.c_str()), nullptr);
+}
+
+// Test that a trace with only the header has no commands, and that a truncated header fails.
+TEST_F(WireTraceTests, LoadHeader) {
+    std::unique_ptr<utils::WireTrace> trace =
+        utils::WireTrace::LoadFromFile(WriteTraceFile({}).c_str());
+    ASSERT_NE(trace, nullptr);
+    EXPECT_TRUE(trace->GetCommands().empty());
+
+    EXPECT_EQ(utils::WireTrace::LoadFromFile(WriteTraceFile({}, 4).c_str()), nullptr);
+}
+
+// Test that traces whose last command is truncated fail to load.
+TEST_F(WireTraceTests, LoadTruncatedCommand) {
+    std::vector<char> commands = RecordCreateSurfaceCommands();
+    ASSERT_FALSE(commands.empty());
+    ASSERT_NE(utils::WireTrace::LoadFromFile(WriteTraceFile(commands).c_str()), nullptr);
+
+    // Truncated in the middle of the command header.
+    std::vector<char> truncated(commands.begin(), commands.end());
+    truncated.resize(commands.size() + 6);
+    memcpy(&truncated[commands.size()], commands.data(), 6);
+    EXPECT_EQ(utils::WireTrace::LoadFromFile(WriteTraceFile(truncated).c_str()), nullptr);
+
+    // Truncated after the command header.
+    truncated.assign(commands.begin(), commands.end() - 1);
+    EXPECT_EQ(utils::WireTrace::LoadFromFile(WriteTraceFile(truncated).c_str()), nullptr);
+}
+
+// Test that traces with commands whose size is corrupt fail to load.
+TEST_F(WireTraceTests, LoadCorruptCommandSize) {
+    // The size is smaller than the command header.
+    EXPECT_EQ(utils::WireTrace::LoadFromFile(
+                  WriteTraceFile(MakeCommandHeader(4, WireCmd::InstanceCreateSurface)).c_str()),
+              nullptr);
+
+    // The size is larger than the rest of the trace, including sizes that overflow.
+    EXPECT_EQ(utils::WireTrace::LoadFromFile(
+                  WriteTraceFile(MakeCommandHeader(64, WireCmd::InstanceCreateSurface)).c_str()),
+              nullptr);
+    EXPECT_EQ(utils::WireTrace::LoadFromFile(
+                  WriteTraceFile(MakeCommandHeader(~uint64_t(0), WireCmd::InstanceCreateSurface))
+                      .c_str()),
+              nullptr);
+}
+
+// Test that a recorded trace is split into its commands.
+TEST_F(WireTraceTests, LoadCommands) {
+    std::vector<char> commands = RecordCreateSurfaceCommands();
+    std::unique_ptr<utils::WireTrace> trace =
+        utils::WireTrace::LoadFromFile(WriteTraceFile(commands).c_str());
+    ASSERT_NE(trace, nullptr);
+
+    // The two surface creations, then the release of both surfaces.
+    const std::vector<utils::WireTrace::Command>& traceCommands = trace->GetCommands();
+    ASSERT_EQ(traceCommands.size(), 4u);
+    EXPECT_EQ(traceCommands[0].id, static_cast<uint32_t>(WireCmd::InstanceCreateSurface));
+    EXPECT_EQ(traceCommands[1].id, static_cast<uint32_t>(WireCmd::DestroyObject));
+    EXPECT_EQ(traceCommands[2].id, static_cast<uint32_t>(WireCmd::InstanceCreateSurface));
+    EXPECT_EQ(traceCommands[3].id, static_cast<uint32_t>(WireCmd::DestroyObject));
+
+    size_t offset = 8;
+    for (const utils::WireTrace::Command& command : traceCommands) {
+        EXPECT_EQ(command.offset, offset);
+        EXPECT_EQ(memcmp(trace->GetCommandData(command), &commands[offset - 8], command.size), 0);
+        offset += command.size;
+    }
+    EXPECT_EQ(offset, commands.size() + 8);
+}
+
+// Test that replaying a trace calls the procs with the injected instance and accumulates the
+// statistics of each command.
+TEST_F(WireTraceTests, Replay) {
+    std::unique_ptr<utils::WireTrace> trace =
+        utils::WireTrace::LoadFromFile(WriteTraceFile(RecordCreateSurfaceCommands()).c_str());
+    ASSERT_NE(trace, nullptr);
+
+    StrictMock<MockProcTable> api;
+    DawnProcTable procs;
+    api.GetProcTable(&procs);
+
+    WGPUInstance instance = api.GetNewInstance();
+    WGPUSurface surface1 = api.GetNewSurface();
+    WGPUSurface surface2 = api.GetNewSurface();
+    EXPECT_CALL(api, InstanceReference(instance));
+    EXPECT_CALL(api, InstanceCreateSurface(instance, NotNull()))
+        .WillOnce(Return(surface1))
+        .WillOnce(Return(surface2));
+    EXPECT_CALL(api, SurfaceRelease(surface1));
+    EXPECT_CALL(api, SurfaceRelease(surface2));
+    EXPECT_CALL(api, InstanceRelease(instance));
+
+    std::vector<utils::WireReplayCommandStats> stats;
+    ASSERT_TRUE(utils::ReplayWireTrace(*trace, procs, instance, &stats));
+
+    for (size_t id = 0; id < stats.size(); ++id) {
+        uint64_t expectedCount = 0;
+        if (id == static_cast<size_t>(WireCmd::InstanceCreateSurface) ||
+            id == static_cast<size_t>(WireCmd::DestroyObject)) {
+            expectedCount = 2;
+        }
+        EXPECT_EQ(stats[id].count, expectedCount) << GetWireCommandName(id);
+        EXPECT_GE(stats[id].seconds, 0.0);
+        if (expectedCount == 0) {
+            EXPECT_EQ(stats[id].seconds, 0.0);
+        }
+    }
+    ASSERT_GT(stats.size(), static_cast<size_t>(WireCmd::InstanceCreateSurface));
+    ASSERT_GT(stats.size(), static_cast<size_t>(WireCmd::DestroyObject));
+
+    // Replaying without statistics works as well.
+    EXPECT_CALL(api, InstanceReference(instance));
+    EXPECT_CALL(api, InstanceCreateSurface(instance, NotNull()))
+        .WillOnce(Return(surface1))
+        .WillOnce(Return(surface2));
+    EXPECT_CALL(api, SurfaceRelease(surface1));
+    EXPECT_CALL(api, SurfaceRelease(surface2));
+    EXPECT_CALL(api, InstanceRelease(instance));
+    EXPECT_TRUE(utils::ReplayWireTrace(*trace, procs, instance));
+}
+
+// Test that the replay stops at a command that the server fails to handle.
+TEST_F(WireTraceTests, ReplayInvalidCommand) {
+    std::vector<char> commands = RecordCreateSurfaceCommands();
+    std::vector<char> invalidCommand = MakeCommandHeader(12, static_cast<WireCmd>(0xFFFF));
+    commands.insert(commands.begin(), invalidCommand.begin(), invalidCommand.end());
+
+    std::unique_ptr<utils::WireTrace> trace =
+        utils::WireTrace::LoadFromFile(WriteTraceFile(commands).c_str());
+    ASSERT_NE(trace, nullptr);
+    ASSERT_EQ(trace->GetCommands().size(), 5u);
+
+    StrictMock<MockProcTable> api;
+    DawnProcTable procs;
+    api.GetProcTable(&procs);
+
+    // None of the commands after the invalid one are handled.
+    WGPUInstance instance = api.GetNewInstance();
+    EXPECT_CALL(api, InstanceReference(instance));
+    EXPECT_CALL(api, InstanceCreateSurface(_, _)).Times(0);
+    EXPECT_CALL(api, InstanceRelease(instance));
+
+    std::vector<utils::WireReplayCommandStats> stats;
+    EXPECT_FALSE(utils::ReplayWireTrace(*trace, procs, instance, &stats));
+    if (stats.size() > static_cast<size_t>(WireCmd::InstanceCreateSurface)) {
+        EXPECT_EQ(stats[static_cast<size_t>(WireCmd::InstanceCreateSurface)].count, 0u);
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
@@ -0,0 +1,428 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/SharedMemoryRing.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <new>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace utils {
+
+namespace {
+
+constexpr uint32_t kRingMagic = 0x474e4952;  // "RING"
+constexpr uint32_t kRingVersion = 1;
+
+// The ring data starts on the page following the header.
+constexpr size_t kHeaderSize = 4096;
+constexpr size_t kMinCapacity = 4096;
+constexpr size_t kMaxCapacity = size_t(1) << 30;
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kSegmentAlignment = 8;
+
+enum class SegmentKind : uint32_t {
+    Commands = 1,
+    Padding = 2,
+};
+
+struct SegmentHeader {
+    uint32_t size;
+    SegmentKind kind;
+};
+static_assert(sizeof(SegmentHeader) == kSegmentAlignment);
+
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    // The futex isn't private since it is shared between processes. Spurious wakeups, including
+    // EINTR and EAGAIN when the value already changed, are handled by the callers' loops.
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, nullptr, nullptr,
+            0);
+}
+
+void FutexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr,
+            0);
+}
+
+}  // anonymous namespace
+
+// The header of the ring in shared memory. The offsets are monotonic counts of bytes since the
+// creation of the ring and the sequences are the futex words on which each side sleeps. Members
+// written by different sides are on different cache lines to avoid false sharing.
+struct SharedMemoryRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+
+    // Written by the producer.
+    alignas(kCacheLineSize) std::atomic<uint64_t> writeOffset;
+    std::atomic<uint32_t> dataSequence;
+    std::atomic<uint32_t> consumerWaiting;
+
+    // Written by the consumer.
+    alignas(kCacheLineSize) std::atomic<uint64_t> readOffset;
+    std::atomic<uint32_t> spaceSequence;
+    std::atomic<uint32_t> producerWaiting;
+
+    alignas(kCacheLineSize) std::atomic<uint32_t> closed;
+};
+static_assert(sizeof(SharedMemoryRingHeader) <= kHeaderSize);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+// SharedMemoryRing
+
+// static
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::Create(size_t capacity) {
+    int fd = memfd_create("dawn_wire_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return nullptr;
+    }
+    return CreateInFd(fd, capacity);
+}
+
+// static
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::CreateInFd(int fd, size_t capacity) {
+    if (capacity > kMaxCapacity) {
+        close(fd);
+        return nullptr;
+    }
+    capacity = std::max(static_cast<size_t>(NextPowerOfTwo(capacity)), kMinCapacity);
+
+    // Seal the size so that the other process can't get SIGBUS when accessing the mapping.
+    size_t mappingSize = kHeaderSize + capacity;
+    if (ftruncate(fd, mappingSize) != 0 ||
+        fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+
+    SharedMemoryRingHeader* header = new (mapping) SharedMemoryRingHeader();
+    header->magic = kRingMagic;
+    header->version = kRingVersion;
+    header->capacity = capacity;
+
+    return std::unique_ptr<SharedMemoryRing>(
+        new SharedMemoryRing(fd, mapping, mappingSize, capacity));
+}
+
+// static
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::Open(int fd) {
+    // The file must be sealed against shrinking, otherwise the other process could truncate it
+    // and make accesses to the mapping raise SIGBUS.
+    struct stat fileStat;
+    int seals = fcntl(fd, F_GET_SEALS);
+    if (seals < 0 || (seals & F_SEAL_SHRINK) == 0 || fstat(fd, &fileStat) != 0 ||
+        fileStat.st_size < 0 ||
+        static_cast<uint64_t>(fileStat.st_size) < kHeaderSize + kMinCapacity ||
+        static_cast<uint64_t>(fileStat.st_size) > kHeaderSize + kMaxCapacity) {
+        close(fd);
+        return nullptr;
+    }
+    size_t mappingSize = static_cast<size_t>(fileStat.st_size);
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+
+    // The capacity is read only once here since the other process could change it later.
+    const SharedMemoryRingHeader* header = static_cast<const SharedMemoryRingHeader*>(mapping);
+    uint64_t capacity = header->capacity;
+    if (header->magic != kRingMagic || header->version != kRingVersion ||
+        !IsPowerOfTwo(capacity) || kHeaderSize + capacity != mappingSize) {
+        munmap(mapping, mappingSize);
+        close(fd);
+        return nullptr;
+    }
+
+    return std::unique_ptr<SharedMemoryRing>(
+        new SharedMemoryRing(fd, mapping, mappingSize, static_cast<size_t>(capacity)));
+}
+
+SharedMemoryRing::SharedMemoryRing(int fd, void* mapping, size_t mappingSize, size_t capacity)
+    : mFd(fd), mMapping(mapping), mMappingSize(mappingSize), mCapacity(capacity) {}
+
+SharedMemoryRing::~SharedMemoryRing() {
+    munmap(mMapping, mMappingSize);
+    close(mFd);
+}
+
+int SharedMemoryRing::GetFd() const {
+    return mFd;
+}
+
+size_t SharedMemoryRing::GetCapacity() const {
+    return mCapacity;
+}
+
+void SharedMemoryRing::Close() {
+    SharedMemoryRingHeader* header = GetHeader();
+    header->closed.store(1);
+    header->dataSequence.fetch_add(1);
+    header->spaceSequence.fetch_add(1);
+    FutexWake(&header->dataSequence);
+    FutexWake(&header->spaceSequence);
+}
+
+bool SharedMemoryRing::IsClosed() const {
+    return GetHeader()->closed.load(std::memory_order_acquire) != 0;
+}
+
+SharedMemoryRingHeader* SharedMemoryRing::GetHeader() const {
+    return static_cast<SharedMemoryRingHeader*>(mMapping);
+}
+
+char* SharedMemoryRing::GetData() const {
+    return static_cast<char*>(mMapping) + kHeaderSize;
+}
+
+// SharedMemoryRingSerializer
+
+SharedMemoryRingSerializer::SharedMemoryRingSerializer(SharedMemoryRing* ring) : mRing(ring) {}
+
+SharedMemoryRingSerializer::~SharedMemoryRingSerializer() = default;
+
+size_t SharedMemoryRingSerializer::GetMaximumAllocationSize() const {
+    return mRing->GetCapacity() / 2 - sizeof(SegmentHeader);
+}
+
+void* SharedMemoryRingSerializer::GetCmdSpace(size_t size) {
+    // Note: This returns non-null even if size is zero.
+    if (size > GetMaximumAllocationSize()) {
+        return nullptr;
+    }
+
+    const size_t capacity = mRing->GetCapacity();
+    SharedMemoryRingHeader* header = mRing->GetHeader();
+
+    // Append to the current segment if the allocation fits before the end of the ring and
+    // there is enough free space. Otherwise finish the segment and start a new one.
+    if (mHasSegment) {
+        uint64_t ringEnd = mSegmentOffset - (mSegmentOffset & (capacity - 1)) + capacity;
+        uint64_t readOffset = header->readOffset.load(std::memory_order_acquire);
+        if (mWriteOffset + size <= ringEnd && readOffset <= mPublishedOffset &&
+            mWriteOffset + size - readOffset <= capacity) {
+            char* result = mRing->GetData() + (mWriteOffset & (capacity - 1));
+            mWriteOffset += size;
+            return result;
+        }
+        FinishSegment();
+    }
+
+    // Skip the end of the ring with a padding segment if the new segment doesn't fit before it.
+    size_t position = mWriteOffset & (capacity - 1);
+    size_t remaining = capacity - position;
+    if (remaining < sizeof(SegmentHeader) + size) {
+        if (!WaitForFreeSpace(remaining)) {
+            return nullptr;
+        }
+        ASSERT(remaining >= sizeof(SegmentHeader));
+        SegmentHeader padding = {0, SegmentKind::Padding};
+        memcpy(mRing->GetData() + position, &padding, sizeof(padding));
+        mWriteOffset += remaining;
+        position = 0;
+    }
+
+    if (!WaitForFreeSpace(sizeof(SegmentHeader) + size)) {
+        return nullptr;
+    }
+    mSegmentOffset = mWriteOffset;
+    mHasSegment = true;
+    mWriteOffset += sizeof(SegmentHeader) + size;
+    return mRing->GetData() + position + sizeof(SegmentHeader);
+}
+
+bool SharedMemoryRingSerializer::Flush() {
+    if (mRing->IsClosed()) {
+        return false;
+    }
+    if (mHasSegment) {
+        FinishSegment();
+    }
+    Publish();
+    return true;
+}
+
+void SharedMemoryRingSerializer::FinishSegment() {
+    ASSERT(mHasSegment);
+    SegmentHeader segment;
+    segment.size = static_cast<uint32_t>(mWriteOffset - mSegmentOffset - sizeof(SegmentHeader));
+    segment.kind = SegmentKind::Commands;
+    memcpy(mRing->GetData() + (mSegmentOffset & (mRing->GetCapacity() - 1)), &segment,
+           sizeof(segment));
+
+    mWriteOffset = Align(mWriteOffset, kSegmentAlignment);
+    mHasSegment = false;
+}
+
+void SharedMemoryRingSerializer::Publish() {
+    ASSERT(!mHasSegment);
+    if (mPublishedOffset == mWriteOffset) {
+        return;
+    }
+
+    // The sequential consistency of the stores and loads of the offsets, sequences and waiting
+    // flags on both sides guarantees that either the consumer sees the new offset before
+    // sleeping, or the producer sees that it needs to wake it up.
+    SharedMemoryRingHeader* header = mRing->GetHeader();
+    header->writeOffset.store(mWriteOffset);
+    mPublishedOffset = mWriteOffset;
+    header->dataSequence.fetch_add(1);
+    if (header->consumerWaiting.load() != 0) {
+        FutexWake(&header->dataSequence);
+    }
+}
+
+bool SharedMemoryRingSerializer::WaitForFreeSpace(size_t size) {
+    ASSERT(!mHasSegment);
+    const size_t capacity = mRing->GetCapacity();
+    SharedMemoryRingHeader* header = mRing->GetHeader();
+
+    while (true) {
+        if (mRing->IsClosed()) {
+            return false;
+        }
+        uint64_t readOffset = header->readOffset.load(std::memory_order_acquire);
+        if (readOffset > mPublishedOffset) {
+            // The consumer can't have read commands that weren't published.
+            return false;
+        }
+        if (mWriteOffset + size - readOffset <= capacity) {
+            return true;
+        }
+
+        // The ring is full. Let the consumer drain it and sleep until it frees some space.
+        Publish();
+        header->producerWaiting.store(1);
+        uint32_t sequence = header->spaceSequence.load();
+        if (mWriteOffset + size - header->readOffset.load() > capacity &&
+            header->closed.load() == 0) {
+            FutexWait(&header->spaceSequence, sequence);
+        }
+        header->producerWaiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+// SharedMemoryRingReader
+
+SharedMemoryRingReader::SharedMemoryRingReader(SharedMemoryRing* ring,
+                                               dawn::wire::CommandHandler* handler)
+    : mRing(ring), mHandler(handler) {}
+
+SharedMemoryRingReader::~SharedMemoryRingReader() = default;
+
+bool SharedMemoryRingReader::HandleCommands() {
+    const size_t capacity = mRing->GetCapacity();
+    SharedMemoryRingHeader* header = mRing->GetHeader();
+    const volatile char* data = mRing->GetData();
+
+    uint64_t writeOffset = header->writeOffset.load(std::memory_order_acquire);
+    if (writeOffset < mReadOffset || writeOffset - mReadOffset > capacity ||
+        writeOffset % kSegmentAlignment != 0) {
+        return false;
+    }
+
+    while (mReadOffset != writeOffset) {
+        size_t position = mReadOffset & (capacity - 1);
+        size_t remaining = capacity - position;
+        uint64_t available = writeOffset - mReadOffset;
+        if (available < sizeof(SegmentHeader)) {
+            return false;
+        }
+
+        // Read the segment header only once since the producer could modify it concurrently.
+        const volatile SegmentHeader* segmentHeader =
+            reinterpret_cast<const volatile SegmentHeader*>(data + position);
+        uint32_t segmentSize = segmentHeader->size;
+        SegmentKind segmentKind = segmentHeader->kind;
+
+        uint64_t consumedSize;
+        switch (segmentKind) {
+            case SegmentKind::Padding:
+                consumedSize = remaining;
+                break;
+            case SegmentKind::Commands:
+                if (segmentSize > remaining - sizeof(SegmentHeader)) {
+                    return false;
+                }
+                consumedSize = Align(sizeof(SegmentHeader) + segmentSize, kSegmentAlignment);
+                break;
+            default:
+                return false;
+        }
+        if (consumedSize > available) {
+            return false;
+        }
+
+        if (segmentKind == SegmentKind::Commands && segmentSize > 0 &&
+            mHandler->HandleCommands(data + position + sizeof(SegmentHeader), segmentSize) ==
+                nullptr) {
+            return false;
+        }
+
+        // Release the space of each segment as soon as it is handled so that a producer waiting
+        // for space can continue while the next segments are handled.
+        mReadOffset += consumedSize;
+        header->readOffset.store(mReadOffset);
+        header->spaceSequence.fetch_add(1);
+        if (header->producerWaiting.load() != 0) {
+            FutexWake(&header->spaceSequence);
+        }
+    }
+    return true;
+}
+
+bool SharedMemoryRingReader::WaitForCommands() {
+    SharedMemoryRingHeader* header = mRing->GetHeader();
+    while (true) {
+        if (HasCommands()) {
+            return true;
+        }
+        if (mRing->IsClosed()) {
+            return HasCommands();
+        }
+
+        header->consumerWaiting.store(1);
+        uint32_t sequence = header->dataSequence.load();
+        if (!HasCommands() && header->closed.load() == 0) {
+            FutexWait(&header->dataSequence, sequence);
+        }
+        header->consumerWaiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool SharedMemoryRingReader::HasCommands() const {
+    return mRing->GetHeader()->writeOffset.load() != mReadOffset;
+}
+
+}  // namespace utils
@@ -0,0 +1,140 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYRING_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYRING_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+
+namespace utils {
+
+struct SharedMemoryRingHeader;
+
+// A single-producer/single-consumer ring buffer of wire commands in shared memory, used to
+// transport the commands of a WireClient to a WireServer (or the return commands in the other
+// direction) in another process without copying them through a socket. Only available on Linux.
+//
+// The commands are serialized directly in the ring by a SharedMemoryRingSerializer and handled
+// directly from the ring by a SharedMemoryRingReader. They are stored in segments of contiguous
+// commands, each prefixed by a small header. Segments never wrap around the end of the ring:
+// when an allocation doesn't fit before the end, the rest of the ring is skipped with a padding
+// segment. Allocations are limited to half of the ring so that they always fit once the ring is
+// drained, and ChunkedCommandSerializer splits larger commands into chunks of that size.
+//
+// The producer and the consumer sleep on futexes in the shared memory when the ring is
+// respectively full or empty, and are only woken up with a system call when they are sleeping.
+class SharedMemoryRing {
+  public:
+    // Creates a ring with a new memfd of |capacity| bytes of ring data, rounded up to a power of
+    // two. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemoryRing> Create(size_t capacity);
+    // Same as Create but resizes, seals and initializes an existing memfd, which must have been
+    // created with MFD_ALLOW_SEALING. Takes ownership of |fd|.
+    static std::unique_ptr<SharedMemoryRing> CreateInFd(int fd, size_t capacity);
+    // Maps the ring in the shared memory file descriptor |fd|, for example a memfd received from
+    // the process that created the ring. Takes ownership of |fd|. Returns nullptr if |fd|
+    // doesn't contain a valid ring or isn't sealed against shrinking.
+    static std::unique_ptr<SharedMemoryRing> Open(int fd);
+
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    // The file descriptor of the shared memory, to send to the other process.
+    int GetFd() const;
+    size_t GetCapacity() const;
+
+    // Marks the ring as closed and wakes up both sides. Once closed, the producer fails to
+    // allocate and the consumer stops waiting after handling the remaining commands.
+    void Close();
+    bool IsClosed() const;
+
+  private:
+    friend class SharedMemoryRingSerializer;
+    friend class SharedMemoryRingReader;
+
+    SharedMemoryRing(int fd, void* mapping, size_t mappingSize, size_t capacity);
+
+    SharedMemoryRingHeader* GetHeader() const;
+    char* GetData() const;
+
+    int mFd;
+    void* mMapping;
+    size_t mMappingSize;
+    size_t mCapacity;
+};
+
+// The producer side of a SharedMemoryRing. GetCmdSpace returns memory in the ring and Flush
+// publishes the commands to the consumer. GetCmdSpace blocks while the ring is full, so the
+// consumer must run on another thread or process.
+class SharedMemoryRingSerializer : public dawn::wire::CommandSerializer {
+  public:
+    explicit SharedMemoryRingSerializer(SharedMemoryRing* ring);
+    ~SharedMemoryRingSerializer() override;
+
+    size_t GetMaximumAllocationSize() const override;
+
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+
+  private:
+    // Writes the header of the segment being serialized.
+    void FinishSegment();
+    // Makes the finished segments visible to the consumer.
+    void Publish();
+    // Waits until |size| bytes after mWriteOffset are free, publishing the finished segments
+    // first so that the consumer can make progress. Returns false if the ring is closed.
+    bool WaitForFreeSpace(size_t size);
+
+    SharedMemoryRing* mRing;
+    // Monotonic offsets in bytes written to the ring since its creation.
+    uint64_t mWriteOffset = 0;
+    uint64_t mPublishedOffset = 0;
+    // The offset of the header of the segment being serialized, if any.
+    uint64_t mSegmentOffset;
+    bool mHasSegment = false;
+};
+
+// The consumer side of a SharedMemoryRing, which passes the commands to a CommandHandler.
+//
+// The content of the shared memory is untrusted: the segment headers and offsets are validated
+// and the commands are given to the handler as volatile memory, as with any other transport.
+class SharedMemoryRingReader {
+  public:
+    SharedMemoryRingReader(SharedMemoryRing* ring, dawn::wire::CommandHandler* handler);
+    ~SharedMemoryRingReader();
+
+    // Handles all the commands published so far. Returns false if the ring is corrupted or if
+    // the handler failed to handle the commands.
+    bool HandleCommands();
+
+    // Blocks until some commands are published or the ring is closed. Returns false if the ring
+    // is closed and there are no commands left to handle.
+    bool WaitForCommands();
+
+  private:
+    bool HasCommands() const;
+
+    SharedMemoryRing* mRing;
+    dawn::wire::CommandHandler* mHandler;
+    uint64_t mReadOffset = 0;
+};
+
+}  // namespace utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYRING_H_
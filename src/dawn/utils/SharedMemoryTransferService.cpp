@@ -0,0 +1,311 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/SharedMemoryTransferService.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+
+namespace utils {
+
+namespace {
+
+// The data serialized in the commands creating the handles.
+struct SharedMemoryHandleInfo {
+    uint64_t regionId;
+};
+
+// A mapping can't be empty, so empty regions map a single byte.
+size_t GetMappingSize(size_t size) {
+    return std::max(size, size_t(1));
+}
+
+bool IsRangeInRegion(const SharedMemoryRegion* region, size_t offset, size_t size) {
+    return offset <= region->GetSize() && size <= region->GetSize() - offset;
+}
+
+class ClientReadHandle : public dawn::wire::client::MemoryTransferService::ReadHandle {
+  public:
+    ClientReadHandle(std::unique_ptr<SharedMemoryRegion> region, uint64_t id)
+        : mRegion(std::move(region)), mId(id) {}
+    ~ClientReadHandle() override = default;
+
+    size_t SerializeCreateSize() override { return sizeof(SharedMemoryHandleInfo); }
+
+    void SerializeCreate(void* serializePointer) override {
+        SharedMemoryHandleInfo info = {mId};
+        memcpy(serializePointer, &info, sizeof(info));
+    }
+
+    const void* GetData() override { return mRegion->GetData(); }
+
+    bool DeserializeDataUpdate(const void* deserializePointer,
+                               size_t deserializeSize,
+                               size_t offset,
+                               size_t size) override {
+        // The server already wrote the data in the region.
+        return deserializeSize == 0 && IsRangeInRegion(mRegion.get(), offset, size);
+    }
+
+  private:
+    std::unique_ptr<SharedMemoryRegion> mRegion;
+    uint64_t mId;
+};
+
+class ClientWriteHandle : public dawn::wire::client::MemoryTransferService::WriteHandle {
+  public:
+    ClientWriteHandle(std::unique_ptr<SharedMemoryRegion> region, uint64_t id)
+        : mRegion(std::move(region)), mId(id) {}
+    ~ClientWriteHandle() override = default;
+
+    size_t SerializeCreateSize() override { return sizeof(SharedMemoryHandleInfo); }
+
+    void SerializeCreate(void* serializePointer) override {
+        SharedMemoryHandleInfo info = {mId};
+        memcpy(serializePointer, &info, sizeof(info));
+    }
+
+    void* GetData() override { return mRegion->GetData(); }
+
+    size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+        ASSERT(IsRangeInRegion(mRegion.get(), offset, size));
+        return 0;
+    }
+
+    void SerializeDataUpdate(void* serializePointer, size_t offset, size_t size) override {
+        // The server reads the data directly from the region.
+        ASSERT(IsRangeInRegion(mRegion.get(), offset, size));
+    }
+
+  private:
+    std::unique_ptr<SharedMemoryRegion> mRegion;
+    uint64_t mId;
+};
+
+class ServerReadHandle : public dawn::wire::server::MemoryTransferService::ReadHandle {
+  public:
+    explicit ServerReadHandle(std::unique_ptr<SharedMemoryRegion> region)
+        : mRegion(std::move(region)) {}
+    ~ServerReadHandle() override = default;
+
+    size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override { return 0; }
+
+    void SerializeDataUpdate(const void* data,
+                             size_t offset,
+                             size_t size,
+                             void* serializePointer) override {
+        // The range is validated against the buffer but the region could be smaller if the
+        // client lied about its size. Ignore the update in that case since only that client
+        // would see the missing data.
+        if (IsRangeInRegion(mRegion.get(), offset, size)) {
+            memcpy(static_cast<char*>(mRegion->GetData()) + offset, data, size);
+        }
+    }
+
+  private:
+    std::unique_ptr<SharedMemoryRegion> mRegion;
+};
+
+class ServerWriteHandle : public dawn::wire::server::MemoryTransferService::WriteHandle {
+  public:
+    explicit ServerWriteHandle(std::unique_ptr<SharedMemoryRegion> region)
+        : mRegion(std::move(region)) {}
+    ~ServerWriteHandle() override = default;
+
+    bool DeserializeDataUpdate(const void* deserializePointer,
+                               size_t deserializeSize,
+                               size_t offset,
+                               size_t size) override {
+        if (deserializeSize != 0 || mTargetData == nullptr) {
+            return false;
+        }
+        if (offset > mDataLength || size > mDataLength - offset ||
+            !IsRangeInRegion(mRegion.get(), offset, size)) {
+            return false;
+        }
+        // The client could still be writing to the region, which only affects the contents of
+        // its own buffer.
+        memcpy(static_cast<char*>(mTargetData) + offset,
+               static_cast<const char*>(mRegion->GetData()) + offset, size);
+        return true;
+    }
+
+  private:
+    std::unique_ptr<SharedMemoryRegion> mRegion;
+};
+
+}  // anonymous namespace
+
+// SharedMemoryRegion
+
+// static
+std::unique_ptr<SharedMemoryRegion> SharedMemoryRegion::Create(size_t size) {
+    int fd = memfd_create("dawn_wire_transfer", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return nullptr;
+    }
+    // Seal the size so that the other process can't get SIGBUS when accessing the mapping.
+    if (ftruncate(fd, GetMappingSize(size)) != 0 ||
+        fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    return Open(fd, size);
+}
+
+// static
+std::unique_ptr<SharedMemoryRegion> SharedMemoryRegion::Open(int fd, size_t size) {
+    struct stat fileStat;
+    int seals = fcntl(fd, F_GET_SEALS);
+    if (seals < 0 || (seals & F_SEAL_SHRINK) == 0 || fstat(fd, &fileStat) != 0 ||
+        fileStat.st_size < 0 || static_cast<uint64_t>(fileStat.st_size) < GetMappingSize(size)) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* mapping =
+        mmap(nullptr, GetMappingSize(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryRegion>(new SharedMemoryRegion(fd, mapping, size));
+}
+
+SharedMemoryRegion::SharedMemoryRegion(int fd, void* mapping, size_t size)
+    : mFd(fd), mMapping(mapping), mSize(size) {}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    munmap(mMapping, GetMappingSize(mSize));
+    close(mFd);
+}
+
+int SharedMemoryRegion::GetFd() const {
+    return mFd;
+}
+
+size_t SharedMemoryRegion::GetSize() const {
+    return mSize;
+}
+
+void* SharedMemoryRegion::GetData() const {
+    return mMapping;
+}
+
+// SharedMemoryClientTransferService
+
+SharedMemoryClientTransferService::SharedMemoryClientTransferService(ExportRegionFn exportRegion)
+    : mExportRegion(std::move(exportRegion)) {}
+
+SharedMemoryClientTransferService::~SharedMemoryClientTransferService() = default;
+
+SharedMemoryClientTransferService::ReadHandle* SharedMemoryClientTransferService::CreateReadHandle(
+    size_t size) {
+    uint64_t id;
+    std::unique_ptr<SharedMemoryRegion> region = CreateAndExportRegion(size, &id);
+    if (region == nullptr) {
+        return nullptr;
+    }
+    return new ClientReadHandle(std::move(region), id);
+}
+
+SharedMemoryClientTransferService::WriteHandle*
+SharedMemoryClientTransferService::CreateWriteHandle(size_t size) {
+    uint64_t id;
+    std::unique_ptr<SharedMemoryRegion> region = CreateAndExportRegion(size, &id);
+    if (region == nullptr) {
+        return nullptr;
+    }
+    return new ClientWriteHandle(std::move(region), id);
+}
+
+std::unique_ptr<SharedMemoryRegion> SharedMemoryClientTransferService::CreateAndExportRegion(
+    size_t size,
+    uint64_t* id) {
+    std::unique_ptr<SharedMemoryRegion> region = SharedMemoryRegion::Create(size);
+    if (region == nullptr) {
+        return nullptr;
+    }
+    *id = mNextRegionId++;
+    if (!mExportRegion(*id, region->GetFd(), size)) {
+        return nullptr;
+    }
+    return region;
+}
+
+// SharedMemoryServerTransferService
+
+SharedMemoryServerTransferService::SharedMemoryServerTransferService() = default;
+
+SharedMemoryServerTransferService::~SharedMemoryServerTransferService() = default;
+
+bool SharedMemoryServerTransferService::ImportRegion(uint64_t id, int fd, size_t size) {
+    std::unique_ptr<SharedMemoryRegion> region = SharedMemoryRegion::Open(fd, size);
+    if (region == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRegions.emplace(id, std::move(region)).second;
+}
+
+bool SharedMemoryServerTransferService::DeserializeReadHandle(const void* deserializePointer,
+                                                              size_t deserializeSize,
+                                                              ReadHandle** readHandle) {
+    std::unique_ptr<SharedMemoryRegion> region = TakeRegion(deserializePointer, deserializeSize);
+    if (region == nullptr) {
+        return false;
+    }
+    *readHandle = new ServerReadHandle(std::move(region));
+    return true;
+}
+
+bool SharedMemoryServerTransferService::DeserializeWriteHandle(const void* deserializePointer,
+                                                               size_t deserializeSize,
+                                                               WriteHandle** writeHandle) {
+    std::unique_ptr<SharedMemoryRegion> region = TakeRegion(deserializePointer, deserializeSize);
+    if (region == nullptr) {
+        return false;
+    }
+    *writeHandle = new ServerWriteHandle(std::move(region));
+    return true;
+}
+
+std::unique_ptr<SharedMemoryRegion> SharedMemoryServerTransferService::TakeRegion(
+    const void* deserializePointer,
+    size_t deserializeSize) {
+    if (deserializeSize != sizeof(SharedMemoryHandleInfo) || deserializePointer == nullptr) {
+        return nullptr;
+    }
+    SharedMemoryHandleInfo info;
+    memcpy(&info, deserializePointer, sizeof(info));
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mRegions.find(info.regionId);
+    if (it == mRegions.end()) {
+        return nullptr;
+    }
+    std::unique_ptr<SharedMemoryRegion> region = std::move(it->second);
+    mRegions.erase(it);
+    return region;
+}
+
+}  // namespace utils
@@ -0,0 +1,117 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace utils {
+
+// A mapping of a sealed memfd whose size can't change, so that the process it is sent to can
+// safely map it. Only available on Linux.
+class SharedMemoryRegion {
+  public:
+    // Creates a zero-initialized region of |size| bytes. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemoryRegion> Create(size_t size);
+    // Maps the region of |size| bytes in |fd|, which must be sealed against shrinking. Takes
+    // ownership of |fd|. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemoryRegion> Open(int fd, size_t size);
+
+    ~SharedMemoryRegion();
+
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    int GetFd() const;
+    size_t GetSize() const;
+    void* GetData() const;
+
+  private:
+    SharedMemoryRegion(int fd, void* mapping, size_t size);
+
+    int mFd;
+    void* mMapping;
+    size_t mSize;
+};
+
+// A client::MemoryTransferService in which each read and write handle is a SharedMemoryRegion
+// mapped by both the client and the server, so that the contents of mapped buffers don't go
+// through the command stream. Only the ID of the region is serialized in the commands creating
+// the handles, and the data updates are empty.
+//
+// The embedder sends the regions to the server out of band with |exportRegion|, for example
+// with SCM_RIGHTS on a Unix socket, and gives them to the server's
+// SharedMemoryServerTransferService::ImportRegion. This must happen before the server handles
+// the commands creating the handles, typically before the next flush of the client.
+class SharedMemoryClientTransferService : public dawn::wire::client::MemoryTransferService {
+  public:
+    // Called with the ID, file descriptor and size of each new region. |fd| is only valid for
+    // the duration of the call. Returns false if the region couldn't be exported, which makes
+    // the creation of the handle fail.
+    using ExportRegionFn = std::function<bool(uint64_t id, int fd, size_t size)>;
+
+    explicit SharedMemoryClientTransferService(ExportRegionFn exportRegion);
+    ~SharedMemoryClientTransferService() override;
+
+    ReadHandle* CreateReadHandle(size_t size) override;
+    WriteHandle* CreateWriteHandle(size_t size) override;
+
+  private:
+    std::unique_ptr<SharedMemoryRegion> CreateAndExportRegion(size_t size, uint64_t* id);
+
+    ExportRegionFn mExportRegion;
+    uint64_t mNextRegionId = 1;
+};
+
+// The server::MemoryTransferService matching SharedMemoryClientTransferService. The server
+// reads from and writes to the regions directly, validating the ranges against their sizes
+// since the client is untrusted.
+class SharedMemoryServerTransferService : public dawn::wire::server::MemoryTransferService {
+  public:
+    SharedMemoryServerTransferService();
+    ~SharedMemoryServerTransferService() override;
+
+    // Maps a region exported by the client, until a handle created with its ID takes it. Takes
+    // ownership of |fd|. Returns false if the region can't be mapped or if |id| was already
+    // imported. Can be called from any thread.
+    bool ImportRegion(uint64_t id, int fd, size_t size);
+
+    bool DeserializeReadHandle(const void* deserializePointer,
+                               size_t deserializeSize,
+                               ReadHandle** readHandle) override;
+    bool DeserializeWriteHandle(const void* deserializePointer,
+                                size_t deserializeSize,
+                                WriteHandle** writeHandle) override;
+
+  private:
+    std::unique_ptr<SharedMemoryRegion> TakeRegion(const void* deserializePointer,
+                                                   size_t deserializeSize);
+
+    // Protects thread safety of access to mRegions.
+    std::mutex mMutex;
+    // The imported regions that no handle uses yet.
+    std::unordered_map<uint64_t, std::unique_ptr<SharedMemoryRegion>> mRegions;
+};
+
+}  // namespace utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
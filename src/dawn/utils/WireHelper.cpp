@@ -27,6 +27,7 @@
 #include "dawn/native/DawnNative.h"
 #include "dawn/utils/TerribleCommandBuffer.h"
 #include "dawn/utils/WireHelper.h"
+#include "dawn/utils/WireTrace.h"
 #include "dawn/wire/WireClient.h"
 #include "dawn/wire/WireServer.h"
 
@@ -34,48 +35,6 @@ namespace utils {
 
 namespace {
 
-class WireServerTraceLayer : public dawn::wire::CommandHandler {
-  public:
-    WireServerTraceLayer(const char* dir, dawn::wire::CommandHandler* handler)
-        : dawn::wire::CommandHandler(), mDir(dir), mHandler(handler) {
-        const char* sep = GetPathSeparator();
-        if (mDir.size() > 0 && mDir.back() != *sep) {
-            mDir += sep;
-        }
-    }
-
-    void BeginWireTrace(const char* name) {
-        std::string filename = name;
-        // Replace slashes in gtest names with underscores so everything is in one
-        // directory.
-        std::replace(filename.begin(), filename.end(), '/', '_');
-        std::replace(filename.begin(), filename.end(), '\\', '_');
-
-        // Prepend the filename with the directory.
-        filename = mDir + filename;
-
-        ASSERT(!mFile.is_open());
-        mFile.open(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
-
-        // Write the initial 8 bytes. This means the fuzzer should never inject an
-        // error.
-        const uint64_t injectedErrorIndex = 0xFFFF'FFFF'FFFF'FFFF;
-        mFile.write(reinterpret_cast<const char*>(&injectedErrorIndex), sizeof(injectedErrorIndex));
-    }
-
-    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
-        if (mFile.is_open()) {
-            mFile.write(const_cast<const char*>(commands), size);
-        }
-        return mHandler->HandleCommands(commands, size);
-    }
-
-  private:
-    std::string mDir;
-    dawn::wire::CommandHandler* mHandler;
-    std::ofstream mFile;
-};
-
 class WireHelperDirect : public WireHelper {
   public:
     explicit WireHelperDirect(const DawnProcTable& procs) { dawnProcSetProcs(&procs); }
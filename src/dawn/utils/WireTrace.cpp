@@ -0,0 +1,190 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/WireTrace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/SystemUtils.h"
+#include "dawn/utils/Timer.h"
+#include "dawn/wire/WireServer.h"
+
+namespace utils {
+
+namespace {
+
+// The size of the injected error index at the start of the trace files.
+constexpr size_t kTraceHeaderSize = sizeof(uint64_t);
+
+// The size of the CmdHeader followed by the WireCmd at the start of each command.
+constexpr size_t kCommandHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+// Discards the server->client commands during replays, since there is no client.
+class DiscardingCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024 * 1024; }
+    void* GetCmdSpace(size_t size) override {
+        if (size > mBuffer.size()) {
+            mBuffer.resize(size);
+        }
+        return mBuffer.data();
+    }
+    bool Flush() override { return true; }
+
+  private:
+    std::vector<char> mBuffer;
+};
+
+}  // anonymous namespace
+
+// WireServerTraceLayer
+
+WireServerTraceLayer::WireServerTraceLayer(const char* dir, dawn::wire::CommandHandler* handler)
+    : dawn::wire::CommandHandler(), mDir(dir), mHandler(handler) {
+    const char* sep = GetPathSeparator();
+    if (mDir.size() > 0 && mDir.back() != *sep) {
+        mDir += sep;
+    }
+}
+
+WireServerTraceLayer::~WireServerTraceLayer() = default;
+
+void WireServerTraceLayer::BeginWireTrace(const char* name) {
+    std::string filename = name;
+    // Replace slashes in gtest names with underscores so everything is in one
+    // directory.
+    std::replace(filename.begin(), filename.end(), '/', '_');
+    std::replace(filename.begin(), filename.end(), '\\', '_');
+
+    // Prepend the filename with the directory.
+    filename = mDir + filename;
+
+    if (mFile.is_open()) {
+        mFile.close();
+    }
+    mFile.open(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    // Write the initial 8 bytes. This means the fuzzer should never inject an
+    // error.
+    const uint64_t injectedErrorIndex = 0xFFFF'FFFF'FFFF'FFFF;
+    mFile.write(reinterpret_cast<const char*>(&injectedErrorIndex), sizeof(injectedErrorIndex));
+}
+
+const volatile char* WireServerTraceLayer::HandleCommands(const volatile char* commands,
+                                                          size_t size) {
+    if (mFile.is_open()) {
+        mFile.write(const_cast<const char*>(commands), size);
+    }
+    return mHandler->HandleCommands(commands, size);
+}
+
+// WireTrace
+
+// static
+std::unique_ptr<WireTrace> WireTrace::LoadFromFile(const char* path) {
+    std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<WireTrace> trace(new WireTrace());
+    trace->mData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (trace->mData.size() < kTraceHeaderSize) {
+        return nullptr;
+    }
+
+    // Split the stream using the size at the start of each command. Commands that were
+    // serialized in chunks are contiguous in the trace so they don't need special handling.
+    size_t offset = kTraceHeaderSize;
+    while (offset < trace->mData.size()) {
+        size_t remainingSize = trace->mData.size() - offset;
+        if (remainingSize < kCommandHeaderSize) {
+            return nullptr;
+        }
+
+        uint64_t commandSize;
+        memcpy(&commandSize, &trace->mData[offset], sizeof(commandSize));
+        if (commandSize < kCommandHeaderSize || commandSize > remainingSize) {
+            return nullptr;
+        }
+
+        Command command;
+        command.offset = offset;
+        command.size = static_cast<size_t>(commandSize);
+        memcpy(&command.id, &trace->mData[offset + sizeof(uint64_t)], sizeof(command.id));
+        trace->mCommands.push_back(command);
+
+        offset += command.size;
+    }
+
+    return trace;
+}
+
+const std::vector<WireTrace::Command>& WireTrace::GetCommands() const {
+    return mCommands;
+}
+
+const char* WireTrace::GetCommandData(const Command& command) const {
+    ASSERT(command.offset + command.size <= mData.size());
+    return &mData[command.offset];
+}
+
+bool ReplayWireTrace(const WireTrace& trace,
+                     const DawnProcTable& procs,
+                     WGPUInstance instance,
+                     std::vector<WireReplayCommandStats>* stats) {
+    DiscardingCommandSerializer serializer;
+
+    dawn::wire::WireServerDescriptor serverDesc = {};
+    serverDesc.procs = &procs;
+    serverDesc.serializer = &serializer;
+
+    // Note: Deleting the server at the end of the replay releases all the objects of the trace.
+    dawn::wire::WireServer wireServer(serverDesc);
+    if (!wireServer.InjectInstance(instance, 1, 0)) {
+        return false;
+    }
+
+    std::unique_ptr<Timer> timer;
+    if (stats != nullptr) {
+        timer.reset(CreateTimer());
+    }
+
+    for (const WireTrace::Command& command : trace.GetCommands()) {
+        double startTime = 0.0;
+        if (stats != nullptr) {
+            startTime = timer->GetAbsoluteTime();
+        }
+
+        if (wireServer.HandleCommands(trace.GetCommandData(command), command.size) == nullptr) {
+            return false;
+        }
+
+        if (stats != nullptr) {
+            double duration = timer->GetAbsoluteTime() - startTime;
+            if (command.id >= stats->size()) {
+                stats->resize(command.id + 1);
+            }
+            (*stats)[command.id].count++;
+            (*stats)[command.id].seconds += duration;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace utils
@@ -0,0 +1,95 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_WIRETRACE_H_
+#define SRC_DAWN_UTILS_WIRETRACE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/webgpu.h"
+#include "dawn/wire/Wire.h"
+
+struct DawnProcTable;
+
+// Wire traces are files containing the client->server command stream of a dawn_wire session,
+// prefixed by 8 bytes that the fuzzers use as the index of the error to inject. When the client
+// uses the default inline memory transfer service, the stream also contains the data written to
+// buffers, either mapped or with Queue::WriteBuffer, so it can be replayed on its own.
+
+namespace utils {
+
+// A CommandHandler that writes the commands to the current trace file before forwarding them to
+// the WireServer.
+class WireServerTraceLayer : public dawn::wire::CommandHandler {
+  public:
+    WireServerTraceLayer(const char* dir, dawn::wire::CommandHandler* handler);
+    ~WireServerTraceLayer() override;
+
+    // Starts writing the commands to the trace file |name| in the trace directory, replacing the
+    // previous trace file if any.
+    void BeginWireTrace(const char* name);
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
+
+  private:
+    std::string mDir;
+    dawn::wire::CommandHandler* mHandler;
+    std::ofstream mFile;
+};
+
+// A wire trace loaded in memory and split into commands.
+class WireTrace {
+  public:
+    struct Command {
+        size_t offset;
+        size_t size;
+        uint32_t id;
+    };
+
+    // Returns nullptr if the file can't be read or isn't a sequence of complete commands.
+    static std::unique_ptr<WireTrace> LoadFromFile(const char* path);
+
+    const std::vector<Command>& GetCommands() const;
+    const char* GetCommandData(const Command& command) const;
+
+  private:
+    WireTrace() = default;
+
+    std::vector<char> mData;
+    std::vector<Command> mCommands;
+};
+
+// The statistics for the commands with a given ID during the replay of a wire trace.
+struct WireReplayCommandStats {
+    uint64_t count = 0;
+    double seconds = 0.0;
+};
+
+// Replays |trace| on a new WireServer calling |procs|. |instance| is injected as the instance of
+// the trace, which is the first instance reserved by the client (ID 1, generation 0). The
+// server->client commands are discarded. Returns false if the server fails to handle a command.
+// When |stats| isn't null, the time spent handling the commands is accumulated in
+// (*stats)[commandId].
+bool ReplayWireTrace(const WireTrace& trace,
+                     const DawnProcTable& procs,
+                     WGPUInstance instance,
+                     std::vector<WireReplayCommandStats>* stats = nullptr);
+
+}  // namespace utils
+
+#endif  // SRC_DAWN_UTILS_WIRETRACE_H_
@@ -16,6 +16,7 @@
 #define SRC_DAWN_WIRE_BUFFERCONSUMER_H_
 
 #include <cstddef>
+#include <vector>
 
 #include "dawn/wire/WireResult.h"
 
@@ -52,11 +53,34 @@ class BufferConsumer {
     size_t mSize;
 };
 
+// Data that is part of a serialized command but that is written in the command stream directly
+// from its source instead of being copied in the SerializeBuffer first. It goes at |offset| in
+// the bytes serialized in the SerializeBuffer.
+struct GatheredData {
+    size_t offset;
+    const char* data;
+    size_t size;
+};
+
 class SerializeBuffer : public BufferConsumer<char> {
   public:
-    using BufferConsumer::BufferConsumer;
+    SerializeBuffer(char* buffer, size_t size) : BufferConsumer(buffer, size), mStart(buffer) {}
+    // A SerializeBuffer that records the data-only members in |gatheredData| instead of copying
+    // them, so |size| only needs to be the size of the command minus its GetDataOnlySize().
+    SerializeBuffer(char* buffer, size_t size, std::vector<GatheredData>* gatheredData)
+        : BufferConsumer(buffer, size), mStart(buffer), mGatheredData(gatheredData) {}
+
     using BufferConsumer::Next;
     using BufferConsumer::NextN;
+
+    // Writes |count| elements of |data|, which must be only data, either by copying them in the
+    // buffer or by recording them as GatheredData.
+    template <typename T, typename N>
+    WireResult NextData(N count, const T* data);
+
+  private:
+    char* mStart;
+    std::vector<GatheredData>* mGatheredData = nullptr;
 };
 
 class DeserializeBuffer : public BufferConsumer<const volatile char> {
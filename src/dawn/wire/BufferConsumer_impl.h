@@ -17,6 +17,7 @@
 
 #include "dawn/wire/BufferConsumer.h"
 
+#include <cstring>
 #include <limits>
 #include <type_traits>
 
@@ -68,6 +69,29 @@ WireResult BufferConsumer<BufferT>::NextN(N count, T** data) {
     return WireResult::Success;
 }
 
+template <typename T, typename N>
+WireResult SerializeBuffer::NextData(N count, const T* data) {
+    static_assert(std::is_trivially_copyable<T>::value, "NextData is only for plain data.");
+
+    if (mGatheredData == nullptr) {
+        T* dst;
+        WIRE_TRY(NextN(count, &dst));
+        memcpy(dst, data, sizeof(T) * count);
+        return WireResult::Success;
+    }
+
+    constexpr size_t kMaxCountWithoutOverflows = std::numeric_limits<size_t>::max() / sizeof(T);
+    if (count > kMaxCountWithoutOverflows) {
+        return WireResult::FatalError;
+    }
+    size_t size = sizeof(T) * count;
+    if (size > 0) {
+        size_t offset = static_cast<size_t>(Buffer() - mStart);
+        mGatheredData->push_back({offset, reinterpret_cast<const char*>(data), size});
+    }
+    return WireResult::Success;
+}
+
 }  // namespace dawn::wire
 
 #endif  // SRC_DAWN_WIRE_BUFFERCONSUMER_IMPL_H_
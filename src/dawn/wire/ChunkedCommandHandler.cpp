@@ -47,11 +47,17 @@ const volatile char* ChunkedCommandHandler::HandleCommands(const volatile char*
             // Once the chunked command is complete, pass the data to the command handler
             // implemenation.
             auto chunkedCommandData = std::move(mChunkedCommandData);
+            size_t chunkedCommandDataSize = std::exchange(mChunkedCommandDataSize, 0);
             if (HandleCommandsImpl(chunkedCommandData.get(), mChunkedCommandPutOffset) == nullptr) {
                 // |HandleCommandsImpl| returns nullptr on error. Forward any errors
                 // out.
                 return nullptr;
             }
+            if (chunkedCommandDataSize <= kMaxRetainedChunkedCommandDataSize &&
+                mChunkedCommandData == nullptr) {
+                mChunkedCommandData = std::move(chunkedCommandData);
+                mChunkedCommandDataSize = chunkedCommandDataSize;
+            }
         }
     }
 
@@ -62,13 +68,17 @@ ChunkedCommandHandler::ChunkedCommandsResult ChunkedCommandHandler::BeginChunked
     const volatile char* commands,
     size_t commandSize,
     size_t initialSize) {
-    ASSERT(!mChunkedCommandData);
-
-    // Reserve space for all the command data we're expecting, and copy the initial data
-    // to the start of the memory.
-    mChunkedCommandData.reset(AllocNoThrow<char>(commandSize));
-    if (!mChunkedCommandData) {
-        return ChunkedCommandsResult::Error;
+    ASSERT(mChunkedCommandRemainingSize == 0);
+
+    // Reserve space for all the command data we're expecting, reusing the buffer of the previous
+    // chunked commands if possible, and copy the initial data to the start of the memory.
+    if (mChunkedCommandDataSize < commandSize) {
+        mChunkedCommandData.reset(AllocNoThrow<char>(commandSize));
+        if (!mChunkedCommandData) {
+            mChunkedCommandDataSize = 0;
+            return ChunkedCommandsResult::Error;
+        }
+        mChunkedCommandDataSize = commandSize;
     }
 
     memcpy(mChunkedCommandData.get(), const_cast<const char*>(commands), initialSize);
@@ -27,6 +27,8 @@ namespace dawn::wire {
 
 class ChunkedCommandHandler : public CommandHandler {
   public:
+    static constexpr size_t kMaxRetainedChunkedCommandDataSize = 16 * 1024 * 1024;
+
     ChunkedCommandHandler();
     ~ChunkedCommandHandler() override;
 
@@ -64,7 +66,11 @@ class ChunkedCommandHandler : public CommandHandler {
 
     size_t mChunkedCommandRemainingSize = 0;
     size_t mChunkedCommandPutOffset = 0;
+    // The buffer in which the chunks are reassembled. It is kept for the next chunked commands
+    // if it isn't larger than kMaxRetainedChunkedCommandDataSize, so that they don't need to
+    // allocate and fault in new memory.
     std::unique_ptr<char[]> mChunkedCommandData;
+    size_t mChunkedCommandDataSize = 0;
 };
 
 }  // namespace dawn::wire
@@ -14,22 +14,60 @@
 
 #include "dawn/wire/ChunkedCommandSerializer.h"
 
+#include "dawn/common/Assert.h"
+
 namespace dawn::wire {
 
 ChunkedCommandSerializer::ChunkedCommandSerializer(CommandSerializer* serializer)
     : mSerializer(serializer), mMaxAllocationSize(serializer->GetMaximumAllocationSize()) {}
 
-void ChunkedCommandSerializer::SerializeChunkedCommand(const char* allocatedBuffer,
-                                                       size_t remainingSize) {
+void ChunkedCommandSerializer::SerializeChunkedCommand(
+    const char* serialized,
+    size_t serializedSize,
+    const std::vector<GatheredData>& gatheredData,
+    size_t commandSize) {
+    // The position in |serialized| and in the gathered data to copy next.
+    size_t serializedOffset = 0;
+    size_t gatheredIndex = 0;
+    size_t gatheredOffset = 0;
+
+    size_t remainingSize = commandSize;
     while (remainingSize > 0) {
         size_t chunkSize = std::min(remainingSize, mMaxAllocationSize);
-        void* dst = mSerializer->GetCmdSpace(chunkSize);
+        char* dst = static_cast<char*>(mSerializer->GetCmdSpace(chunkSize));
         if (dst == nullptr) {
             return;
         }
-        memcpy(dst, allocatedBuffer, chunkSize);
 
-        allocatedBuffer += chunkSize;
+        // Fill the chunk with the serialized bytes up to the next gathered data, then with the
+        // gathered data, and so on.
+        size_t chunkOffset = 0;
+        while (chunkOffset < chunkSize) {
+            const char* src;
+            size_t copySize;
+            if (gatheredIndex < gatheredData.size() &&
+                gatheredData[gatheredIndex].offset == serializedOffset) {
+                const GatheredData& data = gatheredData[gatheredIndex];
+                src = data.data + gatheredOffset;
+                copySize = std::min(data.size - gatheredOffset, chunkSize - chunkOffset);
+                gatheredOffset += copySize;
+                if (gatheredOffset == data.size) {
+                    gatheredIndex++;
+                    gatheredOffset = 0;
+                }
+            } else {
+                size_t end = gatheredIndex < gatheredData.size()
+                                 ? gatheredData[gatheredIndex].offset
+                                 : serializedSize;
+                src = serialized + serializedOffset;
+                copySize = std::min(end - serializedOffset, chunkSize - chunkOffset);
+                serializedOffset += copySize;
+            }
+            ASSERT(copySize > 0);
+            memcpy(dst + chunkOffset, src, copySize);
+            chunkOffset += copySize;
+        }
+
         remainingSize -= chunkSize;
     }
 }
@@ -19,6 +19,7 @@
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/Alloc.h"
 #include "dawn/common/Compiler.h"
@@ -33,6 +34,13 @@ class ChunkedCommandSerializer {
 
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
+        if constexpr (Cmd::kFixedSize != 0) {
+            if (SerializeFixedSizeCommand(cmd, [](const Cmd& cmd, char* allocatedBuffer) {
+                    return cmd.SerializeFixedSize(allocatedBuffer);
+                })) {
+                return;
+            }
+        }
         SerializeCommand(cmd, 0, [](SerializeBuffer*) { return WireResult::Success; });
     }
 
@@ -50,6 +58,14 @@ class ChunkedCommandSerializer {
 
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd, const ObjectIdProvider& objectIdProvider) {
+        if constexpr (Cmd::kFixedSize != 0) {
+            if (SerializeFixedSizeCommand(
+                    cmd, [&objectIdProvider](const Cmd& cmd, char* allocatedBuffer) {
+                        return cmd.SerializeFixedSize(allocatedBuffer, objectIdProvider);
+                    })) {
+                return;
+            }
+        }
         SerializeCommand(cmd, objectIdProvider, 0,
                          [](SerializeBuffer*) { return WireResult::Success; });
     }
@@ -69,6 +85,22 @@ class ChunkedCommandSerializer {
     }
 
   private:
+    // Fast path for the commands whose size is known at compile time: they are written directly
+    // in the serializer's memory without computing their size or using a SerializeBuffer.
+    // Returns false if the command must be chunked instead.
+    template <typename Cmd, typename SerializeCmdFn>
+    bool SerializeFixedSizeCommand(const Cmd& cmd, SerializeCmdFn&& SerializeCmd) {
+        if (DAWN_UNLIKELY(Cmd::kFixedSize > mMaxAllocationSize)) {
+            return false;
+        }
+        char* allocatedBuffer = static_cast<char*>(mSerializer->GetCmdSpace(Cmd::kFixedSize));
+        if (allocatedBuffer != nullptr &&
+            DAWN_UNLIKELY(SerializeCmd(cmd, allocatedBuffer) != WireResult::Success)) {
+            mSerializer->OnSerializeError();
+        }
+        return true;
+    }
+
     template <typename Cmd, typename SerializeCmdFn, typename ExtraSizeSerializeFn>
     void SerializeCommandImpl(const Cmd& cmd,
                               SerializeCmdFn&& SerializeCmd,
@@ -90,21 +122,31 @@ class ChunkedCommandSerializer {
             return;
         }
 
-        auto cmdSpace = std::unique_ptr<char[]>(AllocNoThrow<char>(requiredSize));
+        // The command is too large for the serializer so it is serialized in a temporary buffer
+        // and then copied in chunks. Its data-only members, which make most of the large
+        // commands, are gathered instead and copied in the chunks directly from their source.
+        size_t serializedSize = requiredSize - cmd.GetDataOnlySize();
+        auto cmdSpace = std::unique_ptr<char[]>(AllocNoThrow<char>(serializedSize));
         if (!cmdSpace) {
             return;
         }
-        SerializeBuffer serializeBuffer(cmdSpace.get(), requiredSize);
+        std::vector<GatheredData> gatheredData;
+        SerializeBuffer serializeBuffer(cmdSpace.get(), serializedSize, &gatheredData);
         WireResult r1 = SerializeCmd(cmd, requiredSize, &serializeBuffer);
         WireResult r2 = SerializeExtraSize(&serializeBuffer);
         if (DAWN_UNLIKELY(r1 != WireResult::Success || r2 != WireResult::Success)) {
             mSerializer->OnSerializeError();
             return;
         }
-        SerializeChunkedCommand(cmdSpace.get(), requiredSize);
+        SerializeChunkedCommand(cmdSpace.get(), serializedSize, gatheredData, requiredSize);
     }
 
-    void SerializeChunkedCommand(const char* allocatedBuffer, size_t remainingSize);
+    // Writes the |commandSize| bytes of the command in chunks: the |serializedSize| bytes of
+    // |serialized| with each element of |gatheredData| inserted at its offset.
+    void SerializeChunkedCommand(const char* serialized,
+                                 size_t serializedSize,
+                                 const std::vector<GatheredData>& gatheredData,
+                                 size_t commandSize);
 
     CommandSerializer* mSerializer;
     size_t mMaxAllocationSize;
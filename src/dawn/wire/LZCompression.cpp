@@ -0,0 +1,316 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/wire/LZCompression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::wire {
+
+namespace {
+
+constexpr size_t kMinMatchLength = 4;
+constexpr size_t kMaxOffset = 0xFFFF;
+
+// The literal and match lengths are stored in the 4 bits of the token of each sequence, or as
+// 15 followed by the rest of the length in bytes of 255 ended by a smaller byte.
+constexpr size_t kTokenLengthMask = 0xF;
+constexpr uint8_t kExtraLengthContinue = 0xFF;
+
+constexpr uint32_t kHashBits = 12;
+constexpr size_t kHashTableSize = size_t(1) << kHashBits;
+
+// The positions looked up are further apart the longer there is no match, by one more byte every
+// 2^kSkipShift bytes, so that incompressible data like texture uploads is skipped quickly.
+constexpr uint32_t kSkipShift = 6;
+
+uint32_t Load32(const char* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t value) {
+    return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+// Returns the number of equal bytes at the start of |a| and |b|, up to |maxLength|.
+size_t CountMatchingBytes(const char* a, const char* b, size_t maxLength) {
+    size_t length = 0;
+    while (maxLength - length >= sizeof(uint32_t)) {
+        uint32_t difference = Load32(a + length) ^ Load32(b + length);
+        if (difference != 0) {
+            // The lowest bits are the first bytes since the wire assumes little-endian machines.
+            return length + ScanForward(difference) / 8;
+        }
+        length += sizeof(uint32_t);
+    }
+    while (length < maxLength && a[length] == b[length]) {
+        length++;
+    }
+    return length;
+}
+
+char* WriteExtraLength(char* out, size_t length) {
+    while (length >= kExtraLengthContinue) {
+        *out++ = static_cast<char>(kExtraLengthContinue);
+        length -= kExtraLengthContinue;
+    }
+    *out++ = static_cast<char>(length);
+    return out;
+}
+
+bool ReadExtraLength(const char** in, const char* end, size_t* length) {
+    uint8_t byte;
+    do {
+        if (*in == end) {
+            return false;
+        }
+        byte = static_cast<uint8_t>(*(*in)++);
+        *length += byte;
+    } while (byte == kExtraLengthContinue);
+    return true;
+}
+
+// Writes the literals followed by a match, or only the literals if |matchLength| is 0, which is
+// the last sequence of a block.
+char* WriteSequence(char* out,
+                    const char* literals,
+                    size_t literalLength,
+                    size_t offset,
+                    size_t matchLength) {
+    char* token = out++;
+    uint8_t tokenValue =
+        static_cast<uint8_t>(std::min(literalLength, kTokenLengthMask) << 4);
+    if (literalLength >= kTokenLengthMask) {
+        out = WriteExtraLength(out, literalLength - kTokenLengthMask);
+    }
+    memcpy(out, literals, literalLength);
+    out += literalLength;
+
+    if (matchLength != 0) {
+        ASSERT(matchLength >= kMinMatchLength);
+        ASSERT(offset > 0 && offset <= kMaxOffset);
+        *out++ = static_cast<char>(offset & 0xFF);
+        *out++ = static_cast<char>(offset >> 8);
+
+        size_t length = matchLength - kMinMatchLength;
+        tokenValue |= static_cast<uint8_t>(std::min(length, kTokenLengthMask));
+        if (length >= kTokenLengthMask) {
+            out = WriteExtraLength(out, length - kTokenLengthMask);
+        }
+    }
+
+    *token = static_cast<char>(tokenValue);
+    return out;
+}
+
+// Copies a match that may overlap the bytes it produces, like a run of repeated bytes.
+void CopyMatch(char* out, const char* match, size_t length) {
+    ASSERT(match < out);
+    size_t distance = static_cast<size_t>(out - match);
+    if (distance >= length) {
+        memcpy(out, match, length);
+        return;
+    }
+    size_t i = 0;
+    if (distance >= sizeof(uint64_t)) {
+        for (; length - i >= sizeof(uint64_t); i += sizeof(uint64_t)) {
+            memcpy(out + i, match + i, sizeof(uint64_t));
+        }
+    }
+    for (; i < length; ++i) {
+        out[i] = match[i];
+    }
+}
+
+uint32_t ComputeChecksum(const std::vector<char>& data) {
+    // FNV-1a
+    uint32_t checksum = 2166136261u;
+    for (char c : data) {
+        checksum = (checksum ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return checksum;
+}
+
+}  // anonymous namespace
+
+LZDictionary::LZDictionary(std::vector<char> data)
+    : mData(std::move(data)), mHashTable(kHashTableSize, 0), mChecksum(ComputeChecksum(mData)) {
+    ASSERT(mData.size() < std::numeric_limits<uint32_t>::max());
+    for (size_t position = 0; position + kMinMatchLength <= mData.size(); ++position) {
+        mHashTable[Hash(Load32(&mData[position]))] = static_cast<uint32_t>(position + 1);
+    }
+}
+
+LZDictionary::~LZDictionary() = default;
+
+const char* LZDictionary::GetData() const {
+    return mData.data();
+}
+
+size_t LZDictionary::GetSize() const {
+    return mData.size();
+}
+
+uint32_t LZDictionary::GetChecksum() const {
+    return mChecksum;
+}
+
+uint32_t LZDictionary::Find(uint32_t hash) const {
+    return mHashTable[hash];
+}
+
+LZCompressor::LZCompressor(const LZDictionary* dictionary)
+    : mDictionary(dictionary), mHashTable(kHashTableSize, 0) {}
+
+LZCompressor::~LZCompressor() = default;
+
+// static
+size_t LZCompressor::GetCompressedSizeBound(size_t size) {
+    return size + size / kExtraLengthContinue + 16;
+}
+
+size_t LZCompressor::Compress(const char* source, size_t size, char* destination) {
+    // Start again from an empty table when the positions of this block would overflow.
+    if (size >= std::numeric_limits<uint32_t>::max() - mPositionBase) {
+        ASSERT(size < std::numeric_limits<uint32_t>::max() - 1);
+        std::fill(mHashTable.begin(), mHashTable.end(), 0);
+        mPositionBase = 1;
+    }
+
+    const char* dictionary = mDictionary->GetData();
+    size_t dictionarySize = mDictionary->GetSize();
+
+    char* out = destination;
+    size_t anchor = 0;
+    size_t position = 0;
+    while (size >= kMinMatchLength && position <= size - kMinMatchLength) {
+        uint32_t value = Load32(source + position);
+        uint32_t hash = Hash(value);
+        uint32_t previous = mHashTable[hash];
+        mHashTable[hash] = mPositionBase + static_cast<uint32_t>(position);
+
+        size_t offset = 0;
+        size_t matchLength = 0;
+        if (previous >= mPositionBase) {
+            size_t candidate = previous - mPositionBase;
+            offset = position - candidate;
+            if (offset <= kMaxOffset && Load32(source + candidate) == value) {
+                matchLength =
+                    kMinMatchLength + CountMatchingBytes(source + candidate + kMinMatchLength,
+                                                         source + position + kMinMatchLength,
+                                                         size - position - kMinMatchLength);
+            }
+        } else if (uint32_t found = mDictionary->Find(hash); found != 0) {
+            size_t candidate = found - 1;
+            offset = position + dictionarySize - candidate;
+            if (offset <= kMaxOffset && Load32(dictionary + candidate) == value) {
+                matchLength = CountMatchingBytes(dictionary + candidate, source + position,
+                                                 std::min(dictionarySize - candidate,
+                                                          size - position));
+                // Matches reaching the end of the dictionary continue at the start of the block.
+                if (candidate + matchLength == dictionarySize) {
+                    matchLength += CountMatchingBytes(source, source + position + matchLength,
+                                                      size - position - matchLength);
+                }
+            }
+        }
+
+        if (matchLength == 0) {
+            position += 1 + ((position - anchor) >> kSkipShift);
+            continue;
+        }
+
+        out = WriteSequence(out, source + anchor, position - anchor, offset, matchLength);
+        position += matchLength;
+        anchor = position;
+    }
+    out = WriteSequence(out, source + anchor, size - anchor, 0, 0);
+
+    mPositionBase += static_cast<uint32_t>(size);
+    return static_cast<size_t>(out - destination);
+}
+
+bool LZDecompress(const char* source,
+                  size_t size,
+                  char* destination,
+                  size_t decompressedSize,
+                  const LZDictionary& dictionary) {
+    const char* in = source;
+    const char* end = source + size;
+    size_t outPosition = 0;
+    while (true) {
+        if (in == end) {
+            return false;
+        }
+        uint8_t token = static_cast<uint8_t>(*in++);
+
+        size_t literalLength = token >> 4;
+        if (literalLength == kTokenLengthMask && !ReadExtraLength(&in, end, &literalLength)) {
+            return false;
+        }
+        if (literalLength > static_cast<size_t>(end - in) ||
+            literalLength > decompressedSize - outPosition) {
+            return false;
+        }
+        memcpy(destination + outPosition, in, literalLength);
+        in += literalLength;
+        outPosition += literalLength;
+
+        // The last sequence has only literals.
+        if (in == end) {
+            return outPosition == decompressedSize;
+        }
+
+        if (end - in < 2) {
+            return false;
+        }
+        size_t offset = static_cast<uint8_t>(in[0]) | (static_cast<uint8_t>(in[1]) << 8);
+        in += 2;
+
+        size_t matchLength = token & kTokenLengthMask;
+        if (matchLength == kTokenLengthMask && !ReadExtraLength(&in, end, &matchLength)) {
+            return false;
+        }
+        matchLength += kMinMatchLength;
+        if (offset == 0 || offset > outPosition + dictionary.GetSize() ||
+            matchLength > decompressedSize - outPosition) {
+            return false;
+        }
+
+        char* out = destination + outPosition;
+        if (offset > outPosition) {
+            // The match starts in the dictionary and may continue at the start of the block.
+            size_t dictionaryPosition = dictionary.GetSize() - (offset - outPosition);
+            size_t dictionaryLength =
+                std::min(matchLength, dictionary.GetSize() - dictionaryPosition);
+            memcpy(out, dictionary.GetData() + dictionaryPosition, dictionaryLength);
+            if (matchLength > dictionaryLength) {
+                CopyMatch(out + dictionaryLength, destination, matchLength - dictionaryLength);
+            }
+        } else {
+            CopyMatch(out, out - offset, matchLength);
+        }
+        outPosition += matchLength;
+    }
+}
+
+}  // namespace dawn::wire
@@ -0,0 +1,89 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_WIRE_LZCOMPRESSION_H_
+#define SRC_DAWN_WIRE_LZCOMPRESSION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dawn::wire {
+
+// A fast LZ77 compression of blocks of data, used to compress the wire command stream. The format
+// is similar to LZ4 blocks: a sequence of literals followed by a match of at least 4 bytes at an
+// offset of at most 64KB, repeated, and ending with literals only. Blocks are compressed
+// independently of each other but can reference a dictionary as if it preceded them, which helps
+// the small blocks that don't repeat themselves enough to compress well on their own.
+
+// Data that the compressed blocks can reference as if it preceded them. Only the last 64KB of the
+// dictionary are used.
+class LZDictionary {
+  public:
+    explicit LZDictionary(std::vector<char> data);
+    ~LZDictionary();
+
+    LZDictionary(const LZDictionary&) = delete;
+    LZDictionary& operator=(const LZDictionary&) = delete;
+
+    const char* GetData() const;
+    size_t GetSize() const;
+    // A checksum of the data, to check that both sides of the wire use the same dictionary.
+    uint32_t GetChecksum() const;
+
+    // Returns the position of the last occurrence in the dictionary of 4 bytes with |hash|, plus
+    // one, or 0 if there is none.
+    uint32_t Find(uint32_t hash) const;
+
+  private:
+    std::vector<char> mData;
+    std::vector<uint32_t> mHashTable;
+    uint32_t mChecksum;
+};
+
+class LZCompressor {
+  public:
+    explicit LZCompressor(const LZDictionary* dictionary);
+    ~LZCompressor();
+
+    LZCompressor(const LZCompressor&) = delete;
+    LZCompressor& operator=(const LZCompressor&) = delete;
+
+    // The maximum size of the compression of |size| bytes, for incompressible data.
+    static size_t GetCompressedSizeBound(size_t size);
+
+    // Compresses the |size| bytes of |source| into |destination|, which must be at least
+    // GetCompressedSizeBound(size) bytes, and returns the compressed size.
+    size_t Compress(const char* source, size_t size, char* destination);
+
+  private:
+    const LZDictionary* mDictionary;
+    // The last position of each hash of 4 bytes, offset by mPositionBase so that the positions
+    // of the previous blocks are ignored without clearing the table for each block.
+    std::vector<uint32_t> mHashTable;
+    uint32_t mPositionBase = 1;
+};
+
+// Decompresses the |size| bytes of |source| compressed with |dictionary| into the
+// |decompressedSize| bytes of |destination|. Returns false if |source| isn't a valid compressed
+// block of exactly |decompressedSize| bytes.
+bool LZDecompress(const char* source,
+                  size_t size,
+                  char* destination,
+                  size_t decompressedSize,
+                  const LZDictionary& dictionary);
+
+}  // namespace dawn::wire
+
+#endif  // SRC_DAWN_WIRE_LZCOMPRESSION_H_
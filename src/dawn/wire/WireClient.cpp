@@ -18,7 +18,9 @@
 namespace dawn::wire {
 
 WireClient::WireClient(const WireClientDescriptor& descriptor)
-    : mImpl(new client::Client(descriptor.serializer, descriptor.memoryTransferService)) {}
+    : mImpl(new client::Client(descriptor.serializer,
+                               descriptor.memoryTransferService,
+                               descriptor.flushPolicy)) {}
 
 WireClient::~WireClient() {
     mImpl.reset();
@@ -61,6 +63,18 @@ void WireClient::ReclaimInstanceReservation(const ReservedInstance& reservation)
     mImpl->ReclaimInstanceReservation(reservation);
 }
 
+bool WireClient::Flush() {
+    return mImpl->Flush();
+}
+
+bool WireClient::FlushIfExpired() {
+    return mImpl->FlushIfExpired();
+}
+
+WireClientFlushStats WireClient::GetFlushStats() const {
+    return mImpl->GetFlushStats();
+}
+
 void WireClient::Disconnect() {
     mImpl->Disconnect();
 }
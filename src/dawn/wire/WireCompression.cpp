@@ -0,0 +1,249 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/wire/WireCompression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "dawn/common/Alloc.h"
+#include "dawn/common/Assert.h"
+#include "dawn/wire/LZCompression.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// "DAWNWLZ1" in little-endian. As the size of an uncompressed command it would be far too large
+// to be valid, so a stream header can't be mistaken for uncompressed commands.
+constexpr uint64_t kStreamMagic = 0x315A4C574E574144ull;
+constexpr uint32_t kStreamFormatVersion = 1;
+
+struct StreamHeader {
+    uint64_t magic;
+    uint32_t formatVersion;
+    uint32_t dictionaryChecksum;
+};
+
+// Each frame is this header followed by the compressed commands, or by the commands themselves
+// when they don't compress, in which case the two sizes are equal.
+struct FrameHeader {
+    uint32_t compressedSize;
+    uint32_t decompressedSize;
+};
+
+static_assert(CompressingCommandSerializer::kMaxFrameSize <= std::numeric_limits<uint32_t>::max());
+
+// The dictionary primes the compression of each frame with the start of the header of every
+// command: the high bytes of CmdHeader::commandSize, which are always zero, followed by the
+// WireCmd of the command. Later commands in a frame match the previous ones instead.
+std::vector<char> BuildDictionary() {
+    std::vector<char> data;
+    for (uint32_t id = 0; GetWireCommandName(id) != nullptr; ++id) {
+        uint32_t words[2] = {0, id};
+        const char* bytes = reinterpret_cast<const char*>(words);
+        data.insert(data.end(), bytes, bytes + sizeof(words));
+    }
+    return data;
+}
+
+const LZDictionary& GetDictionary() {
+    static const LZDictionary* dictionary = new LZDictionary(BuildDictionary());
+    return *dictionary;
+}
+
+}  // anonymous namespace
+
+CompressingCommandSerializer::CompressingCommandSerializer(CommandSerializer* serializer)
+    : mSerializer(serializer),
+      mCompressor(std::make_unique<LZCompressor>(&GetDictionary())),
+      mFrameCapacity(std::min(kMaxFrameSize,
+                              serializer->GetMaximumAllocationSize() - sizeof(FrameHeader))),
+      mFrame(new char[mFrameCapacity]),
+      mCompressedFrame(new char[LZCompressor::GetCompressedSizeBound(mFrameCapacity)]) {
+    ASSERT(serializer->GetMaximumAllocationSize() > sizeof(FrameHeader) + sizeof(StreamHeader));
+}
+
+CompressingCommandSerializer::~CompressingCommandSerializer() = default;
+
+size_t CompressingCommandSerializer::GetMaximumAllocationSize() const {
+    return mFrameCapacity;
+}
+
+void* CompressingCommandSerializer::GetCmdSpace(size_t size) {
+    ASSERT(size <= mFrameCapacity);
+    if (mFrameCapacity - mFrameSize < size && !WriteFrame()) {
+        return nullptr;
+    }
+    char* result = &mFrame[mFrameSize];
+    mFrameSize += size;
+    return result;
+}
+
+bool CompressingCommandSerializer::Flush() {
+    return WriteFrame() && mSerializer->Flush();
+}
+
+void CompressingCommandSerializer::OnSerializeError() {
+    mSerializer->OnSerializeError();
+}
+
+WireCompressionStats CompressingCommandSerializer::GetStats() const {
+    return mStats;
+}
+
+bool CompressingCommandSerializer::WriteFrame() {
+    if (mFrameSize == 0) {
+        return true;
+    }
+
+    if (!mWroteStreamHeader) {
+        char* space = static_cast<char*>(mSerializer->GetCmdSpace(sizeof(StreamHeader)));
+        if (space == nullptr) {
+            return false;
+        }
+        StreamHeader header = {kStreamMagic, kStreamFormatVersion,
+                               GetDictionary().GetChecksum()};
+        memcpy(space, &header, sizeof(header));
+        mStats.compressedBytes += sizeof(header);
+        mWroteStreamHeader = true;
+    }
+
+    size_t compressedSize =
+        mCompressor->Compress(mFrame.get(), mFrameSize, mCompressedFrame.get());
+    const char* payload = mCompressedFrame.get();
+    if (compressedSize >= mFrameSize) {
+        compressedSize = mFrameSize;
+        payload = mFrame.get();
+    }
+
+    char* space =
+        static_cast<char*>(mSerializer->GetCmdSpace(sizeof(FrameHeader) + compressedSize));
+    if (space == nullptr) {
+        return false;
+    }
+    FrameHeader header = {static_cast<uint32_t>(compressedSize),
+                          static_cast<uint32_t>(mFrameSize)};
+    memcpy(space, &header, sizeof(header));
+    memcpy(space + sizeof(header), payload, compressedSize);
+
+    mStats.frames++;
+    mStats.uncompressedBytes += mFrameSize;
+    mStats.compressedBytes += sizeof(header) + compressedSize;
+    mFrameSize = 0;
+    return true;
+}
+
+DecompressingCommandHandler::DecompressingCommandHandler(CommandHandler* handler)
+    : mHandler(handler) {}
+
+DecompressingCommandHandler::~DecompressingCommandHandler() = default;
+
+const volatile char* DecompressingCommandHandler::HandleCommands(const volatile char* commands,
+                                                                 size_t size) {
+    switch (mState) {
+        case StreamState::Unknown: {
+            uint64_t magic;
+            if (size < sizeof(magic)) {
+                return mHandler->HandleCommands(commands, size);
+            }
+            memcpy(&magic, const_cast<const char*>(commands), sizeof(magic));
+            if (magic != kStreamMagic) {
+                mState = StreamState::Uncompressed;
+                return mHandler->HandleCommands(commands, size);
+            }
+
+            size_t headerSize = ReadStreamHeader(commands, size);
+            if (headerSize == 0) {
+                return nullptr;
+            }
+            mState = StreamState::Compressed;
+            return HandleFrames(commands + headerSize, size - headerSize);
+        }
+        case StreamState::Compressed:
+            return HandleFrames(commands, size);
+        case StreamState::Uncompressed:
+            return mHandler->HandleCommands(commands, size);
+    }
+    UNREACHABLE();
+}
+
+bool DecompressingCommandHandler::IsCompressed() const {
+    return mState == StreamState::Compressed;
+}
+
+size_t DecompressingCommandHandler::ReadStreamHeader(const volatile char* commands, size_t size) {
+    StreamHeader header;
+    if (size < sizeof(header)) {
+        return 0;
+    }
+    memcpy(&header, const_cast<const char*>(commands), sizeof(header));
+    if (header.formatVersion != kStreamFormatVersion ||
+        header.dictionaryChecksum != GetDictionary().GetChecksum()) {
+        return 0;
+    }
+
+    size_t frameSize = CompressingCommandSerializer::kMaxFrameSize;
+    mCompressedFrame.reset(AllocNoThrow<char>(frameSize));
+    mFrame.reset(AllocNoThrow<char>(frameSize));
+    if (mCompressedFrame == nullptr || mFrame == nullptr) {
+        return 0;
+    }
+    return sizeof(header);
+}
+
+const volatile char* DecompressingCommandHandler::HandleFrames(const volatile char* commands,
+                                                               size_t size) {
+    while (size > 0) {
+        FrameHeader header;
+        if (size < sizeof(header)) {
+            return nullptr;
+        }
+        memcpy(&header, const_cast<const char*>(commands), sizeof(header));
+        commands += sizeof(header);
+        size -= sizeof(header);
+
+        if (header.decompressedSize > CompressingCommandSerializer::kMaxFrameSize ||
+            header.compressedSize > header.decompressedSize || header.compressedSize > size) {
+            return nullptr;
+        }
+
+        if (header.compressedSize == header.decompressedSize) {
+            // The commands didn't compress and are stored as is.
+            if (mHandler->HandleCommands(commands, header.compressedSize) == nullptr) {
+                return nullptr;
+            }
+        } else {
+            // Copy the compressed frame first since the memory of the transport may be modified
+            // concurrently by the other side.
+            memcpy(mCompressedFrame.get(), const_cast<const char*>(commands),
+                   header.compressedSize);
+            if (!LZDecompress(mCompressedFrame.get(), header.compressedSize, mFrame.get(),
+                              header.decompressedSize, GetDictionary())) {
+                return nullptr;
+            }
+            if (mHandler->HandleCommands(mFrame.get(), header.decompressedSize) == nullptr) {
+                return nullptr;
+            }
+        }
+
+        commands += header.compressedSize;
+        size -= header.compressedSize;
+    }
+    return commands;
+}
+
+}  // namespace dawn::wire
@@ -15,46 +15,84 @@
 #include "dawn/wire/WireDeserializeAllocator.h"
 
 #include <algorithm>
+#include <limits>
+#include <new>
+
+#include "dawn/common/Math.h"
 
 namespace dawn::wire {
-WireDeserializeAllocator::WireDeserializeAllocator() {
-    Reset();
-}
 
-WireDeserializeAllocator::~WireDeserializeAllocator() {
+namespace {
+
+// All the allocations are aligned like malloc's since they are used for structures of any type.
+constexpr size_t kAllocationAlignment = alignof(std::max_align_t);
+
+}  // anonymous namespace
+
+WireDeserializeAllocator::WireDeserializeAllocator(size_t maxArenaSize)
+    : mMaxArenaSize(maxArenaSize) {
     Reset();
 }
 
+WireDeserializeAllocator::~WireDeserializeAllocator() = default;
+
 void* WireDeserializeAllocator::GetSpace(size_t size) {
-    // Return space in the current buffer if possible first.
-    if (mRemainingSize >= size) {
-        char* buffer = mCurrentBuffer;
-        mCurrentBuffer += size;
-        mRemainingSize -= size;
-        return buffer;
+    if (size > std::numeric_limits<size_t>::max() - kAllocationAlignment) {
+        return nullptr;
     }
+    size = Align(size, kAllocationAlignment);
 
-    // Otherwise allocate a new buffer and try again.
-    size_t allocationSize = std::max(size, size_t(2048));
-    char* allocation = static_cast<char*>(malloc(allocationSize));
-    if (allocation == nullptr) {
-        return nullptr;
+    // Return space in the current buffer if possible first.
+    if (mRemainingSize < size) {
+        // Otherwise allocate a new buffer, growing geometrically so that commands with many
+        // allocations only make a few of them.
+        size_t allocationSize = std::max(size, std::max(mUsedSize, sizeof(mStaticBuffer)));
+        char* allocation = new (std::nothrow) char[allocationSize];
+        if (allocation == nullptr) {
+            return nullptr;
+        }
+
+        mAllocations.emplace_back(allocation);
+        mCurrentBuffer = allocation;
+        mRemainingSize = allocationSize;
     }
 
-    mAllocations.push_back(allocation);
-    mCurrentBuffer = allocation;
-    mRemainingSize = allocationSize;
-    return GetSpace(size);
+    char* buffer = mCurrentBuffer;
+    mCurrentBuffer += size;
+    mRemainingSize -= size;
+    mUsedSize += size;
+    return buffer;
 }
 
 void WireDeserializeAllocator::Reset() {
-    for (auto* allocation : mAllocations) {
-        free(allocation);
+    // Grow the arena to the size used by the last command if it didn't fit, so that the next
+    // commands like it don't need to allocate. A single allocation replaces the previous arena
+    // and the overflow allocations. The geometric growth is clamped to the maximum size so that
+    // commands close to it still fit in the arena.
+    if (!mAllocations.empty()) {
+        mAllocations.clear();
+
+        if (mUsedSize <= mMaxArenaSize) {
+            size_t arenaSize = std::min(std::max(mUsedSize, mArenaSize * 2), mMaxArenaSize);
+            mArena.reset(new (std::nothrow) char[arenaSize]);
+            mArenaSize = mArena != nullptr ? arenaSize : 0;
+        }
     }
-    mAllocations.clear();
+    mUsedSize = 0;
 
-    // The initial buffer is the inline buffer so that some allocations can be skipped
-    mCurrentBuffer = mStaticBuffer;
-    mRemainingSize = sizeof(mStaticBuffer);
+    // The initial buffer is the inline buffer so that some allocations can be skipped, until
+    // the arena replaces it.
+    if (mArena != nullptr) {
+        mCurrentBuffer = mArena.get();
+        mRemainingSize = mArenaSize;
+    } else {
+        mCurrentBuffer = mStaticBuffer;
+        mRemainingSize = sizeof(mStaticBuffer);
+    }
+}
+
+size_t WireDeserializeAllocator::GetArenaSize() const {
+    return mArena != nullptr ? mArenaSize : sizeof(mStaticBuffer);
 }
+
 }  // namespace dawn::wire
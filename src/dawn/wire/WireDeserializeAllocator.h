@@ -15,28 +15,45 @@
 #ifndef SRC_DAWN_WIRE_WIREDESERIALIZEALLOCATOR_H_
 #define SRC_DAWN_WIRE_WIREDESERIALIZEALLOCATOR_H_
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "dawn/wire/WireCmd_autogen.h"
 
 namespace dawn::wire {
-// A really really simple implementation of the DeserializeAllocator. It's main feature
-// is that it has some inline storage so as to avoid allocations for the majority of
-// commands.
+// A bump allocator for the data pointed to by the deserialized commands. It starts with some
+// inline storage so as to avoid allocations for the majority of commands. When a command needs
+// more, the extra memory is allocated on the heap, and on the next Reset the arena grows to the
+// size that the command needed, so that the following commands of that size don't allocate
+// anymore. The arena never grows past |maxArenaSize|: larger commands still work but allocate
+// and free their memory each time.
 class WireDeserializeAllocator : public DeserializeAllocator {
   public:
-    WireDeserializeAllocator();
+    static constexpr size_t kDefaultMaxArenaSize = 1024 * 1024;
+
+    explicit WireDeserializeAllocator(size_t maxArenaSize = kDefaultMaxArenaSize);
     virtual ~WireDeserializeAllocator();
 
     void* GetSpace(size_t size) override;
 
+    // Makes all the memory returned by GetSpace available again.
     void Reset();
 
+    // The size of the memory kept across calls to Reset, including the inline storage.
+    size_t GetArenaSize() const;
+
   private:
+    size_t mMaxArenaSize;
     size_t mRemainingSize = 0;
     char* mCurrentBuffer = nullptr;
-    char mStaticBuffer[2048];
-    std::vector<char*> mAllocations;
+    // The total size returned by GetSpace since the last Reset.
+    size_t mUsedSize = 0;
+    std::unique_ptr<char[]> mArena;
+    size_t mArenaSize = 0;
+    // The allocations made since the last Reset because the arena was full.
+    std::vector<std::unique_ptr<char[]>> mAllocations;
+    alignas(std::max_align_t) char mStaticBuffer[2048];
 };
 }  // namespace dawn::wire
 
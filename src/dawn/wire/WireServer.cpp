@@ -14,19 +14,31 @@
 
 #include "dawn/wire/WireServer.h"
 #include "dawn/wire/server/Server.h"
+#include "dawn/wire/server/ThreadedServer.h"
 
 namespace dawn::wire {
 
-WireServer::WireServer(const WireServerDescriptor& descriptor)
-    : mImpl(new server::Server(*descriptor.procs,
-                               descriptor.serializer,
-                               descriptor.memoryTransferService)) {}
+WireServer::WireServer(const WireServerDescriptor& descriptor) {
+    if (descriptor.deviceThreadCount == 0) {
+        mImpl = std::make_unique<server::Server>(*descriptor.procs, descriptor.serializer,
+                                                 descriptor.memoryTransferService,
+                                                 descriptor.maxDeserializeArenaSize);
+    } else {
+        mThreadedImpl = std::make_unique<server::ThreadedServer>(
+            *descriptor.procs, descriptor.serializer, descriptor.memoryTransferService,
+            descriptor.maxDeserializeArenaSize, descriptor.deviceThreadCount);
+    }
+}
 
 WireServer::~WireServer() {
     mImpl.reset();
+    mThreadedImpl.reset();
 }
 
 const volatile char* WireServer::HandleCommands(const volatile char* commands, size_t size) {
+    if (mThreadedImpl != nullptr) {
+        return mThreadedImpl->HandleCommands(commands, size);
+    }
     return mImpl->HandleCommands(commands, size);
 }
 
@@ -35,6 +47,9 @@ bool WireServer::InjectTexture(WGPUTexture texture,
                                uint32_t generation,
                                uint32_t deviceId,
                                uint32_t deviceGeneration) {
+    if (mThreadedImpl != nullptr) {
+        return mThreadedImpl->InjectTexture(texture, id, generation, deviceId, deviceGeneration);
+    }
     return mImpl->InjectTexture(texture, id, generation, deviceId, deviceGeneration);
 }
 
@@ -43,25 +58,55 @@ bool WireServer::InjectSwapChain(WGPUSwapChain swapchain,
                                  uint32_t generation,
                                  uint32_t deviceId,
                                  uint32_t deviceGeneration) {
+    if (mThreadedImpl != nullptr) {
+        return mThreadedImpl->InjectSwapChain(swapchain, id, generation, deviceId,
+                                              deviceGeneration);
+    }
     return mImpl->InjectSwapChain(swapchain, id, generation, deviceId, deviceGeneration);
 }
 
 bool WireServer::InjectDevice(WGPUDevice device, uint32_t id, uint32_t generation) {
+    if (mThreadedImpl != nullptr) {
+        return mThreadedImpl->InjectDevice(device, id, generation);
+    }
     return mImpl->InjectDevice(device, id, generation);
 }
 
 bool WireServer::InjectInstance(WGPUInstance instance, uint32_t id, uint32_t generation) {
+    if (mThreadedImpl != nullptr) {
+        return mThreadedImpl->InjectInstance(instance, id, generation);
+    }
     return mImpl->InjectInstance(instance, id, generation);
 }
 
 WGPUDevice WireServer::GetDevice(uint32_t id, uint32_t generation) {
+    if (mThreadedImpl != nullptr) {
+        return mThreadedImpl->GetDevice(id, generation);
+    }
     return mImpl->GetDevice(id, generation);
 }
 
 bool WireServer::IsDeviceKnown(WGPUDevice device) const {
+    if (mThreadedImpl != nullptr) {
+        return mThreadedImpl->IsDeviceKnown(device);
+    }
     return mImpl->IsDeviceKnown(device);
 }
 
+void WireServer::TickDevices() {
+    if (mThreadedImpl != nullptr) {
+        mThreadedImpl->TickDevices();
+        return;
+    }
+    mImpl->TickDevices();
+}
+
+void WireServer::WaitForIdle() {
+    if (mThreadedImpl != nullptr) {
+        mThreadedImpl->WaitForIdle();
+    }
+}
+
 namespace server {
 MemoryTransferService::MemoryTransferService() = default;
 
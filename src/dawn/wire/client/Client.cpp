@@ -37,8 +37,13 @@ class NoopCommandSerializer final : public CommandSerializer {
 
 }  // anonymous namespace
 
-Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
-    : ClientBase(), mSerializer(serializer), mMemoryTransferService(memoryTransferService) {
+Client::Client(CommandSerializer* serializer,
+               MemoryTransferService* memoryTransferService,
+               const WireClientFlushPolicy& flushPolicy)
+    : ClientBase(),
+      mFlushingSerializer(serializer, flushPolicy),
+      mSerializer(&mFlushingSerializer),
+      mMemoryTransferService(memoryTransferService) {
     if (mMemoryTransferService == nullptr) {
         // If a MemoryTransferService is not provided, fall back to inline memory.
         mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -47,6 +52,7 @@ Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTrans
 }
 
 Client::~Client() {
+    mFlushingSerializer.DisableAutoFlush();
     DestroyAllObjects();
 }
 
@@ -141,9 +147,28 @@ void Client::ReclaimInstanceReservation(const ReservedInstance& reservation) {
     Free(FromAPI(reservation.instance));
 }
 
+bool Client::Flush() {
+    if (mDisconnected) {
+        return false;
+    }
+    return mFlushingSerializer.Flush();
+}
+
+bool Client::FlushIfExpired() {
+    if (mDisconnected) {
+        return false;
+    }
+    return mFlushingSerializer.FlushIfExpired();
+}
+
+const WireClientFlushStats& Client::GetFlushStats() const {
+    return mFlushingSerializer.GetStats();
+}
+
 void Client::Disconnect() {
     mDisconnected = true;
     mSerializer = ChunkedCommandSerializer(NoopCommandSerializer::GetInstance());
+    mFlushingSerializer.DisableAutoFlush();
 
     auto& deviceList = mObjects[ObjectType::Device];
     {
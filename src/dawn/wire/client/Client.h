@@ -27,6 +27,7 @@
 #include "dawn/wire/WireCmd_autogen.h"
 #include "dawn/wire/WireDeserializeAllocator.h"
 #include "dawn/wire/client/ClientBase_autogen.h"
+#include "dawn/wire/client/FlushingCommandSerializer.h"
 #include "dawn/wire/client/ObjectStore.h"
 
 namespace dawn::wire::client {
@@ -36,7 +37,9 @@ class MemoryTransferService;
 
 class Client : public ClientBase {
   public:
-    Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService);
+    Client(CommandSerializer* serializer,
+           MemoryTransferService* memoryTransferService,
+           const WireClientFlushPolicy& flushPolicy);
     ~Client() override;
 
     // Make<T>(arg1, arg2, arg3) creates a new T, calling a constructor of the form:
@@ -83,6 +86,7 @@ class Client : public ClientBase {
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
         mSerializer.SerializeCommand(cmd, *this);
+        mFlushingSerializer.OnCommandSerialized(GetFlushTrigger<Cmd>());
     }
 
     template <typename Cmd, typename ExtraSizeSerializeFn>
@@ -90,8 +94,13 @@ class Client : public ClientBase {
                           size_t extraSize,
                           ExtraSizeSerializeFn&& SerializeExtraSize) {
         mSerializer.SerializeCommand(cmd, *this, extraSize, SerializeExtraSize);
+        mFlushingSerializer.OnCommandSerialized(GetFlushTrigger<Cmd>());
     }
 
+    bool Flush();
+    bool FlushIfExpired();
+    const WireClientFlushStats& GetFlushStats() const;
+
     void Disconnect();
     bool IsDisconnected() const;
 
@@ -100,6 +109,7 @@ class Client : public ClientBase {
 
 #include "dawn/wire/client/ClientPrototypes_autogen.inc"
 
+    FlushingCommandSerializer mFlushingSerializer;
     ChunkedCommandSerializer mSerializer;
     WireDeserializeAllocator mWireCommandAllocator;
     PerObjectType<ObjectStore> mObjectStores;
@@ -0,0 +1,131 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/wire/client/FlushingCommandSerializer.h"
+
+namespace dawn::wire::client {
+
+namespace {
+
+// Reading the clock after each command would be a significant part of the cost of the smallest
+// commands, so the pending time is only checked every few commands.
+constexpr size_t kCommandsPerPendingTimeCheck = 16;
+
+}  // anonymous namespace
+
+FlushingCommandSerializer::FlushingCommandSerializer(CommandSerializer* serializer,
+                                                     const WireClientFlushPolicy& policy)
+    : mSerializer(serializer), mPolicy(policy) {}
+
+FlushingCommandSerializer::~FlushingCommandSerializer() = default;
+
+size_t FlushingCommandSerializer::GetMaximumAllocationSize() const {
+    return mSerializer->GetMaximumAllocationSize();
+}
+
+void* FlushingCommandSerializer::GetCmdSpace(size_t size) {
+    void* space = mSerializer->GetCmdSpace(size);
+    if (space != nullptr) {
+        if (mPendingBytes == 0 && mPolicy.maxPendingTimeUs != 0) {
+            mOldestPendingTime = std::chrono::steady_clock::now();
+        }
+        mPendingBytes += size;
+    }
+    return space;
+}
+
+bool FlushingCommandSerializer::Flush() {
+    return FlushForReason(FlushReason::Explicit);
+}
+
+void FlushingCommandSerializer::OnSerializeError() {
+    mSerializer->OnSerializeError();
+}
+
+void FlushingCommandSerializer::OnCommandSerialized(FlushTrigger trigger) {
+    mPendingCommands++;
+
+    if (trigger == FlushTrigger::Submit && mPolicy.flushOnSubmit) {
+        FlushForReason(FlushReason::Submit);
+    } else if (trigger == FlushTrigger::MapAsync && mPolicy.flushOnMapAsync) {
+        FlushForReason(FlushReason::MapAsync);
+    } else if (mPolicy.maxPendingBytes != 0 && mPendingBytes >= mPolicy.maxPendingBytes) {
+        FlushForReason(FlushReason::PendingBytes);
+    } else if (mPolicy.maxPendingCommands != 0 &&
+               mPendingCommands >= mPolicy.maxPendingCommands) {
+        FlushForReason(FlushReason::PendingCommands);
+    } else if (mPendingCommands % kCommandsPerPendingTimeCheck == 0 && IsExpired()) {
+        FlushForReason(FlushReason::PendingTime);
+    }
+}
+
+bool FlushingCommandSerializer::FlushIfExpired() {
+    if (!IsExpired()) {
+        return true;
+    }
+    return FlushForReason(FlushReason::PendingTime);
+}
+
+void FlushingCommandSerializer::DisableAutoFlush() {
+    mPolicy = {};
+}
+
+const WireClientFlushStats& FlushingCommandSerializer::GetStats() const {
+    return mStats;
+}
+
+bool FlushingCommandSerializer::FlushForReason(FlushReason reason) {
+    if (mPendingBytes == 0) {
+        return mSerializer->Flush();
+    }
+
+    mStats.flushes++;
+    switch (reason) {
+        case FlushReason::Explicit:
+            mStats.explicitFlushes++;
+            break;
+        case FlushReason::PendingBytes:
+            mStats.pendingBytesFlushes++;
+            break;
+        case FlushReason::PendingCommands:
+            mStats.pendingCommandsFlushes++;
+            break;
+        case FlushReason::Submit:
+            mStats.submitFlushes++;
+            break;
+        case FlushReason::MapAsync:
+            mStats.mapAsyncFlushes++;
+            break;
+        case FlushReason::PendingTime:
+            mStats.pendingTimeFlushes++;
+            break;
+    }
+    mStats.flushedCommands += mPendingCommands;
+    mStats.flushedBytes += mPendingBytes;
+
+    mPendingCommands = 0;
+    mPendingBytes = 0;
+    return mSerializer->Flush();
+}
+
+bool FlushingCommandSerializer::IsExpired() const {
+    if (mPolicy.maxPendingTimeUs == 0 || mPendingBytes == 0) {
+        return false;
+    }
+    auto pendingTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - mOldestPendingTime);
+    return static_cast<uint64_t>(pendingTime.count()) >= mPolicy.maxPendingTimeUs;
+}
+
+}  // namespace dawn::wire::client
@@ -0,0 +1,95 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_WIRE_CLIENT_FLUSHINGCOMMANDSERIALIZER_H_
+#define SRC_DAWN_WIRE_CLIENT_FLUSHINGCOMMANDSERIALIZER_H_
+
+#include <chrono>
+#include <type_traits>
+
+#include "dawn/wire/Wire.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireCmd_autogen.h"
+
+namespace dawn::wire::client {
+
+// The commands after which a WireClientFlushPolicy may require a flush.
+enum class FlushTrigger {
+    None,
+    Submit,
+    MapAsync,
+};
+
+template <typename Cmd>
+constexpr FlushTrigger GetFlushTrigger() {
+    if constexpr (std::is_same_v<Cmd, QueueSubmitCmd>) {
+        return FlushTrigger::Submit;
+    } else if constexpr (std::is_same_v<Cmd, BufferMapAsyncCmd>) {
+        return FlushTrigger::MapAsync;
+    } else {
+        return FlushTrigger::None;
+    }
+}
+
+// Forwards the commands of the client to the embedder's CommandSerializer and flushes it as
+// required by the WireClientFlushPolicy. The client notifies it after each command it
+// serializes, since commands larger than the maximum allocation size take several calls to
+// GetCmdSpace.
+class FlushingCommandSerializer final : public CommandSerializer {
+  public:
+    FlushingCommandSerializer(CommandSerializer* serializer, const WireClientFlushPolicy& policy);
+    ~FlushingCommandSerializer() override;
+
+    size_t GetMaximumAllocationSize() const override;
+    void* GetCmdSpace(size_t size) override;
+    // Flushes at the request of the embedder.
+    bool Flush() override;
+    void OnSerializeError() override;
+
+    void OnCommandSerialized(FlushTrigger trigger);
+    bool FlushIfExpired();
+
+    // Stops flushing automatically, for example when the client is destroyed so that the
+    // embedder decides whether the last commands are sent.
+    void DisableAutoFlush();
+
+    const WireClientFlushStats& GetStats() const;
+
+  private:
+    enum class FlushReason {
+        Explicit,
+        PendingBytes,
+        PendingCommands,
+        Submit,
+        MapAsync,
+        PendingTime,
+    };
+
+    bool FlushForReason(FlushReason reason);
+    bool IsExpired() const;
+
+    CommandSerializer* mSerializer;
+    WireClientFlushPolicy mPolicy;
+    WireClientFlushStats mStats;
+
+    size_t mPendingBytes = 0;
+    size_t mPendingCommands = 0;
+    // When the oldest pending command was serialized, only tracked if the policy has a
+    // maxPendingTimeUs.
+    std::chrono::steady_clock::time_point mOldestPendingTime;
+};
+
+}  // namespace dawn::wire::client
+
+#endif  // SRC_DAWN_WIRE_CLIENT_FLUSHINGCOMMANDSERIALIZER_H_
@@ -19,7 +19,6 @@
 #include <map>
 #include <memory>
 #include <unordered_set>
-#include <utility>
 #include <vector>
 
 #include "dawn/wire/WireCmd_autogen.h"
@@ -38,10 +37,10 @@ enum class AllocationState : uint32_t {
 template <typename T>
 struct ObjectDataBase {
     // The backend-provided handle and generation to this object.
-    T handle;
+    T handle = nullptr;
     uint32_t generation = 0;
 
-    AllocationState state;
+    AllocationState state = AllocationState::Free;
 };
 
 // Stores what the backend knows about the type.
@@ -74,6 +73,11 @@ struct ObjectData<WGPUDevice> : public ObjectDataBase<WGPUDevice> {
 };
 
 // Keeps track of the mapping between client IDs and backend objects.
+//
+// The objects are stored in a dense array of slots indexed by their ID. The client keeps the free
+// list of this slot map: it reuses the IDs of its destroyed objects, with a new generation, so
+// the IDs stay close to the number of live objects and the slots are recycled in place instead
+// of growing the array. Free resets the slot so that Allocate only has to mark it as used.
 template <typename T>
 class KnownObjectsBase {
   public:
@@ -83,10 +87,7 @@ class KnownObjectsBase {
         // Reserve ID 0 so that it can be used to represent nullptr for optional object values
         // in the wire format. However don't tag it as allocated so that it is an error to ask
         // KnownObjects for ID 0.
-        Data reservation;
-        reservation.handle = nullptr;
-        reservation.state = AllocationState::Free;
-        mKnown.push_back(std::move(reservation));
+        mKnown.resize(1);
     }
 
     // Get a backend objects for a given client ID.
@@ -114,6 +115,13 @@ class KnownObjectsBase {
         return data;
     }
 
+    // Same as Get but also returns nullptr if the object isn't of |generation|, for example
+    // because the object that a callback refers to was destroyed and its ID was reused.
+    Data* Get(uint32_t id, uint32_t generation) {
+        Data* data = Get(id);
+        return data != nullptr && data->generation == generation ? data : nullptr;
+    }
+
     Data* FillReservation(uint32_t id, T handle) {
         ASSERT(id < mKnown.size());
         Data* data = &mKnown[id];
@@ -127,33 +135,34 @@ class KnownObjectsBase {
     // Returns nullptr if the ID is already allocated, or too far ahead, or if ID is 0 (ID 0 is
     // reserved for nullptr). Invalidates all the Data*
     Data* Allocate(uint32_t id, AllocationState state = AllocationState::Allocated) {
-        if (id == 0 || id > mKnown.size()) {
+        if (id == 0 || (id > mKnown.size() && !mAllowSparseIds)) {
             return nullptr;
         }
 
-        Data data;
-        data.state = state;
-        data.handle = nullptr;
-
+        // The new slots, including the ones skipped by sparse IDs, are free.
         if (id >= mKnown.size()) {
-            mKnown.push_back(std::move(data));
-            return &mKnown.back();
+            mKnown.resize(id + 1);
         }
 
-        if (mKnown[id].state != AllocationState::Free) {
+        Data* data = &mKnown[id];
+        if (data->state != AllocationState::Free) {
             return nullptr;
         }
 
-        mKnown[id] = std::move(data);
-        return &mKnown[id];
+        data->state = state;
+        return data;
     }
 
-    // Marks an ID as deallocated
+    // Marks an ID as deallocated and resets its slot for the next object with this ID.
     void Free(uint32_t id) {
         ASSERT(id < mKnown.size());
-        mKnown[id].state = AllocationState::Free;
+        mKnown[id] = Data();
     }
 
+    // Allows allocating IDs that are ahead of the next ID, for servers that only see some of
+    // the objects of the client. The caller is responsible for bounding the IDs.
+    void AllowSparseIds() { mAllowSparseIds = true; }
+
     std::vector<T> AcquireAllHandles() {
         std::vector<T> objects;
         for (Data& data : mKnown) {
@@ -180,6 +189,7 @@ class KnownObjectsBase {
 
   protected:
     std::vector<Data> mKnown;
+    bool mAllowSparseIds = false;
 };
 
 template <typename T>
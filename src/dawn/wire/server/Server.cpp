@@ -22,8 +22,12 @@ CallbackUserdata::CallbackUserdata(Server* server, const std::shared_ptr<bool>&
 
 Server::Server(const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService)
-    : mSerializer(serializer),
+               MemoryTransferService* memoryTransferService,
+               size_t maxDeserializeArenaSize,
+               std::mutex* serializerMutex)
+    : mAllocator(maxDeserializeArenaSize),
+      mSerializer(serializer),
+      mSerializerMutex(serializerMutex),
       mProcs(procs),
       mMemoryTransferService(memoryTransferService),
       mIsAlive(std::make_shared<bool>(true)) {
@@ -49,8 +53,7 @@ bool Server::InjectTexture(WGPUTexture texture,
                            uint32_t deviceId,
                            uint32_t deviceGeneration) {
     ASSERT(texture != nullptr);
-    ObjectData<WGPUDevice>* device = DeviceObjects().Get(deviceId);
-    if (device == nullptr || device->generation != deviceGeneration) {
+    if (DeviceObjects().Get(deviceId, deviceGeneration) == nullptr) {
         return false;
     }
 
@@ -76,8 +79,7 @@ bool Server::InjectSwapChain(WGPUSwapChain swapchain,
                              uint32_t deviceId,
                              uint32_t deviceGeneration) {
     ASSERT(swapchain != nullptr);
-    ObjectData<WGPUDevice>* device = DeviceObjects().Get(deviceId);
-    if (device == nullptr || device->generation != deviceGeneration) {
+    if (DeviceObjects().Get(deviceId, deviceGeneration) == nullptr) {
         return false;
     }
 
@@ -138,8 +140,8 @@ bool Server::InjectInstance(WGPUInstance instance, uint32_t id, uint32_t generat
 }
 
 WGPUDevice Server::GetDevice(uint32_t id, uint32_t generation) {
-    ObjectData<WGPUDevice>* data = DeviceObjects().Get(id);
-    if (data == nullptr || data->generation != generation) {
+    ObjectData<WGPUDevice>* data = DeviceObjects().Get(id, generation);
+    if (data == nullptr) {
         return nullptr;
     }
     return data->handle;
@@ -149,6 +151,25 @@ bool Server::IsDeviceKnown(WGPUDevice device) const {
     return DeviceObjects().IsKnown(device);
 }
 
+WGPUDevice Server::ExtractDevice(uint32_t id, uint32_t* generation) {
+    ObjectData<WGPUDevice>* data = DeviceObjects().Get(id);
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    WGPUDevice device = data->handle;
+    *generation = data->generation;
+    ClearDeviceCallbacks(device);
+    DeviceObjects().Free(id);
+    return device;
+}
+
+void Server::TickDevices() {
+    for (WGPUDevice device : DeviceObjects().GetAllHandles()) {
+        mProcs.deviceTick(device);
+    }
+}
+
 void Server::SetForwardingDeviceCallbacks(ObjectData<WGPUDevice>* deviceObject) {
     // Note: these callbacks are manually inlined here since they do not acquire and
     // free their userdata. Also unlike other callbacks, these are cleared and unset when
@@ -16,6 +16,7 @@
 #define SRC_DAWN_WIRE_SERVER_SERVER_H_
 
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "dawn/wire/ChunkedCommandSerializer.h"
@@ -147,7 +148,9 @@ class Server : public ServerBase {
   public:
     Server(const DawnProcTable& procs,
            CommandSerializer* serializer,
-           MemoryTransferService* memoryTransferService);
+           MemoryTransferService* memoryTransferService,
+           size_t maxDeserializeArenaSize,
+           std::mutex* serializerMutex = nullptr);
     ~Server() override;
 
     // ChunkedCommandHandler implementation
@@ -172,6 +175,13 @@ class Server : public ServerBase {
     WGPUDevice GetDevice(uint32_t id, uint32_t generation);
     bool IsDeviceKnown(WGPUDevice device) const;
 
+    // Removes the device from the server without releasing it so that it can be injected in
+    // another server. The caller takes over the reference of the server. Returns nullptr if the
+    // device isn't allocated.
+    WGPUDevice ExtractDevice(uint32_t id, uint32_t* generation);
+
+    void TickDevices();
+
     template <typename T,
               typename Enable = std::enable_if<std::is_base_of<CallbackUserdata, T>::value>>
     std::unique_ptr<T> MakeUserdata() {
@@ -181,6 +191,7 @@ class Server : public ServerBase {
   private:
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
+        std::unique_lock<std::mutex> lock = LockSerializer();
         mSerializer.SerializeCommand(cmd);
     }
 
@@ -188,9 +199,20 @@ class Server : public ServerBase {
     void SerializeCommand(const Cmd& cmd,
                           size_t extraSize,
                           ExtraSizeSerializeFn&& SerializeExtraSize) {
+        std::unique_lock<std::mutex> lock = LockSerializer();
         mSerializer.SerializeCommand(cmd, extraSize, SerializeExtraSize);
     }
 
+    // The serializer is shared with the other servers when the devices have their own threads,
+    // in which case whole commands are serialized with the lock held so that they don't
+    // interleave.
+    std::unique_lock<std::mutex> LockSerializer() {
+        if (mSerializerMutex == nullptr) {
+            return {};
+        }
+        return std::unique_lock<std::mutex>(*mSerializerMutex);
+    }
+
     void SetForwardingDeviceCallbacks(ObjectData<WGPUDevice>* deviceObject);
     void ClearDeviceCallbacks(WGPUDevice device);
 
@@ -227,6 +249,7 @@ class Server : public ServerBase {
 
     WireDeserializeAllocator mAllocator;
     ChunkedCommandSerializer mSerializer;
+    std::mutex* mSerializerMutex;
     DawnProcTable mProcs;
     std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
     MemoryTransferService* mMemoryTransferService = nullptr;
@@ -51,10 +51,11 @@ bool Server::DoQueueWriteBuffer(ObjectId queueId,
                                 const uint8_t* data,
                                 uint64_t size) {
     // The null object isn't valid as `self` or `buffer` so we can combine the check with the
-    // check that the ID is valid.
+    // check that the ID is valid. The buffer is resolved like the objects of the generated
+    // commands since it may belong to the Server of another device thread.
     auto* queue = QueueObjects().Get(queueId);
-    auto* buffer = BufferObjects().Get(bufferId);
-    if (queue == nullptr || buffer == nullptr) {
+    WGPUBuffer buffer;
+    if (queue == nullptr || GetFromId(bufferId, &buffer) != WireResult::Success) {
         return false;
     }
 
@@ -62,7 +63,7 @@ bool Server::DoQueueWriteBuffer(ObjectId queueId,
         return false;
     }
 
-    mProcs.queueWriteBuffer(queue->handle, buffer->handle, bufferOffset, data,
+    mProcs.queueWriteBuffer(queue->handle, buffer, bufferOffset, data,
                             static_cast<size_t>(size));
     return true;
 }
@@ -0,0 +1,439 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/wire/server/ThreadedServer.h"
+
+#include <condition_variable>
+#include <thread>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::wire::server {
+
+// A thread with its own Server that handles the commands of some of the devices, in the order
+// they are submitted.
+class ThreadedServer::DeviceThread {
+  public:
+    DeviceThread(ThreadedServer* owner, std::unique_ptr<Server> server)
+        : mOwner(owner), mServer(std::move(server)), mThread([this]() { Run(); }) {}
+
+    ~DeviceThread() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_one();
+        mThread.join();
+    }
+
+    // The Server can only be used directly by the thread of the ThreadedServer while the
+    // device thread is idle.
+    Server* GetServer() { return mServer.get(); }
+
+    // Appends commands to the batch that is submitted to the thread by Submit.
+    void AppendCommands(const volatile char* commands, size_t size) {
+        const char* data = const_cast<const char*>(commands);
+        mPendingCommands.insert(mPendingCommands.end(), data, data + size);
+    }
+
+    void Submit() {
+        if (mPendingCommands.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mQueuedCommands.empty()) {
+                std::swap(mQueuedCommands, mPendingCommands);
+            } else {
+                mQueuedCommands.insert(mQueuedCommands.end(), mPendingCommands.begin(),
+                                       mPendingCommands.end());
+            }
+        }
+        mPendingCommands.clear();
+        mCondition.notify_one();
+    }
+
+    void RequestTick() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTickRequested = true;
+        }
+        mCondition.notify_one();
+    }
+
+    void WaitForIdle() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdleCondition.wait(lock, [this]() {
+            return !mBusy && mQueuedCommands.empty() && !mTickRequested;
+        });
+    }
+
+  private:
+    void Run() {
+        std::vector<char> commands;
+        while (true) {
+            bool tick;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mBusy = false;
+                mIdleCondition.notify_all();
+                mCondition.wait(lock, [this]() {
+                    return mStopping || !mQueuedCommands.empty() || mTickRequested;
+                });
+                if (mStopping) {
+                    return;
+                }
+                // Take the whole queue and leave the previous batch's memory for the next one.
+                std::swap(commands, mQueuedCommands);
+                tick = std::exchange(mTickRequested, false);
+                mBusy = true;
+            }
+
+            // Once a thread fails, the client is disconnected so the other commands are
+            // dropped.
+            if (!mOwner->mFailed.load(std::memory_order_relaxed)) {
+                bool success = commands.empty() ||
+                               mServer->HandleCommands(commands.data(), commands.size()) != nullptr;
+                if (success && tick) {
+                    mServer->TickDevices();
+                }
+                if (!success || !mOwner->FlushSerializer()) {
+                    mOwner->mFailed.store(true, std::memory_order_relaxed);
+                }
+            }
+            commands.clear();
+        }
+    }
+
+    ThreadedServer* mOwner;
+    std::unique_ptr<Server> mServer;
+    // Only used on the thread of the ThreadedServer.
+    std::vector<char> mPendingCommands;
+
+    std::mutex mMutex;
+    // Notified when commands are queued, when a tick is requested or when stopping.
+    std::condition_variable mCondition;
+    // Notified when the thread becomes idle.
+    std::condition_variable mIdleCondition;
+    std::vector<char> mQueuedCommands;
+    bool mTickRequested = false;
+    bool mBusy = false;
+    bool mStopping = false;
+
+    // Started last, once all the members are initialized.
+    std::thread mThread;
+};
+
+ThreadedServer::ThreadedServer(const DawnProcTable& procs,
+                               CommandSerializer* serializer,
+                               MemoryTransferService* memoryTransferService,
+                               size_t maxDeserializeArenaSize,
+                               uint32_t deviceThreadCount)
+    : mProcs(procs), mSerializer(serializer), mRoutingAllocator(maxDeserializeArenaSize) {
+    ASSERT(deviceThreadCount > 0);
+
+    // Each Server only sees the IDs of its own objects while this class checks that the IDs
+    // aren't ahead of all the IDs seen so far.
+    mRootServer = std::make_unique<Server>(procs, serializer, memoryTransferService,
+                                           maxDeserializeArenaSize, &mSerializerMutex);
+    mRootServer->AllowSparseObjectIds();
+    for (uint32_t i = 0; i < deviceThreadCount; ++i) {
+        auto server = std::make_unique<Server>(procs, serializer, memoryTransferService,
+                                               maxDeserializeArenaSize, &mSerializerMutex);
+        server->AllowSparseObjectIds();
+        mDeviceThreads.push_back(std::make_unique<DeviceThread>(this, std::move(server)));
+    }
+
+    // Reserve ID 0 like the Servers do, since it represents nullptr.
+    for (std::vector<uint32_t>& servers : mObjectServers) {
+        servers.push_back(kRootServer);
+    }
+}
+
+ThreadedServer::~ThreadedServer() {
+    // Stop the device threads and release the devices before the instance and adapters of the
+    // root Server.
+    SubmitToDeviceThreads();
+    WaitForDeviceThreads();
+    mDeviceThreads.clear();
+    mRootServer = nullptr;
+}
+
+const volatile char* ThreadedServer::HandleCommandsImpl(const volatile char* commands,
+                                                        size_t size) {
+    if (mFailed.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    // Consecutive commands for the same device thread are appended to its batch at once.
+    const volatile char* run = commands;
+    size_t runSize = 0;
+    uint32_t runServer = kRootServer;
+    auto AppendRun = [&]() {
+        if (runSize != 0) {
+            mDeviceThreads[runServer - 1]->AppendCommands(run, runSize);
+            runSize = 0;
+        }
+    };
+
+    while (size >= sizeof(CmdHeader) + sizeof(WireCmd)) {
+        // Chunked commands are reassembled here so that the Servers only get whole commands.
+        switch (HandleChunkedCommands(commands, size)) {
+            case ChunkedCommandsResult::Consumed:
+                AppendRun();
+                SubmitToDeviceThreads();
+                return commands + size;
+            case ChunkedCommandsResult::Error:
+                return nullptr;
+            case ChunkedCommandsResult::Passthrough:
+                break;
+        }
+
+        uint64_t commandSize64 = reinterpret_cast<const volatile CmdHeader*>(commands)->commandSize;
+        if (commandSize64 < sizeof(CmdHeader) + sizeof(WireCmd) || commandSize64 > size) {
+            return nullptr;
+        }
+        size_t commandSize = static_cast<size_t>(commandSize64);
+
+        WireResult routingResult =
+            GetCommandRouting(commands, commandSize, &mRoutingAllocator, &mRouting);
+        mRoutingAllocator.Reset();
+        if (routingResult != WireResult::Success) {
+            return nullptr;
+        }
+        uint32_t server = GetObjectServer(mRouting.selfType, mRouting.selfId);
+        if (mRouting.hasResult &&
+            SetObjectServer(mRouting.resultType, mRouting.result.id, server) !=
+                WireResult::Success) {
+            return nullptr;
+        }
+
+        bool usesObjectsOfOtherServers = UsesObjectsOfOtherServers(server);
+        if (server == kRootServer || usesObjectsOfOtherServers) {
+            // The commands of the instance and the adapters can affect all the devices, and the
+            // commands using objects of other Servers need these Servers to be idle, so they are
+            // handled once the device threads are idle.
+            AppendRun();
+            SubmitToDeviceThreads();
+            WaitForDeviceThreads();
+
+            const char* command = const_cast<const char*>(commands);
+            mIdleCommands.assign(command, command + commandSize);
+            Server* handler = WaitForServer(server);
+            if (usesObjectsOfOtherServers) {
+                handler->SetObjectServerLookup(this);
+            }
+            bool success = handler->HandleCommands(mIdleCommands.data(), commandSize) != nullptr;
+            handler->SetObjectServerLookup(nullptr);
+            if (!success || !FlushSerializer()) {
+                return nullptr;
+            }
+        } else {
+            if (server != runServer || runSize == 0) {
+                AppendRun();
+                run = commands;
+                runServer = server;
+            }
+            runSize += commandSize;
+        }
+
+        commands += commandSize;
+        size -= commandSize;
+    }
+
+    AppendRun();
+    SubmitToDeviceThreads();
+    if (size != 0) {
+        return nullptr;
+    }
+    return commands;
+}
+
+uint32_t ThreadedServer::GetObjectServer(ObjectType type, ObjectId id) {
+    const std::vector<uint32_t>& servers = mObjectServers[type];
+    if (id >= servers.size()) {
+        return kRootServer;
+    }
+
+    uint32_t server = servers[id];
+    if (server == kRootServer && type == ObjectType::Device) {
+        return MoveDeviceToThread(id);
+    }
+    return server;
+}
+
+const ServerBase* ThreadedServer::FindObjectServer(ObjectType type, ObjectId id) const {
+    const std::vector<uint32_t>& servers = mObjectServers[type];
+    if (id == 0 || id >= servers.size()) {
+        return nullptr;
+    }
+
+    uint32_t server = servers[id];
+    if (server == kRootServer) {
+        return mRootServer.get();
+    }
+    return mDeviceThreads[server - 1]->GetServer();
+}
+
+bool ThreadedServer::UsesObjectsOfOtherServers(uint32_t server) {
+    for (const RoutingObject& object : mRouting.objects) {
+        // The ID 0 is the null object of optional members.
+        if (object.id != 0 && GetObjectServer(object.type, object.id) != server) {
+            return true;
+        }
+    }
+    return false;
+}
+
+WireResult ThreadedServer::SetObjectServer(ObjectType type, ObjectId id, uint32_t server) {
+    std::vector<uint32_t>& servers = mObjectServers[type];
+    if (id == 0 || id > servers.size()) {
+        return WireResult::FatalError;
+    }
+
+    if (id == servers.size()) {
+        servers.push_back(server);
+    } else {
+        servers[id] = server;
+    }
+    return WireResult::Success;
+}
+
+uint32_t ThreadedServer::MoveDeviceToThread(ObjectId id) {
+    // The device may not be allocated yet if it is still being requested, in which case the
+    // root Server handles (and rejects) its commands like a single Server would.
+    uint32_t generation;
+    WGPUDevice device = mRootServer->ExtractDevice(id, &generation);
+    if (device == nullptr) {
+        return kRootServer;
+    }
+
+    uint32_t server = AssignDeviceThread();
+    mObjectServers[ObjectType::Device][id] = server;
+    bool success = WaitForServer(server)->InjectDevice(device, id, generation);
+    ASSERT(success);
+    // InjectDevice added a reference for the new Server, release the one of the root Server.
+    mProcs.deviceRelease(device);
+    return server;
+}
+
+uint32_t ThreadedServer::AssignDeviceThread() {
+    uint32_t thread = mNextDeviceThread;
+    mNextDeviceThread = (mNextDeviceThread + 1) % mDeviceThreads.size();
+    return thread + 1;
+}
+
+Server* ThreadedServer::WaitForServer(uint32_t server) {
+    if (server == kRootServer) {
+        return mRootServer.get();
+    }
+
+    DeviceThread* thread = mDeviceThreads[server - 1].get();
+    thread->Submit();
+    thread->WaitForIdle();
+    return thread->GetServer();
+}
+
+bool ThreadedServer::InjectTexture(WGPUTexture texture,
+                                   uint32_t id,
+                                   uint32_t generation,
+                                   uint32_t deviceId,
+                                   uint32_t deviceGeneration) {
+    uint32_t server = GetObjectServer(ObjectType::Device, deviceId);
+    if (SetObjectServer(ObjectType::Texture, id, server) != WireResult::Success) {
+        return false;
+    }
+    return WaitForServer(server)->InjectTexture(texture, id, generation, deviceId,
+                                                deviceGeneration);
+}
+
+bool ThreadedServer::InjectSwapChain(WGPUSwapChain swapchain,
+                                     uint32_t id,
+                                     uint32_t generation,
+                                     uint32_t deviceId,
+                                     uint32_t deviceGeneration) {
+    uint32_t server = GetObjectServer(ObjectType::Device, deviceId);
+    if (SetObjectServer(ObjectType::SwapChain, id, server) != WireResult::Success) {
+        return false;
+    }
+    return WaitForServer(server)->InjectSwapChain(swapchain, id, generation, deviceId,
+                                                  deviceGeneration);
+}
+
+bool ThreadedServer::InjectDevice(WGPUDevice device, uint32_t id, uint32_t generation) {
+    uint32_t server = AssignDeviceThread();
+    if (SetObjectServer(ObjectType::Device, id, server) != WireResult::Success) {
+        return false;
+    }
+    return WaitForServer(server)->InjectDevice(device, id, generation);
+}
+
+bool ThreadedServer::InjectInstance(WGPUInstance instance, uint32_t id, uint32_t generation) {
+    if (SetObjectServer(ObjectType::Instance, id, kRootServer) != WireResult::Success) {
+        return false;
+    }
+    return mRootServer->InjectInstance(instance, id, generation);
+}
+
+WGPUDevice ThreadedServer::GetDevice(uint32_t id, uint32_t generation) {
+    return WaitForServer(GetObjectServer(ObjectType::Device, id))->GetDevice(id, generation);
+}
+
+bool ThreadedServer::IsDeviceKnown(WGPUDevice device) {
+    if (mRootServer->IsDeviceKnown(device)) {
+        return true;
+    }
+    for (uint32_t i = 0; i < mDeviceThreads.size(); ++i) {
+        if (WaitForServer(i + 1)->IsDeviceKnown(device)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadedServer::TickDevices() {
+    for (std::unique_ptr<DeviceThread>& thread : mDeviceThreads) {
+        thread->RequestTick();
+    }
+    // Devices that are still in the root Server haven't been used yet, but may have been lost.
+    mRootServer->TickDevices();
+    if (!FlushSerializer()) {
+        mFailed.store(true, std::memory_order_relaxed);
+    }
+}
+
+void ThreadedServer::WaitForIdle() {
+    SubmitToDeviceThreads();
+    WaitForDeviceThreads();
+}
+
+void ThreadedServer::SubmitToDeviceThreads() {
+    for (std::unique_ptr<DeviceThread>& thread : mDeviceThreads) {
+        thread->Submit();
+    }
+}
+
+void ThreadedServer::WaitForDeviceThreads() {
+    for (std::unique_ptr<DeviceThread>& thread : mDeviceThreads) {
+        thread->WaitForIdle();
+    }
+}
+
+bool ThreadedServer::FlushSerializer() {
+    std::lock_guard<std::mutex> lock(mSerializerMutex);
+    return mSerializer->Flush();
+}
+
+}  // namespace dawn::wire::server
@@ -0,0 +1,139 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_WIRE_SERVER_THREADEDSERVER_H_
+#define SRC_DAWN_WIRE_SERVER_THREADEDSERVER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dawn/wire/ChunkedCommandHandler.h"
+#include "dawn/wire/WireDeserializeAllocator.h"
+#include "dawn/wire/server/Server.h"
+
+namespace dawn::wire::server {
+
+// The implementation of a WireServer whose devices have their own threads, used when
+// WireServerDescriptor::deviceThreadCount isn't 0.
+//
+// Each device thread has its own Server, and each device is assigned to one of them. The commands
+// are routed to the Server of the object they are called on (see GetCommandRouting) and the
+// objects they create are assigned to the same Server. The commands of each thread are handled
+// in order so the commands of each device are too.
+//
+// The instance and the adapters are in a root Server that handles their commands on the thread
+// of HandleCommands, once the device threads are idle since these commands can affect all the
+// devices. Devices created by the root Server with Adapter::RequestDevice are moved to a device
+// thread the first time the client uses them.
+//
+// The commands that use objects of other Servers, for example a queue writing to a buffer of
+// another device, are handled like the commands of the root Server once the device threads are
+// idle. Their Server then resolves the IDs of the objects of other Servers too, so that the
+// device reports a validation error like it would with a single Server.
+//
+// The routing only decides which Server handles a command: each Server gets a copy of the
+// command and validates it, and since the Servers only use the objects of other Servers while
+// these are idle, a client that changes its commands while they are handled can only make its
+// own commands fail.
+class ThreadedServer : public ChunkedCommandHandler, public ObjectServerLookup {
+  public:
+    ThreadedServer(const DawnProcTable& procs,
+                   CommandSerializer* serializer,
+                   MemoryTransferService* memoryTransferService,
+                   size_t maxDeserializeArenaSize,
+                   uint32_t deviceThreadCount);
+    ~ThreadedServer() override;
+
+    bool InjectTexture(WGPUTexture texture,
+                       uint32_t id,
+                       uint32_t generation,
+                       uint32_t deviceId,
+                       uint32_t deviceGeneration);
+
+    bool InjectSwapChain(WGPUSwapChain swapchain,
+                         uint32_t id,
+                         uint32_t generation,
+                         uint32_t deviceId,
+                         uint32_t deviceGeneration);
+
+    bool InjectDevice(WGPUDevice device, uint32_t id, uint32_t generation);
+
+    bool InjectInstance(WGPUInstance instance, uint32_t id, uint32_t generation);
+
+    WGPUDevice GetDevice(uint32_t id, uint32_t generation);
+    bool IsDeviceKnown(WGPUDevice device);
+
+    void TickDevices();
+    void WaitForIdle();
+
+  private:
+    class DeviceThread;
+
+    // The index of the Server of an object: 0 for the root Server, and i + 1 for the Server of
+    // the i-th device thread.
+    static constexpr uint32_t kRootServer = 0;
+
+    const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override;
+
+    // ObjectServerLookup implementation.
+    const ServerBase* FindObjectServer(ObjectType type, ObjectId id) const override;
+
+    // Returns the index of the Server of an object, or kRootServer if the object is unknown so
+    // that the root Server rejects its commands.
+    uint32_t GetObjectServer(ObjectType type, ObjectId id);
+    // Assigns a newly created object to a Server. Like the Servers, requires that |id| isn't
+    // ahead of the IDs seen so far, which bounds the size of the tables of all the Servers.
+    WireResult SetObjectServer(ObjectType type, ObjectId id, uint32_t server);
+
+    // Returns whether the objects used by the current command aren't all in |server|.
+    bool UsesObjectsOfOtherServers(uint32_t server);
+    // Moves a device allocated in the root Server to a device thread. Returns the index of its
+    // new Server, or kRootServer if the device isn't allocated in the root Server.
+    uint32_t MoveDeviceToThread(ObjectId id);
+    uint32_t AssignDeviceThread();
+
+    // Returns the Server with the given index once it is safe to use on this thread.
+    Server* WaitForServer(uint32_t server);
+
+    void SubmitToDeviceThreads();
+    void WaitForDeviceThreads();
+    bool FlushSerializer();
+
+    DawnProcTable mProcs;
+    CommandSerializer* mSerializer;
+    // Held while any of the Servers serializes a command or when the serializer is flushed.
+    std::mutex mSerializerMutex;
+    // Set when a device thread fails to handle its commands.
+    std::atomic<bool> mFailed{false};
+
+    std::unique_ptr<Server> mRootServer;
+    std::vector<std::unique_ptr<DeviceThread>> mDeviceThreads;
+    uint32_t mNextDeviceThread = 0;
+
+    // The index of the Server of each object, indexed by ID.
+    PerObjectType<std::vector<uint32_t>> mObjectServers;
+    // The routing of the current command, and the allocator used to read the objects of its
+    // structures and arrays.
+    CommandRouting mRouting;
+    WireDeserializeAllocator mRoutingAllocator;
+    // The commands handled while the device threads are idle are copied out of the transport
+    // memory first.
+    std::vector<char> mIdleCommands;
+};
+
+}  // namespace dawn::wire::server
+
+#endif  // SRC_DAWN_WIRE_SERVER_THREADEDSERVER_H_